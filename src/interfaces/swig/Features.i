@@ -67,6 +67,7 @@
 %rename(StreamingHashedDocDotFeatures) CStreamingHashedDocDotFeatures;
 %rename(RandomKitchenSinksDotFeatures) CRandomKitchenSinksDotFeatures;
 %rename(RandomFourierDotFeatures) CRandomFourierDotFeatures;
+%rename(QuantizedDenseFeatures) CQuantizedDenseFeatures;
 %rename(Labels) CLabels;
 %rename(LabelsFactory) CLabelsFactory;
 
@@ -499,6 +500,7 @@ namespace shogun
 %include <shogun/features/streaming/StreamingHashedDocDotFeatures.h>
 %include <shogun/features/RandomKitchenSinksDotFeatures.h>
 %include <shogun/features/RandomFourierDotFeatures.h>
+%include <shogun/features/QuantizedDenseFeatures.h>
 
 %include <shogun/labels/Labels.h>
 %include <shogun/labels/LabelsFactory.h>
@@ -24,6 +24,7 @@
 #include <shogun/features/streaming/StreamingHashedDocDotFeatures.h>
 #include <shogun/features/RandomKitchenSinksDotFeatures.h>
 #include <shogun/features/RandomFourierDotFeatures.h>
+#include <shogun/features/QuantizedDenseFeatures.h>
 #include <shogun/labels/Labels.h>
 #include <shogun/labels/LabelsFactory.h>
 #include <shogun/labels/DenseLabels.h>
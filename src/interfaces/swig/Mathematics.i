@@ -112,6 +112,8 @@ namespace shogun
 #endif
 }
 
+%rename(KernelMatrixOperator) CKernelMatrixOperator;
+
 /* Operator functions */
 %include <shogun/mathematics/linalg/ratapprox/opfunc/OperatorFunction.h>
 namespace shogun
@@ -187,6 +189,7 @@ namespace shogun
 %include <shogun/mathematics/linalg/linop/MatrixOperator.h>
 %include <shogun/mathematics/linalg/linop/SparseMatrixOperator.h>
 %include <shogun/mathematics/linalg/linop/DenseMatrixOperator.h>
+%include <shogun/mathematics/linalg/linop/KernelMatrixOperator.h>
 
 %include <shogun/mathematics/linalg/ratapprox/opfunc/OperatorFunction.h>
 %include <shogun/mathematics/linalg/ratapprox/opfunc/RationalApproximation.h>
@@ -14,6 +14,7 @@
 #include <shogun/mathematics/linalg/linop/MatrixOperator.h>
 #include <shogun/mathematics/linalg/linop/SparseMatrixOperator.h>
 #include <shogun/mathematics/linalg/linop/DenseMatrixOperator.h>
+#include <shogun/mathematics/linalg/linop/KernelMatrixOperator.h>
 
 #include <shogun/mathematics/linalg/ratapprox/opfunc/OperatorFunction.h>
 #include <shogun/mathematics/linalg/ratapprox/opfunc/RationalApproximation.h>
@@ -1943,7 +1943,9 @@ TParameter::delete_cont()
 			for (index_t i=0; i<old_length; i++) {
 				SGSparseVector<char>* buf = (SGSparseVector<char>*) (*(char**)
 						m_parameter + i *m_datatype.sizeof_stype());
-				if (buf->num_feat_entries > 0) SG_FREE(buf->features);
+				/* the entries may be a view into the block of a
+				 * compressed sparse matrix, release instead of freeing */
+				*buf=SGSparseVector<char>();
 			}
 
 			switch (m_datatype.m_ptype) {
@@ -2307,6 +2309,11 @@ TParameter::save_stype(CSerializableFile* file, const void* param,
 		}
 		if (!file->write_string_begin(
 				&m_datatype, m_name, prefix, len_real)) return false;
+		if (file->supports_block_io() && m_datatype.m_ptype!=PT_SGOBJECT) {
+			if (!file->write_block(&m_datatype, m_name, prefix,
+					str_ptr->string, size_t(len_real)
+					*m_datatype.sizeof_ptype())) return false;
+		} else
 		for (index_t i=0; i<len_real; i++) {
 			if (!file->write_stringentry_begin(
 					&m_datatype, m_name, prefix, i)) return false;
@@ -2330,6 +2337,11 @@ TParameter::save_stype(CSerializableFile* file, const void* param,
 		}
 		if (!file->write_sparse_begin(
 				&m_datatype, m_name, prefix, len_real)) return false;
+		if (file->supports_block_io()) {
+			if (!file->write_block(&m_datatype, m_name, prefix,
+					spr_ptr->features, size_t(len_real)*TSGDataType
+					::sizeof_sparseentry(m_datatype.m_ptype))) return false;
+		} else
 		for (index_t i=0; i<len_real; i++) {
 			SGSparseVectorEntry<char>* cur = (SGSparseVectorEntry<char>*)
 				((char*) spr_ptr->features + i *TSGDataType
@@ -2373,6 +2385,11 @@ TParameter::load_stype(CSerializableFile* file, void* param,
 			return false;
 		str_ptr->string = len_real > 0
 			? SG_MALLOC(char, len_real*m_datatype.sizeof_ptype()): NULL;
+		if (file->supports_block_io() && m_datatype.m_ptype!=PT_SGOBJECT) {
+			if (!file->read_block(&m_datatype, m_name, prefix,
+					str_ptr->string, size_t(len_real)
+					*m_datatype.sizeof_ptype())) return false;
+		} else
 		for (index_t i=0; i<len_real; i++) {
 			if (!file->read_stringentry_begin(
 					&m_datatype, m_name, prefix, i)) return false;
@@ -2393,6 +2410,11 @@ TParameter::load_stype(CSerializableFile* file, void* param,
 		spr_ptr->features = len_real > 0? (SGSparseVectorEntry<char>*)
 			SG_MALLOC(char, len_real *TSGDataType::sizeof_sparseentry(
 				m_datatype.m_ptype)): NULL;
+		if (file->supports_block_io()) {
+			if (!file->read_block(&m_datatype, m_name, prefix,
+					spr_ptr->features, size_t(len_real)*TSGDataType
+					::sizeof_sparseentry(m_datatype.m_ptype))) return false;
+		} else
 		for (index_t i=0; i<len_real; i++) {
 			SGSparseVectorEntry<char>* cur = (SGSparseVectorEntry<char>*)
 				((char*) spr_ptr->features + i *TSGDataType
@@ -2575,6 +2597,12 @@ TParameter::save(CSerializableFile* file, const char* prefix)
 
 		/* ******************************************************** */
 
+		if (file->supports_block_io() && m_datatype.m_stype==ST_NONE
+			&& m_datatype.m_ptype!=PT_SGOBJECT) {
+			if (!file->write_block(&m_datatype, m_name, prefix,
+					*(char**) m_parameter, size_t(len_real_x)*len_real_y
+					*m_datatype.sizeof_stype())) return false;
+		} else
 		for (index_t x=0; x<len_real_x; x++)
 			for (index_t y=0; y<len_real_y; y++) {
 				if (!file->write_item_begin(
@@ -2661,6 +2689,15 @@ TParameter::load(CSerializableFile* file, const char* prefix)
 					break;
 			}
 
+			if (file->supports_block_io() && m_datatype.m_stype==ST_NONE
+				&& m_datatype.m_ptype!=PT_SGOBJECT)
+			{
+				if (!file->read_block(&m_datatype, m_name, prefix,
+							*(char**) m_parameter, size_t(dims[0])*dims[1]
+							*m_datatype.sizeof_stype()))
+					return false;
+			}
+			else
 			for (index_t x=0; x<dims[0]; x++)
 			{
 				for (index_t y=0; y<dims[1]; y++)
@@ -3704,10 +3741,10 @@ bool TParameter::copy_stype(EStructType stype, EPrimitiveType ptype,
 						" freeing memory.\n",
 						source_ptr->num_feat_entries, target_ptr->num_feat_entries);
 
-				/* if string have different lengths, free data and make equal */
-				SG_FREE(target_ptr->features);
-				target_ptr->features=NULL;
-				target_ptr->num_feat_entries=0;
+				/* if vectors have different lengths, release data and make
+				 * equal. The entries are not freed directly, the target may
+				 * be a view into the block of a compressed sparse matrix */
+				*target_ptr=SGSparseVector<char>();
 			}
 
 			if (!target_ptr->features)
@@ -3855,6 +3892,14 @@ bool TParameter::copy(TParameter* target)
 			 * is there */
 			ASSERT(m_datatype.equals(target->m_datatype));
 
+			/* containers of primitive types are copied in one go */
+			if (m_datatype.m_stype==ST_NONE && m_datatype.m_ptype!=PT_SGOBJECT)
+			{
+				sg_memcpy(*(char**)target->m_parameter, *(char**)m_parameter,
+						size_t(*m_datatype.m_length_y)*m_datatype.sizeof_stype());
+				break;
+			}
+
 			/* x is number of processed bytes */
 			index_t x=0;
 			SG_SDEBUG("length_y: %d\n", *m_datatype.m_length_y)
@@ -3922,6 +3967,15 @@ bool TParameter::copy(TParameter* target)
 			 * is there */
 			ASSERT(m_datatype.equals(target->m_datatype));
 
+			/* containers of primitive types are copied in one go */
+			if (m_datatype.m_stype==ST_NONE && m_datatype.m_ptype!=PT_SGOBJECT)
+			{
+				sg_memcpy(*(char**)target->m_parameter, *(char**)m_parameter,
+						size_t(*m_datatype.m_length_y)*(*m_datatype.m_length_x)
+						*m_datatype.sizeof_stype());
+				break;
+			}
+
 			/* x is number of processed bytes */
 			index_t x=0;
 			SG_SDEBUG("length_y: %d\n", *m_datatype.m_length_y)
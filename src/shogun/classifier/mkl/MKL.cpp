@@ -1617,12 +1617,33 @@ void CMKL::compute_sum_beta(float64_t* sumw)
 
 	int32_t nsv=svm->get_num_support_vectors();
 	int32_t num_kernels = kernel->get_num_subkernels();
-	SGVector<float64_t> beta=SGVector<float64_t>(num_kernels);
 	int32_t nweights=0;
 	const float64_t* old_beta = kernel->get_subkernel_weights(nweights);
 	ASSERT(nweights==num_kernels)
 	ASSERT(old_beta)
 
+	// all subkernels at once when the weights are those of the kernel list
+	if (kernel->get_kernel_type()==K_COMBINED &&
+			((CCombinedKernel*) kernel)->get_num_kernels()==num_kernels)
+	{
+		SGVector<int32_t> idx(nsv);
+		SGVector<float64_t> coef(nsv);
+		for (int32_t i=0; i<nsv; i++)
+		{
+			idx[i]=svm->get_support_vector(i);
+			coef[i]=svm->get_alpha(i);
+		}
+
+		SGVector<float64_t> forms=
+			((CCombinedKernel*) kernel)->compute_subkernel_quadratic_forms(idx, coef);
+		for (int32_t n=0; n<num_kernels; n++)
+			sumw[n]=0.5*forms[n];
+
+		mkl_iterations++;
+		return;
+	}
+
+	SGVector<float64_t> beta=SGVector<float64_t>(num_kernels);
 	for (int32_t i=0; i<num_kernels; i++)
 	{
 		beta.vector[i]=0;
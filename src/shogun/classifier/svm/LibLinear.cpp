@@ -18,10 +18,68 @@
 #include <shogun/labels/BinaryLabels.h>
 #include <shogun/lib/Signal.h>
 #include <shogun/lib/Time.h>
+#include <shogun/mathematics/RandomStream.h>
 #include <shogun/optimization/liblinear/tron.h>
 
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
 using namespace shogun;
 
+namespace
+{
+	/* index of the calling thread within the current parallel region */
+	inline int32_t current_thread()
+	{
+#ifdef HAVE_OPENMP
+		return omp_get_thread_num();
+#else
+		return 0;
+#endif
+	}
+
+	/* calls f(index, value) for every entry of vector j of x; in transposed
+	 * problems the bias coordinate is an implicit vector of l ones */
+	template <class F>
+	void for_each_entry(
+		CDotFeatures* x, int32_t j, bool is_bias, int32_t l, F f)
+	{
+		if (is_bias)
+		{
+			for (int32_t ind=0; ind<l; ind++)
+				f(ind, 1.0);
+			return;
+		}
+
+		int32_t ind;
+		float64_t val;
+		void* iterator=x->get_feature_iterator(j);
+		while (x->get_next_feature(ind, val, iterator))
+			f(ind, val);
+		x->free_feature_iterator(iterator);
+	}
+
+	/* w+=alpha*x_i on a vector that other threads update concurrently,
+	 * either with atomic adds or without any synchronisation */
+	void add_to_shared_vec(
+		CDotFeatures* x, int32_t i, float64_t alpha, float64_t* w,
+		int32_t dim, bool atomic)
+	{
+		if (!atomic)
+		{
+			x->add_to_dense_vec(alpha, i, w, dim);
+			return;
+		}
+
+		for_each_entry(x, i, false, 0, [&](int32_t ind, float64_t val)
+		{
+#pragma omp atomic
+			w[ind]+=alpha*val;
+		});
+	}
+}
+
 CLibLinear::CLibLinear()
 : CLinearMachine()
 {
@@ -70,6 +128,13 @@ void CLibLinear::init()
 	SG_ADD(&m_linear_term, "linear_term", "Linear Term", MS_NOT_AVAILABLE);
 	SG_ADD((machine_int_t*) &liblinear_solver_type, "liblinear_solver_type",
 			"Type of LibLinear solver.", MS_NOT_AVAILABLE);
+
+	m_parallel_mode=LL_SEQUENTIAL;
+	set_parallel_block_size();
+	SG_ADD((machine_int_t*) &m_parallel_mode, "parallel_mode",
+			"Parallel mode of the coordinate descent solvers.", MS_NOT_AVAILABLE);
+	SG_ADD(&m_parallel_block_size, "parallel_block_size",
+			"Block size of the deterministic parallel mode.", MS_NOT_AVAILABLE);
 }
 
 CLibLinear::~CLibLinear()
@@ -168,6 +233,12 @@ bool CLibLinear::train_machine(CFeatures* data)
 
 	SG_INFO("%d training points %d dims\n", prob.l, prob.n)
 
+	// asynchronous modes with a single thread are plain coordinate descent,
+	// the deterministic mode always runs blocked to be thread-count invariant
+	bool run_async=(m_parallel_mode==LL_ASYNC_ATOMIC ||
+			m_parallel_mode==LL_ASYNC_WILD) && parallel->get_num_threads()>1;
+	bool run_primal_parallel=run_async || m_parallel_mode==LL_DETERMINISTIC;
+
 	function *fun_obj=NULL;
 	switch (liblinear_solver_type)
 	{
@@ -190,26 +261,38 @@ bool CLibLinear::train_machine(CFeatures* data)
 			break;
 		}
 		case L2R_L2LOSS_SVC_DUAL:
-			solve_l2r_l1l2_svc(w, &prob, epsilon, Cp, Cn, L2R_L2LOSS_SVC_DUAL);
-			break;
 		case L2R_L1LOSS_SVC_DUAL:
-			solve_l2r_l1l2_svc(w, &prob, epsilon, Cp, Cn, L2R_L1LOSS_SVC_DUAL);
+		{
+			if (run_async)
+				solve_l2r_l1l2_svc_parallel(w, &prob, epsilon, Cp, Cn, liblinear_solver_type);
+			else
+				solve_l2r_l1l2_svc(w, &prob, epsilon, Cp, Cn, liblinear_solver_type);
 			break;
+		}
 		case L1R_L2LOSS_SVC:
 		{
 			//ASSUME FEATURES ARE TRANSPOSED ALREADY
-			solve_l1r_l2_svc(w, &prob, epsilon*CMath::min(pos,neg)/prob.l, Cp, Cn);
+			if (run_primal_parallel)
+				solve_l1r_l2_svc_parallel(w, &prob, epsilon*CMath::min(pos,neg)/prob.l, Cp, Cn);
+			else
+				solve_l1r_l2_svc(w, &prob, epsilon*CMath::min(pos,neg)/prob.l, Cp, Cn);
 			break;
 		}
 		case L1R_LR:
 		{
 			//ASSUME FEATURES ARE TRANSPOSED ALREADY
-			solve_l1r_lr(w, &prob, epsilon*CMath::min(pos,neg)/prob.l, Cp, Cn);
+			if (run_primal_parallel)
+				solve_l1r_lr_parallel(w, &prob, epsilon*CMath::min(pos,neg)/prob.l, Cp, Cn);
+			else
+				solve_l1r_lr(w, &prob, epsilon*CMath::min(pos,neg)/prob.l, Cp, Cn);
 			break;
 		}
 		case L2R_LR_DUAL:
 		{
-			solve_l2r_lr_dual(w, &prob, epsilon, Cp, Cn);
+			if (run_async)
+				solve_l2r_lr_dual_parallel(w, &prob, epsilon, Cp, Cn);
+			else
+				solve_l2r_lr_dual(w, &prob, epsilon, Cp, Cn);
 			break;
 		}
 		default:
@@ -1346,6 +1429,1182 @@ void CLibLinear::solve_l2r_lr_dual(SGVector<float64_t>& w, const liblinear_probl
 }
 
 
+// Asynchronous parallel variant of solve_l2r_l1l2_svc (PASSCoDe, see
+// Hsieh, Yu and Dhillon, ICML 2015).
+//
+// Every thread owns a slice of the dual variables which it shuffles and
+// shrinks on its own. The primal vector w is shared between all threads and
+// either updated atomically (LL_ASYNC_ATOMIC) or without any locking
+// (LL_ASYNC_WILD), in which case w is only approximately consistent with
+// alpha but converges to the solution of a slightly perturbed problem.
+
+#undef GETI
+#define GETI(i) (y[i]+1)
+// To support weights for instances, use GETI(i) (i)
+
+void CLibLinear::solve_l2r_l1l2_svc_parallel(
+			SGVector<float64_t>& w,
+			const liblinear_problem *prob, double eps, double Cp, double Cn, LIBLINEAR_SOLVER_TYPE st)
+{
+	int l = prob->l;
+	int w_size = prob->n;
+	int i, iter = 0;
+	bool atomic = m_parallel_mode==LL_ASYNC_ATOMIC;
+	int32_t num_threads = CMath::max(CMath::min(parallel->get_num_threads(), l), 1);
+#ifndef HAVE_OPENMP
+	num_threads = 1;
+#endif
+	double *QD = SG_MALLOC(double, l);
+	int *index = SG_MALLOC(int, l);
+	double *alpha = SG_MALLOC(double, l);
+	int32_t *y = SG_MALLOC(int32_t, l);
+	int32_t *slice_start = SG_MALLOC(int32_t, num_threads+1);
+	int32_t *active = SG_MALLOC(int32_t, num_threads);
+	RandomStream* rng = new RandomStream[num_threads];
+
+	double PGmax_old = CMath::INFTY;
+	double PGmin_old = -CMath::INFTY;
+
+	// default solver_type: L2R_L2LOSS_SVC_DUAL
+	double diag[3] = {0.5/Cn, 0, 0.5/Cp};
+	double upper_bound[3] = {CMath::INFTY, 0, CMath::INFTY};
+	if(st == L2R_L1LOSS_SVC_DUAL)
+	{
+		diag[0] = 0;
+		diag[2] = 0;
+		upper_bound[0] = Cn;
+		upper_bound[2] = Cp;
+	}
+
+	int n = prob->n;
+
+	if (prob->use_bias)
+		n--;
+
+	for(i=0; i<w_size; i++)
+		w[i] = 0;
+
+	for(i=0; i<l; i++)
+	{
+		alpha[i] = 0;
+		if(prob->y[i] > 0)
+			y[i] = +1;
+		else
+			y[i] = -1;
+		index[i] = i;
+	}
+
+#pragma omp parallel for num_threads(num_threads)
+	for(int32_t k=0; k<l; k++)
+		QD[k] = diag[GETI(k)] + prob->x->dot(k, prob->x, k);
+
+	for (int32_t t=0; t<=num_threads; t++)
+		slice_start[t] = int64_t(l)*t/num_threads;
+	const uint64_t rng_seed = CMath::random();
+	for (int32_t t=0; t<num_threads; t++)
+	{
+		active[t] = slice_start[t+1]-slice_start[t];
+		rng[t].set_seed(rng_seed, t);
+	}
+
+	auto pb = progress(range(10));
+	CTime start_time;
+	while (iter < max_iterations && !cancel_computation())
+	{
+		if (m_max_train_time > 0 && start_time.cur_time_diff() > m_max_train_time)
+		  break;
+
+		double PGmax_new = -CMath::INFTY;
+		double PGmin_new = CMath::INFTY;
+
+#pragma omp parallel num_threads(num_threads) \
+		reduction(max:PGmax_new) reduction(min:PGmin_new)
+		{
+			int32_t t = current_thread();
+			int32_t* slice = index+slice_start[t];
+			int32_t active_size = active[t];
+
+			for (int32_t s=0; s<active_size; s++)
+			{
+				int32_t j = rng[t].random(s, active_size-1);
+				CMath::swap(slice[s], slice[j]);
+			}
+
+			for (int32_t s=0; s<active_size; s++)
+			{
+				int32_t k = slice[s];
+				int32_t yk = y[k];
+
+				double G = prob->x->dense_dot(k, w.vector, n);
+				if (prob->use_bias)
+					G+=w.vector[n];
+
+				if (m_linear_term.vector)
+					G = G*yk + m_linear_term.vector[k];
+				else
+					G = G*yk-1;
+
+				double C = upper_bound[GETI(k)];
+				G += alpha[k]*diag[GETI(k)];
+
+				double PG = 0;
+				if (alpha[k] == 0)
+				{
+					if (G > PGmax_old)
+					{
+						active_size--;
+						CMath::swap(slice[s], slice[active_size]);
+						s--;
+						continue;
+					}
+					else if (G < 0)
+						PG = G;
+				}
+				else if (alpha[k] == C)
+				{
+					if (G < PGmin_old)
+					{
+						active_size--;
+						CMath::swap(slice[s], slice[active_size]);
+						s--;
+						continue;
+					}
+					else if (G > 0)
+						PG = G;
+				}
+				else
+					PG = G;
+
+				PGmax_new = CMath::max(PGmax_new, PG);
+				PGmin_new = CMath::min(PGmin_new, PG);
+
+				if(fabs(PG) > 1.0e-12)
+				{
+					double alpha_old = alpha[k];
+					alpha[k] = CMath::min(CMath::max(alpha[k] - G/QD[k], 0.0), C);
+					double d = (alpha[k] - alpha_old)*yk;
+
+					add_to_shared_vec(prob->x, k, d, w.vector, n, atomic);
+
+					if (prob->use_bias)
+					{
+						if (atomic)
+						{
+#pragma omp atomic
+							w.vector[n]+=d;
+						}
+						else
+							w.vector[n]+=d;
+					}
+				}
+			}
+
+			active[t] = active_size;
+		}
+
+		int32_t total_active = 0;
+		for (int32_t t=0; t<num_threads; t++)
+			total_active += active[t];
+
+		iter++;
+		float64_t gap=PGmax_new - PGmin_new;
+		pb.print_absolute(
+		    gap, -CMath::log10(gap), -CMath::log10(1), -CMath::log10(eps));
+
+		if(gap <= eps)
+		{
+			if(total_active == l)
+				break;
+			else
+			{
+				for (int32_t t=0; t<num_threads; t++)
+					active[t] = slice_start[t+1]-slice_start[t];
+				PGmax_old = CMath::INFTY;
+				PGmin_old = -CMath::INFTY;
+				continue;
+			}
+		}
+		PGmax_old = PGmax_new;
+		PGmin_old = PGmin_new;
+		if (PGmax_old <= 0)
+			PGmax_old = CMath::INFTY;
+		if (PGmin_old >= 0)
+			PGmin_old = -CMath::INFTY;
+	}
+
+	pb.complete_absolute();
+	SG_INFO("optimization finished, #iter = %d, #threads = %d\n", iter, num_threads)
+	if (iter >= max_iterations)
+	{
+		SG_WARNING("reaching max number of iterations\nUsing -s 2 may be faster"
+				"(also see liblinear FAQ)\n\n");
+	}
+
+	// calculate objective value
+
+	double v = 0;
+	int nSV = 0;
+	for(i=0; i<w_size; i++)
+		v += w.vector[i]*w.vector[i];
+	for(i=0; i<l; i++)
+	{
+		v += alpha[i]*(alpha[i]*diag[GETI(i)] - 2);
+		if(alpha[i] > 0)
+			++nSV;
+	}
+	SG_INFO("Objective value = %lf\n",v/2)
+	SG_INFO("nSV = %d\n",nSV)
+
+	delete[] rng;
+	SG_FREE(active);
+	SG_FREE(slice_start);
+	SG_FREE(QD);
+	SG_FREE(alpha);
+	SG_FREE(y);
+	SG_FREE(index);
+}
+
+// Asynchronous parallel variant of solve_l2r_lr_dual, the dual variables
+// are partitioned between the threads just like in solve_l2r_l1l2_svc_parallel
+
+#undef GETI
+#define GETI(i) (y[i]+1)
+// To support weights for instances, use GETI(i) (i)
+
+void CLibLinear::solve_l2r_lr_dual_parallel(SGVector<float64_t>& w, const liblinear_problem *prob, double eps, double Cp, double Cn)
+{
+	int l = prob->l;
+	int w_size = prob->n;
+	int i, iter = 0;
+	bool atomic = m_parallel_mode==LL_ASYNC_ATOMIC;
+	int32_t num_threads = CMath::max(CMath::min(parallel->get_num_threads(), l), 1);
+#ifndef HAVE_OPENMP
+	num_threads = 1;
+#endif
+	double *xTx = SG_MALLOC(double, l);
+	int max_iter = 1000;
+	int *index = SG_MALLOC(int, l);
+	double *alpha = SG_MALLOC(double, 2*l); // store alpha and C - alpha
+	int32_t *y = SG_MALLOC(int32_t, l);
+	int32_t *slice_start = SG_MALLOC(int32_t, num_threads+1);
+	RandomStream* rng = new RandomStream[num_threads];
+	int max_inner_iter = 100; // for inner Newton
+	double innereps = 1e-2;
+	double innereps_min = CMath::min(1e-8, eps);
+	double upper_bound[3] = {Cn, 0, Cp};
+	double Gmax_init = 0;
+
+	for(i=0; i<l; i++)
+	{
+		if(prob->y[i] > 0)
+			y[i] = +1;
+		else
+			y[i] = -1;
+	}
+
+	// Initial alpha can be set here. Note that
+	// 0 < alpha[i] < upper_bound[GETI(i)]
+	// alpha[2*i] + alpha[2*i+1] = upper_bound[GETI(i)]
+	for(i=0; i<l; i++)
+	{
+		alpha[2*i] = CMath::min(0.001*upper_bound[GETI(i)], 1e-8);
+		alpha[2*i+1] = upper_bound[GETI(i)] - alpha[2*i];
+		index[i] = i;
+	}
+
+	for(i=0; i<w_size; i++)
+		w[i] = 0;
+	if (prob->use_bias)
+		w.vector[w_size] = 0;
+
+#pragma omp parallel for num_threads(num_threads)
+	for(int32_t k=0; k<l; k++)
+	{
+		xTx[k] = prob->x->dot(k, prob->x, k);
+		add_to_shared_vec(prob->x, k, y[k]*alpha[2*k], w.vector, w_size, true);
+
+		if (prob->use_bias)
+		{
+#pragma omp atomic
+			w.vector[w_size]+=y[k]*alpha[2*k];
+			xTx[k]+=1;
+		}
+	}
+
+	for (int32_t t=0; t<=num_threads; t++)
+		slice_start[t] = int64_t(l)*t/num_threads;
+	const uint64_t rng_seed = CMath::random();
+	for (int32_t t=0; t<num_threads; t++)
+	{
+		rng[t].set_seed(rng_seed, t);
+	}
+
+	auto pb = progress(range(10));
+	CTime start_time;
+	while (iter < max_iter && !cancel_computation())
+	{
+		if (m_max_train_time > 0 && start_time.cur_time_diff() > m_max_train_time)
+		  break;
+
+		int newton_iter = 0;
+		double Gmax = 0;
+
+#pragma omp parallel num_threads(num_threads) \
+		reduction(max:Gmax) reduction(+:newton_iter)
+		{
+			int32_t t = current_thread();
+			int32_t* slice = index+slice_start[t];
+			int32_t slice_size = slice_start[t+1]-slice_start[t];
+
+			for (int32_t s=0; s<slice_size; s++)
+			{
+				int32_t j = rng[t].random(s, slice_size-1);
+				CMath::swap(slice[s], slice[j]);
+			}
+
+			for (int32_t s=0; s<slice_size; s++)
+			{
+				int32_t k = slice[s];
+				int32_t yk = y[k];
+				double C = upper_bound[GETI(k)];
+				double ywTx = 0, xisq = xTx[k];
+
+				ywTx = prob->x->dense_dot(k, w.vector, w_size);
+				if (prob->use_bias)
+					ywTx+=w.vector[w_size];
+
+				ywTx *= yk;
+				double a = xisq, b = ywTx;
+
+				// Decide to minimize g_1(z) or g_2(z)
+				int ind1 = 2*k, ind2 = 2*k+1, sign = 1;
+				if(0.5*a*(alpha[ind2]-alpha[ind1])+b < 0)
+				{
+					ind1 = 2*k+1;
+					ind2 = 2*k;
+					sign = -1;
+				}
+
+				//  g_t(z) = z*log(z) + (C-z)*log(C-z) + 0.5a(z-alpha_old)^2 + sign*b(z-alpha_old)
+				double alpha_old = alpha[ind1];
+				double z = alpha_old;
+				if(C - z < 0.5 * C)
+					z = 0.1*z;
+				double gp = a*(z-alpha_old)+sign*b+CMath::log(z/(C-z));
+				Gmax = CMath::max(Gmax, CMath::abs(gp));
+
+				// Newton method on the sub-problem
+				const double eta = 0.1; // xi in the paper
+				int inner_iter = 0;
+				while (inner_iter <= max_inner_iter)
+				{
+					if(fabs(gp) < innereps)
+						break;
+					double gpp = a + C/(C-z)/z;
+					double tmpz = z - gp/gpp;
+					if(tmpz <= 0)
+						z *= eta;
+					else // tmpz in (0, C)
+						z = tmpz;
+					gp = a*(z-alpha_old)+sign*b+log(z/(C-z));
+					newton_iter++;
+					inner_iter++;
+				}
+
+				if(inner_iter > 0) // update w
+				{
+					alpha[ind1] = z;
+					alpha[ind2] = C-z;
+
+					double d = sign*(z-alpha_old)*yk;
+					add_to_shared_vec(prob->x, k, d, w.vector, w_size, atomic);
+
+					if (prob->use_bias)
+					{
+						if (atomic)
+						{
+#pragma omp atomic
+							w.vector[w_size]+=d;
+						}
+						else
+							w.vector[w_size]+=d;
+					}
+				}
+			}
+		}
+
+		if(iter == 0)
+			Gmax_init = Gmax;
+		iter++;
+
+		pb.print_absolute(
+		    Gmax, -CMath::log10(Gmax), -CMath::log10(Gmax_init),
+		    -CMath::log10(eps * Gmax_init));
+
+		if(Gmax < eps)
+			break;
+
+		if(newton_iter <= l/10)
+			innereps = CMath::max(innereps_min, 0.1*innereps);
+
+	}
+
+	pb.complete_absolute();
+	SG_INFO("optimization finished, #iter = %d, #threads = %d\n", iter, num_threads)
+	if (iter >= max_iter)
+		SG_WARNING("reaching max number of iterations\nUsing -s 0 may be faster (also see FAQ)\n\n")
+
+	// calculate objective value
+
+	double v = 0;
+	for(i=0; i<w_size; i++)
+		v += w[i] * w[i];
+	v *= 0.5;
+	for(i=0; i<l; i++)
+		v += alpha[2*i] * log(alpha[2*i]) + alpha[2*i+1] * log(alpha[2*i+1])
+			- upper_bound[GETI(i)] * log(upper_bound[GETI(i)]);
+	SG_INFO("Objective value = %lf\n", v)
+
+	delete[] rng;
+	SG_FREE(slice_start);
+	SG_FREE(xTx);
+	SG_FREE(alpha);
+	SG_FREE(y);
+	SG_FREE(index);
+}
+
+// Parallel variants of solve_l1r_l2_svc and solve_l1r_lr
+//
+// Both solvers keep a shared vector over the samples that the coordinate
+// steps read and update (b = 1-ywTx for the L2 loss, exp(w^T x_i) for the
+// logistic loss). solve_l1r_parallel drives the coordinate steps, the
+// solvers only provide the step, its update of the shared vector and the
+// loss of a sample.
+//
+// In the asynchronous modes the threads own slices of the coordinates and
+// update the shared vector concurrently (Shotgun, see Bradley et al.,
+// ICML 2011). Each coordinate's Newton step and line search only reads the
+// shared vector, and the accepted step is then scattered into it atomically
+// (LL_ASYNC_ATOMIC) or without synchronisation (LL_ASYNC_WILD).
+//
+// In LL_DETERMINISTIC mode the shuffled active set is processed in blocks of
+// m_parallel_block_size coordinates: all steps of a block are computed in
+// parallel against the same shared vector and then applied in block order.
+// Each step decreases the objective on its own, but together they can
+// increase it if the coordinates are correlated. The objective change of a
+// block is therefore measured on the samples it touches. If the objective
+// did not decrease, the block is rolled back and its steps are applied
+// scaled by 1/(number of steps). By convexity the objective at this average
+// of the single steps is not larger than the average of their objectives,
+// so it decreases as well.
+
+void CLibLinear::solve_l1r_parallel(
+	SGVector<float64_t>& w, const liblinear_problem *prob_col, double eps,
+	double* shared,
+	std::function<bool(int32_t, double, double&, double&, bool&)> propose,
+	std::function<void(int32_t, double, bool)> apply,
+	std::function<double(int32_t, double)> sample_loss,
+	std::function<void()> recompute)
+{
+	int l = prob_col->l;
+	int w_size = prob_col->n;
+	int j, iter = 0;
+	int active_size = w_size;
+	bool deterministic = m_parallel_mode==LL_DETERMINISTIC;
+	bool atomic = m_parallel_mode==LL_ASYNC_ATOMIC;
+	int32_t num_threads = CMath::max(CMath::min(parallel->get_num_threads(), w_size), 1);
+#ifndef HAVE_OPENMP
+	num_threads = 1;
+#endif
+	int32_t block_size = CMath::max(m_parallel_block_size, 1);
+
+	double Gmax_old = CMath::INFTY;
+	double Gmax_init=0;
+
+	CDotFeatures* x = prob_col->x;
+
+	int n = prob_col->n;
+	if (prob_col->use_bias)
+		n--;
+
+	int *index = SG_MALLOC(int, w_size);
+	for(j=0; j<w_size; j++)
+		index[j] = j;
+
+	int32_t *slice_start = SG_MALLOC(int32_t, num_threads+1);
+	int32_t *active = SG_MALLOC(int32_t, num_threads);
+	RandomStream* rng = new RandomStream[num_threads];
+	int32_t *block = SG_MALLOC(int32_t, block_size);
+	int32_t *shrunk = SG_MALLOC(int32_t, w_size);
+	double *block_d = SG_MALLOC(double, block_size);
+	double *block_violation = SG_MALLOC(double, block_size);
+	bool *block_keep = SG_MALLOC(bool, block_size);
+	bool *block_exhausted = SG_MALLOC(bool, block_size);
+	double *block_w_old = SG_MALLOC(double, block_size);
+	int32_t *touched = SG_MALLOC(int32_t, l);
+	double *touched_old = SG_MALLOC(double, l);
+	bool *is_touched = SG_CALLOC(bool, l);
+	int32_t num_damped = 0;
+
+	for (int32_t t=0; t<=num_threads; t++)
+		slice_start[t] = int64_t(w_size)*t/num_threads;
+	const uint64_t rng_seed = deterministic ? 0 : CMath::random();
+	for (int32_t t=0; t<num_threads; t++)
+	{
+		active[t] = slice_start[t+1]-slice_start[t];
+		rng[t].set_seed(rng_seed, t);
+	}
+
+	// applies the num_steps steps of a block, damped if they do not
+	// decrease the objective together
+	auto apply_block = [&](int32_t num_steps)
+	{
+		if (num_steps==1)
+			apply(block[0], block_d[0], false);
+		if (num_steps<=1)
+			return;
+
+		int32_t num_touched = 0;
+		double change = 0;
+		for (int32_t s=0; s<num_steps; s++)
+		{
+			int32_t k = block[s];
+			block_w_old[s] = w.vector[k];
+			change += fabs(w.vector[k]+block_d[s])-fabs(w.vector[k]);
+			for_each_entry(x, k, use_bias && k==n, l, [&](int32_t ind, float64_t val)
+			{
+				if (!is_touched[ind])
+				{
+					is_touched[ind] = true;
+					touched[num_touched] = ind;
+					touched_old[num_touched++] = shared[ind];
+				}
+			});
+		}
+
+		for (int32_t s=0; s<num_steps; s++)
+			apply(block[s], block_d[s], false);
+
+		for (int32_t t=0; t<num_touched; t++)
+		{
+			int32_t ind = touched[t];
+			change += sample_loss(ind, shared[ind])-sample_loss(ind, touched_old[t]);
+		}
+
+		if (change > 0)
+		{
+			for (int32_t t=0; t<num_touched; t++)
+				shared[touched[t]] = touched_old[t];
+			for (int32_t s=0; s<num_steps; s++)
+				w.vector[block[s]] = block_w_old[s];
+			for (int32_t s=0; s<num_steps; s++)
+				apply(block[s], block_d[s]/num_steps, false);
+			num_damped++;
+		}
+
+		for (int32_t t=0; t<num_touched; t++)
+			is_touched[touched[t]] = false;
+	};
+
+	auto pb = progress(range(10));
+	CTime start_time;
+	while (iter < max_iterations && !cancel_computation())
+	{
+		if (m_max_train_time > 0 && start_time.cur_time_diff() > m_max_train_time)
+		  break;
+
+		double Gmax_new = 0;
+		bool need_recompute = false;
+
+		if (deterministic)
+		{
+			for(j=0; j<active_size; j++)
+			{
+				int i = CMath::random(j, active_size-1);
+				CMath::swap(index[i], index[j]);
+			}
+
+			int32_t num_kept = 0;
+			int32_t num_shrunk = 0;
+			for (int32_t first=0; first<active_size; first+=block_size)
+			{
+				int32_t num_block = CMath::min(block_size, active_size-first);
+				sg_memcpy(block, index+first, sizeof(int32_t)*num_block);
+
+#pragma omp parallel for num_threads(num_threads)
+				for (int32_t k=0; k<num_block; k++)
+				{
+					block_keep[k] = propose(block[k], Gmax_old, block_d[k],
+							block_violation[k], block_exhausted[k]);
+				}
+
+				// keeps the coordinates in block order and moves the
+				// non-zero steps to the front of the block
+				int32_t num_steps = 0;
+				for (int32_t k=0; k<num_block; k++)
+				{
+					if (!block_keep[k])
+					{
+						shrunk[num_shrunk++] = block[k];
+						continue;
+					}
+					index[num_kept++] = block[k];
+					Gmax_new = CMath::max(Gmax_new, block_violation[k]);
+					need_recompute = need_recompute || block_exhausted[k];
+					if (block_d[k] != 0)
+					{
+						block[num_steps] = block[k];
+						block_d[num_steps++] = block_d[k];
+					}
+				}
+				apply_block(num_steps);
+			}
+			sg_memcpy(index+num_kept, shrunk, sizeof(int32_t)*num_shrunk);
+			active_size = num_kept;
+		}
+		else
+		{
+#pragma omp parallel num_threads(num_threads) \
+			reduction(max:Gmax_new) reduction(||:need_recompute)
+			{
+				int32_t t = current_thread();
+				int32_t* slice = index+slice_start[t];
+				int32_t slice_active = active[t];
+
+				for (int32_t s=0; s<slice_active; s++)
+				{
+					int32_t i = rng[t].random(s, slice_active-1);
+					CMath::swap(slice[s], slice[i]);
+				}
+
+				for (int32_t s=0; s<slice_active; s++)
+				{
+					double d, violation;
+					bool exhausted;
+					if (!propose(slice[s], Gmax_old, d, violation, exhausted))
+					{
+						slice_active--;
+						CMath::swap(slice[s], slice[slice_active]);
+						s--;
+						continue;
+					}
+
+					Gmax_new = CMath::max(Gmax_new, violation);
+					if (d != 0)
+						apply(slice[s], d, atomic);
+					need_recompute = need_recompute || exhausted;
+				}
+
+				active[t] = slice_active;
+			}
+
+			active_size = 0;
+			for (int32_t t=0; t<num_threads; t++)
+				active_size += active[t];
+		}
+
+		// recompute the shared vector if line search takes too many steps
+		if (need_recompute)
+		{
+			SG_INFO("#")
+			recompute();
+		}
+
+		if(iter == 0)
+			Gmax_init = Gmax_new;
+		iter++;
+
+		pb.print_absolute(
+		    Gmax_new, -CMath::log10(Gmax_new), -CMath::log10(Gmax_init),
+		    -CMath::log10(eps * Gmax_init));
+
+		if(Gmax_new <= eps*Gmax_init)
+		{
+			if(active_size == w_size)
+				break;
+			else
+			{
+				active_size = w_size;
+				for (int32_t t=0; t<num_threads; t++)
+					active[t] = slice_start[t+1]-slice_start[t];
+				Gmax_old = CMath::INFTY;
+				continue;
+			}
+		}
+
+		Gmax_old = Gmax_new;
+	}
+
+	pb.complete_absolute();
+	SG_INFO("optimization finished, #iter = %d, #threads = %d\n", iter, num_threads)
+	if (num_damped)
+		SG_INFO("#damped blocks = %d\n", num_damped)
+	if(iter >= max_iterations)
+		SG_WARNING("\nWARNING: reaching max number of iterations\n")
+
+	delete[] rng;
+	SG_FREE(active);
+	SG_FREE(slice_start);
+	SG_FREE(block);
+	SG_FREE(shrunk);
+	SG_FREE(block_d);
+	SG_FREE(block_violation);
+	SG_FREE(block_keep);
+	SG_FREE(block_exhausted);
+	SG_FREE(block_w_old);
+	SG_FREE(touched);
+	SG_FREE(touched_old);
+	SG_FREE(is_touched);
+	SG_FREE(index);
+}
+
+#undef GETI
+#define GETI(i) (y[i]+1)
+// To support weights for instances, use GETI(i) (i)
+
+void CLibLinear::solve_l1r_l2_svc_parallel(
+	SGVector<float64_t>& w,
+	const liblinear_problem *prob_col, double eps, double Cp, double Cn)
+{
+	int l = prob_col->l;
+	int w_size = prob_col->n;
+	int j;
+	int max_num_linesearch = 20;
+	int32_t num_threads = CMath::max(CMath::min(parallel->get_num_threads(), w_size), 1);
+
+	double sigma = 0.01;
+
+	int32_t *y = SG_MALLOC(int32_t, l);
+	double *b = SG_MALLOC(double, l); // b = 1-ywTx
+	double *xj_sq = SG_MALLOC(double, w_size);
+
+	CDotFeatures* x = prob_col->x;
+
+	double C[3] = {Cn,0,Cp};
+
+	int n = prob_col->n;
+	if (prob_col->use_bias)
+		n--;
+
+	for(j=0; j<l; j++)
+	{
+		b[j] = 1;
+		if(prob_col->y[j] > 0)
+			y[j] = 1;
+		else
+			y[j] = -1;
+	}
+
+	for(j=0; j<w_size; j++)
+		w.vector[j] = 0;
+
+#pragma omp parallel for num_threads(num_threads)
+	for(int32_t k=0; k<w_size; k++)
+	{
+		double sq = 0;
+		for_each_entry(x, k, use_bias && k==n, l, [&](int32_t ind, float64_t val)
+		{
+			sq += C[GETI(ind)]*val*val;
+		});
+		xj_sq[k] = sq;
+	}
+
+	// Computes the Newton step of coordinate k against the current b,
+	// returns false if the coordinate should be shrunk.
+	auto propose = [&](int32_t k, double Gmax_old, double& d, double& violation, bool& exhausted) -> bool
+	{
+		bool is_bias = use_bias && k==n;
+		double G_loss = 0;
+		double H = 0;
+		d = 0;
+		violation = 0;
+		exhausted = false;
+
+		for_each_entry(x, k, is_bias, l, [&](int32_t ind, float64_t val)
+		{
+			double b_ind = b[ind];
+			if(b_ind > 0)
+			{
+				double tmp = C[GETI(ind)]*val*y[ind];
+				G_loss -= tmp*b_ind;
+				H += tmp*val*y[ind];
+			}
+		});
+
+		G_loss *= 2;
+
+		double G = G_loss;
+		H *= 2;
+		H = CMath::max(H, 1e-12);
+
+		double wk = w.vector[k];
+		double Gp = G+1;
+		double Gn = G-1;
+		if(wk == 0)
+		{
+			if(Gp < 0)
+				violation = -Gp;
+			else if(Gn > 0)
+				violation = Gn;
+			else if(Gp>Gmax_old/l && Gn<-Gmax_old/l)
+				return false;
+		}
+		else if(wk > 0)
+			violation = fabs(Gp);
+		else
+			violation = fabs(Gn);
+
+		// obtain Newton direction d
+		if(Gp <= H*wk)
+			d = -Gp/H;
+		else if(Gn >= H*wk)
+			d = -Gn/H;
+		else
+			d = -wk;
+
+		if(fabs(d) < 1.0e-12)
+		{
+			d = 0;
+			return true;
+		}
+
+		double delta = fabs(wk+d)-fabs(wk) + G*d;
+		double loss_old = 0;
+		int num_linesearch;
+		for(num_linesearch=0; num_linesearch < max_num_linesearch; num_linesearch++)
+		{
+			double cond = fabs(wk+d)-fabs(wk) - sigma*delta;
+
+			double appxcond = xj_sq[k]*d*d + G_loss*d + cond;
+			if(appxcond <= 0)
+				break;
+
+			double loss_new = 0;
+			bool first = num_linesearch==0;
+			for_each_entry(x, k, is_bias, l, [&](int32_t ind, float64_t val)
+			{
+				double b_ind = b[ind];
+				if(first && b_ind > 0)
+					loss_old += C[GETI(ind)]*b_ind*b_ind;
+				double b_new = b_ind - d*val*y[ind];
+				if(b_new > 0)
+					loss_new += C[GETI(ind)]*b_new*b_new;
+			});
+
+			cond = cond + loss_new - loss_old;
+			if(cond <= 0)
+				break;
+			else
+			{
+				d *= 0.5;
+				delta *= 0.5;
+			}
+		}
+		exhausted = num_linesearch >= max_num_linesearch;
+
+		return true;
+	};
+
+	// moves coordinate k by d and scatters the change into b
+	auto apply = [&](int32_t k, double d, bool sync)
+	{
+		w.vector[k] += d;
+		for_each_entry(x, k, use_bias && k==n, l, [&](int32_t ind, float64_t val)
+		{
+			double change = -d*val*y[ind];
+			if (sync)
+			{
+#pragma omp atomic
+				b[ind] += change;
+			}
+			else
+				b[ind] += change;
+		});
+	};
+
+	auto sample_loss = [&](int32_t ind, double b_ind) -> double
+	{
+		return b_ind > 0 ? C[GETI(ind)]*b_ind*b_ind : 0;
+	};
+
+	auto recompute = [&]()
+	{
+		for(int i=0; i<l; i++)
+			b[i] = 1;
+
+		for(int i=0; i<w_size; i++)
+		{
+			if(w.vector[i]==0)
+				continue;
+
+			double wi = w.vector[i];
+			for_each_entry(x, i, use_bias && i==n, l, [&](int32_t ind, float64_t val)
+			{
+				b[ind] -= wi*val*y[ind];
+			});
+		}
+	};
+
+	solve_l1r_parallel(w, prob_col, eps, b, propose, apply, sample_loss, recompute);
+
+	// calculate objective value
+
+	double v = 0;
+	int nnz = 0;
+	for(j=0; j<w_size; j++)
+	{
+		if(w.vector[j] != 0)
+		{
+			v += fabs(w.vector[j]);
+			nnz++;
+		}
+	}
+	for(j=0; j<l; j++)
+		if(b[j] > 0)
+			v += C[GETI(j)]*b[j]*b[j];
+
+	SG_INFO("Objective value = %lf\n", v)
+	SG_INFO("#nonzeros/#features = %d/%d\n", nnz, w_size)
+
+	SG_FREE(y);
+	SG_FREE(b);
+	SG_FREE(xj_sq);
+}
+
+#undef GETI
+#define GETI(i) (y[i]+1)
+// To support weights for instances, use GETI(i) (i)
+
+void CLibLinear::solve_l1r_lr_parallel(
+	SGVector<float64_t>& w,
+	const liblinear_problem *prob_col, double eps,
+	double Cp, double Cn)
+{
+	int l = prob_col->l;
+	int w_size = prob_col->n;
+	int j;
+	int max_num_linesearch = 20;
+	int32_t num_threads = CMath::max(CMath::min(parallel->get_num_threads(), w_size), 1);
+
+	double x_min = 0;
+	double sigma = 0.01;
+
+	int32_t *y = SG_MALLOC(int32_t, l);
+	double *exp_wTx = SG_MALLOC(double, l);
+	double *xj_max = SG_MALLOC(double, w_size);
+	double *C_sum = SG_MALLOC(double, w_size);
+	double *xjneg_sum = SG_MALLOC(double, w_size);
+	double *xjpos_sum = SG_MALLOC(double, w_size);
+
+	CDotFeatures* x = prob_col->x;
+
+	double C[3] = {Cn,0,Cp};
+
+	int n = prob_col->n;
+	if (prob_col->use_bias)
+		n--;
+
+	for(j=0; j<l; j++)
+	{
+		exp_wTx[j] = 1;
+		if(prob_col->y[j] > 0)
+			y[j] = 1;
+		else
+			y[j] = -1;
+	}
+
+	for(j=0; j<w_size; j++)
+		w.vector[j] = 0;
+
+#pragma omp parallel for num_threads(num_threads) reduction(min:x_min)
+	for(int32_t k=0; k<w_size; k++)
+	{
+		xj_max[k] = 0;
+		C_sum[k] = 0;
+		xjneg_sum[k] = 0;
+		xjpos_sum[k] = 0;
+
+		for_each_entry(x, k, use_bias && k==n, l, [&](int32_t ind, float64_t val)
+		{
+			x_min = CMath::min(x_min, val);
+			xj_max[k] = CMath::max(xj_max[k], val);
+			C_sum[k] += C[GETI(ind)];
+			if(y[ind] == -1)
+				xjneg_sum[k] += C[GETI(ind)]*val;
+			else
+				xjpos_sum[k] += C[GETI(ind)]*val;
+		});
+	}
+
+	// Computes the Newton step of coordinate k against the current exp_wTx,
+	// returns false if the coordinate should be shrunk.
+	auto propose = [&](int32_t k, double Gmax_old, double& d, double& violation, bool& exhausted) -> bool
+	{
+		bool is_bias = use_bias && k==n;
+		double sum1 = 0;
+		double sum2 = 0;
+		double H = 0;
+		d = 0;
+		violation = 0;
+		exhausted = false;
+
+		for_each_entry(x, k, is_bias, l, [&](int32_t ind, float64_t val)
+		{
+			double exp_wTxind = exp_wTx[ind];
+			double tmp1 = val/(1+exp_wTxind);
+			double tmp2 = C[GETI(ind)]*tmp1;
+			double tmp3 = tmp2*exp_wTxind;
+			sum2 += tmp2;
+			sum1 += tmp3;
+			H += tmp1*tmp3;
+		});
+
+		double G = -sum2 + xjneg_sum[k];
+
+		double wk = w.vector[k];
+		double Gp = G+1;
+		double Gn = G-1;
+		if(wk == 0)
+		{
+			if(Gp < 0)
+				violation = -Gp;
+			else if(Gn > 0)
+				violation = Gn;
+			else if(Gp>Gmax_old/l && Gn<-Gmax_old/l)
+				return false;
+		}
+		else if(wk > 0)
+			violation = fabs(Gp);
+		else
+			violation = fabs(Gn);
+
+		// obtain Newton direction d
+		if(Gp <= H*wk)
+			d = -Gp/H;
+		else if(Gn >= H*wk)
+			d = -Gn/H;
+		else
+			d = -wk;
+
+		if(fabs(d) < 1.0e-12)
+		{
+			d = 0;
+			return true;
+		}
+
+		d = CMath::min(CMath::max(d,-10.0),10.0);
+
+		double delta = fabs(wk+d)-fabs(wk) + G*d;
+		int num_linesearch;
+		for(num_linesearch=0; num_linesearch < max_num_linesearch; num_linesearch++)
+		{
+			double cond = fabs(wk+d)-fabs(wk) - sigma*delta;
+
+			if(x_min >= 0)
+			{
+				double tmp = exp(d*xj_max[k]);
+				double appxcond1 = log(1+sum1*(tmp-1)/xj_max[k]/C_sum[k])*C_sum[k] + cond - d*xjpos_sum[k];
+				double appxcond2 = log(1+sum2*(1/tmp-1)/xj_max[k]/C_sum[k])*C_sum[k] + cond + d*xjneg_sum[k];
+				if(CMath::min(appxcond1,appxcond2) <= 0)
+					break;
+			}
+
+			cond += d*xjneg_sum[k];
+
+			for_each_entry(x, k, is_bias, l, [&](int32_t ind, float64_t val)
+			{
+				double exp_dx = exp(d*val);
+				double exp_wTx_new = exp_wTx[ind]*exp_dx;
+				cond += C[GETI(ind)]*log((1+exp_wTx_new)/(exp_dx+exp_wTx_new));
+			});
+
+			if(cond <= 0)
+				break;
+			else
+			{
+				d *= 0.5;
+				delta *= 0.5;
+			}
+		}
+		exhausted = num_linesearch >= max_num_linesearch;
+
+		return true;
+	};
+
+	// moves coordinate k by d and scales exp_wTx accordingly
+	auto apply = [&](int32_t k, double d, bool sync)
+	{
+		w.vector[k] += d;
+		for_each_entry(x, k, use_bias && k==n, l, [&](int32_t ind, float64_t val)
+		{
+			double factor = exp(d*val);
+			if (sync)
+			{
+#pragma omp atomic
+				exp_wTx[ind] *= factor;
+			}
+			else
+				exp_wTx[ind] *= factor;
+		});
+	};
+
+	auto sample_loss = [&](int32_t ind, double exp_wTxind) -> double
+	{
+		if(y[ind] == 1)
+			return C[GETI(ind)]*log(1+1/exp_wTxind);
+		return C[GETI(ind)]*log(1+exp_wTxind);
+	};
+
+	auto recompute = [&]()
+	{
+		for(int i=0; i<l; i++)
+			exp_wTx[i] = 0;
+
+		for(int i=0; i<w_size; i++)
+		{
+			if(w.vector[i]==0)
+				continue;
+
+			double wi = w.vector[i];
+			for_each_entry(x, i, use_bias && i==n, l, [&](int32_t ind, float64_t val)
+			{
+				exp_wTx[ind] += wi*val;
+			});
+		}
+
+		for(int i=0; i<l; i++)
+			exp_wTx[i] = exp(exp_wTx[i]);
+	};
+
+	solve_l1r_parallel(w, prob_col, eps, exp_wTx, propose, apply, sample_loss, recompute);
+
+	// calculate objective value
+
+	double v = 0;
+	int nnz = 0;
+	for(j=0; j<w_size; j++)
+		if(w.vector[j] != 0)
+		{
+			v += fabs(w.vector[j]);
+			nnz++;
+		}
+	for(j=0; j<l; j++)
+		if(y[j] == 1)
+			v += C[GETI(j)]*log(1+1/exp_wTx[j]);
+		else
+			v += C[GETI(j)]*log(1+exp_wTx[j]);
+
+	SG_INFO("Objective value = %lf\n", v)
+	SG_INFO("#nonzeros/#features = %d/%d\n", nnz, w_size)
+
+	SG_FREE(y);
+	SG_FREE(exp_wTx);
+	SG_FREE(xj_max);
+	SG_FREE(C_sum);
+	SG_FREE(xjneg_sum);
+	SG_FREE(xjpos_sum);
+}
+
 void CLibLinear::set_linear_term(const SGVector<float64_t> linear_term)
 {
 	if (!m_labels)
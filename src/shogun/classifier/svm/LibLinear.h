@@ -19,6 +19,8 @@
 #include <shogun/machine/LinearMachine.h>
 #include <shogun/optimization/liblinear/shogun_liblinear.h>
 
+#include <functional>
+
 namespace shogun
 {
 	/** liblinar solver type */
@@ -41,6 +43,27 @@ namespace shogun
 		L2R_LR_DUAL
 	};
 
+	/** parallel execution mode of the liblinear coordinate descent solvers */
+	enum LIBLINEAR_PARALLEL_MODE
+	{
+		/// single-threaded coordinate descent (default)
+		LL_SEQUENTIAL,
+		/// asynchronous parallel coordinate descent where the shared vector
+		/// (w for the dual solvers, the margins for the L1 primal solvers)
+		/// is updated with atomic operations (PASSCoDe-Atomic)
+		LL_ASYNC_ATOMIC,
+		/// asynchronous parallel coordinate descent where the shared vector
+		/// is updated without any synchronisation (PASSCoDe-Wild)
+		LL_ASYNC_WILD,
+		/// synchronous block-parallel coordinate descent for the L1
+		/// regularized primal solvers. Proposals for a block of coordinates
+		/// are computed in parallel and applied in a fixed order, damped if
+		/// they do not decrease the objective together, so the result only
+		/// depends on the seed and the block size but not on the number of
+		/// threads. The dual solvers run sequentially in this mode.
+		LL_DETERMINISTIC
+	};
+
 /** @brief This class provides an interface to the LibLinear library for large-
  * scale linear learning focusing on SVM [1]. This is the classification interface. For
  * regression, see CLibLinearRegression. There is also an online version, see
@@ -175,6 +198,37 @@ class CLibLinear : public CLinearMachine
 		/** set the linear term for qp */
 		void init_linear_term();
 
+		/** set the parallel mode of the coordinate descent solvers
+		 *
+		 * @param mode parallel mode, see ::LIBLINEAR_PARALLEL_MODE
+		 */
+		inline void set_parallel_mode(LIBLINEAR_PARALLEL_MODE mode)
+		{
+			m_parallel_mode=mode;
+		}
+
+		/** @return parallel mode of the coordinate descent solvers */
+		inline LIBLINEAR_PARALLEL_MODE get_parallel_mode()
+		{
+			return m_parallel_mode;
+		}
+
+		/** set the number of coordinates that are updated synchronously
+		 * in the LL_DETERMINISTIC mode
+		 *
+		 * @param block_size block size
+		 */
+		inline void set_parallel_block_size(int32_t block_size=64)
+		{
+			m_parallel_block_size=block_size;
+		}
+
+		/** @return block size used in the LL_DETERMINISTIC mode */
+		inline int32_t get_parallel_block_size()
+		{
+			return m_parallel_block_size;
+		}
+
 	protected:
 		/** train linear SVM classifier
 		 *
@@ -199,6 +253,22 @@ class CLibLinear : public CLinearMachine
 		void solve_l1r_lr(SGVector<float64_t>& w, const liblinear_problem *prob_col, double eps, double Cp, double Cn);
 		void solve_l2r_lr_dual(SGVector<float64_t>& w, const liblinear_problem *prob, double eps, double Cp, double Cn);
 
+		void solve_l2r_l1l2_svc_parallel(
+			SGVector<float64_t>& w,
+			const liblinear_problem *prob, double eps, double Cp, double Cn, LIBLINEAR_SOLVER_TYPE st);
+		void solve_l2r_lr_dual_parallel(SGVector<float64_t>& w, const liblinear_problem *prob, double eps, double Cp, double Cn);
+		void solve_l1r_l2_svc_parallel(SGVector<float64_t>& w, const liblinear_problem *prob_col, double eps, double Cp, double Cn);
+		void solve_l1r_lr_parallel(SGVector<float64_t>& w, const liblinear_problem *prob_col, double eps, double Cp, double Cn);
+#ifndef SWIG
+		void solve_l1r_parallel(
+			SGVector<float64_t>& w, const liblinear_problem *prob_col, double eps,
+			double* shared,
+			std::function<bool(int32_t, double, double&, double&, bool&)> propose,
+			std::function<void(int32_t, double, bool)> apply,
+			std::function<double(int32_t, double)> sample_loss,
+			std::function<void()> recompute);
+#endif
+
 
 	protected:
 		/** C1 */
@@ -217,6 +287,12 @@ class CLibLinear : public CLinearMachine
 
 		/** solver type */
 		LIBLINEAR_SOLVER_TYPE liblinear_solver_type;
+
+		/** parallel mode of the coordinate descent solvers */
+		LIBLINEAR_PARALLEL_MODE m_parallel_mode;
+
+		/** number of coordinates per block in LL_DETERMINISTIC mode */
+		int32_t m_parallel_block_size;
 };
 
 } /* namespace shogun  */
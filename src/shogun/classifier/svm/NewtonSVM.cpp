@@ -12,7 +12,7 @@
 #ifdef HAVE_LAPACK
 #include <shogun/classifier/svm/NewtonSVM.h>
 #include <shogun/mathematics/Math.h>
-#include <shogun/mathematics/linalg/LinalgNamespace.h>
+#include <shogun/mathematics/linalg/LinalgExpression.h>
 #include <shogun/machine/LinearMachine.h>
 #include <shogun/features/DotFeatures.h>
 #include <shogun/labels/Labels.h>
@@ -237,7 +237,6 @@ void CNewtonSVM::line_search_linear(float64_t* weights, float64_t* d, float64_t*
 	SGVector<float64_t> Y=((CBinaryLabels*) m_labels)->get_labels();
 	SGVector<float64_t> outz(x_n);
 	SGVector<float64_t> temp1(x_n);
-	SGVector<float64_t> temp1forout(x_n);
 	SGVector<float64_t> outzsv(x_n);
 	SGVector<float64_t> Ysv(x_n);
 	SGVector<float64_t> Xsv(x_n);
@@ -274,9 +273,7 @@ void CNewtonSVM::line_search_linear(float64_t* weights, float64_t* d, float64_t*
 	{
 		// FIXME:: port it to linalg::
 		SGVector<float64_t>::vector_multiply(temp1.vector, Y.vector, Xd.vector, x_n);
-		sg_memcpy(temp1forout.vector, temp1.vector, sizeof(float64_t)*x_n);
-		linalg::scale(temp1forout, temp1forout, t);
-		linalg::add(sg_out, temp1forout, outz, 1.0, -1.0);
+		linalg::eval(linalg::add(linalg::lazy(sg_out), linalg::lazy(temp1), 1.0, -t), outz);
 
 		// Calculation of sv
 		sv_len=0;
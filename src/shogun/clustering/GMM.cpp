@@ -17,6 +17,7 @@
 #include <shogun/distance/EuclideanDistance.h>
 #include <shogun/labels/MulticlassLabels.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/lapack.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/multiclass/KNN.h>
@@ -25,6 +26,26 @@
 using namespace shogun;
 using namespace std;
 
+/* number of feature vectors processed at once by the E- and M-steps */
+#define GMM_BLOCK_SIZE 512
+
+/* log(sum(exp(values))), shifted by the maximum to avoid under- and overflow */
+static float64_t log_sum_exp(const float64_t* values, int32_t len)
+{
+	float64_t max_value=-CMath::INFTY;
+	for (int32_t i=0; i<len; i++)
+		max_value=CMath::max(max_value, values[i]);
+
+	if (max_value==-CMath::INFTY)
+		return max_value;
+
+	float64_t sum=0;
+	for (int32_t i=0; i<len; i++)
+		sum+=CMath::exp(values[i]-max_value);
+
+	return max_value+CMath::log(sum);
+}
+
 CGMM::CGMM() : CDistribution(), m_components(),	m_coefficients()
 {
 	register_params();
@@ -150,37 +171,25 @@ float64_t CGMM::train_em(float64_t min_cov, int32_t max_iter, float64_t min_chan
 	int32_t iter=0;
 	float64_t log_likelihood_prev=0;
 	float64_t log_likelihood_cur=0;
-	SGVector<float64_t> logPxy(num_vectors * m_components.size());
-	SGVector<float64_t> logPx(num_vectors);
-	//float64_t* logPost=SG_MALLOC(float64_t, num_vectors*m_components.vlen);
+	int32_t num_comp=int32_t(m_components.size());
 
 	while (iter<max_iter)
 	{
 		log_likelihood_prev=log_likelihood_cur;
 		log_likelihood_cur=0;
 
+		// the joint log likelihoods are normalized in place to the posteriors
+		compute_log_joint(alpha.matrix);
+
+		#pragma omp parallel for num_threads(parallel->get_num_threads()) reduction(+:log_likelihood_cur)
 		for (int32_t i=0; i<num_vectors; i++)
 		{
-			logPx[i]=0;
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
-			for (int32_t j=0; j<int32_t(m_components.size()); j++)
-			{
-				logPxy[index_t(i * m_components.size() + j)] =
-				    m_components[j]->compute_log_PDF(v) +
-				    CMath::log(m_coefficients[j]);
-				logPx[i] +=
-				    CMath::exp(logPxy[index_t(i * m_components.size() + j)]);
-			}
+			float64_t* alpha_i=alpha.matrix+index_t(i)*num_comp;
+			float64_t logPx=log_sum_exp(alpha_i, num_comp);
+			log_likelihood_cur+=logPx;
 
-			logPx[i]=CMath::log(logPx[i]);
-			log_likelihood_cur+=logPx[i];
-
-			for (int32_t j=0; j<int32_t(m_components.size()); j++)
-			{
-				//logPost[i*m_components.vlen+j]=logPxy[i*m_components.vlen+j]-logPx[i];
-				alpha.matrix[i * m_components.size() + j] = CMath::exp(
-				    logPxy[index_t(i * m_components.size() + j)] - logPx[i]);
-			}
+			for (int32_t j=0; j<num_comp; j++)
+				alpha_i[j]=CMath::exp(alpha_i[j]-logPx);
 		}
 
 		if (iter>0 && log_likelihood_cur-log_likelihood_prev<min_change)
@@ -227,20 +236,12 @@ float64_t CGMM::train_smem(int32_t max_iter, int32_t max_cand, float64_t min_cov
 		memset(logPostSum, 0, m_components.size()*sizeof(float64_t));
 		memset(logPostSum2, 0, m_components.size()*sizeof(float64_t));
 		memset(logPostSumSum, 0, (m_components.size()*(m_components.size()-1)/2)*sizeof(float64_t));
+		compute_log_joint(logPxy.vector);
 		for (int32_t i=0; i<num_vectors; i++)
 		{
-			logPx[i]=0;
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
-			for (int32_t j=0; j<int32_t(m_components.size()); j++)
-			{
-				logPxy[index_t(i * m_components.size() + j)] =
-				    m_components[j]->compute_log_PDF(v) +
-				    CMath::log(m_coefficients[j]);
-				logPx[i] +=
-				    CMath::exp(logPxy[index_t(i * m_components.size() + j)]);
-			}
-
-			logPx[i]=CMath::log(logPx[i]);
+			logPx[i] = log_sum_exp(
+			    logPxy.vector + index_t(i * m_components.size()),
+			    int32_t(m_components.size()));
 
 			for (int32_t j=0; j<int32_t(m_components.size()); j++)
 			{
@@ -350,17 +351,14 @@ void CGMM::partial_em(int32_t comp1, int32_t comp2, int32_t comp3, float64_t min
 	SGVector<float64_t> init_logPx_fix(num_vectors);
 	SGVector<float64_t> post_add(num_vectors);
 
+	compute_log_joint(init_logPxy.vector);
 	for (int32_t i=0; i<num_vectors; i++)
 	{
 		init_logPx[i]=0;
 		init_logPx_fix[i]=0;
 
-		SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
 		for (int32_t j=0; j<int32_t(m_components.size()); j++)
 		{
-			init_logPxy[index_t(i * m_components.size() + j)] =
-			    m_components[j]->compute_log_PDF(v) +
-			    CMath::log(m_coefficients[j]);
 			init_logPx[i] +=
 			    CMath::exp(init_logPxy[index_t(i * m_components.size() + j)]);
 			if (j!=comp1 && j!=comp2 && j!=comp3)
@@ -493,15 +491,12 @@ void CGMM::partial_em(int32_t comp1, int32_t comp2, int32_t comp3, float64_t min
 		log_likelihood_prev=log_likelihood_cur;
 		log_likelihood_cur=0;
 
+		partial_candidate->compute_log_joint(logPxy.vector);
 		for (int32_t i=0; i<num_vectors; i++)
 		{
 			logPx[i]=0;
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
 			for (int32_t j=0; j<3; j++)
-			{
-				logPxy[i*3+j]=components[j]->compute_log_PDF(v)+CMath::log(coefficients[j]);
 				logPx[i]+=CMath::exp(logPxy[i*3+j]);
-			}
 
 			logPx[i]=CMath::log(logPx[i]+init_logPx_fix[i]);
 			log_likelihood_cur+=logPx[i];
@@ -534,124 +529,398 @@ void CGMM::max_likelihood(SGMatrix<float64_t> alpha, float64_t min_cov)
 {
 	CDotFeatures* dotdata=(CDotFeatures *) features;
 	int32_t num_dim=dotdata->get_dim_feature_space();
+	int32_t num_vectors=alpha.num_rows;
+	int32_t num_comp=alpha.num_cols;
+
+	// the responsibilities of each vector are stored contiguously, i.e. a
+	// block of vectors is a (num_comp x block size) column-major matrix
+	SGVector<float64_t> alpha_sums(num_comp);
+	SGMatrix<float64_t> means(num_dim, num_comp);
+	typename SGVector<float64_t>::EigenVectorXtMap eig_alpha_sums=alpha_sums;
+	typename SGMatrix<float64_t>::EigenMatrixXtMap eig_means=means;
+	eig_alpha_sums.setZero();
+	eig_means.setZero();
+
+	for (index_t start=0; start<num_vectors; start+=GMM_BLOCK_SIZE)
+	{
+		int32_t num=CMath::min(GMM_BLOCK_SIZE, num_vectors-start);
+		SGMatrix<float64_t> points=get_feature_block(SGVector<index_t>(), start, num);
+		typename SGMatrix<float64_t>::EigenMatrixXtMap eig_points=points;
+		Eigen::Map<Eigen::MatrixXd> eig_alpha(alpha.matrix+start*num_comp, num_comp, num);
 
-	float64_t alpha_sum;
-	float64_t alpha_sum_sum=0;
+		eig_alpha_sums+=eig_alpha.rowwise().sum();
+		eig_means+=eig_points*eig_alpha.transpose();
+	}
+
+	for (int32_t i=0; i<num_comp; i++)
+		eig_means.col(i)/=alpha_sums[i];
+
+	// weighted scatter around the new means, accumulated per component
+	vector<SGMatrix<float64_t> > cov_sums(num_comp);
+	for (int32_t i=0; i<num_comp; i++)
+	{
+		switch (m_components[i]->get_cov_type())
+		{
+			case FULL:
+				cov_sums[i]=SGMatrix<float64_t>(num_dim, num_dim);
+				break;
+			case DIAG:
+				cov_sums[i]=SGMatrix<float64_t>(num_dim, 1);
+				break;
+			case SPHERICAL:
+				cov_sums[i]=SGMatrix<float64_t>(1, 1);
+				break;
+		}
+		cov_sums[i].zero();
+	}
 
-	for (int32_t i=0; i<alpha.num_cols; i++)
+	for (index_t start=0; start<num_vectors; start+=GMM_BLOCK_SIZE)
 	{
-		alpha_sum=0;
-		SGVector<float64_t> mean_sum(num_dim);
-		linalg::zero(mean_sum);
+		int32_t num=CMath::min(GMM_BLOCK_SIZE, num_vectors-start);
+		SGMatrix<float64_t> points=get_feature_block(SGVector<index_t>(), start, num);
+		typename SGMatrix<float64_t>::EigenMatrixXtMap eig_points=points;
+		Eigen::Map<Eigen::MatrixXd> eig_alpha(alpha.matrix+start*num_comp, num_comp, num);
 
-		for (int32_t j=0; j<alpha.num_rows; j++)
+		#pragma omp parallel for num_threads(parallel->get_num_threads())
+		for (int32_t i=0; i<num_comp; i++)
 		{
-			alpha_sum+=alpha.matrix[j*alpha.num_cols+i];
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(j);
-			linalg::add(
-			    v, mean_sum, mean_sum, alpha.matrix[j * alpha.num_cols + i],
-			    1.0);
+			typename SGMatrix<float64_t>::EigenMatrixXtMap eig_cov_sum=cov_sums[i];
+			Eigen::MatrixXd difference=eig_points.colwise()-eig_means.col(i);
+
+			switch (m_components[i]->get_cov_type())
+			{
+				case FULL:
+					eig_cov_sum+=(difference.array().rowwise()*
+						eig_alpha.row(i).array()).matrix()*difference.transpose();
+					break;
+				case DIAG:
+					eig_cov_sum+=difference.cwiseAbs2()*eig_alpha.row(i).transpose();
+					break;
+				case SPHERICAL:
+					eig_cov_sum(0,0)+=difference.cwiseAbs2().colwise().sum().dot(
+						eig_alpha.row(i));
+					break;
+			}
 		}
+	}
 
-		linalg::scale(mean_sum, mean_sum, 1.0 / alpha_sum);
+	float64_t alpha_sum_sum=0;
+	for (int32_t i=0; i<num_comp; i++)
+	{
+		SGVector<float64_t> mean(num_dim);
+		sg_memcpy(mean.vector, means.get_column_vector(i), num_dim*sizeof(float64_t));
+		m_components[i]->set_mean(mean);
 
-		m_components[i]->set_mean(mean_sum);
+		linalg::scale(cov_sums[i], cov_sums[i], 1.0/alpha_sums[i]);
+		set_component_cov(i, cov_sums[i], min_cov);
 
-		SGMatrix<float64_t> cov_sum;
+		m_coefficients.vector[i]=alpha_sums[i];
+		alpha_sum_sum+=alpha_sums[i];
+	}
 
-		ECovType cov_type = m_components[i]->get_cov_type();
-		if (cov_type==FULL)
-		{
-			cov_sum = SGMatrix<float64_t>(num_dim, num_dim);
-			linalg::zero(cov_sum);
-		}
-		else if(cov_type==DIAG)
+	linalg::scale(m_coefficients, m_coefficients, 1.0 / alpha_sum_sum);
+}
+
+float64_t CGMM::train_minibatch_em(int32_t batch_size, int32_t num_epochs,
+		float64_t min_cov, float64_t decay)
+{
+	if (!features)
+		SG_ERROR("No features to train on.\n")
+
+	REQUIRE(batch_size>0, "Batch size (%d) must be positive\n", batch_size)
+	REQUIRE(decay>0.5 && decay<=1, "Decay (%f) must be in (0.5, 1]\n", decay)
+
+	CDotFeatures* dotdata=(CDotFeatures *) features;
+	int32_t num_vectors=dotdata->get_num_vectors();
+	int32_t num_dim=dotdata->get_dim_feature_space();
+	int32_t num_comp=int32_t(m_components.size());
+
+	REQUIRE(num_vectors>=num_comp, "Need at least as many vectors (%d) as "
+			"components (%d)\n", num_vectors, num_comp)
+
+	batch_size=CMath::min(batch_size, num_vectors);
+
+	SGVector<index_t> perm(num_vectors);
+	perm.range_fill();
+	CMath::permute(perm);
+
+	/* initialize the means by k-means++ seeding and the covariances with the
+	 * variance of the first batch if no model is present */
+	if (m_components[0]->get_mean().vector==NULL)
+	{
+		SGMatrix<float64_t> points=get_feature_block(perm, 0, batch_size);
+		typename SGMatrix<float64_t>::EigenMatrixXtMap eig_points=points;
+		Eigen::VectorXd mean=eig_points.rowwise().mean();
+		SGMatrix<float64_t> variance(num_dim, 1);
+		typename SGMatrix<float64_t>::EigenMatrixXtMap eig_variance=variance;
+		eig_variance=(eig_points.colwise()-mean).cwiseAbs2().rowwise().mean();
+
+		// k-means++ seeding of the means on the first batch
+		Eigen::VectorXd min_dists=Eigen::VectorXd::Constant(batch_size, CMath::INFTY);
+		index_t chosen=CMath::random(0, batch_size-1);
+		for (int32_t i=0; i<num_comp; i++)
 		{
-			cov_sum = SGMatrix<float64_t>(1, num_dim);
-			linalg::zero(cov_sum);
+			SGVector<float64_t> init_mean(num_dim);
+			sg_memcpy(init_mean.vector, points.get_column_vector(chosen),
+					num_dim*sizeof(float64_t));
+			m_components[i]->set_mean(init_mean);
+
+			min_dists=min_dists.cwiseMin(
+				(eig_points.colwise()-eig_points.col(chosen)).cwiseAbs2().colwise().sum().transpose());
+			float64_t threshold=CMath::random(0.0, min_dists.sum());
+			for (chosen=0; chosen<batch_size-1; chosen++)
+			{
+				threshold-=min_dists[chosen];
+				if (threshold<=0)
+					break;
+			}
+
+			SGMatrix<float64_t> cov;
+			switch (m_components[i]->get_cov_type())
+			{
+				case FULL:
+					cov=SGMatrix<float64_t>(num_dim, num_dim);
+					cov.zero();
+					for (int32_t j=0; j<num_dim; j++)
+						cov(j,j)=variance[j];
+					break;
+				case DIAG:
+					cov=variance.clone();
+					break;
+				case SPHERICAL:
+					cov=SGMatrix<float64_t>(1, 1);
+					cov(0,0)=SGVector<float64_t>::sum(variance.matrix, num_dim);
+					break;
+			}
+			set_component_cov(i, cov, min_cov);
+			m_coefficients[i]=1.0/num_comp;
 		}
-		else if(cov_type==SPHERICAL)
+	}
+
+	/* running averages of the sufficient statistics: the responsibilities,
+	 * the weighted sums of the vectors and of their (uncentered) squares */
+	SGVector<float64_t> stats0(num_comp);
+	SGMatrix<float64_t> stats1(num_dim, num_comp);
+	vector<SGMatrix<float64_t> > stats2(num_comp);
+	for (int32_t i=0; i<num_comp; i++)
+	{
+		switch (m_components[i]->get_cov_type())
 		{
-			cov_sum = SGMatrix<float64_t>(1, 1);
-			linalg::zero(cov_sum);
+			case FULL:
+				stats2[i]=SGMatrix<float64_t>(num_dim, num_dim);
+				break;
+			case DIAG:
+				stats2[i]=SGMatrix<float64_t>(num_dim, 1);
+				break;
+			case SPHERICAL:
+				stats2[i]=SGMatrix<float64_t>(1, 1);
+				break;
 		}
+	}
+	typename SGVector<float64_t>::EigenVectorXtMap eig_stats0=stats0;
+	typename SGMatrix<float64_t>::EigenMatrixXtMap eig_stats1=stats1;
+
+	SGMatrix<float64_t> resp(num_comp, batch_size);
+	float64_t log_likelihood=0;
+	int32_t step=0;
+
+	for (int32_t epoch=0; epoch<num_epochs; epoch++)
+	{
+		if (epoch>0)
+			CMath::permute(perm);
+
+		log_likelihood=0;
 
-		for (int32_t j=0; j<alpha.num_rows; j++)
+		for (index_t start=0; start<num_vectors; start+=batch_size)
 		{
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(j);
+			int32_t num=CMath::min(batch_size, num_vectors-start);
+			SGMatrix<float64_t> points=get_feature_block(perm, start, num);
+			typename SGMatrix<float64_t>::EigenMatrixXtMap eig_points=points;
 
-			linalg::add(v, mean_sum, v, 1.0, -1.0);
-			switch (cov_type)
+			// E-step on the batch
+			compute_log_joint(points, resp.matrix);
+
+			float64_t batch_log_likelihood=0;
+			#pragma omp parallel for num_threads(parallel->get_num_threads()) reduction(+:batch_log_likelihood)
+			for (int32_t i=0; i<num; i++)
 			{
-				case FULL:
-				    cblas_dger(
-				        CblasRowMajor, num_dim, num_dim,
-				        alpha.matrix[j * alpha.num_cols + i], v.vector, 1,
-				        v.vector, 1, (double*)cov_sum.matrix, num_dim);
-
-				    break;
-			    case DIAG:
-			    {
-				    auto temp_matrix = SGMatrix<float64_t>(v.vector, 1, v.vlen);
-				    auto temp_result = linalg::matrix_prod(
-				        temp_matrix, temp_matrix, true, false);
-				    cov_sum = temp_result.get_diagonal_vector().clone();
-				    linalg::scale(
-				        cov_sum, cov_sum, alpha.matrix[j * alpha.num_cols + i]);
-			    }
-
-			    break;
-			    case SPHERICAL:
-				    float64_t temp = 0;
-
-				    temp = linalg::dot(v, v);
-
-				    cov_sum(0, 0) +=
-				        temp * alpha.matrix[j * alpha.num_cols + i];
-				    break;
+				float64_t* resp_i=resp.get_column_vector(i);
+				float64_t logPx=log_sum_exp(resp_i, num_comp);
+				batch_log_likelihood+=logPx;
+
+				for (int32_t j=0; j<num_comp; j++)
+					resp_i[j]=CMath::exp(resp_i[j]-logPx);
+			}
+			log_likelihood+=batch_log_likelihood;
+
+			// step size of the stepwise EM, the first batch replaces the
+			// (empty) statistics
+			float64_t eta=step==0 ? 1.0 : CMath::pow(step+2.0, -decay);
+			step++;
+
+			Eigen::Map<Eigen::MatrixXd> eig_resp(resp.matrix, num_comp, num);
+			eig_stats0=(1-eta)*eig_stats0+(eta/num)*eig_resp.rowwise().sum();
+			eig_stats1=(1-eta)*eig_stats1+(eta/num)*(eig_points*eig_resp.transpose());
+
+			#pragma omp parallel for num_threads(parallel->get_num_threads())
+			for (int32_t i=0; i<num_comp; i++)
+			{
+				typename SGMatrix<float64_t>::EigenMatrixXtMap eig_stats2=stats2[i];
+				switch (m_components[i]->get_cov_type())
+				{
+					case FULL:
+						eig_stats2=(1-eta)*eig_stats2+(eta/num)*
+							((eig_points.array().rowwise()*eig_resp.row(i).array()).matrix()*
+							 eig_points.transpose());
+						break;
+					case DIAG:
+						eig_stats2=(1-eta)*eig_stats2+(eta/num)*
+							(eig_points.cwiseAbs2()*eig_resp.row(i).transpose());
+						break;
+					case SPHERICAL:
+						eig_stats2(0,0)=(1-eta)*eig_stats2(0,0)+(eta/num)*
+							eig_points.cwiseAbs2().colwise().sum().dot(eig_resp.row(i));
+						break;
+				}
+			}
+
+			// M-step from the running statistics
+			float64_t stats0_sum=eig_stats0.sum();
+			for (int32_t i=0; i<num_comp; i++)
+			{
+				m_coefficients[i]=stats0[i]/stats0_sum;
+
+				// keep components that have not been responsible for any vector
+				if (stats0[i]<=0)
+					continue;
+
+				SGVector<float64_t> mean(num_dim);
+				typename SGVector<float64_t>::EigenVectorXtMap eig_mean=mean;
+				eig_mean=eig_stats1.col(i)/stats0[i];
+				m_components[i]->set_mean(mean);
+
+				SGMatrix<float64_t> cov=stats2[i].clone();
+				typename SGMatrix<float64_t>::EigenMatrixXtMap eig_cov=cov;
+				eig_cov/=stats0[i];
+				switch (m_components[i]->get_cov_type())
+				{
+					case FULL:
+						eig_cov-=eig_mean*eig_mean.transpose();
+						break;
+					case DIAG:
+						eig_cov-=eig_mean.cwiseAbs2();
+						break;
+					case SPHERICAL:
+						eig_cov(0,0)-=eig_mean.squaredNorm();
+						break;
+				}
+				set_component_cov(i, cov, min_cov);
 			}
 		}
+	}
+
+	return log_likelihood;
+}
+
+void CGMM::set_component_cov(int32_t i, SGMatrix<float64_t> cov, float64_t min_cov)
+{
+	int32_t num_dim=m_components[i]->get_mean().vlen;
 
-		switch (cov_type)
+	switch (m_components[i]->get_cov_type())
+	{
+		case FULL:
 		{
-			case FULL:
-		    {
-			    linalg::scale(cov_sum, cov_sum, 1.0 / alpha_sum);
+			SGVector<float64_t> d0 =
+			    SGMatrix<float64_t>::compute_eigenvectors(cov);
+			for (int32_t j = 0; j < num_dim; j++)
+				d0[j] = CMath::max(min_cov, d0[j]);
 
-			    SGVector<float64_t> d0 =
-			        SGMatrix<float64_t>::compute_eigenvectors(cov_sum);
-			    for (int32_t j = 0; j < num_dim; j++)
-				    d0[j] = CMath::max(min_cov, d0[j]);
+			m_components[i]->set_d(d0);
+			m_components[i]->set_u(cov);
 
-			    m_components[i]->set_d(d0);
-			    m_components[i]->set_u(cov_sum);
+			break;
+		}
+		case DIAG:
+		{
+			SGVector<float64_t> d0(num_dim);
+			for (int32_t j = 0; j < num_dim; j++)
+				d0[j] = CMath::max(min_cov, cov[j]);
 
-			    break;
-		    }
-		    case DIAG:
-			    for (int32_t j = 0; j < num_dim; j++)
-			    {
-				    cov_sum(0, j) /= alpha_sum;
-				    cov_sum(0, j) = CMath::max(min_cov, cov_sum(0, j));
-			    }
+			m_components[i]->set_d(d0);
 
-			    m_components[i]->set_d(cov_sum.get_row_vector(0));
+			break;
+		}
+		case SPHERICAL:
+		{
+			SGVector<float64_t> d0(1);
+			d0[0] = CMath::max(min_cov, cov[0] / num_dim);
 
-			    break;
-		    case SPHERICAL:
-			    cov_sum[0] /= alpha_sum * num_dim;
-			    cov_sum[0] = CMath::max(min_cov, cov_sum[0]);
+			m_components[i]->set_d(d0);
 
-			    m_components[i]->set_d(cov_sum.get_row_vector(0));
+			break;
+		}
+	}
+}
+
+SGMatrix<float64_t> CGMM::get_feature_block(SGVector<index_t> idxs, index_t start, int32_t num)
+{
+	CDotFeatures* dotdata=(CDotFeatures *) features;
+	int32_t num_dim=dotdata->get_dim_feature_space();
+
+	// contiguous vectors of dense real valued features are used in place
+	if (!idxs.vector && dotdata->get_feature_class()==C_DENSE &&
+			dotdata->get_feature_type()==F_DREAL)
+	{
+		CSubsetStack* subset_stack=dotdata->get_subset_stack();
+		bool has_subsets=subset_stack->has_subsets();
+		SG_UNREF(subset_stack);
 
-			    break;
+		if (!has_subsets)
+		{
+			SGMatrix<float64_t> matrix=
+				((CDenseFeatures<float64_t>*) dotdata)->get_feature_matrix();
+			return SGMatrix<float64_t>(matrix.get_column_vector(start), num_dim, num, false);
 		}
+	}
 
-		m_coefficients.vector[i]=alpha_sum;
-		alpha_sum_sum+=alpha_sum;
+	SGMatrix<float64_t> block(num_dim, num);
+	block.zero();
+	for (int32_t i=0; i<num; i++)
+	{
+		index_t idx=idxs.vector ? idxs[start+i] : start+i;
+		dotdata->add_to_dense_vec(1.0, idx, block.get_column_vector(i), num_dim);
 	}
 
-	linalg::scale(m_coefficients, m_coefficients, 1.0 / alpha_sum_sum);
+	return block;
+}
+
+void CGMM::compute_log_joint(SGMatrix<float64_t> points, float64_t* log_joint)
+{
+	int32_t num_comp=int32_t(m_components.size());
+
+	for (int32_t j=0; j<num_comp; j++)
+	{
+		SGVector<float64_t> log_pdf=m_components[j]->compute_log_PDF_batch(points);
+		float64_t log_coef=CMath::log(m_coefficients[j]);
+
+		for (int32_t i=0; i<points.num_cols; i++)
+			log_joint[index_t(i)*num_comp+j]=log_pdf[i]+log_coef;
+	}
+}
+
+void CGMM::compute_log_joint(float64_t* log_joint)
+{
+	CDotFeatures* dotdata=(CDotFeatures *) features;
+	int32_t num_vectors=dotdata->get_num_vectors();
+	int32_t num_comp=int32_t(m_components.size());
+
+	#pragma omp parallel for schedule(dynamic) num_threads(parallel->get_num_threads())
+	for (index_t start=0; start<num_vectors; start+=GMM_BLOCK_SIZE)
+	{
+		int32_t num=CMath::min(GMM_BLOCK_SIZE, num_vectors-start);
+		SGMatrix<float64_t> points=get_feature_block(SGVector<index_t>(), start, num);
+		compute_log_joint(points, log_joint+start*num_comp);
+	}
 }
 
 int32_t CGMM::get_num_model_parameters()
@@ -78,6 +78,26 @@ class CGMM : public CDistribution
 		float64_t train_em(float64_t min_cov=1e-9, int32_t max_iter=1000,
 				float64_t min_change=1e-9);
 
+		/** learn model using stepwise (online) EM on mini-batches
+		 *
+		 * The sufficient statistics are running averages over the batches
+		 * with step size \f$(t+2)^{-decay}\f$, so the model is updated
+		 * after every batch instead of after a full pass over the data.
+		 * If the components have not been initialized yet, the means are
+		 * seeded k-means++ style and the covariances are set to the
+		 * variance of the first batch.
+		 *
+		 * @param batch_size number of vectors per batch
+		 * @param num_epochs number of passes over the data
+		 * @param min_cov minimum covariance
+		 * @param decay step size decay in (0.5, 1]
+		 *
+		 * @return log likelihood of training data during the last epoch
+		 */
+		float64_t train_minibatch_em(int32_t batch_size=1000,
+				int32_t num_epochs=10, float64_t min_cov=1e-9,
+				float64_t decay=0.6);
+
 		/** learn model using SMEM
 		 *
 		 * @param max_iter maximum SMEM iterations
@@ -242,6 +262,42 @@ class CGMM : public CDistribution
 		void partial_em(int32_t comp1, int32_t comp2, int32_t comp3,
 				float64_t min_cov, int32_t max_em_iter, float64_t min_change);
 
+		/** set the covariance of a component, clamped to a minimum
+		 *
+		 * @param i index of the component
+		 * @param cov full covariance, diagonal or (for spherical
+		 * components) trace of the covariance, overwritten
+		 * @param min_cov minimum covariance
+		 */
+		void set_component_cov(int32_t i, SGMatrix<float64_t> cov,
+				float64_t min_cov);
+
+		/** get a block of training vectors as columns of a dense matrix
+		 *
+		 * @param idxs indices of the vectors, contiguous if empty
+		 * @param start first position in idxs
+		 * @param num number of vectors
+		 *
+		 * @return dimension x num matrix, which may reference the features
+		 */
+		SGMatrix<float64_t> get_feature_block(SGVector<index_t> idxs,
+				index_t start, int32_t num);
+
+		/** compute log(coef_j*P(x|j)) of all components for a block
+		 *
+		 * @param points vectors as columns
+		 * @param log_joint num components x num vectors output
+		 */
+		void compute_log_joint(SGMatrix<float64_t> points,
+				float64_t* log_joint);
+
+		/** compute log(coef_j*P(x|j)) of all components for all training
+		 * vectors, in parallel over blocks of vectors
+		 *
+		 * @param log_joint num components x num vectors output
+		 */
+		void compute_log_joint(float64_t* log_joint);
+
 	protected:
 		/** Mixture components */
 		std::vector<CGaussian*> m_components;
@@ -12,31 +12,45 @@
 #include <shogun/base/progress.h>
 #include <shogun/clustering/Hierarchical.h>
 #include <shogun/distance/Distance.h>
+#include <shogun/features/DenseFeatures.h>
 #include <shogun/features/Features.h>
 #include <shogun/labels/Labels.h>
 #include <shogun/mathematics/Math.h>
 
+#include <algorithm>
+
 using namespace shogun;
 
-#ifndef DOXYGEN_SHOULD_SKIP_THIS
-struct pair
+/* position of pair i/j in the condensed upper triangle of a distance matrix */
+static inline int64_t condensed_index(int64_t num, int64_t i, int64_t j)
 {
-	/** index 1 */
-	int32_t idx1;
-	/** index 2 */
-	int32_t idx2;
-};
-#endif // DOXYGEN_SHOULD_SKIP_THIS
+	if (i>j)
+		CMath::swap(i, j);
+
+	return i*num-i*(i+1)/2+j-i-1;
+}
+
+/* root of the union-find tree containing i, with path halving */
+static inline int32_t find_root(int32_t* parent, int32_t i)
+{
+	while (parent[i]!=i)
+	{
+		parent[i]=parent[parent[i]];
+		i=parent[i];
+	}
+
+	return i;
+}
 
 CHierarchical::CHierarchical()
-: CDistanceMachine(), merges(3), dimensions(0), assignment(NULL),
-	table_size(0), pairs(NULL), merge_distance(NULL)
+: CDistanceMachine(), merges(3), linkage(SINGLE_LINKAGE), dimensions(0),
+	assignment(NULL), table_size(0), pairs(NULL), merge_distance(NULL)
 {
 }
 
-CHierarchical::CHierarchical(int32_t merges_, CDistance* d)
-: CDistanceMachine(), merges(merges_), dimensions(0), assignment(NULL),
-	table_size(0), pairs(NULL), merge_distance(NULL)
+CHierarchical::CHierarchical(int32_t merges_, CDistance* d, ELinkageType l)
+: CDistanceMachine(), merges(merges_), linkage(l), dimensions(0),
+	assignment(NULL), table_size(0), pairs(NULL), merge_distance(NULL)
 {
 	set_distance(d);
 }
@@ -66,8 +80,6 @@ bool CHierarchical::train_machine(CFeatures* data)
 	int32_t num=lhs->get_num_vectors();
 	ASSERT(num>0)
 
-	const int32_t num_pairs=num*(num-1)/2;
-
 	SG_FREE(merge_distance);
 	merge_distance=SG_MALLOC(float64_t, num);
 	SGVector<float64_t>::fill_vector(merge_distance, num, -1.0);
@@ -80,77 +92,315 @@ bool CHierarchical::train_machine(CFeatures* data)
 	pairs=SG_MALLOC(int32_t, 2*num);
 	SGVector<int32_t>::fill_vector(pairs, 2*num, -1);
 
-	pair* index=SG_MALLOC(pair, num_pairs);
-	float64_t* distances=SG_MALLOC(float64_t, num_pairs);
-
-	int32_t offs=0;
-	for (auto i : progress(range(0, num), *this->io))
+	/* full dendrogram in terms of the vectors that were joined */
+	SGMatrix<int32_t> merge_pairs(2, CMath::max(num-1, 1));
+	SGVector<float64_t> merge_dists(CMath::max(num-1, 1));
+	if (num>1)
 	{
-		for (int32_t j=i+1; j<num; j++)
+		switch (linkage)
 		{
-			distances[offs] = distance->distance(i, j);
-			index[offs].idx1 = i;
-			index[offs].idx2 = j;
-			offs++; // offs=i*(i+1)/2+j
+			case SINGLE_LINKAGE:
+				compute_slink(merge_pairs, merge_dists);
+				break;
+			case COMPLETE_LINKAGE:
+			case AVERAGE_LINKAGE:
+				compute_nn_chain(merge_pairs, merge_dists);
+				break;
+			case WARD_LINKAGE:
+				compute_ward_nn_chain(merge_pairs, merge_dists);
+				break;
 		}
 	}
 
-	CMath::qsort_index<float64_t,pair>(distances, index, (num-1)*num/2);
-	//CMath::display_vector(distances, (num-1)*num/2, "dists");
+	SGVector<index_t> order(num-1);
+	order.range_fill();
+	std::stable_sort(order.vector, order.vector+order.vlen,
+			[&merge_dists](index_t a, index_t b)
+			{
+				return merge_dists[a]<merge_dists[b];
+			});
+
+	/* replay the merges in order of distance, numbering the cluster created
+	 * by merge l as num+l */
+	SGVector<int32_t> parent(num);
+	SGVector<int32_t> label(num);
+	parent.range_fill();
+	label.range_fill();
 
-	auto pb = progress(range(0, num_pairs - 1), *this->io);
-	int32_t k=-1;
 	int32_t l=0;
-	for (; l<num && (num-l)>=merges && k<num_pairs-1; l++)
+	for (; l<num-1 && (num-l)>=merges; l++)
 	{
-		while (k<num_pairs-1)
-		{
-			k++;
+		index_t k=order[l];
+		int32_t r1=find_root(parent.vector, merge_pairs(0,k));
+		int32_t r2=find_root(parent.vector, merge_pairs(1,k));
+		int32_t c1=label[r1];
+		int32_t c2=label[r2];
+
+		pairs[2*l]=CMath::min(c1, c2);
+		pairs[2*l+1]=CMath::max(c1, c2);
+		merge_distance[l]=merge_dists[k];
+
+		parent[r1]=r2;
+		label[r2]=num+l;
+#ifdef DEBUG_HIERARCHICAL
+		SG_PRINT("l=%04i c1=%+04d c2=%+04d c=%+04d dist=%6.6f\n", l, c1, c2, num+l, merge_distance[l])
+#endif
+	}
 
-			int32_t i=index[k].idx1;
-			int32_t j=index[k].idx2;
-			int32_t c1=assignment[i];
-			int32_t c2=assignment[j];
+	for (int32_t m=0; m<num; m++)
+		assignment[m]=label[find_root(parent.vector, m)];
 
-			if (c1==c2)
-				continue;
+	assignment_size=num;
+	table_size=l-1;
+	ASSERT(table_size>0)
+	SG_UNREF(lhs)
 
-			pb.print_progress();
+	return true;
+}
+
+void CHierarchical::compute_slink(SGMatrix<int32_t> merge_pairs,
+		SGVector<float64_t> merge_dists)
+{
+	int32_t num=merge_dists.vlen+1;
+
+	/* pointer representation: vector i joins the cluster of pi[i] (the last
+	 * vector of that cluster) at height lambda[i] */
+	SGVector<int32_t> pi(num);
+	SGVector<float64_t> lambda(num);
+	SGVector<float64_t> row(num);
+
+	for (auto n : progress(range(0, num), *this->io))
+	{
+		pi[n]=n;
+		lambda[n]=CMath::INFTY;
+		row[n]=CMath::INFTY;
 
-			if (c1<c2)
+		#pragma omp parallel for num_threads(parallel->get_num_threads())
+		for (int32_t i=0; i<n; i++)
+			row[i]=distance->distance(i, n);
+
+		for (int32_t i=0; i<n; i++)
+		{
+			if (lambda[i]>=row[i])
 			{
-				pairs[2*l]=c1;
-				pairs[2*l+1]=c2;
+				row[pi[i]]=CMath::min(row[pi[i]], lambda[i]);
+				lambda[i]=row[i];
+				pi[i]=n;
 			}
 			else
+				row[pi[i]]=CMath::min(row[pi[i]], row[i]);
+		}
+
+		for (int32_t i=0; i<n; i++)
+		{
+			if (lambda[i]>=lambda[pi[i]])
+				pi[i]=n;
+		}
+	}
+
+	for (int32_t i=0; i<num-1; i++)
+	{
+		merge_pairs(0,i)=i;
+		merge_pairs(1,i)=pi[i];
+		merge_dists[i]=lambda[i];
+	}
+}
+
+void CHierarchical::compute_nn_chain(SGMatrix<int32_t> merge_pairs,
+		SGVector<float64_t> merge_dists)
+{
+	int32_t num=merge_dists.vlen+1;
+	int64_t num_pairs=int64_t(num)*(num-1)/2;
+
+	/* the Lance-Williams updates need all cluster distances, they are kept
+	 * in the condensed matrix without any index or sorting */
+	float64_t* dists=SG_MALLOC(float64_t, num_pairs);
+
+	#pragma omp parallel for schedule(dynamic, 16) num_threads(parallel->get_num_threads())
+	for (int32_t i=0; i<num; i++)
+	{
+		float64_t* row=dists+condensed_index(num, i, i+1);
+		for (int32_t j=i+1; j<num; j++)
+			row[j-i-1]=distance->distance(i, j);
+	}
+
+	/* size of the cluster represented by each vector, 0 once merged */
+	SGVector<int32_t> sizes(num);
+	sizes.set_const(1);
+	SGVector<int32_t> chain(num);
+	int32_t chain_len=0;
+	int32_t first_active=0;
+
+	auto pb=progress(range(0, num-1), *this->io);
+	for (int32_t l=0; l<num-1; )
+	{
+		if (chain_len==0)
+		{
+			while (!sizes[first_active])
+				first_active++;
+			chain[chain_len++]=first_active;
+		}
+
+		/* nearest neighbor of the chain's end, preferring its predecessor
+		 * on ties so that reciprocal neighbors are always found */
+		int32_t a=chain[chain_len-1];
+		int32_t b=-1;
+		float64_t best=CMath::INFTY;
+		if (chain_len>1)
+		{
+			b=chain[chain_len-2];
+			best=dists[condensed_index(num, a, b)];
+		}
+
+		for (int32_t k=0; k<num; k++)
+		{
+			if (!sizes[k] || k==a)
+				continue;
+
+			float64_t d=dists[condensed_index(num, a, k)];
+			if (d<best || b<0)
 			{
-				pairs[2*l]=c2;
-				pairs[2*l+1]=c1;
+				best=d;
+				b=k;
 			}
-			merge_distance[l]=distances[k];
+		}
+
+		if (chain_len>1 && b==chain[chain_len-2])
+		{
+			chain_len-=2;
+			merge_pairs(0,l)=a;
+			merge_pairs(1,l)=b;
+			merge_dists[l]=best;
+			l++;
+			pb.print_progress();
 
-			int32_t c=num+l;
-			for (int32_t m=0; m<num; m++)
+			/* b represents the merged cluster */
+			float64_t size_a=sizes[a];
+			float64_t size_b=sizes[b];
+			#pragma omp parallel for num_threads(parallel->get_num_threads())
+			for (int32_t k=0; k<num; k++)
 			{
-				if (assignment[m] == c1 || assignment[m] == c2)
-					assignment[m] = c;
+				if (!sizes[k] || k==a || k==b)
+					continue;
+
+				float64_t d_a=dists[condensed_index(num, a, k)];
+				float64_t& d_b=dists[condensed_index(num, b, k)];
+				if (linkage==COMPLETE_LINKAGE)
+					d_b=CMath::max(d_a, d_b);
+				else
+					d_b=(size_a*d_a+size_b*d_b)/(size_a+size_b);
 			}
-#ifdef DEBUG_HIERARCHICAL
-			SG_PRINT("l=%04i i=%04i j=%04i c1=%+04d c2=%+04d c=%+04d dist=%6.6f\n", l,i,j, c1,c2,c, merge_distance[l])
-#endif
-			break;
+			sizes[b]+=sizes[a];
+			sizes[a]=0;
 		}
+		else
+			chain[chain_len++]=b;
 	}
 	pb.complete();
 
-	assignment_size=num;
-	table_size=l-1;
-	ASSERT(table_size>0)
-	SG_FREE(distances);
-	SG_FREE(index);
-	SG_UNREF(lhs)
+	SG_FREE(dists);
+}
 
-	return true;
+void CHierarchical::compute_ward_nn_chain(SGMatrix<int32_t> merge_pairs,
+		SGVector<float64_t> merge_dists)
+{
+	int32_t num=merge_dists.vlen+1;
+
+	CFeatures* lhs=distance->get_lhs();
+	REQUIRE(distance->get_distance_type()==D_EUCLIDEAN,
+			"Ward linkage requires the Euclidean distance\n")
+	REQUIRE(lhs->get_feature_class()==C_DENSE && lhs->get_feature_type()==F_DREAL,
+			"Ward linkage requires dense real valued features\n")
+
+	/* centroids of the clusters represented by each vector */
+	CDenseFeatures<float64_t>* features=(CDenseFeatures<float64_t>*) lhs;
+	int32_t num_dim=features->get_num_features();
+	SGMatrix<float64_t> centroids(num_dim, num);
+	for (int32_t i=0; i<num; i++)
+	{
+		SGVector<float64_t> vec=features->get_feature_vector(i);
+		sg_memcpy(centroids.get_column_vector(i), vec.vector, num_dim*sizeof(float64_t));
+		features->free_feature_vector(vec, i);
+	}
+	SG_UNREF(lhs);
+
+	SGVector<int32_t> sizes(num);
+	sizes.set_const(1);
+	SGVector<int32_t> chain(num);
+	SGVector<float64_t> cand(num);
+	int32_t chain_len=0;
+	int32_t first_active=0;
+
+	auto pb=progress(range(0, num-1), *this->io);
+	for (int32_t l=0; l<num-1; )
+	{
+		if (chain_len==0)
+		{
+			while (!sizes[first_active])
+				first_active++;
+			chain[chain_len++]=first_active;
+		}
+
+		/* squared Ward distances of the chain's end to all clusters */
+		int32_t a=chain[chain_len-1];
+		float64_t* c_a=centroids.get_column_vector(a);
+		float64_t size_a=sizes[a];
+
+		#pragma omp parallel for num_threads(parallel->get_num_threads())
+		for (int32_t k=0; k<num; k++)
+		{
+			if (!sizes[k] || k==a)
+			{
+				cand[k]=CMath::INFTY;
+				continue;
+			}
+
+			float64_t* c_k=centroids.get_column_vector(k);
+			float64_t sq_dist=0;
+			for (int32_t i=0; i<num_dim; i++)
+				sq_dist+=CMath::sq(c_a[i]-c_k[i]);
+
+			cand[k]=2*size_a*sizes[k]/(size_a+sizes[k])*sq_dist;
+		}
+
+		int32_t b=-1;
+		float64_t best=CMath::INFTY;
+		if (chain_len>1)
+		{
+			b=chain[chain_len-2];
+			best=cand[b];
+		}
+
+		for (int32_t k=0; k<num; k++)
+		{
+			if (sizes[k] && k!=a && (cand[k]<best || b<0))
+			{
+				best=cand[k];
+				b=k;
+			}
+		}
+
+		if (chain_len>1 && b==chain[chain_len-2])
+		{
+			chain_len-=2;
+			merge_pairs(0,l)=a;
+			merge_pairs(1,l)=b;
+			merge_dists[l]=CMath::sqrt(best);
+			l++;
+			pb.print_progress();
+
+			float64_t* c_b=centroids.get_column_vector(b);
+			float64_t size_b=sizes[b];
+			for (int32_t i=0; i<num_dim; i++)
+				c_b[i]=(size_a*c_a[i]+size_b*c_b[i])/(size_a+size_b);
+
+			sizes[b]+=sizes[a];
+			sizes[a]=0;
+		}
+		else
+			chain[chain_len++]=b;
+	}
+	pb.complete();
 }
 
 bool CHierarchical::load(FILE* srcfile)
@@ -22,11 +22,25 @@ namespace shogun
 {
 class CDistanceMachine;
 
-/** @brief Agglomerative hierarchical single linkage clustering.
+/** linkage criterion between clusters */
+enum ELinkageType
+{
+	/// minimum distance between the elements
+	SINGLE_LINKAGE=0,
+	/// maximum distance between the elements
+	COMPLETE_LINKAGE=1,
+	/// average distance between the elements
+	AVERAGE_LINKAGE=2,
+	/// increase of the within-cluster variance (Euclidean only)
+	WARD_LINKAGE=3
+};
+
+/** @brief Agglomerative hierarchical clustering.
  *
  * Starting with each object being assigned to its own cluster clusters are
- * iteratively merged.  Here the clusters are merged whose elements have
- * minimum distance, i.e.  the clusters A and B that obtain
+ * iteratively merged.  By default (single linkage) the clusters are merged
+ * whose elements have minimum distance, i.e.  the clusters A and B that
+ * obtain
  *
  * \f[
  * \min\{d({\bf x},{\bf x'}): {\bf x}\in {\cal A},{\bf x'}\in {\cal B}\}
@@ -34,6 +48,13 @@ class CDistanceMachine;
  *
  * are merged.
  *
+ * Single linkage is computed with SLINK in O(n) memory, evaluating the
+ * distances of one vector to all previous vectors in parallel. Complete
+ * and average linkage use the nearest-neighbor chain algorithm on the
+ * condensed distance matrix, Ward linkage uses it on the cluster centroids
+ * of dense real valued features in O(n) memory. In all cases the merges
+ * are reported in order of increasing distance.
+ *
  * cf e.g. http://en.wikipedia.org/wiki/Data_clustering*/
 class CHierarchical : public CDistanceMachine
 {
@@ -45,8 +66,10 @@ class CHierarchical : public CDistanceMachine
 		 *
 		 * @param merges the merges
 		 * @param d distance
+		 * @param l linkage criterion
 		 */
-		CHierarchical(int32_t merges, CDistance* d);
+		CHierarchical(int32_t merges, CDistance* d,
+				ELinkageType l=SINGLE_LINKAGE);
 		virtual ~CHierarchical();
 
 		/** problem type */
@@ -88,6 +111,18 @@ class CHierarchical : public CDistanceMachine
 		 */
 		int32_t get_merges();
 
+		/** set linkage criterion
+		 *
+		 * @param l new linkage
+		 */
+		inline void set_linkage(ELinkageType l) { linkage=l; }
+
+		/** get linkage criterion
+		 *
+		 * @return linkage
+		 */
+		inline ELinkageType get_linkage() const { return linkage; }
+
 		/** get assignment
 		 *
 		 */
@@ -124,10 +159,39 @@ class CHierarchical : public CDistanceMachine
 
 		virtual bool train_require_labels() const { return false; }
 
+		/** compute the single linkage dendrogram with SLINK
+		 *
+		 * @param merge_pairs vectors joined by each merge (2 x num-1)
+		 * @param merge_dists distance of each merge (num-1)
+		 */
+		void compute_slink(SGMatrix<int32_t> merge_pairs,
+				SGVector<float64_t> merge_dists);
+
+		/** compute the complete or average linkage dendrogram with the
+		 * nearest-neighbor chain algorithm
+		 *
+		 * @param merge_pairs vectors joined by each merge (2 x num-1)
+		 * @param merge_dists distance of each merge (num-1)
+		 */
+		void compute_nn_chain(SGMatrix<int32_t> merge_pairs,
+				SGVector<float64_t> merge_dists);
+
+		/** compute the Ward linkage dendrogram with the nearest-neighbor
+		 * chain algorithm on the cluster centroids
+		 *
+		 * @param merge_pairs vectors joined by each merge (2 x num-1)
+		 * @param merge_dists distance of each merge (num-1)
+		 */
+		void compute_ward_nn_chain(SGMatrix<int32_t> merge_pairs,
+				SGVector<float64_t> merge_dists);
+
 	protected:
 		/// the number of merges in hierarchical clustering
 		int32_t merges;
 
+		/// linkage criterion
+		ELinkageType linkage;
+
 		/// number of dimensions
 		int32_t dimensions;
 
@@ -11,11 +11,16 @@
 #include <shogun/converter/HashedDocConverter.h>
 #include <shogun/lib/DelimiterTokenizer.h>
 #include <shogun/lib/Hash.h>
-#include <shogun/lib/DynamicArray.h>
 #include <shogun/features/StringFeatures.h>
 #include <shogun/features/hashed/HashedDocDotFeatures.h>
 #include <shogun/mathematics/Math.h>
 
+#include <algorithm>
+
+#ifdef HAVE_OPENMP
+#include <omp.h>
+#endif
+
 using namespace shogun;
 
 namespace shogun
@@ -37,8 +42,106 @@ CHashedDocConverter::CHashedDocConverter(CTokenizer* tzer,
 	init(tzer, hash_bits, normalize, n_grams, skips);
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+struct CHashedDocConverter::HashingBuffers
+{
+	/** marks an unused slot in the table */
+	static const uint32_t EMPTY = 0xFFFFFFFF;
+
+	HashingBuffers(CTokenizer* tzer) : tokenizer(tzer), keys(1024), counts(1024),
+		used_slots(512), num_used(0)
+	{
+		SG_REF(tokenizer);
+		keys.set_const(EMPTY);
+	}
+
+	~HashingBuffers()
+	{
+		SG_UNREF(tokenizer);
+	}
+
+	/** increments the count of a hashed index */
+	void add(uint32_t idx)
+	{
+		if (2*(num_used+1)>keys.vlen)
+			grow();
+
+		index_t slot = find_slot(keys, idx);
+		if (keys[slot]==EMPTY)
+		{
+			keys[slot] = idx;
+			counts[slot] = 1;
+			used_slots[num_used++] = slot;
+		}
+		else
+			counts[slot]++;
+	}
+
+	/** @return slot of idx or the empty slot where it belongs */
+	static index_t find_slot(const SGVector<uint32_t>& table, uint32_t idx)
+	{
+		uint32_t mask = table.vlen-1;
+		uint32_t slot = idx*2654435761U;
+		slot = (slot ^ (slot>>16)) & mask;
+		while (table[slot]!=EMPTY && table[slot]!=idx)
+			slot = (slot+1) & mask;
+		return slot;
+	}
+
+	/** doubles the size of the table */
+	void grow()
+	{
+		SGVector<uint32_t> new_keys(2*keys.vlen);
+		SGVector<int32_t> new_counts(2*keys.vlen);
+		new_keys.set_const(EMPTY);
+
+		for (index_t i=0; i<num_used; i++)
+		{
+			index_t slot = find_slot(new_keys, keys[used_slots[i]]);
+			new_keys[slot] = keys[used_slots[i]];
+			new_counts[slot] = counts[used_slots[i]];
+			used_slots[i] = slot;
+		}
+
+		keys = new_keys;
+		counts = new_counts;
+		used_slots.resize_vector(keys.vlen/2);
+	}
+
+	/** empties the table */
+	void clear()
+	{
+		for (index_t i=0; i<num_used; i++)
+			keys[used_slots[i]] = EMPTY;
+		num_used = 0;
+	}
+
+	/** the tokenizer */
+	CTokenizer* tokenizer;
+
+	/** the current n+k active tokens in a circular manner */
+	SGVector<uint32_t> cached_hashes;
+
+	/** the combinations generated from the active tokens */
+	SGVector<index_t> ngram_indices;
+
+	/** open addressing table of hashed indices */
+	SGVector<uint32_t> keys;
+
+	/** counts of the hashed indices in keys */
+	SGVector<int32_t> counts;
+
+	/** occupied slots of the table */
+	SGVector<index_t> used_slots;
+
+	/** number of occupied slots */
+	index_t num_used;
+};
+#endif
+
 CHashedDocConverter::~CHashedDocConverter()
 {
+	delete m_buffers;
 	SG_UNREF(tokenizer);
 }
 
@@ -49,6 +152,7 @@ void CHashedDocConverter::init(CTokenizer* tzer, int32_t hash_bits, bool normali
 	should_normalize = normalize;
 	ngrams = n_grams;
 	tokens_to_skip = skips;
+	m_buffers = NULL;
 
 	if (tzer==NULL)
 	{
@@ -87,51 +191,91 @@ CFeatures* CHashedDocConverter::apply(CFeatures* features)
 	CStringFeatures<char>* s_features = (CStringFeatures<char>*) features;
 
 	int32_t dim = CMath::pow(2, num_bits);
-	SGSparseMatrix<float64_t> matrix(dim,features->get_num_vectors());
-	for (index_t vec_idx=0; vec_idx<s_features->get_num_vectors(); vec_idx++)
+	index_t num_vectors = s_features->get_num_vectors();
+	SGSparseMatrix<float64_t> matrix(dim, num_vectors);
+
+	/* tokenizers keep state, so each thread works on its own copy */
+	int32_t num_threads = CMath::max(1, CMath::min(parallel->get_num_threads(), num_vectors));
+	HashingBuffers** buffers = SG_MALLOC(HashingBuffers*, num_threads);
+	for (int32_t t=0; t<num_threads; t++)
+		buffers[t] = new HashingBuffers(t==0 ? tokenizer : tokenizer->get_copy());
+
+	#pragma omp parallel num_threads(num_threads)
 	{
-		SGVector<char> doc = s_features->get_feature_vector(vec_idx);
-		matrix[vec_idx] = apply(doc);
-		s_features->free_feature_vector(doc, vec_idx);
+#ifdef HAVE_OPENMP
+		HashingBuffers* thread_buffers = buffers[omp_get_thread_num()];
+#else
+		HashingBuffers* thread_buffers = buffers[0];
+#endif
+
+		#pragma omp for schedule(dynamic, 64)
+		for (index_t vec_idx=0; vec_idx<num_vectors; vec_idx++)
+		{
+			int32_t len;
+			bool free_vec;
+			char* doc = s_features->get_feature_vector(vec_idx, len, free_vec);
+			matrix.sparse_matrix[vec_idx] = hash_document(SGVector<char>(doc, len, false),
+					thread_buffers);
+			s_features->free_feature_vector(doc, vec_idx, free_vec);
+		}
 	}
 
+	for (int32_t t=0; t<num_threads; t++)
+		delete buffers[t];
+	SG_FREE(buffers);
+
 	return (CFeatures*) new CSparseFeatures<float64_t>(matrix);
 }
 
 SGSparseVector<float64_t> CHashedDocConverter::apply(SGVector<char> document)
 {
 	ASSERT(document.size()>0)
-	const int32_t array_size = 1024*1024;
-	/** the array will contain all the hashes generated from the tokens */
-	CDynamicArray<uint32_t> hashed_indices(array_size);
+
+	if (!m_buffers || m_buffers->tokenizer!=tokenizer)
+	{
+		delete m_buffers;
+		m_buffers = new HashingBuffers(tokenizer);
+	}
+
+	return hash_document(document, m_buffers);
+}
+
+SGSparseVector<float64_t> CHashedDocConverter::hash_document(SGVector<char> document,
+	HashingBuffers* buffers)
+{
+	CTokenizer* tzer = buffers->tokenizer;
 
 	/** this vector will maintain the current n+k active tokens
 	 * in a circular manner */
-	SGVector<uint32_t> cached_hashes(ngrams+tokens_to_skip);
+	SGVector<uint32_t>& cached_hashes = buffers->cached_hashes;
+	if (cached_hashes.vlen!=ngrams+tokens_to_skip)
+		cached_hashes = SGVector<uint32_t>(ngrams+tokens_to_skip);
 	index_t hashes_start = 0;
 	index_t hashes_end = 0;
 	int32_t len = cached_hashes.vlen - 1;
 
 	/** the combinations generated from the current active tokens will be
 	 * stored here to avoid creating new objects */
-	SGVector<index_t> ngram_indices((ngrams-1)*(tokens_to_skip+1) + 1);
+	SGVector<index_t>& ngram_indices = buffers->ngram_indices;
+	if (ngram_indices.vlen!=(ngrams-1)*(tokens_to_skip+1) + 1)
+		ngram_indices = SGVector<index_t>((ngrams-1)*(tokens_to_skip+1) + 1);
 
 	/** Reading n+s-1 tokens */
 	const int32_t seed = 0xdeadbeaf;
-	tokenizer->set_text(document);
+	tzer->set_text(document);
 	index_t token_start = 0;
-	while (hashes_end<ngrams-1+tokens_to_skip && tokenizer->has_next())
+	while (hashes_end<ngrams-1+tokens_to_skip && tzer->has_next())
 	{
-		index_t end = tokenizer->next_token_idx(token_start);
+		index_t end = tzer->next_token_idx(token_start);
 		uint32_t token_hash = CHash::MurmurHash3((uint8_t* ) &document.vector[token_start],
 				end-token_start, seed);
 		cached_hashes[hashes_end++] = token_hash;
 	}
 
-	/** Reading token and storing index to hashed_indices */
-	while (tokenizer->has_next())
+	/** Reading token and counting its combinations */
+	while (tzer->has_next())
 	{
-		index_t end = tokenizer->next_token_idx(token_start);
+		index_t end = tzer->next_token_idx(token_start);
 		uint32_t token_hash = CHash::MurmurHash3((uint8_t* ) &document.vector[token_start],
 				end-token_start, seed);
 		cached_hashes[hashes_end] = token_hash;
@@ -140,7 +284,7 @@ SGSparseVector<float64_t> CHashedDocConverter::apply(SGVector<char> document)
 				ngram_indices, num_bits, ngrams, tokens_to_skip);
 
 		for (index_t i=0; i<ngram_indices.vlen; i++)
-			hashed_indices.append_element(ngram_indices[i]);
+			buffers->add(ngram_indices[i]);
 
 		hashes_start++;
 		hashes_end++;
@@ -155,12 +299,13 @@ SGSparseVector<float64_t> CHashedDocConverter::apply(SGVector<char> document)
 	{
 		while (hashes_start!=hashes_end)
 		{
-			len--;
+			/* tokens after hashes_start, fewer than n+k-1 for short documents */
+			len = (hashes_end-hashes_start+cached_hashes.vlen) % cached_hashes.vlen - 1;
 			index_t max_idx = CHashedDocConverter::generate_ngram_hashes(cached_hashes, hashes_start,
 					len, ngram_indices, num_bits, ngrams, tokens_to_skip);
 
 			for (index_t i=0; i<max_idx; i++)
-				hashed_indices.append_element(ngram_indices[i]);
+				buffers->add(ngram_indices[i]);
 
 			hashes_start++;
 			if (hashes_start==cached_hashes.vlen)
@@ -168,37 +313,20 @@ SGSparseVector<float64_t> CHashedDocConverter::apply(SGVector<char> document)
 		}
 	}
 
-	SGSparseVector<float64_t> sparse_doc_rep = create_hashed_representation(hashed_indices);
-
-	/** Normalizing vector */
-	if (should_normalize)
+	SGSparseVector<float64_t> sparse_doc_rep(buffers->num_used);
+	float64_t norm_const = should_normalize ? CMath::sqrt((float64_t) document.size()) : 1.0;
+	for (index_t i=0; i<buffers->num_used; i++)
 	{
-		float64_t norm_const = CMath::sqrt((float64_t) document.size());
-		for (index_t i=0; i<sparse_doc_rep.num_feat_entries; i++)
-			sparse_doc_rep.features[i].entry /= norm_const;
+		index_t slot = buffers->used_slots[i];
+		sparse_doc_rep.features[i].feat_index = buffers->keys[slot];
+		sparse_doc_rep.features[i].entry = buffers->counts[slot] / norm_const;
 	}
+	buffers->clear();
 
-	return sparse_doc_rep;
-}
-
-SGSparseVector<float64_t> CHashedDocConverter::create_hashed_representation(CDynamicArray<uint32_t>& hashed_indices)
-{
-	int32_t num_nnz_features = count_distinct_indices(hashed_indices);
+	std::sort(sparse_doc_rep.features, sparse_doc_rep.features+sparse_doc_rep.num_feat_entries,
+		[](const SGSparseVectorEntry<float64_t>& a, const SGSparseVectorEntry<float64_t>& b)
+		{ return a.feat_index<b.feat_index; });
 
-	SGSparseVector<float64_t> sparse_doc_rep(num_nnz_features);
-	index_t sparse_idx = 0;
-	for (index_t i=0; i<hashed_indices.get_num_elements(); i++)
-	{
-		sparse_doc_rep.features[sparse_idx].feat_index = hashed_indices[i];
-		sparse_doc_rep.features[sparse_idx].entry = 1;
-		while ( (i+1<hashed_indices.get_num_elements()) &&
-				(hashed_indices[i+1]==hashed_indices[i]) )
-		{
-			sparse_doc_rep.features[sparse_idx].entry++;
-			i++;
-		}
-		sparse_idx++;
-	}
 	return sparse_doc_rep;
 }
 
@@ -225,24 +353,6 @@ index_t CHashedDocConverter::generate_ngram_hashes(SGVector<uint32_t>& hashes, i
 	return h_idx;
 }
 
-int32_t CHashedDocConverter::count_distinct_indices(CDynamicArray<uint32_t>& hashed_indices)
-{
-	CMath::qsort(hashed_indices.get_array(), hashed_indices.get_num_elements());
-
-	/** Counting nnz features */
-	int32_t num_nnz_features = 0;
-	for (index_t i=0; i<hashed_indices.get_num_elements(); i++)
-	{
-		num_nnz_features++;
-		while ( (i+1<hashed_indices.get_num_elements()) &&
-				(hashed_indices[i+1]==hashed_indices[i]) )
-		{
-			i++;
-		}
-	}
-	return num_nnz_features;
-}
-
 void CHashedDocConverter::set_normalization(bool normalize)
 {
 	should_normalize = normalize;
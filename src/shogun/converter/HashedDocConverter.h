@@ -35,6 +35,10 @@ template<class T> class CSparseFeatures;
  * The latter implements a k-skip n-grams approach, meaning that you can combine up to n tokens, while skipping up to k.
  * Eg. for the tokens ["a", "b", "c", "d"], with n_grams = 2 and skips = 2, one would get the following combinations :
  * ["a", "ab", "ac" (skipped 1), "ad" (skipped 2), "b", "bc", "bd" (skipped 1), "c", "cd", "d"].
+ *
+ * Documents are hashed in parallel, each thread using its own copy of the tokenizer
+ * and reusable buffers. The hashed indices of a document are counted in an open addressing
+ * table, so no per document allocation other than the resulting sparse vector is made.
  */
 class CHashedDocConverter : public CConverter
 {
@@ -66,7 +70,7 @@ public:
 	/** Destructor */
 	virtual ~CHashedDocConverter();
 
-	/** Hashes each string contained in features
+	/** Hashes each string contained in features (in parallel)
 	 *
 	 * @param features the strings to be hashed. Must be an instance of CStringFeatures.
 	 * @return a CSparseFeatures object containing the hashes of the strings.
@@ -123,21 +127,17 @@ protected:
 	/** init */
 	void init(CTokenizer* tzer, int32_t d, bool normalize, int32_t n_grams, int32_t skips);
 
-	/** This method takes a dynamic array as an argument, sorts it and returns the number
-	 * of the distinct elements(indices here) in the array.
-	 *
-	 * @param hashed_indices the array to sort and count elements
-	 * @return the number of distinct elements
-	 */
-	int32_t count_distinct_indices(CDynamicArray<uint32_t>& hashed_indices);
+private:
+	/** reusable buffers for hashing a document */
+	struct HashingBuffers;
 
-	/** This method takes the dynamic array containing all the hashed indices of a document and returns a compact
-	 * sparse representation with each index found and with the count of such index
+	/** Hashes the tokens contained in document using the given buffers
 	 *
-	 * @param hashed_indices the array containing the hashed indices
-	 * @return the compact hashed document representation
+	 * @param document the char vector to tokenize and hash
+	 * @param buffers buffers (and tokenizer) to use
+	 * @return a SGSparseVector with the hashed representation of the document
 	 */
-	SGSparseVector<float64_t> create_hashed_representation(CDynamicArray<uint32_t>& hashed_indices);
+	SGSparseVector<float64_t> hash_document(SGVector<char> document, HashingBuffers* buffers);
 
 protected:
 
@@ -155,6 +155,10 @@ protected:
 
 	/** the number of tokens to skip */
 	int32_t tokens_to_skip;
+
+private:
+	/** buffers used by apply(SGVector<char>) */
+	HashingBuffers* m_buffers;
 };
 }
 
@@ -13,6 +13,7 @@
 #include <shogun/io/SGIO.h>
 #include <shogun/distance/CosineDistance.h>
 #include <shogun/features/Features.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
 
 using namespace shogun;
 
@@ -80,3 +81,40 @@ float64_t CCosineDistance::compute(int32_t idx_a, int32_t idx_b)
 	else
 		return s ;
 }
+
+void CCosineDistance::compute_block(SGMatrix<float64_t>& block,
+		index_t lhs_start, index_t lhs_stop, index_t rhs_start, index_t rhs_stop)
+{
+	SGMatrix<float64_t> a=get_dense_block(lhs, lhs_start, lhs_stop);
+	SGMatrix<float64_t> b=get_dense_block(rhs, rhs_start, rhs_stop);
+
+	if (!a.matrix || !b.matrix)
+	{
+		CDistance::compute_block(block, lhs_start, lhs_stop, rhs_start, rhs_stop);
+		return;
+	}
+
+	SGVector<float64_t> norm_a(a.num_cols);
+	for (index_t i=0; i<a.num_cols; i++)
+		norm_a[i]=sqrt(linalg::dot(a.get_column(i), a.get_column(i)));
+
+	SGVector<float64_t> norm_b(b.num_cols);
+	for (index_t j=0; j<b.num_cols; j++)
+		norm_b[j]=sqrt(linalg::dot(b.get_column(j), b.get_column(j)));
+
+	linalg::matrix_prod(a, b, block, true, false);
+
+	for (index_t j=0; j<block.num_cols; j++)
+	{
+		for (index_t i=0; i<block.num_rows; i++)
+		{
+			float64_t s=norm_a[i]*norm_b[j];
+
+			// trap division by zero
+			if (s==0)
+				block(i,j)=0;
+			else
+				block(i,j)=CMath::max(0.0, 1-block(i,j)/s);
+		}
+	}
+}
@@ -76,6 +76,19 @@ class CCosineDistance: public CDenseDistance<float64_t>
 		/// idx_{a,b} denote the index of the feature vectors
 		/// in the corresponding feature object
 		virtual float64_t compute(int32_t idx_a, int32_t idx_b);
+
+		/** compute a tile of the distance matrix from the product of the
+		 * feature blocks and their norms
+		 *
+		 * @param block result tile
+		 * @param lhs_start first lhs vector
+		 * @param lhs_stop one past the last lhs vector
+		 * @param rhs_start first rhs vector
+		 * @param rhs_stop one past the last rhs vector
+		 */
+		virtual void compute_block(SGMatrix<float64_t>& block,
+				index_t lhs_start, index_t lhs_stop,
+				index_t rhs_start, index_t rhs_stop);
 };
 
 } // namespace shogun
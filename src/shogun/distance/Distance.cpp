@@ -20,6 +20,7 @@
 #include <shogun/lib/config.h>
 
 #include <shogun/distance/Distance.h>
+#include <shogun/features/DenseFeatures.h>
 #include <shogun/features/Features.h>
 
 #include <string.h>
@@ -210,9 +211,9 @@ float64_t CDistance::distance(int32_t idx_a, int32_t idx_b)
 	if (precompute_matrix && (precomputed_matrix!=NULL))
 	{
 		if (idx_a>=idx_b)
-			return precomputed_matrix[idx_a*(idx_a+1)/2+idx_b] ;
+			return precomputed_matrix[int64_t(idx_a)*(idx_a+1)/2+idx_b] ;
 		else
-			return precomputed_matrix[idx_b*(idx_b+1)/2+idx_a] ;
+			return precomputed_matrix[int64_t(idx_b)*(idx_b+1)/2+idx_a] ;
 	}
 
 	return compute(idx_a, idx_b);
@@ -238,18 +239,130 @@ void CDistance::do_precompute_matrix()
 
 	ASSERT(num_left==num_right)
 	ASSERT(lhs==rhs)
-	int32_t num=num_left;
+	int64_t num=num_left;
 
 	SG_FREE(precomputed_matrix);
-	precomputed_matrix=SG_MALLOC(float32_t, num*(num+1)/2);
+	precomputed_matrix=NULL;
+
+	// the generic block computation goes through distance(), which must not
+	// read the matrix while it is being filled
+	bool precompute=precompute_matrix;
+	precompute_matrix=false;
+
+	float32_t* packed=SG_MALLOC(float32_t, num*(num+1)/2);
+	compute_blocks(true, [packed](const SGMatrix<float64_t>& block,
+				index_t i_start, index_t i_stop, index_t j_start, index_t j_stop)
+	{
+		for (index_t j=j_start; j<j_stop; j++)
+		{
+			for (index_t i=i_start; i<i_stop && i<=j; i++)
+				packed[int64_t(j)*(j+1)/2+i]=block(i-i_start, j-j_start);
+		}
+	});
+
+	precomputed_matrix=packed;
+	precompute_matrix=precompute;
+}
+
+void CDistance::get_distance_block(SGMatrix<float64_t>& block,
+		index_t lhs_start, index_t lhs_stop, index_t rhs_start, index_t rhs_stop)
+{
+	REQUIRE(lhs && rhs, "Features not set!\n")
+	REQUIRE(lhs_start>=0 && lhs_start<=lhs_stop && lhs_stop<=lhs->get_num_vectors() &&
+			rhs_start>=0 && rhs_start<=rhs_stop && rhs_stop<=rhs->get_num_vectors(),
+			"Block [%d,%d)x[%d,%d) out of range (%dx%d)\n", lhs_start, lhs_stop,
+			rhs_start, rhs_stop, lhs->get_num_vectors(), rhs->get_num_vectors())
+	REQUIRE(block.num_rows==lhs_stop-lhs_start && block.num_cols==rhs_stop-rhs_start,
+			"Block size (%dx%d) does not match the range (%dx%d)\n",
+			block.num_rows, block.num_cols, lhs_stop-lhs_start, rhs_stop-rhs_start)
+
+	compute_block(block, lhs_start, lhs_stop, rhs_start, rhs_stop);
+}
+
+void CDistance::compute_block(SGMatrix<float64_t>& block,
+		index_t lhs_start, index_t lhs_stop, index_t rhs_start, index_t rhs_stop)
+{
+	for (index_t j=rhs_start; j<rhs_stop; j++)
+	{
+		for (index_t i=lhs_start; i<lhs_stop; i++)
+			block(i-lhs_start, j-rhs_start)=distance(i, j);
+	}
+}
+
+SGMatrix<float64_t> CDistance::get_dense_block(CFeatures* features,
+		index_t start, index_t stop)
+{
+	if (!features || features->get_feature_class()!=C_DENSE ||
+			features->get_feature_type()!=F_DREAL)
+		return SGMatrix<float64_t>();
+
+	CDenseFeatures<float64_t>* dense=static_cast<CDenseFeatures<float64_t>*>(features);
+	int32_t num_features=dense->get_num_features();
+
+	if (!dense->get_subset_stack()->has_subsets())
+	{
+		int32_t num_feat=0;
+		int32_t num_vec=0;
+		float64_t* matrix=dense->get_feature_matrix(num_feat, num_vec);
+		if (matrix)
+			return SGMatrix<float64_t>(matrix+int64_t(start)*num_features,
+					num_features, stop-start, false);
+	}
 
-	for (auto i : progress(range(num), *this->io))
+	SGMatrix<float64_t> block(num_features, stop-start);
+	for (index_t i=start; i<stop; i++)
 	{
-		for (int32_t j=0; j<=i; j++)
-			precomputed_matrix[i*(i+1)/2+j] = compute(i,j) ;
+		int32_t len=0;
+		bool do_free=false;
+		float64_t* vec=dense->get_feature_vector(i, len, do_free);
+		sg_memcpy(block.get_column_vector(i-start), vec, sizeof(float64_t)*len);
+		dense->free_feature_vector(vec, i, do_free);
 	}
+	return block;
 }
 
+template <class F>
+void CDistance::compute_blocks(bool symmetric, F store)
+{
+	const index_t m=get_num_vec_lhs();
+	const index_t n=get_num_vec_rhs();
+	const index_t bs=m_block_size;
+	const index_t num_row_blocks=(m+bs-1)/bs;
+	const index_t num_col_blocks=(n+bs-1)/bs;
+	const int64_t num_blocks=int64_t(num_row_blocks)*num_col_blocks;
+
+	PRange<int64_t> pb=PRange<int64_t>(
+	    range(num_blocks), *this->io, "PROGRESS: ", UTF8, []() { return true; });
+
+	#pragma omp parallel num_threads(parallel->get_num_threads())
+	{
+		float64_t* buffer=SG_MALLOC(float64_t, int64_t(bs)*bs);
+
+		#pragma omp for schedule(dynamic)
+		for (int64_t b=0; b<num_blocks; b++)
+		{
+			index_t bi=b%num_row_blocks;
+			index_t bj=b/num_row_blocks;
+
+			if (symmetric && bi>bj)
+				continue;
+
+			index_t i_start=bi*bs;
+			index_t i_stop=CMath::min(i_start+bs, m);
+			index_t j_start=bj*bs;
+			index_t j_stop=CMath::min(j_start+bs, n);
+
+			SGMatrix<float64_t> block(buffer, i_stop-i_start, j_stop-j_start, false);
+			compute_block(block, i_start, i_stop, j_start, j_stop);
+			store(block, i_start, i_stop, j_start, j_stop);
+
+			pb.print_progress();
+		}
+
+		SG_FREE(buffer);
+	}
+	pb.complete();
+}
 void CDistance::init()
 {
 	precomputed_matrix = NULL;
@@ -258,91 +371,66 @@ void CDistance::init()
 	rhs = NULL;
 	num_lhs=0;
 	num_rhs=0;
+	m_block_size=128;
 
 	m_parameters->add((CSGObject**) &lhs, "lhs",
 					  "Feature vectors to occur on left hand side.");
 	m_parameters->add((CSGObject**) &rhs, "rhs",
 					  "Feature vectors to occur on right hand side.");
+	m_parameters->add(&m_block_size, "block_size",
+					  "Number of vectors per tile of the distance matrix.");
 }
 
 template <class T>
 SGMatrix<T> CDistance::get_distance_matrix()
 {
-	T* result = NULL;
-
 	REQUIRE(has_features(), "no features assigned to distance\n")
 
 	int32_t m=get_num_vec_lhs();
 	int32_t n=get_num_vec_rhs();
 
-	int64_t total_num = int64_t(m)*n;
-	int64_t total=0;
-
 	// if lhs == rhs and sizes match assume k(i,j)=k(j,i)
 	bool symmetric= (lhs && lhs==rhs && m==n);
 
 	SG_DEBUG("returning distance matrix of size %dx%d\n", m, n)
 
-	result=SG_MALLOC(T, total_num);
+	SGMatrix<T> result(m, n);
 
-	PRange<int64_t> pb = PRange<int64_t>(
-	    range(total_num), *this->io, "PROGRESS: ", UTF8, []() { return true; });
-	int32_t num_threads;
-	int64_t step;
-	#pragma omp parallel shared(num_threads, step)
+	if (symmetric && precompute_matrix)
 	{
-#ifdef HAVE_OPENMP
-		#pragma omp single
+		if (!precomputed_matrix)
+			do_precompute_matrix();
+
+		#pragma omp parallel for num_threads(parallel->get_num_threads())
+		for (index_t j=0; j<n; j++)
 		{
-			num_threads=omp_get_num_threads();
-			step=total_num/num_threads;
-			num_threads--;
+			for (index_t i=0; i<=j; i++)
+			{
+				T v=precomputed_matrix[int64_t(j)*(j+1)/2+i];
+				result(i,j)=v;
+				result(j,i)=v;
+			}
 		}
-		int32_t thread_num=omp_get_thread_num();
-#else
-		num_threads=0;
-		step=total_num;
-		int32_t thread_num=0;
-#endif
-		bool verbose=(thread_num == 0);
 
-		int32_t start=compute_row_start(thread_num*step, n, symmetric);
-		int32_t end=(thread_num==num_threads) ? m : compute_row_start((thread_num+1)*step, n, symmetric);
+		return result;
+	}
 
-		for (int32_t i=start; i<end; i++)
+	compute_blocks(symmetric, [&result, symmetric](const SGMatrix<float64_t>& block,
+				index_t i_start, index_t i_stop, index_t j_start, index_t j_stop)
+	{
+		for (index_t j=j_start; j<j_stop; j++)
 		{
-			int32_t j_start=0;
-
-			if (symmetric)
-				j_start=i;
-
-			for (int32_t j=j_start; j<n; j++)
+			for (index_t i=i_start; i<i_stop; i++)
 			{
-				float64_t v=this->distance(i,j);
-				result[i+j*m]=v;
-
-				if (symmetric && i!=j)
-					result[j+i*m]=v;
-
-				if (verbose)
-				{
-					total++;
-
-					if (symmetric && i!=j)
-						total++;
-
-					pb.print_progress();
-
-					// TODO: replace with new signal
-					// if (CSignal::cancel_computations())
-					//	break;
-				}
+				T v=block(i-i_start, j-j_start);
+				result(i,j)=v;
+				if (symmetric)
+					result(j,i)=v;
 			}
 		}
-	}
-	pb.complete();
+	});
 
-	return SGMatrix<T>(result,m,n,true);
+	return result;
 }
 
 template SGMatrix<float64_t> CDistance::get_distance_matrix<float64_t>();
@@ -159,27 +159,45 @@ class CDistance : public CSGObject
 		}
 
 		/** get distance matrix (templated)
+		 *
+		 * The matrix is computed in tiles of get_block_size() vectors
+		 * which are distributed over all threads. If lhs and rhs are the
+		 * same only the upper triangle of tiles is computed.
 		 *
 		 * @return the distance matrix
 		 */
 		template <class T> SGMatrix<T> get_distance_matrix();
 
-		/** compute row start offset for parallel kernel matrix computation
+		/** compute the distances between the lhs vectors
+		 * [lhs_start, lhs_stop) and the rhs vectors [rhs_start, rhs_stop),
+		 * see compute_block()
 		 *
-		 * @param offs offset
-		 * @param n number of columns
-		 * @param symmetric whether matrix is symmetric
+		 * @param block column-major result of size
+		 * (lhs_stop-lhs_start)x(rhs_stop-rhs_start)
+		 * @param lhs_start first lhs vector
+		 * @param lhs_stop one past the last lhs vector
+		 * @param rhs_start first rhs vector
+		 * @param rhs_stop one past the last rhs vector
 		 */
-		int32_t compute_row_start(int64_t offs, int32_t n, bool symmetric)
-		{
-			int32_t i_start;
+		void get_distance_block(SGMatrix<float64_t>& block,
+				index_t lhs_start, index_t lhs_stop,
+				index_t rhs_start, index_t rhs_stop);
 
-			if (symmetric)
-				i_start=(int32_t) CMath::floor(n-CMath::sqrt(CMath::sq((float64_t) n)-offs));
-			else
-				i_start=(int32_t) (offs/int64_t(n));
+		/** set the number of vectors per tile side used when computing
+		 * the distance matrix
+		 *
+		 * @param block_size tile size
+		 */
+		void set_block_size(int32_t block_size)
+		{
+			REQUIRE(block_size>0, "Block size (%d) must be positive!\n", block_size)
+			m_block_size=block_size;
+		}
 
-			return i_start;
+		/** @return number of vectors per tile side */
+		int32_t get_block_size() const
+		{
+			return m_block_size;
 		}
 
 		/** init distance
@@ -367,6 +385,38 @@ class CDistance : public CSGObject
 		/// in the corresponding feature object
 		virtual float64_t compute(int32_t idx_a, int32_t idx_b)=0;
 
+		/** compute the distances between the lhs vectors
+		 * [lhs_start, lhs_stop) and the rhs vectors [rhs_start, rhs_stop)
+		 *
+		 * The default implementation calls distance() for every pair,
+		 * distances which can batch the computation (e.g. via matrix
+		 * products) override this.
+		 *
+		 * @param block column-major result of size
+		 * (lhs_stop-lhs_start)x(rhs_stop-rhs_start)
+		 * @param lhs_start first lhs vector
+		 * @param lhs_stop one past the last lhs vector
+		 * @param rhs_start first rhs vector
+		 * @param rhs_stop one past the last rhs vector
+		 */
+		virtual void compute_block(SGMatrix<float64_t>& block,
+				index_t lhs_start, index_t lhs_stop,
+				index_t rhs_start, index_t rhs_stop);
+
+		/** get the vectors [start, stop) of dense real-valued features as
+		 * the columns of a matrix. No copy is made if the vectors are
+		 * contiguous in memory, i.e. if there is no subset.
+		 *
+		 * @param features features, must be CDenseFeatures<float64_t>
+		 * to obtain a non-empty result
+		 * @param start first vector
+		 * @param stop one past the last vector
+		 * @return dim x (stop-start) matrix or an empty matrix if the
+		 * features are not dense real-valued features
+		 */
+		static SGMatrix<float64_t> get_dense_block(CFeatures* features,
+				index_t start, index_t stop);
+
 		/// matrix precomputation
 		void do_precompute_matrix();
 
@@ -382,6 +432,15 @@ class CDistance : public CSGObject
 	private:
 		void init();
 
+		/** calls store(block, lhs_start, lhs_stop, rhs_start, rhs_stop)
+		 * for every tile of the distance matrix, in parallel
+		 *
+		 * @param symmetric only visit tiles on or above the diagonal
+		 * @param store functor that consumes a computed tile
+		 */
+		template <class F>
+		void compute_blocks(bool symmetric, F store);
+
 	protected:
 		/** FIXME: precompute matrix should be dropped, handling
 		 * should be via customdistance
@@ -403,6 +462,9 @@ class CDistance : public CSGObject
 		/** number of feature vectors on the right hand side */
 		int32_t num_rhs;
 
+		/** number of vectors per tile side of the distance matrix */
+		int32_t m_block_size;
+
 };
 } // namespace shogun
 #endif
@@ -15,6 +15,7 @@
 #include <shogun/features/DotFeatures.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
 
 using namespace shogun;
 
@@ -80,6 +81,38 @@ float64_t CEuclideanDistance::compute(int32_t idx_a, int32_t idx_b)
 	return CMath::sqrt(result);
 }
 
+void CEuclideanDistance::compute_block(SGMatrix<float64_t>& block,
+		index_t lhs_start, index_t lhs_stop, index_t rhs_start, index_t rhs_stop)
+{
+	SGMatrix<float64_t> a=get_dense_block(lhs, lhs_start, lhs_stop);
+	SGMatrix<float64_t> b=get_dense_block(rhs, rhs_start, rhs_stop);
+
+	if (a.matrix && b.matrix)
+		linalg::matrix_prod(a, b, block, true, false);
+	else if (lhs->get_feature_class()==rhs->get_feature_class())
+	{
+		static_cast<CDotFeatures*>(lhs)->dot_block(block, lhs_start, lhs_stop,
+				static_cast<CDotFeatures*>(rhs), rhs_start, rhs_stop);
+	}
+	else
+	{
+		CDistance::compute_block(block, lhs_start, lhs_stop, rhs_start, rhs_stop);
+		return;
+	}
+
+	for (index_t j=0; j<block.num_cols; j++)
+	{
+		const float64_t sq_rhs=m_rhs_squared_norms[rhs_start+j];
+		for (index_t i=0; i<block.num_rows; i++)
+		{
+			// rounding in the expansion may produce tiny negative values
+			float64_t result=CMath::max(0.0,
+				m_lhs_squared_norms[lhs_start+i]+sq_rhs-2*block(i,j));
+			block(i,j)=disable_sqrt ? result : CMath::sqrt(result);
+		}
+	}
+}
+
 void CEuclideanDistance::precompute_lhs()
 {
 	REQUIRE(lhs, "Left hand side feature cannot be NULL!\n");
@@ -180,6 +180,19 @@ protected:
 	/// in the corresponding feature object
 	virtual float64_t compute(int32_t idx_a, int32_t idx_b);
 
+	/** compute a tile of the distance matrix from the product of the dense
+	 * feature blocks and the cached squared norms
+	 *
+	 * @param block result tile
+	 * @param lhs_start first lhs vector
+	 * @param lhs_stop one past the last lhs vector
+	 * @param rhs_start first rhs vector
+	 * @param rhs_stop one past the last rhs vector
+	 */
+	virtual void compute_block(SGMatrix<float64_t>& block,
+			index_t lhs_start, index_t lhs_stop,
+			index_t rhs_start, index_t rhs_stop);
+
 	/** if application of sqrt on matrix computation is disabled */
 	bool disable_sqrt;
 
@@ -85,6 +85,36 @@ float64_t CMinkowskiMetric::compute(int32_t idx_a, int32_t idx_b)
 	return pow(result,1/k);
 }
 
+void CMinkowskiMetric::compute_block(SGMatrix<float64_t>& block,
+		index_t lhs_start, index_t lhs_stop, index_t rhs_start, index_t rhs_stop)
+{
+	SGMatrix<float64_t> a=get_dense_block(lhs, lhs_start, lhs_stop);
+	SGMatrix<float64_t> b=get_dense_block(rhs, rhs_start, rhs_stop);
+
+	if (!a.matrix || !b.matrix)
+	{
+		CDistance::compute_block(block, lhs_start, lhs_stop, rhs_start, rhs_stop);
+		return;
+	}
+
+	ASSERT(a.num_rows==b.num_rows)
+
+	for (index_t j=0; j<b.num_cols; j++)
+	{
+		const float64_t* bvec=b.get_column_vector(j);
+		for (index_t i=0; i<a.num_cols; i++)
+		{
+			const float64_t* avec=a.get_column_vector(i);
+
+			float64_t result=0;
+			for (index_t d=0; d<a.num_rows; d++)
+				result+=pow(fabs(avec[d]-bvec[d]),k);
+
+			block(i,j)=pow(result,1/k);
+		}
+	}
+}
+
 void CMinkowskiMetric::init()
 {
 	k = 2.0;
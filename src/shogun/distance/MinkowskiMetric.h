@@ -87,6 +87,18 @@ class CMinkowskiMetric: public CDenseDistance<float64_t>
 		/// in the corresponding feature object
 		virtual float64_t compute(int32_t idx_a, int32_t idx_b);
 
+		/** compute a tile of the distance matrix from contiguous feature blocks
+		 *
+		 * @param block result tile
+		 * @param lhs_start first lhs vector
+		 * @param lhs_stop one past the last lhs vector
+		 * @param rhs_start first rhs vector
+		 * @param rhs_stop one past the last rhs vector
+		 */
+		virtual void compute_block(SGMatrix<float64_t>& block,
+				index_t lhs_start, index_t lhs_stop,
+				index_t rhs_start, index_t rhs_stop);
+
 	private:
 		void init();
 
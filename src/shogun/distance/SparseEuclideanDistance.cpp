@@ -74,6 +74,23 @@ float64_t CSparseEuclideanDistance::compute(int32_t idx_a, int32_t idx_b)
 	return CMath::sqrt(result);
 }
 
+void CSparseEuclideanDistance::compute_block(SGMatrix<float64_t>& block,
+		index_t lhs_start, index_t lhs_stop, index_t rhs_start, index_t rhs_stop)
+{
+	((CSparseFeatures<float64_t>*) lhs)->dot_block(block, lhs_start, lhs_stop,
+		(CSparseFeatures<float64_t>*) rhs, rhs_start, rhs_stop);
+
+	for (index_t j=0; j<block.num_cols; j++)
+	{
+		const float64_t sq_b=sq_rhs[rhs_start+j];
+		for (index_t i=0; i<block.num_rows; i++)
+		{
+			block(i,j)=CMath::sqrt(CMath::abs(
+				sq_lhs[lhs_start+i]+sq_b-2*block(i,j)));
+		}
+	}
+}
+
 void CSparseEuclideanDistance::init()
 {
 	sq_lhs=NULL;
@@ -72,6 +72,19 @@ class CSparseEuclideanDistance: public CSparseDistance<float64_t>
 		virtual float64_t compute(int32_t idx_a, int32_t idx_b);
 		/*    compute_kernel*/
 
+		/** compute a tile of the distance matrix from one block of sparse
+		 * dot products, see CSparseFeatures::dot_block()
+		 *
+		 * @param block output of size (lhs_stop-lhs_start) x (rhs_stop-rhs_start)
+		 * @param lhs_start first lhs vector
+		 * @param lhs_stop one past the last lhs vector
+		 * @param rhs_start first rhs vector
+		 * @param rhs_stop one past the last rhs vector
+		 */
+		virtual void compute_block(SGMatrix<float64_t>& block,
+				index_t lhs_start, index_t lhs_stop,
+				index_t rhs_start, index_t rhs_stop);
+
 	private:
 		void init();
 
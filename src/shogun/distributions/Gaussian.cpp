@@ -273,6 +273,43 @@ float64_t CGaussian::compute_log_PDF(SGVector<float64_t> point)
 	return -0.5 * answer;
 }
 
+SGVector<float64_t> CGaussian::compute_log_PDF_batch(SGMatrix<float64_t> points)
+{
+	ASSERT(m_mean.vector && m_d.vector)
+	ASSERT(points.num_rows == m_mean.vlen)
+
+	typename SGMatrix<float64_t>::EigenMatrixXtMap eig_points = points;
+	typename SGVector<float64_t>::EigenVectorXtMap eig_mean = m_mean;
+	typename SGVector<float64_t>::EigenVectorXtMap eig_d = m_d;
+
+	SGVector<float64_t> log_pdf(points.num_cols);
+	typename SGVector<float64_t>::EigenVectorXtMap eig_log_pdf = log_pdf;
+
+	Eigen::MatrixXd difference = eig_points.colwise() - eig_mean;
+
+	switch (m_cov_type)
+	{
+	case FULL:
+	{
+		// m_u holds the eigenvectors as columns, U^T projects onto them
+		typename SGMatrix<float64_t>::EigenMatrixXtMap eig_u = m_u;
+		Eigen::MatrixXd projected = eig_u.transpose() * difference;
+		eig_log_pdf = projected.cwiseAbs2().transpose() * eig_d.cwiseInverse();
+		break;
+	}
+	case DIAG:
+		eig_log_pdf = difference.cwiseAbs2().transpose() * eig_d.cwiseInverse();
+		break;
+	case SPHERICAL:
+		eig_log_pdf = difference.cwiseAbs2().colwise().sum().transpose() / m_d[0];
+		break;
+	}
+
+	eig_log_pdf = -0.5 * (eig_log_pdf.array() + m_constant);
+
+	return log_pdf;
+}
+
 SGVector<float64_t> CGaussian::get_mean()
 {
 	return m_mean;
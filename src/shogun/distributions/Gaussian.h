@@ -126,6 +126,17 @@ class CGaussian : public CDistribution
 		 */
 		virtual float64_t compute_log_PDF(SGVector<float64_t> point);
 
+		/** compute log PDF of several points at once
+		 *
+		 * The points are centered and whitened with the stored
+		 * decomposition of the covariance as a single matrix product,
+		 * which is much faster than calling compute_log_PDF() per point.
+		 *
+		 * @param points points for which to compute the log PDF, one per column
+		 * @return computed log PDF of each point
+		 */
+		SGVector<float64_t> compute_log_PDF_batch(SGMatrix<float64_t> points);
+
 		/** get mean
 		 *
 		 * @return mean
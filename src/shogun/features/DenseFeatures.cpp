@@ -565,6 +565,153 @@ void CDenseFeatures<float64_t>::add_to_dense_vec(float64_t alpha, int32_t vec_id
 	free_feature_vector(vec1, vec_idx1, vfree);
 }
 
+template<class ST> float64_t CDenseFeatures<ST>::dense_dot_float32(
+		int32_t vec_idx1, const float32_t* vec2, int32_t vec2_len)
+{
+	ASSERT(vec2_len == num_features)
+
+	int32_t vlen;
+	bool vfree;
+	ST* vec1 = get_feature_vector(vec_idx1, vlen, vfree);
+
+	ASSERT(vlen == num_features)
+	float64_t result = 0;
+
+	for (int32_t i = 0; i < num_features; i++)
+		result += vec1[i] * vec2[i];
+
+	free_feature_vector(vec1, vec_idx1, vfree);
+
+	return result;
+}
+
+template<> float64_t CDenseFeatures<float32_t>::dense_dot_float32(
+		int32_t vec_idx1, const float32_t* vec2, int32_t vec2_len)
+{
+	ASSERT(vec2_len == num_features)
+
+	int32_t vlen;
+	bool vfree;
+	float32_t* vec1 = get_feature_vector(vec_idx1, vlen, vfree);
+	SGVector<float32_t> sg_vec1(vec1, vlen, false);
+
+	ASSERT(vlen == num_features)
+	SGVector<float32_t> tmp(const_cast<float32_t*>(vec2), vec2_len, false);
+	float64_t result = linalg::dot(sg_vec1, tmp);
+
+	free_feature_vector(vec1, vec_idx1, vfree);
+
+	return result;
+}
+
+template<class ST> void CDenseFeatures<ST>::add_to_dense_vec_float32(
+		float32_t alpha, int32_t vec_idx1, float32_t* vec2, int32_t vec2_len,
+		bool abs_val)
+{
+	ASSERT(vec2_len == num_features)
+
+	int32_t vlen;
+	bool vfree;
+	ST* vec1 = get_feature_vector(vec_idx1, vlen, vfree);
+
+	ASSERT(vlen == num_features)
+
+	if (abs_val)
+	{
+		for (int32_t i = 0; i < num_features; i++)
+			vec2[i] += alpha * CMath::abs(vec1[i]);
+	}
+	else
+	{
+		for (int32_t i = 0; i < num_features; i++)
+			vec2[i] += alpha * vec1[i];
+	}
+
+	free_feature_vector(vec1, vec_idx1, vfree);
+}
+
+template<> void CDenseFeatures<float32_t>::add_to_dense_vec_float32(
+		float32_t alpha, int32_t vec_idx1, float32_t* vec2, int32_t vec2_len,
+		bool abs_val)
+{
+	ASSERT(vec2_len == num_features)
+
+	int32_t vlen;
+	bool vfree;
+	float32_t* vec1 = get_feature_vector(vec_idx1, vlen, vfree);
+
+	ASSERT(vlen == num_features)
+
+	if (abs_val)
+	{
+		for (int32_t i = 0; i < num_features; i++)
+			vec2[i] += alpha * CMath::abs(vec1[i]);
+	}
+	else
+	{
+		SGVector<float32_t>::vec1_plus_scalar_times_vec2(vec2, alpha, vec1, num_features);
+	}
+
+	free_feature_vector(vec1, vec_idx1, vfree);
+}
+
+template<class ST> void CDenseFeatures<ST>::dense_dot_range_float32(
+		float64_t* output, int32_t start, int32_t stop, float64_t* alphas,
+		const float32_t* vec, int32_t dim, float64_t b)
+{
+	ASSERT(output)
+	ASSERT(start>=0)
+	ASSERT(start<stop)
+	ASSERT(stop<=get_num_vectors())
+	ASSERT(dim==num_features)
+
+#pragma omp parallel for num_threads(parallel->get_num_threads())
+	for (int32_t i=start; i<stop; i++)
+	{
+		float64_t result=dense_dot_float32(i, vec, dim);
+		if (alphas)
+			result*=alphas[i];
+		output[i-start]=result+b;
+	}
+}
+
+template<class ST> void CDenseFeatures<ST>::dot_block(
+		SGMatrix<float64_t>& block, index_t lhs_start, index_t lhs_stop,
+		CDotFeatures* df, index_t rhs_start, index_t rhs_stop)
+{
+	CDotFeatures::dot_block(block, lhs_start, lhs_stop, df, rhs_start, rhs_stop);
+}
+
+template<> void CDenseFeatures<float32_t>::dot_block(
+		SGMatrix<float64_t>& block, index_t lhs_start, index_t lhs_stop,
+		CDotFeatures* df, index_t rhs_start, index_t rhs_stop)
+{
+	ASSERT(df)
+	ASSERT(block.num_rows==lhs_stop-lhs_start)
+	ASSERT(block.num_cols==rhs_stop-rhs_start)
+
+	CDenseFeatures<float32_t>* sf=(CDenseFeatures<float32_t>*) df;
+	if (df->get_feature_class()!=C_DENSE || df->get_feature_type()!=F_SHORTREAL ||
+			!feature_matrix.matrix || !sf->feature_matrix.matrix ||
+			m_subset_stack->has_subsets() || sf->m_subset_stack->has_subsets())
+	{
+		CDotFeatures::dot_block(block, lhs_start, lhs_stop, df, rhs_start, rhs_stop);
+		return;
+	}
+
+	ASSERT(num_features==sf->num_features)
+
+	// the product stays in single precision, only the result is widened
+	Eigen::Map<Eigen::MatrixXf> lhs_block(feature_matrix.matrix+int64_t(lhs_start)*num_features,
+			num_features, lhs_stop-lhs_start);
+	Eigen::Map<Eigen::MatrixXf> rhs_block(sf->feature_matrix.matrix+int64_t(rhs_start)*num_features,
+			num_features, rhs_stop-rhs_start);
+	Eigen::Map<Eigen::MatrixXd> block_eig(block.matrix, block.num_rows, block.num_cols);
+
+	Eigen::MatrixXf prod=lhs_block.transpose()*rhs_block;
+	block_eig=prod.cast<float64_t>();
+}
+
 template<class ST> int32_t CDenseFeatures<ST>::get_nnz_features_for_vector(int32_t num)
 {
 	return num_features;
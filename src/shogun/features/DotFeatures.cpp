@@ -50,6 +50,20 @@ float64_t CDotFeatures::dense_dot_sgvec(int32_t vec_idx1, SGVector<float64_t> ve
 	return dense_dot(vec_idx1, vec2.vector, vec2.vlen);
 }
 
+void CDotFeatures::dot_block(SGMatrix<float64_t>& block,
+		index_t lhs_start, index_t lhs_stop, CDotFeatures* df,
+		index_t rhs_start, index_t rhs_stop)
+{
+	ASSERT(block.num_rows==lhs_stop-lhs_start)
+	ASSERT(block.num_cols==rhs_stop-rhs_start)
+
+	for (index_t j=rhs_start; j<rhs_stop; j++)
+	{
+		for (index_t i=lhs_start; i<lhs_stop; i++)
+			block(i-lhs_start, j-rhs_start)=dot(i, df, j);
+	}
+}
+
 void CDotFeatures::dense_dot_range(float64_t* output, int32_t start, int32_t stop, float64_t* alphas, float64_t* vec, int32_t dim, float64_t b)
 {
 	ASSERT(output)
@@ -104,6 +118,36 @@ void CDotFeatures::dense_dot_range(float64_t* output, int32_t start, int32_t sto
 	pb.complete();
 }
 
+void CDotFeatures::dense_dot_range_float32(float64_t* output, int32_t start, int32_t stop, float64_t* alphas, const float32_t* vec, int32_t dim, float64_t b)
+{
+	SGVector<float64_t> vec64(dim);
+	for (int32_t i=0; i<dim; i++)
+		vec64[i]=vec[i];
+
+	dense_dot_range(output, start, stop, alphas, vec64.vector, dim, b);
+}
+
+float64_t CDotFeatures::dense_dot_float32(int32_t vec_idx1, const float32_t* vec2, int32_t vec2_len)
+{
+	SGVector<float64_t> vec64(vec2_len);
+	for (int32_t i=0; i<vec2_len; i++)
+		vec64[i]=vec2[i];
+
+	return dense_dot(vec_idx1, vec64.vector, vec2_len);
+}
+
+void CDotFeatures::add_to_dense_vec_float32(float32_t alpha, int32_t vec_idx1, float32_t* vec2, int32_t vec2_len, bool abs_val)
+{
+	ASSERT(vec2_len==get_dim_feature_space())
+
+	int32_t index;
+	float64_t value;
+	void* it=get_feature_iterator(vec_idx1);
+	while (get_next_feature(index, value, it))
+		vec2[index]+=alpha*(abs_val ? CMath::abs(value) : value);
+	free_feature_iterator(it);
+}
+
 void CDotFeatures::dense_dot_range_subset(int32_t* sub_index, int32_t num, float64_t* output, float64_t* alphas, float64_t* vec, int32_t dim, float64_t b)
 {
 	ASSERT(sub_index)
@@ -105,6 +105,35 @@ class CDotFeatures : public CFeatures
 		 */
 		virtual void add_to_dense_vec(float64_t alpha, int32_t vec_idx1, float64_t* vec2, int32_t vec2_len, bool abs_val=false)=0;
 
+		/** compute dot product between vector1 and a single precision dense
+		 * vector
+		 *
+		 * The default implementation promotes vec2 to double and calls
+		 * dense_dot(), features stored in single precision override it to
+		 * stay in float32.
+		 *
+		 * @param vec_idx1 index of first vector
+		 * @param vec2 pointer to single precision vector
+		 * @param vec2_len length of vec2
+		 * @return dot product
+		 */
+		virtual float64_t dense_dot_float32(int32_t vec_idx1, const float32_t* vec2, int32_t vec2_len);
+
+		/** add vector 1 multiplied with alpha to a single precision dense
+		 * vector2
+		 *
+		 * The default implementation walks the non-zero features with the
+		 * feature iterator, features without an iterator have to override
+		 * it.
+		 *
+		 * @param alpha scalar alpha
+		 * @param vec_idx1 index of first vector
+		 * @param vec2 pointer to single precision vector
+		 * @param vec2_len length of vec2
+		 * @param abs_val if true add the absolute value
+		 */
+		virtual void add_to_dense_vec_float32(float32_t alpha, int32_t vec_idx1, float32_t* vec2, int32_t vec2_len, bool abs_val=false);
+
 		/** Compute the dot product for a range of vectors. This function makes use of dense_dot
 		 * alphas[i] * sparse[i]^T * w + b
 		 *
@@ -120,6 +149,21 @@ class CDotFeatures : public CFeatures
 		 */
 		virtual void dense_dot_range(float64_t* output, int32_t start, int32_t stop, float64_t* alphas, float64_t* vec, int32_t dim, float64_t b);
 
+		/** single precision version of dense_dot_range()
+		 *
+		 * The default implementation promotes vec to double once and calls
+		 * dense_dot_range().
+		 *
+		 * @param output result for the given vector range
+		 * @param start start vector range from this idx
+		 * @param stop stop vector range at this idx
+		 * @param alphas scalars to multiply with, may be NULL
+		 * @param vec single precision dense vector to compute dot product with
+		 * @param dim length of the dense vector
+		 * @param b bias
+		 */
+		virtual void dense_dot_range_float32(float64_t* output, int32_t start, int32_t stop, float64_t* alphas, const float32_t* vec, int32_t dim, float64_t b);
+
 		/** Compute the dot product for a subset of vectors. This function makes use of dense_dot
 		 * alphas[i] * sparse[i]^T * w + b
 		 *
@@ -134,6 +178,25 @@ class CDotFeatures : public CFeatures
 		virtual void dense_dot_range_subset(int32_t* sub_index, int32_t num,
 				float64_t* output, float64_t* alphas, float64_t* vec, int32_t dim, float64_t b);
 
+		/** compute the dot products between the vectors
+		 * [lhs_start, lhs_stop) of these features and the vectors
+		 * [rhs_start, rhs_stop) of df
+		 *
+		 * The default implementation calls dot() for every pair, features
+		 * which can share work between the pairs override this.
+		 *
+		 * @param block column-major result of size
+		 * (lhs_stop-lhs_start)x(rhs_stop-rhs_start)
+		 * @param lhs_start first vector of these features
+		 * @param lhs_stop one past the last vector of these features
+		 * @param df DotFeatures (of same kind) to compute dot products with
+		 * @param rhs_start first vector of df
+		 * @param rhs_stop one past the last vector of df
+		 */
+		virtual void dot_block(SGMatrix<float64_t>& block,
+				index_t lhs_start, index_t lhs_stop, CDotFeatures* df,
+				index_t rhs_start, index_t rhs_stop);
+
 		/** get number of non-zero features in vector
 		 *
 		 * (in case accurate estimates are too expensive overestimating is OK)
@@ -58,6 +58,7 @@ namespace shogun
 		C_FACTOR_GRAPH = 190,
 		C_INDEX = 200,
 		C_SUB_SAMPLES_DENSE=300,
+		C_QUANTIZED_DENSE=310,
 		C_ANY = 1000
 	};
 
@@ -0,0 +1,501 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/features/QuantizedDenseFeatures.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/base/Parameter.h>
+#include <shogun/io/SGIO.h>
+#include <shogun/mathematics/Math.h>
+
+using namespace shogun;
+
+namespace
+{
+	/* int8 products summed in int32 before they can overflow */
+	const index_t INT_DOT_BLOCK_SIZE = 1 << 16;
+
+	struct quantized_feature_iterator
+	{
+		int32_t vidx;
+		int32_t real_vidx;
+		int32_t index;
+	};
+
+	/* scale and offset mapping [lo, hi] onto the int8 range */
+	void quantization_params(float64_t lo, float64_t hi, bool symmetric,
+			float32_t& scale, float32_t& offset)
+	{
+		if (symmetric)
+		{
+			float64_t max_abs = CMath::max(CMath::abs(lo), CMath::abs(hi));
+			scale = max_abs > 0 ? max_abs / 127 : 1;
+			offset = 0;
+		}
+		else if (hi > lo)
+		{
+			scale = (hi - lo) / 255;
+			offset = lo + 128 * float64_t(scale);
+		}
+		else
+		{
+			// constant group, every value is stored as zero
+			scale = 1;
+			offset = lo;
+		}
+	}
+
+	int8_t quantize_value(float64_t x, float32_t scale, float32_t offset,
+			bool symmetric)
+	{
+		float64_t q = CMath::round((x - offset) / scale);
+		return (int8_t) CMath::clamp(q, symmetric ? -127.0 : -128.0, 127.0);
+	}
+
+	float64_t quantized_dot(const int8_t* q, const float64_t* w, int32_t len)
+	{
+		float64_t result = 0;
+		for (int32_t i = 0; i < len; i++)
+			result += q[i] * w[i];
+
+		return result;
+	}
+}
+
+CQuantizedDenseFeatures::CQuantizedDenseFeatures() : CDotFeatures()
+{
+	init();
+}
+
+CQuantizedDenseFeatures::CQuantizedDenseFeatures(
+		CDenseFeatures<float64_t>* features, EQuantizationScale scale_type,
+		bool symmetric) : CDotFeatures()
+{
+	init();
+	quantize(features, scale_type, symmetric);
+}
+
+CQuantizedDenseFeatures::CQuantizedDenseFeatures(
+		const CQuantizedDenseFeatures& orig) : CDotFeatures(orig)
+{
+	init();
+	m_quantized = orig.m_quantized;
+	m_scales = orig.m_scales;
+	m_offsets = orig.m_offsets;
+	m_feature_errors = orig.m_feature_errors;
+	m_scale_type = orig.m_scale_type;
+	m_symmetric = orig.m_symmetric;
+
+	if (orig.m_subset_stack != NULL)
+	{
+		SG_UNREF(m_subset_stack);
+		m_subset_stack=new CSubsetStack(*orig.m_subset_stack);
+		SG_REF(m_subset_stack);
+	}
+}
+
+CQuantizedDenseFeatures::~CQuantizedDenseFeatures()
+{
+}
+
+void CQuantizedDenseFeatures::init()
+{
+	m_scale_type = QS_PER_ROW;
+	m_symmetric = true;
+
+	SG_ADD(&m_quantized, "quantized", "Quantized feature matrix",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_scales, "scales", "Scale per row or column", MS_NOT_AVAILABLE);
+	SG_ADD(&m_offsets, "offsets", "Offset per row or column",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_feature_errors, "feature_errors",
+			"Largest quantization error per feature", MS_NOT_AVAILABLE);
+	SG_ADD((machine_int_t*) &m_scale_type, "scale_type",
+			"Whether rows or columns share a scale", MS_NOT_AVAILABLE);
+	SG_ADD(&m_symmetric, "symmetric", "Symmetric quantization",
+			MS_NOT_AVAILABLE);
+}
+
+void CQuantizedDenseFeatures::quantize(CDenseFeatures<float64_t>* features,
+		EQuantizationScale scale_type, bool symmetric)
+{
+	REQUIRE(features, "No features provided!\n");
+
+	remove_all_subsets();
+
+	const int32_t num_features = features->get_num_features();
+	const int32_t num_vectors = features->get_num_vectors();
+	const int32_t num_threads = parallel->get_num_threads();
+
+	m_scale_type = scale_type;
+	m_symmetric = symmetric;
+	m_quantized = SGMatrix<int8_t>(num_features, num_vectors);
+	m_feature_errors = SGVector<float64_t>(num_features);
+	m_feature_errors.zero();
+
+	const index_t num_groups = scale_type == QS_PER_ROW ? num_features : num_vectors;
+	m_scales = SGVector<float32_t>(num_groups);
+	m_offsets = SGVector<float32_t>(num_groups);
+
+	if (scale_type == QS_PER_ROW)
+	{
+		SGVector<float64_t> lo(num_features);
+		SGVector<float64_t> hi(num_features);
+		lo.set_const(CMath::INFTY);
+		hi.set_const(-CMath::INFTY);
+
+#pragma omp parallel num_threads(num_threads)
+		{
+			SGVector<float64_t> local_lo(num_features);
+			SGVector<float64_t> local_hi(num_features);
+			local_lo.set_const(CMath::INFTY);
+			local_hi.set_const(-CMath::INFTY);
+
+#pragma omp for
+			for (int32_t j = 0; j < num_vectors; j++)
+			{
+				int32_t len;
+				bool dofree;
+				float64_t* vec = features->get_feature_vector(j, len, dofree);
+				for (int32_t i = 0; i < num_features; i++)
+				{
+					local_lo[i] = CMath::min(local_lo[i], vec[i]);
+					local_hi[i] = CMath::max(local_hi[i], vec[i]);
+				}
+				features->free_feature_vector(vec, j, dofree);
+			}
+
+#pragma omp critical
+			{
+				for (int32_t i = 0; i < num_features; i++)
+				{
+					lo[i] = CMath::min(lo[i], local_lo[i]);
+					hi[i] = CMath::max(hi[i], local_hi[i]);
+				}
+			}
+		}
+
+		for (int32_t i = 0; i < num_features; i++)
+		{
+			if (num_vectors == 0)
+				lo[i] = hi[i] = 0;
+			quantization_params(lo[i], hi[i], symmetric, m_scales[i], m_offsets[i]);
+		}
+	}
+
+#pragma omp parallel num_threads(num_threads)
+	{
+		SGVector<float64_t> local_errors(num_features);
+		local_errors.zero();
+
+#pragma omp for
+		for (int32_t j = 0; j < num_vectors; j++)
+		{
+			int32_t len;
+			bool dofree;
+			float64_t* vec = features->get_feature_vector(j, len, dofree);
+			int8_t* q = m_quantized.get_column_vector(j);
+
+			if (scale_type == QS_PER_COLUMN)
+			{
+				float64_t lo = CMath::INFTY;
+				float64_t hi = -CMath::INFTY;
+				for (int32_t i = 0; i < num_features; i++)
+				{
+					lo = CMath::min(lo, vec[i]);
+					hi = CMath::max(hi, vec[i]);
+				}
+				if (num_features == 0)
+					lo = hi = 0;
+				quantization_params(lo, hi, symmetric, m_scales[j], m_offsets[j]);
+			}
+
+			for (int32_t i = 0; i < num_features; i++)
+			{
+				const float32_t s = scale(i, j);
+				const float32_t o = offset(i, j);
+				q[i] = quantize_value(vec[i], s, o, symmetric);
+
+				const float64_t error = CMath::abs(vec[i] - (s * float64_t(q[i]) + o));
+				local_errors[i] = CMath::max(local_errors[i], error);
+			}
+
+			features->free_feature_vector(vec, j, dofree);
+		}
+
+#pragma omp critical
+		{
+			for (int32_t i = 0; i < num_features; i++)
+				m_feature_errors[i] = CMath::max(m_feature_errors[i], local_errors[i]);
+		}
+	}
+}
+
+const int8_t* CQuantizedDenseFeatures::get_quantized_vector(int32_t num,
+		int32_t& real_num) const
+{
+	real_num = m_subset_stack->subset_idx_conversion(num);
+	return m_quantized.matrix + int64_t(real_num) * m_quantized.num_rows;
+}
+
+SGVector<float64_t> CQuantizedDenseFeatures::get_feature_vector(int32_t num) const
+{
+	int32_t real_num;
+	const int8_t* q = get_quantized_vector(num, real_num);
+
+	SGVector<float64_t> result(m_quantized.num_rows);
+	for (index_t i = 0; i < result.vlen; i++)
+		result[i] = scale(i, real_num) * float64_t(q[i]) + offset(i, real_num);
+
+	return result;
+}
+
+CDenseFeatures<float64_t>* CQuantizedDenseFeatures::dequantize() const
+{
+	REQUIRE(!m_subset_stack->has_subsets(),
+			"Dequantization is not possible with subsets!\n");
+
+	SGMatrix<float64_t> matrix(m_quantized.num_rows, m_quantized.num_cols);
+	for (index_t j = 0; j < matrix.num_cols; j++)
+	{
+		SGVector<float64_t> vec = get_feature_vector(j);
+		sg_memcpy(matrix.get_column_vector(j), vec.vector,
+				sizeof(float64_t) * vec.vlen);
+	}
+
+	return new CDenseFeatures<float64_t>(matrix);
+}
+
+int32_t CQuantizedDenseFeatures::get_dim_feature_space() const
+{
+	return m_quantized.num_rows;
+}
+
+float64_t CQuantizedDenseFeatures::dot(int32_t vec_idx1, CDotFeatures* df,
+		int32_t vec_idx2)
+{
+	ASSERT(df)
+	ASSERT(df->get_feature_type() == get_feature_type())
+	ASSERT(df->get_feature_class() == get_feature_class())
+	CQuantizedDenseFeatures* qf = (CQuantizedDenseFeatures*) df;
+
+	const int32_t len = get_dim_feature_space();
+	ASSERT(len == qf->get_dim_feature_space())
+
+	int32_t real1, real2;
+	const int8_t* q1 = get_quantized_vector(vec_idx1, real1);
+	const int8_t* q2 = qf->get_quantized_vector(vec_idx2, real2);
+
+	if (m_scale_type == QS_PER_COLUMN && qf->m_scale_type == QS_PER_COLUMN)
+	{
+		/* (s1 q1 + o1)^T (s2 q2 + o2) expanded, all sums are exact integers */
+		int64_t sum_qq = 0;
+		int64_t sum_q1 = 0;
+		int64_t sum_q2 = 0;
+		for (index_t start = 0; start < len; start += INT_DOT_BLOCK_SIZE)
+		{
+			const index_t stop = CMath::min(len, start + INT_DOT_BLOCK_SIZE);
+			int32_t block_qq = 0;
+			int32_t block_q1 = 0;
+			int32_t block_q2 = 0;
+			for (index_t i = start; i < stop; i++)
+			{
+				block_qq += int32_t(q1[i]) * q2[i];
+				block_q1 += q1[i];
+				block_q2 += q2[i];
+			}
+			sum_qq += block_qq;
+			sum_q1 += block_q1;
+			sum_q2 += block_q2;
+		}
+
+		const float64_t s1 = m_scales[real1], o1 = m_offsets[real1];
+		const float64_t s2 = qf->m_scales[real2], o2 = qf->m_offsets[real2];
+		return s1 * s2 * sum_qq + s1 * o2 * sum_q1 + o1 * s2 * sum_q2 +
+			len * o1 * o2;
+	}
+
+	/* per row scales differ between the dimensions and cannot be factored
+	 * out, but the int8 products are still exact integers that only need
+	 * the product of the two scales, the offset terms vanish if both
+	 * quantizations are symmetric
+	 */
+	float64_t result = 0;
+	for (index_t i = 0; i < len; i++)
+	{
+		result += float64_t(scale(i, real1)) * qf->scale(i, real2) *
+			(int32_t(q1[i]) * q2[i]);
+	}
+
+	if (!m_symmetric || !qf->m_symmetric)
+	{
+		for (index_t i = 0; i < len; i++)
+		{
+			const float64_t o1 = offset(i, real1);
+			const float64_t o2 = qf->offset(i, real2);
+			result += scale(i, real1) * o2 * q1[i] +
+				o1 * qf->scale(i, real2) * q2[i] + o1 * o2;
+		}
+	}
+
+	return result;
+}
+
+float64_t CQuantizedDenseFeatures::dense_dot(int32_t vec_idx1,
+		const float64_t* vec2, int32_t vec2_len)
+{
+	ASSERT(vec2_len == get_dim_feature_space())
+
+	int32_t real_num;
+	const int8_t* q = get_quantized_vector(vec_idx1, real_num);
+
+	if (m_scale_type == QS_PER_COLUMN)
+	{
+		float64_t sum_qw = 0;
+		float64_t sum_w = 0;
+		for (int32_t i = 0; i < vec2_len; i++)
+		{
+			sum_qw += q[i] * vec2[i];
+			sum_w += vec2[i];
+		}
+
+		return m_scales[real_num] * sum_qw + m_offsets[real_num] * sum_w;
+	}
+
+	float64_t result = 0;
+	for (int32_t i = 0; i < vec2_len; i++)
+		result += (m_scales[i] * float64_t(q[i]) + m_offsets[i]) * vec2[i];
+
+	return result;
+}
+
+void CQuantizedDenseFeatures::add_to_dense_vec(float64_t alpha,
+		int32_t vec_idx1, float64_t* vec2, int32_t vec2_len, bool abs_val)
+{
+	ASSERT(vec2_len == get_dim_feature_space())
+
+	int32_t real_num;
+	const int8_t* q = get_quantized_vector(vec_idx1, real_num);
+
+	if (abs_val)
+	{
+		for (int32_t i = 0; i < vec2_len; i++)
+		{
+			vec2[i] += alpha * CMath::abs(
+				scale(i, real_num) * float64_t(q[i]) + offset(i, real_num));
+		}
+	}
+	else
+	{
+		for (int32_t i = 0; i < vec2_len; i++)
+			vec2[i] += alpha * (scale(i, real_num) * float64_t(q[i]) + offset(i, real_num));
+	}
+}
+
+void CQuantizedDenseFeatures::dense_dot_range(float64_t* output,
+		int32_t start, int32_t stop, float64_t* alphas, float64_t* vec,
+		int32_t dim, float64_t b)
+{
+	ASSERT(output)
+	ASSERT(start>=0)
+	ASSERT(start<stop)
+	ASSERT(stop<=get_num_vectors())
+	ASSERT(dim==get_dim_feature_space())
+
+	/* per row: x^T w = q^T (s .* w) + o^T w
+	 * per column: x^T w = s q^T w + o sum(w)
+	 */
+	SGVector<float64_t> folded(dim);
+	float64_t folded_const = 0;
+	for (int32_t i = 0; i < dim; i++)
+	{
+		if (m_scale_type == QS_PER_ROW)
+		{
+			folded[i] = m_scales[i] * vec[i];
+			folded_const += m_offsets[i] * vec[i];
+		}
+		else
+		{
+			folded[i] = vec[i];
+			folded_const += vec[i];
+		}
+	}
+
+#pragma omp parallel for num_threads(parallel->get_num_threads())
+	for (int32_t i=start; i<stop; i++)
+	{
+		int32_t real_num;
+		const int8_t* q = get_quantized_vector(i, real_num);
+		float64_t result = quantized_dot(q, folded.vector, dim);
+
+		if (m_scale_type == QS_PER_ROW)
+			result += folded_const;
+		else
+			result = m_scales[real_num] * result + m_offsets[real_num] * folded_const;
+
+		if (alphas)
+			result *= alphas[i];
+		output[i-start] = result + b;
+	}
+}
+
+int32_t CQuantizedDenseFeatures::get_nnz_features_for_vector(int32_t num)
+{
+	return get_dim_feature_space();
+}
+
+void* CQuantizedDenseFeatures::get_feature_iterator(int32_t vector_index)
+{
+	if (vector_index>=get_num_vectors())
+	{
+		SG_ERROR("Index out of bounds (number of vectors %d, you "
+		"requested %d)\n", get_num_vectors(), vector_index);
+	}
+
+	quantized_feature_iterator* it = SG_MALLOC(quantized_feature_iterator, 1);
+	it->vidx = vector_index;
+	it->real_vidx = m_subset_stack->subset_idx_conversion(vector_index);
+	it->index = 0;
+	return it;
+}
+
+bool CQuantizedDenseFeatures::get_next_feature(int32_t& index,
+		float64_t& value, void* iterator)
+{
+	quantized_feature_iterator* it = (quantized_feature_iterator*) iterator;
+	if (!it || it->index >= get_dim_feature_space())
+		return false;
+
+	index = it->index++;
+	value = scale(index, it->real_vidx) * float64_t(m_quantized(index, it->real_vidx)) +
+		offset(index, it->real_vidx);
+
+	return true;
+}
+
+void CQuantizedDenseFeatures::free_feature_iterator(void* iterator)
+{
+	SG_FREE(iterator);
+}
+
+CFeatures* CQuantizedDenseFeatures::duplicate() const
+{
+	return new CQuantizedDenseFeatures(*this);
+}
+
+EFeatureType CQuantizedDenseFeatures::get_feature_type() const
+{
+	return F_CHAR;
+}
+
+EFeatureClass CQuantizedDenseFeatures::get_feature_class() const
+{
+	return C_QUANTIZED_DENSE;
+}
+
+int32_t CQuantizedDenseFeatures::get_num_vectors() const
+{
+	return m_subset_stack->has_subsets() ? m_subset_stack->get_size() :
+		m_quantized.num_cols;
+}
@@ -0,0 +1,241 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef _QUANTIZEDDENSEFEATURES_H___
+#define _QUANTIZEDDENSEFEATURES_H___
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+#include <shogun/features/DotFeatures.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+
+namespace shogun
+{
+template <class ST> class CDenseFeatures;
+
+/** granularity of the quantization scales */
+enum EQuantizationScale
+{
+	/** one scale and offset per feature dimension (row of the matrix) */
+	QS_PER_ROW = 0,
+	/** one scale and offset per vector (column of the matrix) */
+	QS_PER_COLUMN = 1
+};
+
+/** @brief Dense features stored as 8 bit integers.
+ *
+ * Every entry of the num_features x num_vectors feature matrix is stored as
+ * an int8 value \f$q\f$ together with a float scale \f$s\f$ and offset
+ * \f$o\f$ that are shared by a row or by a column,
+ *
+ * \f[x \approx s q + o\f]
+ *
+ * Symmetric quantization maps \f$[-\max|x|, \max|x|]\f$ to
+ * \f$[-127, 127]\f$ and has no offset. Asymmetric quantization maps
+ * \f$[\min x, \max x]\f$ to the full \f$[-128, 127]\f$ range, which is the
+ * same as uint8 storage with a zero point.
+ *
+ * The dot products never dequantize a whole vector. The scales and offsets
+ * are factored out of the sums, so the inner loops run over the int8 values
+ * only and the matrix is 8 times smaller than the float64 one.
+ */
+class CQuantizedDenseFeatures : public CDotFeatures
+{
+	public:
+		/** default constructor */
+		CQuantizedDenseFeatures();
+
+		/** quantize dense features
+		 *
+		 * @param features features to quantize
+		 * @param scale_type whether rows or columns share a scale
+		 * @param symmetric symmetric or asymmetric quantization
+		 */
+		CQuantizedDenseFeatures(CDenseFeatures<float64_t>* features,
+				EQuantizationScale scale_type=QS_PER_ROW, bool symmetric=true);
+
+		/** copy constructor */
+		CQuantizedDenseFeatures(const CQuantizedDenseFeatures& orig);
+
+		/** destructor */
+		virtual ~CQuantizedDenseFeatures();
+
+		/** quantize dense features, replaces the current data
+		 *
+		 * @param features features to quantize
+		 * @param scale_type whether rows or columns share a scale
+		 * @param symmetric symmetric or asymmetric quantization
+		 */
+		void quantize(CDenseFeatures<float64_t>* features,
+				EQuantizationScale scale_type=QS_PER_ROW, bool symmetric=true);
+
+		/** get the int8 matrix
+		 *
+		 * @return num_features x num_vectors matrix of quantized values
+		 */
+		SGMatrix<int8_t> get_quantized_matrix() const { return m_quantized; }
+
+		/** get the scales, one per row or one per column
+		 *
+		 * @return scales
+		 */
+		SGVector<float32_t> get_scales() const { return m_scales; }
+
+		/** get the offsets, one per row or one per column
+		 *
+		 * @return offsets
+		 */
+		SGVector<float32_t> get_offsets() const { return m_offsets; }
+
+		/** get the largest absolute quantization error of every feature
+		 * dimension, as measured on the quantized data
+		 *
+		 * @return errors of length num_features
+		 */
+		SGVector<float64_t> get_feature_errors() const { return m_feature_errors; }
+
+		/** @return whether rows or columns share a scale */
+		EQuantizationScale get_scale_type() const { return m_scale_type; }
+
+		/** @return whether the quantization is symmetric */
+		bool is_symmetric() const { return m_symmetric; }
+
+		/** @return number of features */
+		int32_t get_num_features() const { return m_quantized.num_rows; }
+
+		/** get the dequantized feature vector
+		 *
+		 * possible with subset
+		 *
+		 * @param num index of feature vector
+		 * @return dequantized copy of the vector
+		 */
+		SGVector<float64_t> get_feature_vector(int32_t num) const;
+
+		/** dequantize all features
+		 *
+		 * not possible with subset
+		 *
+		 * @return dense float64 features
+		 */
+		CDenseFeatures<float64_t>* dequantize() const;
+
+		virtual int32_t get_dim_feature_space() const;
+
+		/** compute dot product between vector1 and vector2,
+		 * appointed by their indices
+		 *
+		 * possible with subset
+		 *
+		 * @param vec_idx1 index of first vector
+		 * @param df CQuantizedDenseFeatures to compute dot product with
+		 * @param vec_idx2 index of second vector
+		 */
+		virtual float64_t dot(int32_t vec_idx1, CDotFeatures* df,
+				int32_t vec_idx2);
+
+		/** compute dot product between vector1 and a dense vector
+		 *
+		 * possible with subset
+		 *
+		 * @param vec_idx1 index of first vector
+		 * @param vec2 pointer to real valued vector
+		 * @param vec2_len length of real valued vector
+		 */
+		virtual float64_t dense_dot(int32_t vec_idx1, const float64_t* vec2,
+				int32_t vec2_len);
+
+		/** add vector 1 multiplied with alpha to dense vector2
+		 *
+		 * possible with subset
+		 *
+		 * @param alpha scalar alpha
+		 * @param vec_idx1 index of first vector
+		 * @param vec2 pointer to real valued vector
+		 * @param vec2_len length of real valued vector
+		 * @param abs_val if true add the absolute value
+		 */
+		virtual void add_to_dense_vec(float64_t alpha, int32_t vec_idx1,
+				float64_t* vec2, int32_t vec2_len, bool abs_val=false);
+
+		/** Compute the dot product for a range of vectors. The scales and
+		 * offsets are folded into vec once, every vector then costs a
+		 * single pass over its int8 values.
+		 *
+		 * @param output result for the given vector range
+		 * @param start start vector range from this idx
+		 * @param stop stop vector range at this idx
+		 * @param alphas scalars to multiply with, may be NULL
+		 * @param vec dense vector to compute dot product with
+		 * @param dim length of the dense vector
+		 * @param b bias
+		 */
+		virtual void dense_dot_range(float64_t* output, int32_t start,
+				int32_t stop, float64_t* alphas, float64_t* vec, int32_t dim,
+				float64_t b);
+
+		virtual int32_t get_nnz_features_for_vector(int32_t num);
+
+		virtual void* get_feature_iterator(int32_t vector_index);
+
+		virtual bool get_next_feature(int32_t& index, float64_t& value,
+				void* iterator);
+
+		virtual void free_feature_iterator(void* iterator);
+
+		virtual CFeatures* duplicate() const;
+
+		/** @return F_CHAR, the signed 8 bit type */
+		virtual EFeatureType get_feature_type() const;
+
+		/** @return C_QUANTIZED_DENSE */
+		virtual EFeatureClass get_feature_class() const;
+
+		virtual int32_t get_num_vectors() const;
+
+		/** @return object name */
+		virtual const char* get_name() const { return "QuantizedDenseFeatures"; }
+
+	private:
+		/** register parameters */
+		void init();
+
+		/** pointer to the int8 values of a vector, resolves subsets */
+		const int8_t* get_quantized_vector(int32_t num, int32_t& real_num) const;
+
+		/** scale of entry (row, col) */
+		float32_t scale(index_t row, index_t col) const
+		{
+			return m_scales[m_scale_type==QS_PER_ROW ? row : col];
+		}
+
+		/** offset of entry (row, col) */
+		float32_t offset(index_t row, index_t col) const
+		{
+			return m_offsets[m_scale_type==QS_PER_ROW ? row : col];
+		}
+
+	protected:
+		/** num_features x num_vectors quantized values */
+		SGMatrix<int8_t> m_quantized;
+
+		/** scale per row or per column */
+		SGVector<float32_t> m_scales;
+
+		/** offset per row or per column */
+		SGVector<float32_t> m_offsets;
+
+		/** largest absolute error per feature dimension */
+		SGVector<float64_t> m_feature_errors;
+
+		/** whether rows or columns share a scale */
+		EQuantizationScale m_scale_type;
+
+		/** symmetric or asymmetric quantization */
+		bool m_symmetric;
+};
+}
+#endif // _QUANTIZEDDENSEFEATURES_H___
@@ -85,16 +85,15 @@ float64_t CRandomFourierDotFeatures::post_dot(float64_t dot_result, index_t par_
 SGVector<float64_t> CRandomFourierDotFeatures::generate_random_parameter_vector()
 {
 	SGVector<float64_t> vec(feats->get_dim_feature_space()+1);
+	// one draw from the global generator seeds the whole vector
+	RandomStream rng(CMath::random());
 	switch (kernel)
 	{
 		case GAUSSIAN:
-			for (index_t i=0; i<vec.vlen-1; i++)
-			{
-				vec[i] = CMath::sqrt((float64_t) 1/kernel_params[0]) *
-							CMath::sqrt(2.0) * CMath::normal_random(0.0, 1);
-			}
+			rng.fill_array_normal(vec.vector, vec.vlen-1, 0.0,
+					CMath::sqrt(2.0/kernel_params[0]));
 
-			vec[vec.vlen-1] = CMath::random(0.0, 2 * CMath::PI);
+			vec[vec.vlen-1] = rng.random(0.0, 2 * CMath::PI);
 			break;
 
 		default:
@@ -173,21 +173,27 @@ template<class ST> void CSparseFeatures<ST>::add_to_dense_vec(float64_t alpha, i
 
 	if (sv.features)
 	{
-		if (abs_val)
+		// as in dense_dot, four products are formed independently, they are
+		// stored in order since feature indices may repeat
+		float64_t val[4];
+		int32_t i=0;
+
+		for (; i+4<=sv.num_feat_entries; i+=4)
 		{
-			for (int32_t i=0; i<sv.num_feat_entries; i++)
+			for (int32_t k=0; k<4; k++)
 			{
-				vec[sv.features[i].feat_index]+=alpha
-					*CMath::abs(sv.features[i].entry);
+				ST entry=sv.features[i+k].entry;
+				val[k]=alpha*(abs_val ? CMath::abs(entry) : entry);
 			}
+
+			for (int32_t k=0; k<4; k++)
+				vec[sv.features[i+k].feat_index]+=val[k];
 		}
-		else
+
+		for (; i<sv.num_feat_entries; i++)
 		{
-			for (int32_t i=0; i<sv.num_feat_entries; i++)
-			{
-				vec[sv.features[i].feat_index]+=alpha
-						*sv.features[i].entry;
-			}
+			ST entry=sv.features[i].entry;
+			vec[sv.features[i].feat_index]+=alpha*(abs_val ? CMath::abs(entry) : entry);
 		}
 	}
 
@@ -497,16 +503,39 @@ template<class ST> float64_t CSparseFeatures<ST>::dense_dot(int32_t vec_idx1, co
 
 	if (sv.features)
 	{
-		REQUIRE(get_num_features() >= sv.get_num_dimensions(),
+		// the dimension check is done in the same pass as the product
+		int32_t max_index=-1;
+		float64_t sum[4]={0, 0, 0, 0};
+		int32_t i=0;
+
+		for (; i+4<=sv.num_feat_entries; i+=4)
+		{
+			for (int32_t k=0; k<4; k++)
+			{
+				int32_t idx=sv.features[i+k].feat_index;
+				max_index=CMath::max(max_index, idx);
+				if (idx<vec2_len)
+					sum[k]+=vec2[idx]*sv.features[i+k].entry;
+			}
+		}
+
+		for (; i<sv.num_feat_entries; i++)
+		{
+			int32_t idx=sv.features[i].feat_index;
+			max_index=CMath::max(max_index, idx);
+			if (idx<vec2_len)
+				sum[0]+=vec2[idx]*sv.features[i].entry;
+		}
+
+		REQUIRE(get_num_features() > max_index,
 			"sparse_matrix[%d] check failed (matrix features %d >= vector dimension %d)\n",
-			vec_idx1, get_num_features(), sv.get_num_dimensions());
+			vec_idx1, get_num_features(), max_index+1);
 
-		REQUIRE(vec2_len >= sv.get_num_dimensions(),
+		REQUIRE(vec2_len > max_index,
 			"sparse_matrix[%d] check failed (dense vector dimension %d >= vector dimension %d)\n",
-			vec_idx1, vec2_len, sv.get_num_dimensions());
+			vec_idx1, vec2_len, max_index+1);
 
-		for (int32_t i=0; i<sv.num_feat_entries; i++)
-			result+=vec2[sv.features[i].feat_index]*sv.features[i].entry;
+		result=(sum[0]+sum[1])+(sum[2]+sum[3]);
 	}
 
 	free_sparse_feature_vector(vec_idx1);
@@ -521,6 +550,81 @@ template<> float64_t CSparseFeatures<complex128_t>::dense_dot(int32_t vec_idx1,
 	return 0.0;
 }
 
+template<class ST> void CSparseFeatures<ST>::dot_block(
+		SGMatrix<float64_t>& block, index_t lhs_start, index_t lhs_stop,
+		CDotFeatures* df, index_t rhs_start, index_t rhs_stop)
+{
+	ASSERT(df)
+	if (df->get_feature_class()!=get_feature_class() ||
+			df->get_feature_type()!=get_feature_type())
+	{
+		CDotFeatures::dot_block(block, lhs_start, lhs_stop, df, rhs_start,
+				rhs_stop);
+		return;
+	}
+
+	ASSERT(block.num_rows==lhs_stop-lhs_start)
+	ASSERT(block.num_cols==rhs_stop-rhs_start)
+	CSparseFeatures<ST>* sf=(CSparseFeatures<ST>*) df;
+	index_t dim=CMath::max(get_num_features(), sf->get_num_features());
+
+	index_t num_lhs=lhs_stop-lhs_start;
+	SGSparseVector<ST>* lhs_vectors=SG_MALLOC(SGSparseVector<ST>, num_lhs);
+	for (index_t i=0; i<num_lhs; i++)
+		lhs_vectors[i]=get_sparse_feature_vector(lhs_start+i);
+
+	// only the entries that were scattered are reset, so the accumulator is
+	// cleared once per call; large ones are fresh zero pages anyway
+	float64_t* accumulator=SG_CALLOC(float64_t, dim);
+
+	for (index_t j=rhs_start; j<rhs_stop; j++)
+	{
+		SGSparseVector<ST> bvec=sf->get_sparse_feature_vector(j);
+		for (index_t k=0; k<bvec.num_feat_entries; k++)
+			accumulator[bvec.features[k].feat_index]+=bvec.features[k].entry;
+
+		float64_t* result=block.get_column_vector(j-rhs_start);
+		for (index_t i=0; i<num_lhs; i++)
+		{
+			const SGSparseVectorEntry<ST>* features=lhs_vectors[i].features;
+			const index_t len=lhs_vectors[i].num_feat_entries;
+			float64_t sum[4]={0, 0, 0, 0};
+			index_t k=0;
+
+			for (; k+4<=len; k+=4)
+			{
+				sum[0]+=accumulator[features[k].feat_index]*features[k].entry;
+				sum[1]+=accumulator[features[k+1].feat_index]*features[k+1].entry;
+				sum[2]+=accumulator[features[k+2].feat_index]*features[k+2].entry;
+				sum[3]+=accumulator[features[k+3].feat_index]*features[k+3].entry;
+			}
+
+			for (; k<len; k++)
+				sum[0]+=accumulator[features[k].feat_index]*features[k].entry;
+
+			result[i]=(sum[0]+sum[1])+(sum[2]+sum[3]);
+		}
+
+		for (index_t k=0; k<bvec.num_feat_entries; k++)
+			accumulator[bvec.features[k].feat_index]=0;
+
+		sf->free_sparse_feature_vector(j);
+	}
+
+	SG_FREE(accumulator);
+
+	for (index_t i=0; i<num_lhs; i++)
+		free_sparse_feature_vector(lhs_start+i);
+	SG_FREE(lhs_vectors);
+}
+
+template<> void CSparseFeatures<complex128_t>::dot_block(
+		SGMatrix<float64_t>& block, index_t lhs_start, index_t lhs_stop,
+		CDotFeatures* df, index_t rhs_start, index_t rhs_stop)
+{
+	SG_NOTIMPLEMENTED;
+}
+
 template<class ST> void* CSparseFeatures<ST>::get_feature_iterator(int32_t vector_index)
 {
 	if (vector_index>=get_num_vectors())
@@ -571,18 +675,27 @@ template<class ST> void CSparseFeatures<ST>::free_feature_iterator(void* iterato
 
 template<class ST> CFeatures* CSparseFeatures<ST>::copy_subset(SGVector<index_t> indices)
 {
+	/* the copy is stored compressed, so it does not share vectors which may
+	 * be views into the block of entries of this matrix */
+	SGVector<int64_t> offsets(indices.vlen+1);
+	offsets[0]=0;
+	for (index_t i=0; i<indices.vlen; ++i)
+	{
+		offsets[i+1]=offsets[i]+get_nnz_features_for_vector(indices.vector[i]);
+	}
+
 	SGSparseMatrix<ST> matrix_copy=SGSparseMatrix<ST>(get_dim_feature_space(),
-			indices.vlen);
+			offsets);
 
 	for (index_t i=0; i<indices.vlen; ++i)
 	{
 		/* index to copy */
 		index_t index=indices.vector[i];
-		index_t real_index=m_subset_stack->subset_idx_conversion(index);
 
 		/* copy sparse vector */
-		SGSparseVector<ST> current=get_sparse_feature_vector(real_index);
-		matrix_copy.sparse_matrix[i]=current;
+		SGSparseVector<ST> current=get_sparse_feature_vector(index);
+		sg_memcpy(matrix_copy.sparse_matrix[i].features, current.features,
+				sizeof(SGSparseVectorEntry<ST>)*current.num_feat_entries);
 
 		free_sparse_feature_vector(index);
 	}
@@ -412,6 +412,28 @@ template <class ST> class CSparseFeatures : public CDotFeatures
 		 */
 		virtual float64_t dense_dot(int32_t vec_idx1, const float64_t* vec2, int32_t vec2_len);
 
+		/** compute the dot products between the vectors
+		 * [lhs_start, lhs_stop) of these features and the vectors
+		 * [rhs_start, rhs_stop) of df
+		 *
+		 * Every vector of df is scattered into a dense accumulator once,
+		 * the dot products with all vectors of this block are gathers from
+		 * it, so no sparse vectors have to be merged.
+		 *
+		 * possible with subset of this instance and of DotFeatures
+		 *
+		 * @param block column-major result of size
+		 * (lhs_stop-lhs_start)x(rhs_stop-rhs_start)
+		 * @param lhs_start first vector of these features
+		 * @param lhs_stop one past the last vector of these features
+		 * @param df DotFeatures (of same kind) to compute dot products with
+		 * @param rhs_start first vector of df
+		 * @param rhs_stop one past the last vector of df
+		 */
+		virtual void dot_block(SGMatrix<float64_t>& block,
+				index_t lhs_start, index_t lhs_stop, CDotFeatures* df,
+				index_t rhs_start, index_t rhs_stop);
+
 		#ifndef DOXYGEN_SHOULD_SKIP_THIS
 		/** iterator for sparse features */
 		struct sparse_feature_iterator
@@ -94,15 +94,49 @@ template<class ST> CStringFeatures<ST>::CStringFeatures(const CStringFeatures &
 	alphabet=orig.alphabet;
 	SG_REF(alphabet);
 
+	/* init() has reset these */
+	num_vectors=orig.num_vectors;
+	max_string_length=orig.max_string_length;
+	num_symbols=orig.num_symbols;
+	original_num_symbols=orig.original_num_symbols;
+	order=orig.order;
+
 	if (orig.features)
 	{
 		features=SG_MALLOC(SGString<ST>, orig.num_vectors);
 
-		for (int32_t i=0; i<num_vectors; i++)
+		if (orig.m_packed_bits)
 		{
-			features[i].string=SG_MALLOC(ST, orig.features[i].slen);
-			features[i].slen=orig.features[i].slen;
-			sg_memcpy(features[i].string, orig.features[i].string, sizeof(ST)*orig.features[i].slen);
+			int32_t per_byte=8/orig.m_packed_bits;
+			int64_t num_bytes=(orig.m_packed_offsets[num_vectors]+per_byte-1)/per_byte;
+
+			m_packed_offsets=SG_MALLOC(int64_t, num_vectors+1);
+			sg_memcpy(m_packed_offsets, orig.m_packed_offsets, sizeof(int64_t)*(num_vectors+1));
+			m_packed_symbols=SG_MALLOC(uint8_t, num_bytes);
+			sg_memcpy(m_packed_symbols, orig.m_packed_symbols, num_bytes);
+			m_packed_bits=orig.m_packed_bits;
+
+			for (int32_t i=0; i<num_vectors; i++)
+			{
+				features[i].string=NULL;
+				features[i].slen=orig.features[i].slen;
+			}
+		}
+		else
+		{
+			m_symbol_pool_length=0;
+			for (int32_t i=0; i<num_vectors; i++)
+				m_symbol_pool_length+=orig.features[i].slen;
+			m_symbol_pool=SG_MALLOC(ST, m_symbol_pool_length);
+
+			int64_t offs=0;
+			for (int32_t i=0; i<num_vectors; i++)
+			{
+				features[i].string=m_symbol_pool+offs;
+				features[i].slen=orig.features[i].slen;
+				sg_memcpy(features[i].string, orig.features[i].string, sizeof(ST)*orig.features[i].slen);
+				offs+=features[i].slen;
+			}
 		}
 	}
 
@@ -145,6 +179,10 @@ template<class ST> void CStringFeatures<ST>::cleanup()
 {
 	remove_all_subsets();
 
+	/* packed strings have no memory of their own */
+	if (m_packed_bits)
+		free_symbol_storage();
+
 	if (single_string)
 	{
 		SG_FREE(single_string);
@@ -153,6 +191,8 @@ template<class ST> void CStringFeatures<ST>::cleanup()
 	else
 		cleanup_feature_vectors(0, num_vectors-1);
 
+	free_symbol_storage();
+
 	/*
 	if (single_string)
 	{
@@ -185,8 +225,10 @@ template<class ST> void CStringFeatures<ST>::cleanup_feature_vector(int32_t num)
 
 	if (features)
 	{
+		/* pooled strings are left in the symbol pool */
 		int32_t real_num=m_subset_stack->subset_idx_conversion(num);
-		SG_FREE(features[real_num].string);
+		if (!is_pooled(features[real_num].string))
+			SG_FREE(features[real_num].string);
 		features[real_num].string=NULL;
 		features[real_num].slen=0;
 
@@ -204,7 +246,8 @@ template<class ST> void CStringFeatures<ST>::cleanup_feature_vectors(int32_t sta
 		for (int32_t i=start; i<=stop; i++)
 		{
 			int32_t real_num=m_subset_stack->subset_idx_conversion(i);
-			SG_FREE(features[real_num].string);
+			if (!is_pooled(features[real_num].string))
+				SG_FREE(features[real_num].string);
 			features[real_num].string=NULL;
 			features[real_num].slen=0;
 		}
@@ -227,6 +270,23 @@ template<class ST> CFeatures* CStringFeatures<ST>::duplicate() const
 	return new CStringFeatures<ST>(*this);
 }
 
+template<class ST> CSGObject* CStringFeatures<ST>::clone()
+{
+	/* the registered parameters only describe unpacked strings */
+	bool packed=m_packed_bits!=0;
+	unpack();
+
+	CStringFeatures<ST>* copy=(CStringFeatures<ST>*) CFeatures::clone();
+
+	if (packed)
+	{
+		pack();
+		copy->pack();
+	}
+
+	return copy;
+}
+
 template<class ST> SGVector<ST> CStringFeatures<ST>::get_feature_vector(int32_t num)
 {
 	ASSERT(features)
@@ -261,6 +321,7 @@ template<class ST> void CStringFeatures<ST>::set_feature_vector(SGVector<ST> vec
 	if (vector.vlen<=0)
 		SG_ERROR("String has zero or negative length\n")
 
+	unpack();
 	cleanup_feature_vector(num);
 	features[num].slen=vector.vlen;
 	features[num].string=SG_MALLOC(ST, vector.vlen);
@@ -289,8 +350,26 @@ template<class ST> ST* CStringFeatures<ST>::get_feature_vector(int32_t num, int3
 
 	if (!preprocess_on_get)
 	{
-		dofree=false;
 		len=features[real_num].slen;
+
+		if (m_packed_bits)
+		{
+			ST* feat=SG_MALLOC(ST, len);
+			decode_string(real_num, feat);
+			dofree=true;
+			return feat;
+		}
+
+		/* memory mapped strings are read-only */
+		if (m_mapped_file && is_pooled(features[real_num].string))
+		{
+			ST* feat=SG_MALLOC(ST, len);
+			sg_memcpy(feat, features[real_num].string, len*sizeof(ST));
+			dofree=true;
+			return feat;
+		}
+
+		dofree=false;
 		return features[real_num].string;
 	}
 	else
@@ -412,6 +491,13 @@ template<class ST> int32_t CStringFeatures<ST>::get_vector_length(int32_t vec_nu
 {
 	ASSERT(vec_num<get_num_vectors())
 
+	/* no need to (decode and) look at the string */
+	if (!preprocess_on_get)
+	{
+		ASSERT(features)
+		return features[m_subset_stack->subset_idx_conversion(vec_num)].slen;
+	}
+
 	int32_t len;
 	bool free_vec;
 	ST* vec=get_feature_vector(vec_num, len, free_vec);
@@ -612,6 +698,7 @@ template<class ST> bool CStringFeatures<ST>::load_fasta_file(const char* fname,
 	uint64_t offs=0;
 	int32_t num=0;
 	int32_t max_len=0;
+	int64_t pool_length=0;
 
 	CMemoryMappedFile<char> f(fname);
 
@@ -623,6 +710,8 @@ template<class ST> bool CStringFeatures<ST>::load_fasta_file(const char* fname,
 
 		if (len>0 && s[0]=='>')
 			num++;
+		else
+			pool_length+=len;
 	}
 
 	if (num==0)
@@ -634,6 +723,8 @@ template<class ST> bool CStringFeatures<ST>::load_fasta_file(const char* fname,
 	num_symbols=alphabet->get_num_symbols();
 
 	SGString<ST>* strings=SG_MALLOC(SGString<ST>, num);
+	ST* pool=SG_MALLOC(ST, pool_length);
+	int64_t pool_offs=0;
 	offs=0;
 
 	for (i=0;i<num; i++)
@@ -661,8 +752,11 @@ template<class ST> bool CStringFeatures<ST>::load_fasta_file(const char* fname,
 				}
 
 				len=fasta_len-spanned_lines;
-				strings[i].string=SG_MALLOC(ST, len);
+				if (pool_offs+int64_t(len)>pool_length)
+					SG_ERROR("Error reading fasta entry %d, symbols exceed file contents\n", i)
+				strings[i].string=pool+pool_offs;
 				strings[i].slen=len;
+				pool_offs+=len;
 
 				ST* str=strings[i].string;
 				int32_t idx=0;
@@ -693,7 +787,19 @@ template<class ST> bool CStringFeatures<ST>::load_fasta_file(const char* fname,
 			s=f.get_line(len, offs);
 		}
 	}
-	return set_features(strings, num, max_len);
+
+	if (!set_features(strings, num, max_len))
+	{
+		SG_FREE(strings);
+		SG_FREE(pool);
+		return false;
+	}
+	SG_FREE(strings);
+
+	m_symbol_pool=pool;
+	m_symbol_pool_length=pool_length;
+
+	return true;
 }
 
 template<class ST> bool CStringFeatures<ST>::load_fastq_file(const char* fname,
@@ -719,6 +825,9 @@ template<class ST> bool CStringFeatures<ST>::load_fastq_file(const char* fname,
 	alphabet=new CAlphabet(DNA);
 
 	SGString<ST>* strings;
+	ST* pool=NULL;
+	int64_t pool_length=0;
+	int64_t pool_offs=0;
 
 	ST* str=NULL;
 	if (bitremap_in_single_string)
@@ -735,8 +844,22 @@ template<class ST> bool CStringFeatures<ST>::load_fastq_file(const char* fname,
 		str=SG_MALLOC(ST, len);
 	}
 	else
+	{
 		strings=SG_MALLOC(SGString<ST>, num);
 
+		/* reads are stored back to back */
+		for (i=0; i<num; i++)
+		{
+			f.get_line(len, offs);
+			if (f.get_line(len, offs))
+				pool_length+=len;
+			f.get_line(len, offs);
+			f.get_line(len, offs);
+		}
+		pool=SG_MALLOC(ST, pool_length);
+		offs=0;
+	}
+
 	for (i=0;i<num; i++)
 	{
 		if (!f.get_line(len, offs))
@@ -757,8 +880,11 @@ template<class ST> bool CStringFeatures<ST>::load_fastq_file(const char* fname,
 		}
 		else
 		{
-			strings[i].string=SG_MALLOC(ST, len);
+			if (pool_offs+int64_t(len)>pool_length)
+				SG_ERROR("Error reading 'read' in line %d, symbols exceed file contents\n", 4*i+1)
+			strings[i].string=pool+pool_offs;
 			strings[i].slen=len;
+			pool_offs+=len;
 			str=strings[i].string;
 
 			if (ignore_invalid)
@@ -793,6 +919,8 @@ template<class ST> bool CStringFeatures<ST>::load_fastq_file(const char* fname,
 	num_vectors=num;
 	max_string_length=max_len;
 	features=strings;
+	m_symbol_pool=pool;
+	m_symbol_pool_length=pool_length;
 
 	return true;
 }
@@ -959,7 +1087,10 @@ template<class ST> bool CStringFeatures<ST>::append_features(CStringFeatures<ST>
 		int32_t real_i = sf->m_subset_stack->subset_idx_conversion(i);
 		int32_t length=sf->features[real_i].slen;
 		new_features[i].string=SG_MALLOC(ST, length);
-		sg_memcpy(new_features[i].string, sf->features[real_i].string, length);
+		if (sf->m_packed_bits)
+			sf->decode_string(real_i, new_features[i].string);
+		else
+			sg_memcpy(new_features[i].string, sf->features[real_i].string, sizeof(ST)*length);
 		new_features[i].slen=length;
 	}
 	return append_features(new_features, sf_num_str,
@@ -974,6 +1105,8 @@ template<class ST> bool CStringFeatures<ST>::append_features(SGString<ST>* p_fea
 	if (!features)
 		return set_features(p_features, p_num_vectors, p_max_string_length);
 
+	make_strings_writable();
+
 	CAlphabet* alpha=new CAlphabet(alphabet->get_alphabet());
 
 	//compute histogram for char/byte
@@ -1032,6 +1165,8 @@ template<class ST> SGString<ST>* CStringFeatures<ST>::get_features(int32_t& num_
 	if (m_subset_stack->has_subsets())
 		SG_ERROR("get features() is not possible on subset")
 
+	make_strings_writable();
+
 	num_str=num_vectors;
 	max_str_len=max_string_length;
 	return features;
@@ -1251,6 +1386,13 @@ template<class ST> int32_t CStringFeatures<ST>::obtain_by_sliding_window(int32_t
 	if (m_subset_stack->has_subsets())
 		SG_NOTIMPLEMENTED
 
+	/* the windows point into the first string, which must be freeable */
+	if (!single_string)
+	{
+		make_strings_writable();
+		release_symbol_pool();
+	}
+
 	ASSERT(step_size>0)
 	ASSERT(window_size>0)
 	ASSERT(num_vectors==1 || single_string)
@@ -1289,6 +1431,13 @@ template<class ST> int32_t CStringFeatures<ST>::obtain_by_position_list(int32_t
 	if (m_subset_stack->has_subsets())
 		SG_NOTIMPLEMENTED
 
+	/* the windows point into the first string, which must be freeable */
+	if (!single_string)
+	{
+		make_strings_writable();
+		release_symbol_pool();
+	}
+
 	ASSERT(positions)
 	ASSERT(window_size>0)
 	ASSERT(num_vectors==1 || single_string)
@@ -1372,6 +1521,8 @@ template<class ST> void CStringFeatures<ST>::embed_features(int32_t p_order)
 
 	ASSERT(alphabet->get_num_symbols_in_histogram() > 0)
 
+	make_strings_writable();
+
 	order=p_order;
 	original_num_symbols=alphabet->get_num_symbols();
 	int32_t max_val=alphabet->get_num_bits();
@@ -1502,6 +1653,8 @@ template<class ST> void CStringFeatures<ST>::set_feature_vector(int32_t num, ST*
 	ASSERT(features)
 	ASSERT(num<get_num_vectors())
 
+	unpack();
+
 	int32_t real_num=m_subset_stack->subset_idx_conversion(num);
 
 
@@ -1670,8 +1823,13 @@ template<class ST> CFeatures* CStringFeatures<ST>::copy_subset(
 		/* copy string */
 		SGString<ST> current_string=features[real_idx];
 		SGString<ST> string_copy(current_string.slen);
-		sg_memcpy(string_copy.string, current_string.string,
-			current_string.slen*sizeof(ST));
+		if (m_packed_bits)
+			decode_string(real_idx, string_copy.string);
+		else
+		{
+			sg_memcpy(string_copy.string, current_string.string,
+				current_string.slen*sizeof(ST));
+		}
 		list_copy.strings[i]=string_copy;
 	}
 
@@ -1707,10 +1865,354 @@ template<class ST> ST* CStringFeatures<ST>::compute_feature_vector(int32_t num,
 		return NULL;
 
 	ST* target=SG_MALLOC(ST, len);
-	sg_memcpy(target, features[real_num].string, len*sizeof(ST));
+	if (m_packed_bits)
+		decode_string(real_num, target);
+	else
+		sg_memcpy(target, features[real_num].string, len*sizeof(ST));
 	return target;
 }
 
+template<class ST> void CStringFeatures<ST>::compact()
+{
+	REQUIRE(single_string==NULL,
+		"Strings obtained by sliding window cannot be compacted\n");
+
+	if (!features)
+		return;
+
+	int64_t pool_length=0;
+	for (int32_t i=0; i<num_vectors; i++)
+		pool_length+=features[i].slen;
+
+	ST* pool=SG_MALLOC(ST, pool_length);
+	int64_t offs=0;
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		ST* str=pool+offs;
+
+		if (m_packed_bits)
+			decode_string(i, str);
+		else
+		{
+			sg_memcpy(str, features[i].string, sizeof(ST)*features[i].slen);
+			if (!is_pooled(features[i].string))
+				SG_FREE(features[i].string);
+		}
+
+		features[i].string=str;
+		offs+=features[i].slen;
+	}
+
+	free_symbol_storage();
+	m_symbol_pool=pool;
+	m_symbol_pool_length=pool_length;
+}
+
+template<class ST> bool CStringFeatures<ST>::pack()
+{
+	REQUIRE(single_string==NULL,
+		"Strings obtained by sliding window cannot be packed\n");
+
+	if (m_packed_bits)
+		return true;
+
+	if (!features)
+		return false;
+
+	int32_t bits;
+	if (alphabet->get_num_symbols()<=4)
+		bits=2;
+	else if (alphabet->get_num_symbols()<=16)
+		bits=4;
+	else
+		return false;
+
+	int32_t per_byte=8/bits;
+	int64_t* offsets=SG_MALLOC(int64_t, num_vectors+1);
+	offsets[0]=0;
+	for (int32_t i=0; i<num_vectors; i++)
+		offsets[i+1]=offsets[i]+features[i].slen;
+
+	uint8_t* packed=SG_CALLOC(uint8_t, (offsets[num_vectors]+per_byte-1)/per_byte);
+
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		ST* str=features[i].string;
+		int64_t pos=offsets[i];
+
+		for (int32_t j=0; j<features[i].slen; j++, pos++)
+		{
+			uint8_t code=alphabet->remap_to_bin((uint8_t) str[j]);
+
+			/* symbol is not part of the alphabet (or differs in case) */
+			if (code>=(1<<bits) || (ST) alphabet->remap_to_char(code)!=str[j])
+			{
+				SG_DEBUG("string %d cannot be packed\n", i)
+				SG_FREE(offsets);
+				SG_FREE(packed);
+				return false;
+			}
+
+			packed[pos/per_byte]|=code<<((pos%per_byte)*bits);
+		}
+	}
+
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		if (!is_pooled(features[i].string))
+			SG_FREE(features[i].string);
+		features[i].string=NULL;
+	}
+
+	free_symbol_storage();
+	m_packed_symbols=packed;
+	m_packed_offsets=offsets;
+	m_packed_bits=bits;
+
+	return true;
+}
+
+template<class ST> void CStringFeatures<ST>::unpack()
+{
+	if (m_packed_bits)
+		compact();
+}
+
+template<class ST> bool CStringFeatures<ST>::save_contiguous_file(const char* fname)
+{
+	if (m_subset_stack->has_subsets())
+		SG_ERROR("save_contiguous_file() is not possible on subset")
+
+	/* strings cleaned up after packing no longer match the packed offsets */
+	for (int32_t i=0; m_packed_bits && i<num_vectors; i++)
+	{
+		if (features[i].slen!=m_packed_offsets[i+1]-m_packed_offsets[i])
+			unpack();
+	}
+
+	FILE* file=fopen(fname, "wb");
+	if (!file)
+	{
+		SG_WARNING("Could not open file '%s' for writing\n", fname)
+		return false;
+	}
+
+	int32_t num=features ? num_vectors : 0;
+	uint8_t header[8]={'S', 'G', 'S', 'P', 0, (uint8_t) alphabet->get_alphabet(),
+		(uint8_t) m_packed_bits, (uint8_t) sizeof(ST)};
+
+	bool ok=fwrite(header, sizeof(header), 1, file)==1 &&
+		fwrite(&num, sizeof(num), 1, file)==1 &&
+		fwrite(&max_string_length, sizeof(max_string_length), 1, file)==1;
+
+	if (m_packed_bits)
+	{
+		int32_t per_byte=8/m_packed_bits;
+		int64_t num_bytes=(m_packed_offsets[num]+per_byte-1)/per_byte;
+
+		ok=ok && fwrite(m_packed_offsets, sizeof(int64_t), num+1, file)==size_t(num+1);
+		ok=ok && fwrite(m_packed_symbols, 1, num_bytes, file)==size_t(num_bytes);
+	}
+	else
+	{
+		int64_t offs=0;
+		ok=ok && fwrite(&offs, sizeof(offs), 1, file)==1;
+		for (int32_t i=0; i<num && ok; i++)
+		{
+			offs+=features[i].slen;
+			ok=fwrite(&offs, sizeof(offs), 1, file)==1;
+		}
+
+		for (int32_t i=0; i<num && ok; i++)
+		{
+			ok=fwrite(features[i].string, sizeof(ST), features[i].slen, file)==
+				size_t(features[i].slen);
+		}
+	}
+
+	if (fclose(file)!=0)
+		ok=false;
+
+	if (!ok)
+		SG_WARNING("Error writing file '%s'\n", fname)
+
+	return ok;
+}
+
+template<class ST> bool CStringFeatures<ST>::load_contiguous_file(const char* fname)
+{
+	remove_all_subsets();
+
+	CMemoryMappedFile<uint8_t>* file=new CMemoryMappedFile<uint8_t>(fname);
+	SG_REF(file);
+
+	uint8_t* map=file->get_map();
+	uint64_t size=file->get_size();
+	const uint64_t header_size=16;
+
+	int32_t num=0;
+	int32_t max_len=0;
+	if (size>=header_size)
+	{
+		sg_memcpy(&num, map+8, sizeof(num));
+		sg_memcpy(&max_len, map+12, sizeof(max_len));
+	}
+
+	if (size<header_size || memcmp(map, "SGSP", 4)!=0 || map[4]!=0 ||
+			map[7]!=sizeof(ST) || num<0 ||
+			size<header_size+sizeof(int64_t)*(uint64_t(num)+1))
+	{
+		SG_WARNING("'%s' is not a contiguous string file of matching type\n", fname)
+		SG_UNREF(file);
+		return false;
+	}
+
+	int32_t bits=map[6];
+	int64_t* offsets=(int64_t*) (map+header_size);
+	uint8_t* data=map+header_size+sizeof(int64_t)*(uint64_t(num)+1);
+	int64_t data_size=bits ? (offsets[num]*bits+7)/8 : offsets[num]*sizeof(ST);
+
+	bool valid=(bits==0 || bits==2 || bits==4) && offsets[0]==0 &&
+		uint64_t(data-map)+data_size<=size;
+	for (int32_t i=0; i<num && valid; i++)
+	{
+		int64_t len=offsets[i+1]-offsets[i];
+		valid=len>=0 && len<=max_len;
+	}
+
+	if (!valid)
+	{
+		SG_WARNING("'%s' is truncated or corrupt\n", fname)
+		SG_UNREF(file);
+		return false;
+	}
+
+	cleanup();
+	CAlphabet* alpha=new CAlphabet((EAlphabet) map[5]);
+	SG_UNREF(alphabet);
+	alphabet=alpha;
+	SG_REF(alphabet);
+	num_symbols=alphabet->get_num_symbols();
+	original_num_symbols=num_symbols;
+
+	m_mapped_file=file;
+	if (bits)
+	{
+		m_packed_symbols=data;
+		m_packed_offsets=offsets;
+		m_packed_bits=bits;
+	}
+	else
+	{
+		m_symbol_pool=(ST*) data;
+		m_symbol_pool_length=offsets[num];
+	}
+
+	features=SG_MALLOC(SGString<ST>, num);
+	for (int32_t i=0; i<num; i++)
+	{
+		features[i].string=bits ? NULL : m_symbol_pool+offsets[i];
+		features[i].slen=offsets[i+1]-offsets[i];
+	}
+	num_vectors=num;
+	max_string_length=max_len;
+
+	if (bits)
+	{
+		ST* str=SG_MALLOC(ST, max_len);
+		for (int32_t i=0; i<num; i++)
+		{
+			decode_string(i, str);
+			alphabet->add_string_to_histogram(str, features[i].slen);
+		}
+		SG_FREE(str);
+	}
+	else
+		alphabet->add_string_to_histogram(m_symbol_pool, m_symbol_pool_length);
+
+	return true;
+}
+
+template<class ST> void CStringFeatures<ST>::save_serializable_pre() throw (ShogunException)
+{
+	CFeatures::save_serializable_pre();
+
+	unpack();
+}
+
+template<class ST> void CStringFeatures<ST>::load_serializable_pre() throw (ShogunException)
+{
+	CFeatures::load_serializable_pre();
+
+	if (!single_string)
+	{
+		make_strings_writable();
+		release_symbol_pool();
+	}
+}
+
+template<class ST> void CStringFeatures<ST>::decode_string(int32_t real_num, ST* dst) const
+{
+	int32_t per_byte=8/m_packed_bits;
+	uint8_t mask=(1<<m_packed_bits)-1;
+
+	ST table[16];
+	for (int32_t i=0; i<=mask; i++)
+		table[i]=(ST) alphabet->remap_to_char(i);
+
+	int64_t pos=m_packed_offsets[real_num];
+	int32_t len=features[real_num].slen;
+	for (int32_t j=0; j<len; j++, pos++)
+		dst[j]=table[(m_packed_symbols[pos/per_byte]>>((pos%per_byte)*m_packed_bits)) & mask];
+}
+
+template<class ST> bool CStringFeatures<ST>::is_pooled(const ST* str) const
+{
+	return m_symbol_pool && str>=m_symbol_pool &&
+		str<m_symbol_pool+m_symbol_pool_length;
+}
+
+template<class ST> void CStringFeatures<ST>::make_strings_writable()
+{
+	if (m_packed_bits || m_mapped_file)
+		compact();
+}
+
+template<class ST> void CStringFeatures<ST>::release_symbol_pool()
+{
+	if (!m_symbol_pool)
+		return;
+
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		if (is_pooled(features[i].string))
+		{
+			ST* str=SG_MALLOC(ST, features[i].slen);
+			sg_memcpy(str, features[i].string, sizeof(ST)*features[i].slen);
+			features[i].string=str;
+		}
+	}
+
+	free_symbol_storage();
+}
+
+template<class ST> void CStringFeatures<ST>::free_symbol_storage()
+{
+	if (!m_mapped_file)
+	{
+		SG_FREE(m_symbol_pool);
+		SG_FREE(m_packed_symbols);
+		SG_FREE(m_packed_offsets);
+	}
+	SG_UNREF(m_mapped_file);
+
+	m_symbol_pool=NULL;
+	m_symbol_pool_length=0;
+	m_packed_symbols=NULL;
+	m_packed_offsets=NULL;
+	m_packed_bits=0;
+}
+
 template<class ST> void CStringFeatures<ST>::init()
 {
 	set_generic<ST>();
@@ -1728,6 +2230,12 @@ template<class ST> void CStringFeatures<ST>::init()
 	symbol_mask_table_len=0;
 	num_symbols=0.0;
 	original_num_symbols=0;
+	m_symbol_pool=NULL;
+	m_symbol_pool_length=0;
+	m_packed_symbols=NULL;
+	m_packed_offsets=NULL;
+	m_packed_bits=0;
+	m_mapped_file=NULL;
 
 	m_parameters->add((CSGObject**) &alphabet, "alphabet");
 	m_parameters->add_vector(&features, &num_vectors, "features",
@@ -2002,6 +2510,7 @@ template<> void CStringFeatures<sg_type>::save(CFile* writer)		\
 		SG_ERROR("save() is not possible on subset")						\
 	SG_SET_LOCALE_C;													\
 	ASSERT(writer)															\
+	unpack();																\
 	writer->f_write(features, num_vectors);									\
 	SG_RESET_LOCALE;													\
 }
@@ -2039,6 +2548,12 @@ bool CStringFeatures<ST>::obtain_from_char_features(CStringFeatures<CT>* sf, int
 	max_string_length=sf->get_max_vector_length()-start;
 	features=SG_MALLOC(SGString<ST>, num_vectors);
 
+	m_symbol_pool_length=0;
+	for (int32_t i=0; i<num_vectors; i++)
+		m_symbol_pool_length+=sf->get_vector_length(i);
+	m_symbol_pool=SG_MALLOC(ST, m_symbol_pool_length);
+	int64_t pool_offs=0;
+
 	SG_DEBUG("%1.0llf symbols in StringFeatures<*> %d symbols in histogram\n", sf->get_num_symbols(),
 			alpha->get_num_symbols_in_histogram());
 
@@ -2047,14 +2562,16 @@ bool CStringFeatures<ST>::obtain_from_char_features(CStringFeatures<CT>* sf, int
 		int32_t len=-1;
 		bool vfree;
 		CT* c=sf->get_feature_vector(i, len, vfree);
-		ASSERT(!vfree) // won't work when preprocessors are attached
 
-		features[i].string=SG_MALLOC(ST, len);
+		features[i].string=m_symbol_pool+pool_offs;
 		features[i].slen=len;
+		pool_offs+=len;
 
 		ST* str=features[i].string;
 		for (int32_t j=0; j<len; j++)
 			str[j]=(ST) alpha->remap_to_bin(c[j]);
+
+		sf->free_feature_vector(c, i, vfree);
 	}
 
 	original_num_symbols=alpha->get_num_symbols();
@@ -32,6 +32,7 @@ template <class T> class CDynamicArray;
 class CFile;
 template <class T> class SGString;
 template <class T> class SGStringList;
+template <class T> class CMemoryMappedFile;
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 struct SSKDoubleFeature
@@ -67,6 +68,14 @@ struct SSKTripleFeature
  *
  * Also note that string features cannot currently be computed on-the-fly.
  *
+ * Strings that are loaded from fasta/fastq files or obtained from other
+ * string features are stored back to back in a single symbol pool instead of
+ * one allocation per string. For alphabets with at most 16 symbols (e.g. DNA)
+ * the pool can additionally be packed to 2 (or 4) bits per symbol using
+ * pack(); packed strings are decoded on access by get_feature_vector().
+ * The pool can be written to disk with save_contiguous_file() and be memory
+ * mapped again with load_contiguous_file().
+ *
  * (Partly) subset access is supported for this feature type.
  * Simple use the (inherited) add_subset(), remove_subset() functions.
  * If done, all calls that work with features are translated to the subset.
@@ -130,7 +139,8 @@ template <class ST> class CStringFeatures : public CFeatures
 
 		/** cleanup a single feature vector
 		 *
-		 * possible with subset
+		 * possible with subset. Strings in the symbol pool are not freed
+		 * and packed strings are not unpacked.
 		 *
 		 * @param num number of the vector
 		 */
@@ -138,7 +148,8 @@ template <class ST> class CStringFeatures : public CFeatures
 
 		/** cleanup multiple feature vectors
 		 *
-		 * possible with subset
+		 * possible with subset. Strings in the symbol pool are not freed
+		 * and packed strings are not unpacked.
 		 *
 		 * @param start index of first vector to be cleaned
 		 * @param stop index of the last vector to be cleaned
@@ -169,6 +180,12 @@ template <class ST> class CStringFeatures : public CFeatures
 		 */
 		virtual CFeatures* duplicate() const;
 
+		/** clone, packed strings stay packed in the clone
+		 *
+		 * @return cloned feature object
+		 */
+		virtual CSGObject* clone();
+
 		/** get string for selected example num
 		 *
 		 * possible with subset
@@ -199,6 +216,9 @@ template <class ST> class CStringFeatures : public CFeatures
 		 *
 		 * possible with subset
 		 *
+		 * Packed and memory mapped strings are returned as a copy (with
+		 * dofree set to true), as they cannot be modified in place.
+		 *
 		 * @param num index of feature vector
 		 * @param len length is returned by reference
 		 * @param dofree whether returned vector must be freed by
@@ -492,6 +512,50 @@ template <class ST> class CStringFeatures : public CFeatures
 		 */
 		virtual bool save_compressed(char* dest, E_COMPRESSION_TYPE compression, int level);
 
+		/** move all strings into a single contiguous symbol pool
+		 *
+		 * packed strings are unpacked, memory mapped strings are copied to
+		 * memory. Not possible for strings obtained by sliding window.
+		 */
+		void compact();
+
+		/** pack all strings to 2 bits per symbol (4 bits if the alphabet
+		 * has more than 4 but at most 16 symbols)
+		 *
+		 * Packing fails if the alphabet is too large or if a string contains
+		 * symbols that cannot be remapped to the alphabet losslessly. Not
+		 * possible for strings obtained by sliding window.
+		 *
+		 * @return if packing was successful
+		 */
+		bool pack();
+
+		/** unpack strings packed by pack() into a contiguous symbol pool */
+		void unpack();
+
+		/** @return number of bits per packed symbol, 0 if not packed */
+		int32_t get_packed_bits() const { return m_packed_bits; }
+
+		/** save strings in contiguous binary format (packed strings are
+		 * saved packed)
+		 *
+		 * not possible with subset
+		 *
+		 * @param fname filename to save to
+		 * @return if saving was successful
+		 */
+		bool save_contiguous_file(const char* fname);
+
+		/** memory map strings saved by save_contiguous_file()
+		 *
+		 * any subset is removed before. Strings stay mapped (read only)
+		 * until they are modified.
+		 *
+		 * @param fname filename to load from
+		 * @return if loading was successful
+		 */
+		bool load_contiguous_file(const char* fname);
+
 		/** apply preprocessor
 		 *
 		 * @param force_preprocessing if preprocssing shall be forced
@@ -666,9 +730,30 @@ template <class ST> class CStringFeatures : public CFeatures
 		 */
 		virtual ST* compute_feature_vector(int32_t num, int32_t& len);
 
+		/** unpacks strings before serialization */
+		virtual void save_serializable_pre() throw (ShogunException);
+
+		/** gives pooled strings their own memory before deserialization */
+		virtual void load_serializable_pre() throw (ShogunException);
+
 	private:
 		void init();
 
+		/** decode packed string real_num into dst */
+		void decode_string(int32_t real_num, ST* dst) const;
+
+		/** @return whether str points into the symbol pool */
+		bool is_pooled(const ST* str) const;
+
+		/** unpack packed and copy memory mapped strings */
+		void make_strings_writable();
+
+		/** give each pooled string its own allocation */
+		void release_symbol_pool();
+
+		/** free symbol pool, packed symbols and memory mapping */
+		void free_symbol_storage();
+
 	protected:
 		/** alphabet */
 		CAlphabet* alphabet;
@@ -708,6 +793,24 @@ template <class ST> class CStringFeatures : public CFeatures
 
 		/** feature cache */
 		CCache<ST>* feature_cache;
+
+		/** contiguous storage of (unpacked) strings */
+		ST* m_symbol_pool;
+
+		/** number of symbols in pool */
+		int64_t m_symbol_pool_length;
+
+		/** packed symbols */
+		uint8_t* m_packed_symbols;
+
+		/** offsets (in symbols) of packed strings, num_vectors+1 entries */
+		int64_t* m_packed_offsets;
+
+		/** bits per packed symbol, 0 if not packed */
+		int32_t m_packed_bits;
+
+		/** file that pool or packed symbols are mapped from */
+		CMemoryMappedFile<uint8_t>* m_mapped_file;
 };
 }
 #endif // _CSTRINGFEATURES__H__
@@ -0,0 +1,316 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/io/SerializableBinaryFile.h>
+#include <shogun/io/SerializableBinaryReader00.h>
+
+#define STR_HEADER_00                 \
+	"<<_SHOGUN_SERIALIZABLE_BINARY_FILE_V_00_>>"
+
+#define BYTE_ORDER_MARK               0x01020304
+
+using namespace shogun;
+
+CSerializableBinaryFile::CSerializableBinaryFile()
+	:CSerializableFile() { init(); }
+
+CSerializableBinaryFile::CSerializableBinaryFile(FILE* fstream, char rw)
+	:CSerializableFile(fstream, rw) { init(); }
+
+CSerializableBinaryFile::CSerializableBinaryFile(
+	const char* fname, char rw)
+	:CSerializableFile(fname, rw) { init(); }
+
+CSerializableBinaryFile::~CSerializableBinaryFile() {}
+
+bool
+CSerializableBinaryFile::write_bytes(const void* data, size_t num_bytes)
+{
+	if (num_bytes == 0) return true;
+
+	return fwrite(data, 1, num_bytes, m_fstream) == num_bytes;
+}
+
+bool
+CSerializableBinaryFile::read_bytes(void* data, size_t num_bytes)
+{
+	if (num_bytes == 0) return true;
+
+	return fread(data, 1, num_bytes, m_fstream) == num_bytes;
+}
+
+bool
+CSerializableBinaryFile::write_string(const char* str)
+{
+	uint32_t len = strlen(str);
+
+	return write_bytes(&len, sizeof(len)) && write_bytes(str, len);
+}
+
+bool
+CSerializableBinaryFile::read_string(char* str, size_t max_len)
+{
+	uint32_t len;
+	if (!read_bytes(&len, sizeof(len)) || len >= max_len) return false;
+	if (!read_bytes(str, len)) return false;
+	str[len] = '\0';
+
+	return true;
+}
+
+bool
+CSerializableBinaryFile::skip_padding()
+{
+	long pos = ftell(m_fstream);
+	if (pos < 0) return false;
+
+	long padding = (SERIALIZABLE_BINARY_BLOCK_ALIGNMENT
+		- pos % SERIALIZABLE_BINARY_BLOCK_ALIGNMENT)
+		% SERIALIZABLE_BINARY_BLOCK_ALIGNMENT;
+
+	return fseek(m_fstream, padding, SEEK_CUR) == 0;
+}
+
+CSerializableFile::TSerializableReader*
+CSerializableBinaryFile::new_reader(char* dest_version, size_t n)
+{
+	REQUIRE(m_fstream != NULL, "Provided fstream should be != NULL\n");
+
+	string_t buf;
+	if (!read_string(buf, STRING_LEN))
+		return NULL;
+
+	strncpy(dest_version, buf, n < STRING_LEN? n: STRING_LEN);
+
+	uint32_t byte_order;
+	if (!read_bytes(&byte_order, sizeof(byte_order)))
+		return NULL;
+
+	if (byte_order != BYTE_ORDER_MARK) {
+		SG_WARNING("`%s' was written on a machine with different "
+				   "byte order!\n", m_filename);
+		return NULL;
+	}
+
+	m_stack_fpos.push_back(ftell(m_fstream));
+
+	if (strcmp(STR_HEADER_00, dest_version) == 0)
+		return new SerializableBinaryReader00(this);
+
+	return NULL;
+}
+
+void
+CSerializableBinaryFile::init()
+{
+	if (m_fstream == NULL) return;
+
+	uint32_t byte_order = BYTE_ORDER_MARK;
+
+	switch (m_task) {
+	case 'w':
+		if (!write_string(STR_HEADER_00)
+			|| !write_bytes(&byte_order, sizeof(byte_order))) {
+			close(); return;
+		}
+		break;
+	case 'r': break;
+	default:
+		SG_WARNING("Could not open file `%s', unknown mode!\n",
+				   m_filename);
+		close(); return;
+	}
+}
+
+bool
+CSerializableBinaryFile::write_scalar_wrapped(
+	const TSGDataType* type, const void* param)
+{
+	switch (type->m_ptype) {
+	case PT_UNDEFINED:
+	case PT_SGOBJECT:
+		SG_ERROR("write_scalar_wrapped(): Implementation error during"
+				 " writing BinaryFile!");
+		return false;
+	default:
+		break;
+	}
+
+	return write_bytes(param, type->sizeof_ptype());
+}
+
+bool
+CSerializableBinaryFile::write_cont_begin_wrapped(
+	const TSGDataType* type, index_t len_real_y, index_t len_real_x)
+{
+	switch (type->m_ctype) {
+	case CT_NDARRAY:
+		SG_NOTIMPLEMENTED
+		break;
+	case CT_VECTOR: case CT_SGVECTOR:
+	case CT_MATRIX: case CT_SGMATRIX:
+		if (!write_bytes(&len_real_y, sizeof(len_real_y))
+			|| !write_bytes(&len_real_x, sizeof(len_real_x)))
+			return false;
+		break;
+	case CT_UNDEFINED:
+	case CT_SCALAR:
+		SG_ERROR("write_cont_begin_wrapped(): Implementation error "
+				 "during writing BinaryFile!");
+		return false;
+	}
+
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_cont_end_wrapped(
+	const TSGDataType* type, index_t len_real_y, index_t len_real_x)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_string_begin_wrapped(
+	const TSGDataType* type, index_t length)
+{
+	return write_bytes(&length, sizeof(length));
+}
+
+bool
+CSerializableBinaryFile::write_string_end_wrapped(
+	const TSGDataType* type, index_t length)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_stringentry_begin_wrapped(
+	const TSGDataType* type, index_t y)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_stringentry_end_wrapped(
+	const TSGDataType* type, index_t y)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_sparse_begin_wrapped(
+	const TSGDataType* type, index_t length)
+{
+	return write_bytes(&length, sizeof(length));
+}
+
+bool
+CSerializableBinaryFile::write_sparse_end_wrapped(
+	const TSGDataType* type, index_t length)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_sparseentry_begin_wrapped(
+	const TSGDataType* type, const SGSparseVectorEntry<char>* first_entry,
+	index_t feat_index, index_t y)
+{
+	return write_bytes(&feat_index, sizeof(feat_index));
+}
+
+bool
+CSerializableBinaryFile::write_sparseentry_end_wrapped(
+	const TSGDataType* type, const SGSparseVectorEntry<char>* first_entry,
+	index_t feat_index, index_t y)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_item_begin_wrapped(
+	const TSGDataType* type, index_t y, index_t x)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_item_end_wrapped(
+	const TSGDataType* type, index_t y, index_t x)
+{
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_sgserializable_begin_wrapped(
+	const TSGDataType* type, const char* sgserializable_name,
+	EPrimitiveType generic)
+{
+	int32_t generic_type = generic;
+
+	return write_string(sgserializable_name)
+		&& write_bytes(&generic_type, sizeof(generic_type));
+}
+
+bool
+CSerializableBinaryFile::write_sgserializable_end_wrapped(
+	const TSGDataType* type, const char* sgserializable_name,
+	EPrimitiveType generic)
+{
+	// an empty parameter name terminates the parameter list
+	return write_string("");
+}
+
+bool
+CSerializableBinaryFile::write_type_begin_wrapped(
+	const TSGDataType* type, const char* name, const char* prefix)
+{
+	string_t buf;
+	type->to_string(buf, STRING_LEN);
+
+	if (!write_string(name) || !write_string(buf)) return false;
+
+	// length of the payload, filled in by write_type_end_wrapped()
+	uint64_t length = 0;
+	m_stack_fpos.push_back(ftell(m_fstream));
+
+	return write_bytes(&length, sizeof(length));
+}
+
+bool
+CSerializableBinaryFile::write_type_end_wrapped(
+	const TSGDataType* type, const char* name, const char* prefix)
+{
+	long fpos_length = m_stack_fpos.back();
+	m_stack_fpos.pop_back();
+
+	long fpos_end = ftell(m_fstream);
+	if (fpos_length < 0 || fpos_end < 0) return false;
+
+	uint64_t length = fpos_end - fpos_length - sizeof(uint64_t);
+
+	if (fseek(m_fstream, fpos_length, SEEK_SET) != 0) return false;
+	if (!write_bytes(&length, sizeof(length))) return false;
+	if (fseek(m_fstream, fpos_end, SEEK_SET) != 0) return false;
+
+	return true;
+}
+
+bool
+CSerializableBinaryFile::write_block_wrapped(
+	const TSGDataType* type, const void* data, size_t num_bytes)
+{
+	const char padding[SERIALIZABLE_BINARY_BLOCK_ALIGNMENT] = {0};
+
+	long pos = ftell(m_fstream);
+	if (pos < 0) return false;
+
+	if (!write_bytes(padding, (SERIALIZABLE_BINARY_BLOCK_ALIGNMENT
+		- pos % SERIALIZABLE_BINARY_BLOCK_ALIGNMENT)
+		% SERIALIZABLE_BINARY_BLOCK_ALIGNMENT))
+		return false;
+
+	return write_bytes(data, num_bytes);
+}
@@ -0,0 +1,142 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+#ifndef __SERIALIZABLE_BINARY_FILE_H__
+#define __SERIALIZABLE_BINARY_FILE_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/io/SerializableFile.h>
+#include <shogun/base/DynArray.h>
+#include <shogun/lib/DataType.h>
+#include <shogun/lib/common.h>
+
+/** alignment (in bytes, relative to the start of the file) of blocks */
+#define SERIALIZABLE_BINARY_BLOCK_ALIGNMENT 16
+
+namespace shogun
+{
+template <class T> struct SGSparseVectorEntry;
+
+/** @brief serializable binary file
+ *
+ * Compact native-endian format in which every parameter is stored as
+ * name, type string and payload length followed by the payload. Vectors,
+ * matrices, strings and sparse vectors of primitive types are written as
+ * a single block that is aligned to SERIALIZABLE_BINARY_BLOCK_ALIGNMENT
+ * bytes, i.e. saving and loading them costs one fwrite()/fread() instead
+ * of one call per element. Parameters that are missing in the file or
+ * unknown to the loading object are skipped using the stored lengths.
+ */
+class CSerializableBinaryFile :public CSerializableFile
+{
+	friend class SerializableBinaryReader00;
+
+	/** file positions of the length fields of the open parameters while
+	 * writing, start positions of the parameter lists while reading */
+	DynArray<long> m_stack_fpos;
+
+	void init();
+
+	bool write_bytes(const void* data, size_t num_bytes);
+	bool read_bytes(void* data, size_t num_bytes);
+	bool write_string(const char* str);
+	bool read_string(char* str, size_t max_len);
+	bool skip_padding();
+
+protected:
+
+	/** new reader
+	 * @param dest_version
+	 * @param n
+	 */
+	virtual TSerializableReader* new_reader(
+		char* dest_version, size_t n);
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+	virtual bool write_scalar_wrapped(
+		const TSGDataType* type, const void* param);
+
+	virtual bool write_cont_begin_wrapped(
+		const TSGDataType* type, index_t len_real_y,
+		index_t len_real_x);
+	virtual bool write_cont_end_wrapped(
+		const TSGDataType* type, index_t len_real_y,
+		index_t len_real_x);
+
+	virtual bool write_string_begin_wrapped(
+		const TSGDataType* type, index_t length);
+	virtual bool write_string_end_wrapped(
+		const TSGDataType* type, index_t length);
+
+	virtual bool write_stringentry_begin_wrapped(
+		const TSGDataType* type, index_t y);
+	virtual bool write_stringentry_end_wrapped(
+		const TSGDataType* type, index_t y);
+
+	virtual bool write_sparse_begin_wrapped(
+		const TSGDataType* type, index_t length);
+	virtual bool write_sparse_end_wrapped(
+		const TSGDataType* type, index_t length);
+
+	virtual bool write_sparseentry_begin_wrapped(
+		const TSGDataType* type, const SGSparseVectorEntry<char>* first_entry,
+		index_t feat_index, index_t y);
+	virtual bool write_sparseentry_end_wrapped(
+		const TSGDataType* type, const SGSparseVectorEntry<char>* first_entry,
+		index_t feat_index, index_t y);
+
+	virtual bool write_item_begin_wrapped(
+		const TSGDataType* type, index_t y, index_t x);
+	virtual bool write_item_end_wrapped(
+		const TSGDataType* type, index_t y, index_t x);
+
+	virtual bool write_sgserializable_begin_wrapped(
+		const TSGDataType* type, const char* sgserializable_name,
+		EPrimitiveType generic);
+	virtual bool write_sgserializable_end_wrapped(
+		const TSGDataType* type, const char* sgserializable_name,
+		EPrimitiveType generic);
+
+	virtual bool write_type_begin_wrapped(
+		const TSGDataType* type, const char* name,
+		const char* prefix);
+	virtual bool write_type_end_wrapped(
+		const TSGDataType* type, const char* name,
+		const char* prefix);
+
+	virtual bool write_block_wrapped(
+		const TSGDataType* type, const void* data, size_t num_bytes);
+#endif
+public:
+	/** default constructor */
+	explicit CSerializableBinaryFile();
+
+	/** constructor
+	 *
+	 * @param fstream already opened file, must be seekable
+	 * @param rw
+	 */
+	explicit CSerializableBinaryFile(FILE* fstream, char rw);
+
+	/** constructor
+	 *
+	 * @param fname filename to open
+	 * @param rw mode, 'r' or 'w'
+	 */
+	explicit CSerializableBinaryFile(const char* fname, char rw='r');
+
+	/** default destructor */
+	virtual ~CSerializableBinaryFile();
+
+	/** @return true, payloads are written as single blocks */
+	virtual bool supports_block_io() const { return true; }
+
+	/** @return object name */
+	virtual const char* get_name() const {
+		return "SerializableBinaryFile";
+	}
+};
+}
+
+#endif /* __SERIALIZABLE_BINARY_FILE_H__  */
@@ -0,0 +1,236 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/io/SerializableBinaryReader00.h>
+#include <shogun/io/SerializableBinaryFile.h>
+#include <shogun/lib/common.h>
+
+using namespace shogun;
+
+SerializableBinaryReader00::SerializableBinaryReader00(
+	CSerializableBinaryFile* file) { m_file = file; }
+
+SerializableBinaryReader00::~SerializableBinaryReader00() {}
+
+bool
+SerializableBinaryReader00::skip_parameters()
+{
+	string_t r_name, r_type;
+	uint64_t length;
+
+	// the stream may be anywhere in the payload, walk the list from its start
+	if (fseek(m_file->m_fstream, m_file->m_stack_fpos.back(), SEEK_SET
+			) != 0) return false;
+
+	while (true) {
+		if (!m_file->read_string(r_name, STRING_LEN)) return false;
+
+		// an empty parameter name terminates the parameter list
+		if (*r_name == '\0') return true;
+
+		if (!m_file->read_string(r_type, STRING_LEN)) return false;
+		if (!m_file->read_bytes(&length, sizeof(length))) return false;
+		if (fseek(m_file->m_fstream, length, SEEK_CUR) != 0) return false;
+	}
+
+	return false;
+}
+
+bool
+SerializableBinaryReader00::read_scalar_wrapped(
+	const TSGDataType* type, void* param)
+{
+	switch (type->m_ptype) {
+	case PT_UNDEFINED:
+	case PT_SGOBJECT:
+		SG_ERROR("read_scalar_wrapped(): Implementation error during"
+				 " reading BinaryFile!");
+		return false;
+	default:
+		break;
+	}
+
+	return m_file->read_bytes(param, type->sizeof_ptype());
+}
+
+bool
+SerializableBinaryReader00::read_cont_begin_wrapped(
+	const TSGDataType* type, index_t* len_read_y, index_t* len_read_x)
+{
+	switch (type->m_ctype) {
+	case CT_NDARRAY:
+		SG_NOTIMPLEMENTED
+		break;
+	case CT_VECTOR: case CT_SGVECTOR:
+	case CT_MATRIX: case CT_SGMATRIX:
+		if (!m_file->read_bytes(len_read_y, sizeof(*len_read_y))
+			|| !m_file->read_bytes(len_read_x, sizeof(*len_read_x)))
+			return false;
+		break;
+	case CT_UNDEFINED:
+	case CT_SCALAR:
+		SG_ERROR("read_cont_begin_wrapped(): Implementation error "
+				 "during reading BinaryFile!");
+		return false;
+	}
+
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_cont_end_wrapped(
+	const TSGDataType* type, index_t len_read_y, index_t len_read_x)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_string_begin_wrapped(
+	const TSGDataType* type, index_t* length)
+{
+	return m_file->read_bytes(length, sizeof(*length));
+}
+
+bool
+SerializableBinaryReader00::read_string_end_wrapped(
+	const TSGDataType* type, index_t length)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_stringentry_begin_wrapped(
+	const TSGDataType* type, index_t y)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_stringentry_end_wrapped(
+	const TSGDataType* type, index_t y)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_sparse_begin_wrapped(
+	const TSGDataType* type, index_t* length)
+{
+	return m_file->read_bytes(length, sizeof(*length));
+}
+
+bool
+SerializableBinaryReader00::read_sparse_end_wrapped(
+	const TSGDataType* type, index_t length)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_sparseentry_begin_wrapped(
+	const TSGDataType* type, SGSparseVectorEntry<char>* first_entry,
+	index_t* feat_index, index_t y)
+{
+	return m_file->read_bytes(feat_index, sizeof(*feat_index));
+}
+
+bool
+SerializableBinaryReader00::read_sparseentry_end_wrapped(
+	const TSGDataType* type, SGSparseVectorEntry<char>* first_entry,
+	index_t* feat_index, index_t y)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_item_begin_wrapped(
+	const TSGDataType* type, index_t y, index_t x)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_item_end_wrapped(
+	const TSGDataType* type, index_t y, index_t x)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_sgserializable_begin_wrapped(
+	const TSGDataType* type, char* sgserializable_name,
+	EPrimitiveType* generic)
+{
+	int32_t generic_type;
+
+	if (!m_file->read_string(sgserializable_name, STRING_LEN))
+		return false;
+	if (!m_file->read_bytes(&generic_type, sizeof(generic_type)))
+		return false;
+
+	*generic = (EPrimitiveType) generic_type;
+	m_file->m_stack_fpos.push_back(ftell(m_file->m_fstream));
+
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_sgserializable_end_wrapped(
+	const TSGDataType* type, const char* sgserializable_name,
+	EPrimitiveType generic)
+{
+	// parameters that were not requested while loading are skipped
+	if (!skip_parameters()) return false;
+
+	m_file->m_stack_fpos.pop_back();
+
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_type_begin_wrapped(
+	const TSGDataType* type, const char* name, const char* prefix)
+{
+	if (fseek(m_file->m_fstream, m_file->m_stack_fpos.back(), SEEK_SET
+			) != 0) return false;
+
+	string_t type_str;
+	type->to_string(type_str, STRING_LEN);
+
+	string_t r_name, r_type;
+	uint64_t length;
+	while (true) {
+		if (!m_file->read_string(r_name, STRING_LEN)) return false;
+
+		// end of the parameter list, parameter is not in the file
+		if (*r_name == '\0') return false;
+
+		if (!m_file->read_string(r_type, STRING_LEN)) return false;
+		if (!m_file->read_bytes(&length, sizeof(length))) return false;
+
+		if (strcmp(r_name, name) == 0
+			&& strcmp(r_type, type_str) == 0) return true;
+
+		if (fseek(m_file->m_fstream, length, SEEK_CUR) != 0)
+			return false;
+	}
+
+	return false;
+}
+
+bool
+SerializableBinaryReader00::read_type_end_wrapped(
+	const TSGDataType* type, const char* name, const char* prefix)
+{
+	return true;
+}
+
+bool
+SerializableBinaryReader00::read_block_wrapped(
+	const TSGDataType* type, void* data, size_t num_bytes)
+{
+	if (!m_file->skip_padding()) return false;
+
+	return m_file->read_bytes(data, num_bytes);
+}
@@ -83,6 +83,9 @@ public:
 			const TSGDataType* type, const char* name,
 			const char* prefix) = 0;
 
+		virtual bool read_block_wrapped(
+			const TSGDataType* type, void* data, size_t num_bytes);
+
 #endif
 		/* End of abstract write methods  */
 		/* ******************************************************** */
@@ -168,6 +171,9 @@ protected:
 	virtual bool write_type_end_wrapped(
 		const TSGDataType* type, const char* name,
 		const char* prefix) = 0;
+
+	virtual bool write_block_wrapped(
+		const TSGDataType* type, const void* data, size_t num_bytes);
 #endif
 
 	/* End of abstract write methods  */
@@ -200,6 +206,14 @@ public:
 	/** is opened */
 	virtual bool is_opened();
 
+	/** whether contiguous payloads (containers of primitive types, strings
+	 * and sparse vectors) can be written and read as a single block via
+	 * write_block() and read_block() instead of element by element
+	 *
+	 * @return false by default
+	 */
+	virtual bool supports_block_io() const { return false; }
+
 	/* ************************************************************ */
 	/* Begin of public wrappers  */
 
@@ -322,6 +336,13 @@ public:
 		const TSGDataType* type, const char* name, const char* prefix);
 	virtual bool read_type_end(
 		const TSGDataType* type, const char* name, const char* prefix);
+
+	virtual bool write_block(
+		const TSGDataType* type, const char* name, const char* prefix,
+		const void* data, size_t num_bytes);
+	virtual bool read_block(
+		const TSGDataType* type, const char* name, const char* prefix,
+		void* data, size_t num_bytes);
 #endif
 	/* End of public wrappers  */
 	/* ************************************************************ */
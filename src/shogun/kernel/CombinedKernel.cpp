@@ -19,9 +19,13 @@
 #include <shogun/kernel/CustomKernel.h>
 #include <shogun/features/CombinedFeatures.h>
 #include <string.h>
+#include <vector>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/eigen3.h>
 
+/// side length of the blocks of pairs of examples in the quadratic forms
+#define QUADRATIC_FORM_BLOCK_SIZE 64
+
 using namespace shogun;
 using namespace Eigen;
 
@@ -652,6 +656,75 @@ bool CCombinedKernel::precompute_subkernels()
 	return true;
 }
 
+SGVector<float64_t> CCombinedKernel::compute_subkernel_quadratic_forms(
+	SGVector<int32_t> idx, SGVector<float64_t> coef)
+{
+	REQUIRE(idx.vlen==coef.vlen, "Number of indices (%d) and coefficients "
+			"(%d) must match\n", idx.vlen, coef.vlen);
+
+	int32_t num_kernels=get_num_kernels();
+	index_t n=idx.vlen;
+	SGVector<float64_t> forms(num_kernels);
+	forms.zero();
+
+	CKernel** kernels=SG_MALLOC(CKernel*, num_kernels);
+	for (index_t k_idx=0; k_idx<num_kernels; k_idx++)
+		kernels[k_idx]=get_kernel(k_idx);
+
+	// pairs of blocks of examples, only the upper triangle ones for a
+	// symmetric kernel, whose off-diagonal blocks then count twice
+	index_t num_blocks=(n+QUADRATIC_FORM_BLOCK_SIZE-1)/QUADRATIC_FORM_BLOCK_SIZE;
+	std::vector<std::pair<index_t, index_t> > tiles;
+	for (index_t bi=0; bi<num_blocks; bi++)
+	{
+		for (index_t bj=lhs_equals_rhs ? bi : 0; bj<num_blocks; bj++)
+			tiles.push_back(std::make_pair(bi, bj));
+	}
+	index_t num_tiles=tiles.size();
+
+	#pragma omp parallel num_threads(parallel->get_num_threads())
+	{
+		SGVector<float64_t> partial(num_kernels);
+		partial.zero();
+
+		#pragma omp for schedule(dynamic)
+		for (index_t t=0; t<num_tiles; t++)
+		{
+			index_t i_start=tiles[t].first*QUADRATIC_FORM_BLOCK_SIZE;
+			index_t i_end=CMath::min(i_start+QUADRATIC_FORM_BLOCK_SIZE, n);
+			index_t j_start=tiles[t].second*QUADRATIC_FORM_BLOCK_SIZE;
+			index_t j_end=CMath::min(j_start+QUADRATIC_FORM_BLOCK_SIZE, n);
+			float64_t factor=(lhs_equals_rhs && i_start!=j_start) ? 2.0 : 1.0;
+
+			for (index_t k_idx=0; k_idx<num_kernels; k_idx++)
+			{
+				float64_t sum=0;
+				for (index_t i=i_start; i<i_end; i++)
+				{
+					float64_t row=0;
+					for (index_t j=j_start; j<j_end; j++)
+					{
+						row+=coef[j]*normalizer->normalize(
+							kernels[k_idx]->kernel(idx[i], idx[j]), idx[i], idx[j]);
+					}
+					sum+=coef[i]*row;
+				}
+				partial[k_idx]+=factor*sum;
+			}
+		}
+
+		#pragma omp critical
+		for (index_t k_idx=0; k_idx<num_kernels; k_idx++)
+			forms[k_idx]+=partial[k_idx];
+	}
+
+	for (index_t k_idx=0; k_idx<num_kernels; k_idx++)
+		SG_UNREF(kernels[k_idx]);
+	SG_FREE(kernels);
+
+	return forms;
+}
+
 void CCombinedKernel::init()
 {
 	sv_count=0;
@@ -360,6 +360,21 @@ class CCombinedKernel : public CKernel
 		/** precompute all sub-kernels */
 		bool precompute_subkernels();
 
+		/** compute the quadratic forms \f$c^TK_kc\f$ of all subkernels on
+		 * the given examples at once. Every block of pairs of examples is
+		 * evaluated for all subkernels before moving on, blocks are processed
+		 * in parallel and, for a symmetric kernel, only the upper triangle is
+		 * visited. Subkernels replaced by precompute_subkernels() are read
+		 * from their cache.
+		 *
+		 * @param idx indices of the examples
+		 * @param coef coefficients of the examples
+		 * @return for each subkernel, the quadratic form that kernel() gives
+		 * with the subkernel weights set to the corresponding unit vector
+		 */
+		SGVector<float64_t> compute_subkernel_quadratic_forms(
+			SGVector<int32_t> idx, SGVector<float64_t> coef);
+
 		/** Returns a  casted version of the given kernel. Throws an error
 		 * if parameter is not of class CombinedKernel. SG_REF's the returned
 		 * kernel
@@ -15,11 +15,54 @@
 #include <shogun/features/DummyFeatures.h>
 #include <shogun/features/IndexFeatures.h>
 #include <shogun/io/SGIO.h>
+#include <shogun/io/MemoryMappedFile.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
+#include <stdio.h>
+
 using namespace shogun;
 using namespace linalg;
 
+/** header of the files written by CCustomKernel::save_kernel_matrix, padded
+ * so that the matrix that follows is aligned */
+struct CustomKernelFileHeader
+{
+	/** "SGCK" */
+	char magic[4];
+	/** format version */
+	uint32_t version;
+	/** storage layout of the matrix */
+	uint32_t storage;
+	/** whether the matrix is symmetric */
+	uint32_t symmetric;
+	/** number of rows */
+	int64_t num_rows;
+	/** number of cols */
+	int64_t num_cols;
+	/** padding to 64 bytes */
+	char padding[32];
+};
+
+/* number of elements stored for a kernel matrix in the given layout */
+static int64_t custom_kernel_storage_length(ECustomKernelStorage storage,
+		int64_t num_rows, int64_t num_cols)
+{
+	int64_t num_tile_rows=(num_rows+CUSTOM_KERNEL_TILE_SIZE-1)/CUSTOM_KERNEL_TILE_SIZE;
+	int64_t num_tile_cols=(num_cols+CUSTOM_KERNEL_TILE_SIZE-1)/CUSTOM_KERNEL_TILE_SIZE;
+
+	switch (storage)
+	{
+		case CKS_UPPER_TRIANGLE:
+			return num_cols*(num_cols+1)/2;
+		case CKS_TILED:
+		case CKS_TILED_BF16:
+			return num_tile_rows*num_tile_cols*CUSTOM_KERNEL_TILE_SIZE*
+				CUSTOM_KERNEL_TILE_SIZE;
+		default:
+			return num_rows*num_cols;
+	}
+}
+
 void CCustomKernel::init()
 {
 	m_row_subset_stack=new CSubsetStack();
@@ -28,6 +71,10 @@ void CCustomKernel::init()
 	SG_REF(m_col_subset_stack)
 	m_is_symmetric=false;
 	m_free_km=true;
+	m_storage=CKS_FULL;
+	m_num_rows=0;
+	m_num_cols=0;
+	m_mapped_file=NULL;
 
 	SG_ADD((CSGObject**)&m_row_subset_stack, "row_subset_stack",
 			"Subset stack of rows", MS_NOT_AVAILABLE);
@@ -39,6 +86,15 @@ void CCustomKernel::init()
 			MS_NOT_AVAILABLE);
 	SG_ADD(&kmatrix, "kmatrix", "Kernel matrix.", MS_NOT_AVAILABLE);
 	SG_ADD(&upper_diagonal, "upper_diagonal", "Upper diagonal", MS_NOT_AVAILABLE);
+	SG_ADD((machine_int_t*) &m_storage, "storage", "Storage layout",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_num_rows, "num_rows", "Number of rows of the kernel matrix",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_num_cols, "num_cols", "Number of cols of the kernel matrix",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_tiles, "tiles", "Tiles of the kernel matrix", MS_NOT_AVAILABLE);
+	SG_ADD(&m_bf16_tiles, "bf16_tiles", "bfloat16 tiles of the kernel matrix",
+			MS_NOT_AVAILABLE);
 }
 
 CCustomKernel::CCustomKernel()
@@ -98,6 +154,8 @@ CCustomKernel::~CCustomKernel()
 
 bool CCustomKernel::dummy_init(int32_t rows, int32_t cols)
 {
+	m_num_rows=rows;
+	m_num_cols=cols;
 	return init(new CDummyFeatures(rows), new CDummyFeatures(cols));
 }
 
@@ -149,10 +207,10 @@ bool CCustomKernel::init(CFeatures* l, CFeatures* r)
 
 	lhs_equals_rhs=m_is_symmetric;
 
-	SG_DEBUG("num_vec_lhs: %d vs num_rows %d\n", l->get_num_vectors(), kmatrix.num_rows)
-	SG_DEBUG("num_vec_rhs: %d vs num_cols %d\n", r->get_num_vectors(), kmatrix.num_cols)
-	ASSERT(l->get_num_vectors()==kmatrix.num_rows)
-	ASSERT(r->get_num_vectors()==kmatrix.num_cols)
+	SG_DEBUG("num_vec_lhs: %d vs num_rows %d\n", l->get_num_vectors(), m_num_rows)
+	SG_DEBUG("num_vec_rhs: %d vs num_cols %d\n", r->get_num_vectors(), m_num_cols)
+	ASSERT(l->get_num_vectors()==m_num_rows)
+	ASSERT(r->get_num_vectors()==m_num_cols)
 	return init_normalizer();
 }
 
@@ -168,18 +226,27 @@ float64_t CCustomKernel::sum_symmetric_block(index_t block_begin,
 		return CKernel::sum_symmetric_block(block_begin, block_size, no_diag);
 	}
 
-	REQUIRE(kmatrix.matrix, "The kernel matrix is not initialized!\n")
+	REQUIRE(has_kernel_matrix(), "The kernel matrix is not initialized!\n")
 	REQUIRE(m_is_symmetric, "The kernel matrix is not symmetric!\n")
-	REQUIRE(block_begin>=0 && block_begin<kmatrix.num_cols,
+	REQUIRE(block_begin>=0 && block_begin<m_num_cols,
 			"Invalid block begin index (%d, %d)!\n", block_begin, block_begin)
-	REQUIRE(block_begin+block_size<=kmatrix.num_cols,
+	REQUIRE(block_begin+block_size<=m_num_cols,
 			"Invalid block size (%d) at starting index (%d, %d)! "
 			"Please use smaller blocks!", block_size, block_begin, block_begin)
 	REQUIRE(block_size>=1, "Invalid block size (%d)!\n", block_size)
 
+	// other layouts than the full matrix are read into a block first
+	SGMatrix<float32_t> km=kmatrix;
+	if (m_storage!=CKS_FULL)
+	{
+		km=get_float32_kernel_block(block_begin, block_begin, block_size,
+				block_size);
+		block_begin=0;
+	}
+
 	SG_DEBUG("Leaving\n");
 
-	return sum_symmetric(block(kmatrix, block_begin,
+	return sum_symmetric(block(km, block_begin,
 				block_begin, block_size, block_size), no_diag);
 }
 
@@ -197,19 +264,29 @@ float64_t CCustomKernel::sum_block(index_t block_begin_row,
 				block_size_row, block_size_col, no_diag);
 	}
 
-	REQUIRE(kmatrix.matrix, "The kernel matrix is not initialized!\n")
-	REQUIRE(block_begin_row>=0 && block_begin_row<kmatrix.num_rows &&
-			block_begin_col>=0 && block_begin_col<kmatrix.num_cols,
+	REQUIRE(has_kernel_matrix(), "The kernel matrix is not initialized!\n")
+	REQUIRE(block_begin_row>=0 && block_begin_row<m_num_rows &&
+			block_begin_col>=0 && block_begin_col<m_num_cols,
 			"Invalid block begin index (%d, %d)!\n",
 			block_begin_row, block_begin_col)
-	REQUIRE(block_begin_row+block_size_row<=kmatrix.num_rows &&
-			block_begin_col+block_size_col<=kmatrix.num_cols,
+	REQUIRE(block_begin_row+block_size_row<=m_num_rows &&
+			block_begin_col+block_size_col<=m_num_cols,
 			"Invalid block size (%d, %d) at starting index (%d, %d)! "
 			"Please use smaller blocks!", block_size_row, block_size_col,
 			block_begin_row, block_begin_col)
 	REQUIRE(block_size_row>=1 && block_size_col>=1,
 			"Invalid block size (%d, %d)!\n", block_size_row, block_size_col)
 
+	// other layouts than the full matrix are read into a block first
+	SGMatrix<float32_t> km=kmatrix;
+	if (m_storage!=CKS_FULL)
+	{
+		km=get_float32_kernel_block(block_begin_row, block_begin_col,
+				block_size_row, block_size_col);
+		block_begin_row=0;
+		block_begin_col=0;
+	}
+
 	// check if removal of diagonal is required/valid
 	if (no_diag && block_size_row!=block_size_col)
 	{
@@ -219,7 +296,7 @@ float64_t CCustomKernel::sum_block(index_t block_begin_row,
 
 	SG_DEBUG("Leaving\n");
 
-	return sum(block(kmatrix, block_begin_row, block_begin_col,
+	return sum(block(km, block_begin_row, block_begin_col,
 				block_size_row, block_size_col), no_diag);
 }
 
@@ -236,16 +313,25 @@ SGVector<float64_t> CCustomKernel::row_wise_sum_symmetric_block(index_t
 				no_diag);
 	}
 
-	REQUIRE(kmatrix.matrix, "The kernel matrix is not initialized!\n")
+	REQUIRE(has_kernel_matrix(), "The kernel matrix is not initialized!\n")
 	REQUIRE(m_is_symmetric, "The kernel matrix is not symmetric!\n")
-	REQUIRE(block_begin>=0 && block_begin<kmatrix.num_cols,
+	REQUIRE(block_begin>=0 && block_begin<m_num_cols,
 			"Invalid block begin index (%d, %d)!\n", block_begin, block_begin)
-	REQUIRE(block_begin+block_size<=kmatrix.num_cols,
+	REQUIRE(block_begin+block_size<=m_num_cols,
 			"Invalid block size (%d) at starting index (%d, %d)! "
 			"Please use smaller blocks!", block_size, block_begin, block_begin)
 	REQUIRE(block_size>=1, "Invalid block size (%d)!\n", block_size)
 
-	SGVector<float32_t> s=rowwise_sum(block(kmatrix, block_begin,
+	// other layouts than the full matrix are read into a block first
+	SGMatrix<float32_t> km=kmatrix;
+	if (m_storage!=CKS_FULL)
+	{
+		km=get_float32_kernel_block(block_begin, block_begin, block_size,
+				block_size);
+		block_begin=0;
+	}
+
+	SGVector<float32_t> s=rowwise_sum(block(km, block_begin,
 				block_begin, block_size, block_size), no_diag);
 
 	// casting to float64_t vector
@@ -271,24 +357,33 @@ SGMatrix<float64_t> CCustomKernel::row_wise_sum_squared_sum_symmetric_block(
 				block_size, no_diag);
 	}
 
-	REQUIRE(kmatrix.matrix, "The kernel matrix is not initialized!\n")
+	REQUIRE(has_kernel_matrix(), "The kernel matrix is not initialized!\n")
 	REQUIRE(m_is_symmetric, "The kernel matrix is not symmetric!\n")
-	REQUIRE(block_begin>=0 && block_begin<kmatrix.num_cols,
+	REQUIRE(block_begin>=0 && block_begin<m_num_cols,
 			"Invalid block begin index (%d, %d)!\n", block_begin, block_begin)
-	REQUIRE(block_begin+block_size<=kmatrix.num_cols,
+	REQUIRE(block_begin+block_size<=m_num_cols,
 			"Invalid block size (%d) at starting index (%d, %d)! "
 			"Please use smaller blocks!", block_size, block_begin, block_begin)
 	REQUIRE(block_size>=1, "Invalid block size (%d)!\n", block_size)
 
+	// other layouts than the full matrix are read into a block first
+	SGMatrix<float32_t> km=kmatrix;
+	if (m_storage!=CKS_FULL)
+	{
+		km=get_float32_kernel_block(block_begin, block_begin, block_size,
+				block_size);
+		block_begin=0;
+	}
+
 	// initialize the matrix that accumulates the row/col-wise sum
 	// the first column stores the sum of kernel values
 	// the second column stores the sum of squared kernel values
 	SGMatrix<float64_t> row_sum(block_size, 2);
 
-	SGVector<float32_t> sum=rowwise_sum(block(kmatrix,
+	SGVector<float32_t> sum=rowwise_sum(block(km,
 				block_begin, block_begin, block_size, block_size), no_diag);
 
-	auto kmatrix_block = block(kmatrix, block_begin, block_begin, block_size, block_size);
+	auto kmatrix_block = block(km, block_begin, block_begin, block_size, block_size);
 	SGVector<float32_t> sq_sum=rowwise_sum(
 		element_prod(kmatrix_block, kmatrix_block), no_diag);
 
@@ -317,19 +412,29 @@ SGVector<float64_t> CCustomKernel::row_col_wise_sum_block(index_t
 				block_size_row, block_size_col, no_diag);
 	}
 
-	REQUIRE(kmatrix.matrix, "The kernel matrix is not initialized!\n")
-	REQUIRE(block_begin_row>=0 && block_begin_row<kmatrix.num_rows &&
-			block_begin_col>=0 && block_begin_col<kmatrix.num_cols,
+	REQUIRE(has_kernel_matrix(), "The kernel matrix is not initialized!\n")
+	REQUIRE(block_begin_row>=0 && block_begin_row<m_num_rows &&
+			block_begin_col>=0 && block_begin_col<m_num_cols,
 			"Invalid block begin index (%d, %d)!\n",
 			block_begin_row, block_begin_col)
-	REQUIRE(block_begin_row+block_size_row<=kmatrix.num_rows &&
-			block_begin_col+block_size_col<=kmatrix.num_cols,
+	REQUIRE(block_begin_row+block_size_row<=m_num_rows &&
+			block_begin_col+block_size_col<=m_num_cols,
 			"Invalid block size (%d, %d) at starting index (%d, %d)! "
 			"Please use smaller blocks!", block_size_row, block_size_col,
 			block_begin_row, block_begin_col)
 	REQUIRE(block_size_row>=1 && block_size_col>=1,
 			"Invalid block size (%d, %d)!\n", block_size_row, block_size_col)
 
+	// other layouts than the full matrix are read into a block first
+	SGMatrix<float32_t> km=kmatrix;
+	if (m_storage!=CKS_FULL)
+	{
+		km=get_float32_kernel_block(block_begin_row, block_begin_col,
+				block_size_row, block_size_col);
+		block_begin_row=0;
+		block_begin_col=0;
+	}
+
 	// check if removal of diagonal is required/valid
 	if (no_diag && block_size_row!=block_size_col)
 	{
@@ -342,11 +447,11 @@ SGVector<float64_t> CCustomKernel::row_col_wise_sum_block(index_t
 	// the nextt block_size_col entries store the col-wise sum of kernel values
 	SGVector<float64_t> sum(block_size_row+block_size_col);
 
-	SGVector<float32_t> rowwise=rowwise_sum(block(kmatrix,
+	SGVector<float32_t> rowwise=rowwise_sum(block(km,
 				block_begin_row, block_begin_col, block_size_row,
 				block_size_col), no_diag);
 
-	SGVector<float32_t> colwise=colwise_sum(block(kmatrix,
+	SGVector<float32_t> colwise=colwise_sum(block(km,
 				block_begin_row, block_begin_col, block_size_row,
 				block_size_col), no_diag);
 
@@ -369,6 +474,12 @@ void CCustomKernel::cleanup_custom()
 
 	kmatrix=SGMatrix<float32_t>();
 	upper_diagonal=false;
+	m_storage=CKS_FULL;
+	m_num_rows=0;
+	m_num_cols=0;
+	m_tiles=SGVector<float32_t>();
+	m_bf16_tiles=SGVector<uint16_t>();
+	SG_UNREF(m_mapped_file);
 
 	SG_DEBUG("Leaving\n")
 }
@@ -408,7 +519,7 @@ void CCustomKernel::row_subset_changed_post()
 	if (m_row_subset_stack->has_subsets())
 		num_lhs=m_row_subset_stack->get_size();
 	else
-		num_lhs=kmatrix.num_rows;
+		num_lhs=m_num_rows;
 }
 
 void CCustomKernel::add_col_subset(SGVector<index_t> subset)
@@ -440,5 +551,251 @@ void CCustomKernel::col_subset_changed_post()
 	if (m_col_subset_stack->has_subsets())
 		num_rhs=m_col_subset_stack->get_size();
 	else
-		num_rhs=kmatrix.num_cols;
+		num_rhs=m_num_cols;
+}
+
+void CCustomKernel::set_storage(ECustomKernelStorage storage)
+{
+	REQUIRE(!m_row_subset_stack->has_subsets() &&
+			!m_col_subset_stack->has_subsets(), "%s::set_storage() not possible "
+			"with subset. Remove first\n", get_name());
+	REQUIRE(has_kernel_matrix(), "The kernel matrix is not initialized!\n")
+	REQUIRE(storage!=CKS_UPPER_TRIANGLE || m_is_symmetric,
+			"Only a symmetric kernel matrix can be stored as upper triangle!\n")
+
+	if (storage==m_storage)
+		return;
+
+	index_t rows=m_num_rows;
+	index_t cols=m_num_cols;
+	int64_t len=custom_kernel_storage_length(storage, rows, cols);
+	SGMatrix<float32_t> new_kmatrix;
+	SGVector<float32_t> new_tiles;
+	SGVector<uint16_t> new_bf16_tiles;
+
+	switch (storage)
+	{
+		case CKS_UPPER_TRIANGLE:
+			new_kmatrix=SGMatrix<float32_t>(SG_MALLOC(float32_t, len), rows, cols);
+			break;
+		case CKS_TILED:
+			new_tiles=SGVector<float32_t>(len);
+			new_tiles.zero();
+			break;
+		case CKS_TILED_BF16:
+			new_bf16_tiles=SGVector<uint16_t>(len);
+			new_bf16_tiles.zero();
+			break;
+		default:
+			new_kmatrix=SGMatrix<float32_t>(rows, cols);
+	}
+
+	// columns are independent in all the layouts
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
+	for (index_t col=0; col<cols; col++)
+	{
+		for (index_t row=0; row<rows; row++)
+		{
+			float32_t value=get_element(row, col);
+			switch (storage)
+			{
+				case CKS_UPPER_TRIANGLE:
+					if (row<=col)
+						new_kmatrix.matrix[int64_t(row)*cols-int64_t(row)*(row+1)/2+col]=value;
+					break;
+				case CKS_TILED:
+					new_tiles.vector[get_tile_index(row, col)]=value;
+					break;
+				case CKS_TILED_BF16:
+					new_bf16_tiles.vector[get_tile_index(row, col)]=float32_to_bf16(value);
+					break;
+				default:
+					new_kmatrix.matrix[int64_t(col)*rows+row]=value;
+			}
+		}
+	}
+
+	bool symmetric=m_is_symmetric;
+	cleanup_custom();
+	kmatrix=new_kmatrix;
+	m_tiles=new_tiles;
+	m_bf16_tiles=new_bf16_tiles;
+	m_storage=storage;
+	upper_diagonal=storage==CKS_UPPER_TRIANGLE;
+	m_is_symmetric=symmetric;
+	dummy_init(rows, cols);
+}
+
+void CCustomKernel::save_kernel_matrix(const char* filename)
+{
+	REQUIRE(!m_row_subset_stack->has_subsets() &&
+			!m_col_subset_stack->has_subsets(), "%s::save_kernel_matrix() not "
+			"possible with subset. Remove first\n", get_name());
+	REQUIRE(has_kernel_matrix(), "The kernel matrix is not initialized!\n")
+
+	CustomKernelFileHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, "SGCK", 4);
+	header.version=1;
+	header.storage=m_storage;
+	header.symmetric=m_is_symmetric;
+	header.num_rows=m_num_rows;
+	header.num_cols=m_num_cols;
+
+	int64_t len=custom_kernel_storage_length(m_storage, m_num_rows, m_num_cols);
+	const void* data=kmatrix.matrix;
+	size_t element_size=sizeof(float32_t);
+	if (m_storage==CKS_TILED)
+		data=m_tiles.vector;
+	else if (m_storage==CKS_TILED_BF16)
+	{
+		data=m_bf16_tiles.vector;
+		element_size=sizeof(uint16_t);
+	}
+
+	FILE* file=fopen(filename, "wb");
+	REQUIRE(file, "Could not open %s for writing!\n", filename)
+	bool success=fwrite(&header, sizeof(header), 1, file)==1 &&
+		fwrite(data, element_size, len, file)==size_t(len);
+	success=fclose(file)==0 && success;
+	REQUIRE(success, "Could not write the kernel matrix to %s!\n", filename)
+}
+
+bool CCustomKernel::load_kernel_matrix(const char* filename)
+{
+	if (m_row_subset_stack->has_subsets() || m_col_subset_stack->has_subsets())
+	{
+		SG_ERROR("%s::load_kernel_matrix not possible with subset. Remove "
+				"first\n", get_name());
+	}
+
+	CMemoryMappedFile<uint8_t>* file=new CMemoryMappedFile<uint8_t>(filename);
+	SG_REF(file);
+
+	CustomKernelFileHeader header;
+	if (file->get_size()<sizeof(header))
+	{
+		SG_UNREF(file);
+		SG_ERROR("%s is not a custom kernel matrix file!\n", filename)
+		return false;
+	}
+	memcpy(&header, file->get_map(), sizeof(header));
+
+	ECustomKernelStorage storage=(ECustomKernelStorage) header.storage;
+	int64_t len=custom_kernel_storage_length(storage, header.num_rows,
+			header.num_cols);
+	size_t element_size=storage==CKS_TILED_BF16 ? sizeof(uint16_t) :
+		sizeof(float32_t);
+	if (memcmp(header.magic, "SGCK", 4)!=0 || header.version!=1 ||
+			storage>CKS_TILED_BF16 ||
+			file->get_size()!=sizeof(header)+len*element_size)
+	{
+		SG_UNREF(file);
+		SG_ERROR("%s is not a valid custom kernel matrix file!\n", filename)
+		return false;
+	}
+
+	cleanup_custom();
+
+	// the matrix is used in place and lives as long as the mapping
+	void* data=file->get_map()+sizeof(header);
+	if (storage==CKS_TILED)
+		m_tiles=SGVector<float32_t>((float32_t*) data, len, false);
+	else if (storage==CKS_TILED_BF16)
+		m_bf16_tiles=SGVector<uint16_t>((uint16_t*) data, len, false);
+	else
+	{
+		kmatrix=SGMatrix<float32_t>((float32_t*) data, header.num_rows,
+				header.num_cols, false);
+	}
+
+	m_mapped_file=file;
+	m_storage=storage;
+	upper_diagonal=storage==CKS_UPPER_TRIANGLE;
+	m_is_symmetric=header.symmetric;
+	dummy_init(header.num_rows, header.num_cols);
+	return true;
+}
+
+SGMatrix<float32_t> CCustomKernel::get_float32_kernel_block(
+		index_t block_begin_row, index_t block_begin_col,
+		index_t block_size_row, index_t block_size_col)
+{
+	REQUIRE(!m_row_subset_stack->has_subsets() &&
+			!m_col_subset_stack->has_subsets(), "%s::get_float32_kernel_block() "
+			"not possible with subset. Remove first\n", get_name());
+	REQUIRE(has_kernel_matrix(), "The kernel matrix is not initialized!\n")
+	REQUIRE(block_begin_row>=0 && block_begin_col>=0 &&
+			block_begin_row+block_size_row<=m_num_rows &&
+			block_begin_col+block_size_col<=m_num_cols,
+			"Invalid block of size (%d, %d) at (%d, %d)!\n", block_size_row,
+			block_size_col, block_begin_row, block_begin_col)
+
+	SGMatrix<float32_t> result(block_size_row, block_size_col);
+
+	for (index_t j=0; j<block_size_col; j++)
+	{
+		index_t col=block_begin_col+j;
+		float32_t* result_col=result.matrix+int64_t(j)*block_size_row;
+
+		if (m_storage==CKS_FULL)
+		{
+			sg_memcpy(result_col, kmatrix.matrix+int64_t(col)*m_num_rows+
+					block_begin_row, block_size_row*sizeof(float32_t));
+		}
+		else if (m_storage==CKS_TILED)
+		{
+			// a column is contiguous within each tile
+			for (index_t i=0; i<block_size_row; )
+			{
+				index_t row=block_begin_row+i;
+				index_t num=CMath::min(block_size_row-i,
+						CUSTOM_KERNEL_TILE_SIZE-row%CUSTOM_KERNEL_TILE_SIZE);
+				sg_memcpy(result_col+i, m_tiles.vector+get_tile_index(row, col),
+						num*sizeof(float32_t));
+				i+=num;
+			}
+		}
+		else
+		{
+			for (index_t i=0; i<block_size_row; i++)
+				result_col[i]=get_element(block_begin_row+i, col);
+		}
+	}
+
+	return result;
+}
+
+SGVector<float64_t> CCustomKernel::get_kernel_col(int32_t j)
+{
+	REQUIRE(has_kernel_matrix(), "The kernel matrix is not initialized!\n")
+
+	SGVector<float64_t> col(num_lhs);
+	index_t real_col=m_col_subset_stack->subset_idx_conversion(j);
+
+	for (index_t i=0; i<num_lhs; i++)
+	{
+		float64_t value=get_element(
+				m_row_subset_stack->subset_idx_conversion(i), real_col);
+		col[i]=normalizer->normalize(value, i, j);
+	}
+
+	return col;
+}
+
+SGVector<float64_t> CCustomKernel::get_kernel_row(int32_t i)
+{
+	REQUIRE(has_kernel_matrix(), "The kernel matrix is not initialized!\n")
+
+	SGVector<float64_t> row(num_rhs);
+	index_t real_row=m_row_subset_stack->subset_idx_conversion(i);
+
+	for (index_t j=0; j<num_rhs; j++)
+	{
+		float64_t value=get_element(real_row,
+				m_col_subset_stack->subset_idx_conversion(j));
+		row[j]=normalizer->normalize(value, i, j);
+	}
+
+	return row;
 }
@@ -19,8 +19,26 @@
 #include <shogun/kernel/Kernel.h>
 #include <shogun/features/Features.h>
 
+/** number of rows and cols of a tile of the tiled custom kernel layouts */
+#define CUSTOM_KERNEL_TILE_SIZE 64
+
 namespace shogun
 {
+template <class T> class CMemoryMappedFile;
+
+/** layout in which CCustomKernel stores its kernel matrix */
+enum ECustomKernelStorage
+{
+	/** full matrix of 32bit floats, column by column */
+	CKS_FULL=0,
+	/** upper triangle of 32bit floats, row by row */
+	CKS_UPPER_TRIANGLE=1,
+	/** full matrix of 32bit floats, in square tiles */
+	CKS_TILED=2,
+	/** full matrix of 16bit brain floats (bfloat16), in square tiles */
+	CKS_TILED_BF16=3
+};
+
 /** @brief The Custom Kernel allows for custom user provided kernel matrices.
  *
  * For squared training matrices it allows to store only the upper triangle of
@@ -28,6 +46,16 @@ namespace shogun
  * is or can be internally converted into (or directly given in) upper triangle
  * representation. Also note that values are stored as 32bit floats.
  *
+ * With set_storage() the matrix can also be kept in square tiles, so that
+ * rows, columns and blocks are all read from a few contiguous pieces of
+ * memory, and the tiles can be compressed to bfloat16, which halves the
+ * memory at a relative precision of about 1e-2.
+ *
+ * A kernel matrix written with save_kernel_matrix() in any of these layouts
+ * can be loaded with load_kernel_matrix(), which maps the file read-only
+ * instead of reading it. Processes that load the same file share its pages,
+ * and matrices larger than the memory are paged in on demand.
+ *
  * The custom kernel supports subsets each on the rows and the columns. See
  * documentation in CFeatures, CLabels how this works. The interface is similar.
  *
@@ -183,6 +211,7 @@ class CCustomKernel: public CKernel
 
 			kmatrix=SGMatrix<float32_t>(SG_MALLOC(float32_t, len), cols, cols);
 			upper_diagonal=true;
+			m_storage=CKS_UPPER_TRIANGLE;
 
 			for (int64_t i=0; i<len; i++)
 				kmatrix.matrix[i]=tri_kernel_matrix.vector[i];
@@ -233,6 +262,7 @@ class CCustomKernel: public CKernel
 
 			kmatrix=SGMatrix<float32_t>(SG_MALLOC(float32_t, cols*(cols+1)/2), rows, cols);
 			upper_diagonal = true;
+			m_storage=CKS_UPPER_TRIANGLE;
 
 			for (int64_t row=0; row<rows; row++)
 			{
@@ -318,6 +348,66 @@ class CCustomKernel: public CKernel
 			return true;
 		}
 
+		/** convert the kernel matrix to another storage layout
+		 *
+		 * works NOT with subset
+		 *
+		 * @param storage the new layout, CKS_UPPER_TRIANGLE requires a
+		 * symmetric kernel matrix
+		 */
+		void set_storage(ECustomKernelStorage storage);
+
+		/** @return storage layout of the kernel matrix */
+		ECustomKernelStorage get_storage() const
+		{
+			return m_storage;
+		}
+
+		/** write the kernel matrix in its current storage layout to a file
+		 * that load_kernel_matrix() maps
+		 *
+		 * works NOT with subset
+		 *
+		 * @param filename name of the file
+		 */
+		void save_kernel_matrix(const char* filename);
+
+		/** set the kernel matrix from a file written by save_kernel_matrix(),
+		 * mapping it read-only instead of reading it into memory
+		 *
+		 * works NOT with subset
+		 *
+		 * @param filename name of the file
+		 * @return if loading was successful
+		 */
+		bool load_kernel_matrix(const char* filename);
+
+		/** get a block of the kernel matrix, from any storage layout
+		 *
+		 * works NOT with subset
+		 *
+		 * @param block_begin_row the row index at which the block starts
+		 * @param block_begin_col the col index at which the block starts
+		 * @param block_size_row the number of rows in the block
+		 * @param block_size_col the number of cols in the block
+		 * @return the block, not normalized
+		 */
+		SGMatrix<float32_t> get_float32_kernel_block(index_t block_begin_row,
+				index_t block_begin_col, index_t block_size_row,
+				index_t block_size_col);
+
+		/** get column j, reading the stored kernel matrix directly
+		 *
+		 * @return the jth column of the kernel matrix
+		 */
+		virtual SGVector<float64_t> get_kernel_col(int32_t j);
+
+		/** get row i, reading the stored kernel matrix directly
+		 *
+		 * @return the ith row of the kernel matrix
+		 */
+		virtual SGVector<float64_t> get_kernel_row(int32_t i);
+
 		/**
 		 * Overrides the sum_symmetric_block method of CKernel to compute the
 		 * sum directly from the precomputed kernel matrix.
@@ -541,7 +631,9 @@ class CCustomKernel: public CKernel
 			return (get_num_vec_lhs()>0) && (get_num_vec_rhs()>0);
 		}
 
-		/** returns kernel matrix as is (not possible with subset)
+		/** returns kernel matrix as is (not possible with subset), or a
+		 * full copy of it for the tiled layouts and for a matrix mapped
+		 * read-only by load_kernel_matrix()
 		 *
 		 * @return kernel matrix
 		 */
@@ -559,6 +651,13 @@ class CCustomKernel: public CKernel
 					"get_kernel_matrix() and the SGMatrix constructor!\n",
 					get_name(), get_name());
 
+			if (m_storage==CKS_TILED || m_storage==CKS_TILED_BF16)
+				return get_float32_kernel_block(0, 0, m_num_rows, m_num_cols);
+
+			// writing to the mapping would crash
+			if (m_mapped_file)
+				return kmatrix.clone();
+
 			return kmatrix;
 		}
 
@@ -574,27 +673,86 @@ class CCustomKernel: public CKernel
 		 */
 		virtual float64_t compute(int32_t row, int32_t col)
 		{
-			REQUIRE(kmatrix.matrix, "%s::compute(%d, %d): No kenrel matrix "
+			REQUIRE(has_kernel_matrix(), "%s::compute(%d, %d): No kenrel matrix "
 					"set!\n", get_name(), row, col);
 
 			index_t real_row=m_row_subset_stack->subset_idx_conversion(row);
 			index_t real_col=m_col_subset_stack->subset_idx_conversion(col);
 
-			if (upper_diagonal)
+			return get_element(real_row, real_col);
+		}
+
+		/** @return whether a kernel matrix is stored */
+		inline bool has_kernel_matrix() const
+		{
+			return kmatrix.matrix || m_tiles.vector || m_bf16_tiles.vector;
+		}
+
+		/** element of the stored kernel matrix, without subsets
+		 *
+		 * @param real_row row in the stored matrix
+		 * @param real_col col in the stored matrix
+		 * @return the element
+		 */
+		inline float32_t get_element(index_t real_row, index_t real_col) const
+		{
+			switch (m_storage)
 			{
-				if (real_row <= real_col)
-				{
-					int64_t r=real_row;
-					return kmatrix.matrix[r*kmatrix.num_rows - r*(r+1)/2 + real_col];
-				}
-				else
-				{
-					int64_t c=real_col;
-					return kmatrix.matrix[c*kmatrix.num_cols - c*(c+1)/2 + real_row];
-				}
+				case CKS_UPPER_TRIANGLE:
+					if (real_row <= real_col)
+					{
+						int64_t r=real_row;
+						return kmatrix.matrix[r*kmatrix.num_rows - r*(r+1)/2 + real_col];
+					}
+					else
+					{
+						int64_t c=real_col;
+						return kmatrix.matrix[c*kmatrix.num_cols - c*(c+1)/2 + real_row];
+					}
+				case CKS_TILED:
+					return m_tiles.vector[get_tile_index(real_row, real_col)];
+				case CKS_TILED_BF16:
+					return bf16_to_float32(m_bf16_tiles.vector[
+							get_tile_index(real_row, real_col)]);
+				default:
+					return kmatrix.matrix[int64_t(real_col)*kmatrix.num_rows + real_row];
 			}
-			else
-				return kmatrix(real_row, real_col);
+		}
+
+		/** position of an element in the tiled layouts, tiles are stored
+		 * column by column and so are the elements in a tile
+		 *
+		 * @param real_row row in the stored matrix
+		 * @param real_col col in the stored matrix
+		 * @return the position
+		 */
+		inline int64_t get_tile_index(index_t real_row, index_t real_col) const
+		{
+			int64_t num_tile_rows=(m_num_rows+CUSTOM_KERNEL_TILE_SIZE-1)/
+				CUSTOM_KERNEL_TILE_SIZE;
+			int64_t tile=(real_col/CUSTOM_KERNEL_TILE_SIZE)*num_tile_rows+
+				real_row/CUSTOM_KERNEL_TILE_SIZE;
+			return tile*CUSTOM_KERNEL_TILE_SIZE*CUSTOM_KERNEL_TILE_SIZE+
+				(real_col%CUSTOM_KERNEL_TILE_SIZE)*CUSTOM_KERNEL_TILE_SIZE+
+				real_row%CUSTOM_KERNEL_TILE_SIZE;
+		}
+
+		/** @return float of a bfloat16 */
+		static inline float32_t bf16_to_float32(uint16_t value)
+		{
+			uint32_t bits=uint32_t(value)<<16;
+			float32_t result;
+			memcpy(&result, &bits, sizeof(result));
+			return result;
+		}
+
+		/** @return bfloat16 of a float, rounded to nearest even */
+		static inline uint16_t float32_to_bf16(float32_t value)
+		{
+			uint32_t bits;
+			memcpy(&bits, &value, sizeof(bits));
+			bits+=0x7FFF+((bits>>16)&1);
+			return uint16_t(bits>>16);
 		}
 
 	protected:
@@ -616,6 +774,24 @@ class CCustomKernel: public CKernel
 
 		/** indicates whether kernel matrix is to be freed in destructor */
 		bool m_free_km;
+
+		/** storage layout of the kernel matrix */
+		ECustomKernelStorage m_storage;
+
+		/** number of rows of the stored kernel matrix */
+		index_t m_num_rows;
+
+		/** number of cols of the stored kernel matrix */
+		index_t m_num_cols;
+
+		/** tiles of the kernel matrix, for CKS_TILED */
+		SGVector<float32_t> m_tiles;
+
+		/** tiles of the kernel matrix, for CKS_TILED_BF16 */
+		SGVector<uint16_t> m_bf16_tiles;
+
+		/** file the kernel matrix is mapped from, if any */
+		CMemoryMappedFile<uint8_t>* m_mapped_file;
 };
 
 }
@@ -13,7 +13,7 @@
 #include <shogun/kernel/ExponentialARDKernel.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/mathematics/Math.h>
-#include <shogun/mathematics/linalg/LinalgNamespace.h>
+#include <shogun/mathematics/linalg/LinalgExpression.h>
 
 using namespace shogun;
 
@@ -230,8 +230,11 @@ SGMatrix<float64_t> CExponentialARDKernel::get_weighted_vector(SGVector<float64_
 	else
 	{
 		SGMatrix<float64_t> rtmp(vec.vector,vec.vlen,1,false);
-		SGMatrix<float64_t> weights(linalg::exponent(m_log_weights));
-		res = linalg::element_prod(weights, rtmp);
+		res=SGMatrix<float64_t>(vec.vlen,1);
+		// res = exp(log_weights) .* vec in a single pass
+		linalg::eval(linalg::element_prod(
+			linalg::exponent(linalg::lazy(m_log_weights)),
+			linalg::lazy(rtmp)), res);
 	}
 	return res;
 }
@@ -132,6 +132,28 @@ float64_t CGaussianKernel::compute(int32_t idx_a, int32_t idx_b)
     return CMath::exp(-result);
 }
 
+void CGaussianKernel::compute_block(SGMatrix<float64_t>& block,
+		index_t lhs_start, index_t lhs_stop, index_t rhs_start, index_t rhs_stop)
+{
+	// subclasses override compute() with a different kernel function
+	if (get_kernel_type()!=K_GAUSSIAN)
+	{
+		CKernel::compute_block(block, lhs_start, lhs_stop, rhs_start, rhs_stop);
+		return;
+	}
+
+	distance_block(block, lhs_start, lhs_stop, rhs_start, rhs_stop);
+
+	const float64_t inv_width=1.0/get_width();
+	for (index_t j=0; j<block.num_cols; j++)
+	{
+		for (index_t i=0; i<block.num_rows; i++)
+			block(i,j)=CMath::exp(-block(i,j)*inv_width);
+	}
+
+	normalize_block(block, lhs_start, rhs_start);
+}
+
 void CGaussianKernel::load_serializable_post() throw (ShogunException)
 {
 	CKernel::load_serializable_post();
@@ -777,6 +777,7 @@ void CKernel::list_kernel()
 		ENUM_CASE(C_FACTOR_GRAPH)
 		ENUM_CASE(C_INDEX)
 		ENUM_CASE(C_SUB_SAMPLES_DENSE)
+		ENUM_CASE(C_QUANTIZED_DENSE)
 		ENUM_CASE(C_ANY)
 	}
 
@@ -947,6 +948,8 @@ void CKernel::register_params()   {
 	SG_ADD(&properties, "properties", "Kernel properties.", MS_NOT_AVAILABLE);
 	SG_ADD((CSGObject**) &normalizer, "normalizer", "Normalize the kernel.",
 	    MS_AVAILABLE);
+	SG_ADD(&m_block_size, "block_size",
+		"Number of vectors per tile of the kernel matrix.", MS_NOT_AVAILABLE);
 }
 
 
@@ -964,6 +967,7 @@ void CKernel::init()
 	opt_type=FASTBUTMEMHUNGRY;
 	properties=KP_NONE;
 	normalizer=NULL;
+	m_block_size=128;
 
 #ifdef USE_SVMLIGHT
 	memset(&kernel_cache, 0x0, sizeof(KERNEL_CACHE));
@@ -972,34 +976,6 @@ void CKernel::init()
 	set_normalizer(new CIdentityKernelNormalizer());
 }
 
-namespace shogun
-{
-/** kernel thread parameters */
-template <class T> struct K_THREAD_PARAM
-{
-	/** kernel */
-	CKernel* kernel;
-	/** start (unit row) */
-	int32_t start;
-	/** end (unit row) */
-	int32_t end;
-	/** start (unit number of elements) */
-	int64_t total_start;
-	/** m */
-	int32_t m;
-	/** n */
-	int32_t n;
-	/** result */
-	T* result;
-	/** kernel matrix k(i,j)=k(j,i) */
-	bool symmetric;
-	/** output progress */
-	bool verbose;
-	/* Progress bar*/
-	PRange<int64_t>* pb;
-};
-}
-
 float64_t CKernel::sum_symmetric_block(index_t block_begin, index_t block_size,
 		bool no_diag)
 {
@@ -1263,119 +1239,90 @@ SGVector<float64_t> CKernel::row_col_wise_sum_block(index_t block_begin_row,
 	return sum;
 }
 
-template <class T> void* CKernel::get_kernel_matrix_helper(void* p)
+void CKernel::compute_block(SGMatrix<float64_t>& block,
+		index_t lhs_start, index_t lhs_stop, index_t rhs_start, index_t rhs_stop)
 {
-	K_THREAD_PARAM<T>* params= (K_THREAD_PARAM<T>*) p;
-	int32_t i_start=params->start;
-	int32_t i_end=params->end;
-	CKernel* k=params->kernel;
-	T* result=params->result;
-	bool symmetric=params->symmetric;
-	int32_t n=params->n;
-	int32_t m=params->m;
-	bool verbose=params->verbose;
-	int64_t total_start=params->total_start;
-	int64_t total=total_start;
-	PRange<int64_t>* pb = params->pb;
-
-	for (int32_t i=i_start; i<i_end; i++)
+	for (index_t j=rhs_start; j<rhs_stop; j++)
 	{
-		int32_t j_start=0;
-
-		if (symmetric)
-			j_start=i;
-
-		for (int32_t j=j_start; j<n; j++)
-		{
-			float64_t v=k->kernel(i,j);
-			result[i+j*m]=v;
-
-			if (symmetric && i!=j)
-				result[j+i*m]=v;
-
-			if (verbose)
-			{
-				total++;
-
-				if (symmetric && i!=j)
-					total++;
-
-				pb->print_progress();
-
-				// TODO: replace with the new signal
-				// if (CSignal::cancel_computations())
-				//	break;
-			}
-		}
-
+		for (index_t i=lhs_start; i<lhs_stop; i++)
+			block(i-lhs_start, j-rhs_start)=kernel(i, j);
 	}
+}
 
-	return NULL;
+void CKernel::normalize_block(SGMatrix<float64_t>& block,
+		index_t lhs_start, index_t rhs_start)
+{
+	for (index_t j=0; j<block.num_cols; j++)
+	{
+		for (index_t i=0; i<block.num_rows; i++)
+			block(i,j)=normalizer->normalize(block(i,j), i+lhs_start, j+rhs_start);
+	}
 }
 
 template <class T>
 SGMatrix<T> CKernel::get_kernel_matrix()
 {
-	T* result = NULL;
-
 	REQUIRE(has_features(), "no features assigned to kernel\n")
 
-	int32_t m=get_num_vec_lhs();
-	int32_t n=get_num_vec_rhs();
-
-	int64_t total_num = int64_t(m)*n;
+	const index_t m=get_num_vec_lhs();
+	const index_t n=get_num_vec_rhs();
 
 	// if lhs == rhs and sizes match assume k(i,j)=k(j,i)
-	bool symmetric= (lhs && lhs==rhs && m==n);
+	const bool symmetric= (lhs && lhs==rhs && m==n);
 
 	SG_DEBUG("returning kernel matrix of size %dx%d\n", m, n)
 
-	result=SG_MALLOC(T, total_num);
+	SGMatrix<T> result(m, n);
 
-	int32_t num_threads=parallel->get_num_threads();
-	K_THREAD_PARAM<T> params;
-	int64_t step = total_num/num_threads;
-	index_t t = 0;
-	auto pb = progress(range(total_num), *this->io);
-#pragma omp parallel for lastprivate(t) private(params)
-	for (t = 0; t < num_threads; ++t)
-	{
-		params.kernel = this;
-		params.result = result;
-		params.start = compute_row_start(t*step, n, symmetric);
-		params.end = compute_row_start((t+1)*step, n, symmetric);
-		params.total_start=t*step;
-		params.n=n;
-		params.m=m;
-		params.symmetric=symmetric;
-		params.verbose=false;
-		params.pb = &pb;
-		CKernel::get_kernel_matrix_helper<T>((void*)&params);
-	}
+	const index_t bs=m_block_size;
+	const index_t num_row_blocks=(m+bs-1)/bs;
+	const index_t num_col_blocks=(n+bs-1)/bs;
+	const int64_t num_blocks=int64_t(num_row_blocks)*num_col_blocks;
+
+	auto pb=progress(range(num_blocks), *this->io);
 
-	if (total_num % num_threads != 0)
+	#pragma omp parallel num_threads(parallel->get_num_threads())
 	{
-		params.kernel = this;
-		params.result = result;
-		params.start = compute_row_start(t*step, n, symmetric);
-		params.end = m;
-		params.total_start=t*step;
-		params.n=n;
-		params.m=m;
-		params.symmetric=symmetric;
-		params.verbose=false;
-		params.pb = &pb;
-		CKernel::get_kernel_matrix_helper<T>((void*)&params);
-	}
+		float64_t* buffer=SG_MALLOC(float64_t, int64_t(bs)*bs);
+
+		#pragma omp for schedule(dynamic)
+		for (int64_t b=0; b<num_blocks; b++)
+		{
+			index_t bi=b%num_row_blocks;
+			index_t bj=b/num_row_blocks;
+
+			if (symmetric && bi>bj)
+				continue;
+
+			index_t i_start=bi*bs;
+			index_t i_stop=CMath::min(i_start+bs, m);
+			index_t j_start=bj*bs;
+			index_t j_stop=CMath::min(j_start+bs, n);
 
+			SGMatrix<float64_t> block(buffer, i_stop-i_start, j_stop-j_start, false);
+			compute_block(block, i_start, i_stop, j_start, j_stop);
+
+			for (index_t j=j_start; j<j_stop; j++)
+			{
+				for (index_t i=i_start; i<i_stop; i++)
+				{
+					T v=block(i-i_start, j-j_start);
+					result(i,j)=v;
+					if (symmetric)
+						result(j,i)=v;
+				}
+			}
+
+			pb.print_progress();
+		}
+
+		SG_FREE(buffer);
+	}
 	pb.complete();
 
-	return SGMatrix<T>(result,m,n,true);
+	return result;
 }
 
 
 template SGMatrix<float64_t> CKernel::get_kernel_matrix<float64_t>();
 template SGMatrix<float32_t> CKernel::get_kernel_matrix<float32_t>();
-
-template void* CKernel::get_kernel_matrix_helper<float64_t>(void* p);
-template void* CKernel::get_kernel_matrix_helper<float32_t>(void* p);
@@ -443,11 +443,32 @@ class CKernel : public CSGObject
 				bool no_diag=false);
 
 		/** get kernel matrix (templated)
+		 *
+		 * The matrix is computed in tiles of get_block_size() vectors
+		 * which are distributed over all threads. If lhs and rhs are the
+		 * same only the upper triangle of tiles is computed.
 		 *
 		 * @return the kernel matrix
 		 */
 		template <class T> SGMatrix<T> get_kernel_matrix();
 
+		/** set the number of vectors per tile side used when computing
+		 * the kernel matrix
+		 *
+		 * @param block_size tile size
+		 */
+		void set_block_size(int32_t block_size)
+		{
+			REQUIRE(block_size>0, "Block size (%d) must be positive!\n", block_size)
+			m_block_size=block_size;
+		}
+
+		/** @return number of vectors per tile side */
+		int32_t get_block_size() const
+		{
+			return m_block_size;
+		}
+
 		/** initialize kernel
 		 *  e.g. setup lhs/rhs of kernel, precompute normalization
 		 *  constants etc.
@@ -910,29 +931,34 @@ class CKernel : public CSGObject
 		 */
 		virtual float64_t compute(int32_t x, int32_t y)=0;
 
-		/** compute row start offset for parallel kernel matrix computation
+		/** compute a tile of the normalized kernel matrix, i.e.
+		 * block(i-lhs_start, j-rhs_start)=kernel(i, j) for all lhs vectors
+		 * i in [lhs_start, lhs_stop) and rhs vectors j in
+		 * [rhs_start, rhs_stop).
+		 *
+		 * The default evaluates kernel() for every pair. Kernels that can
+		 * compute a whole tile at once, e.g. from a block of dot products,
+		 * override this.
 		 *
-		 * @param offs offset
-		 * @param n number of columns
-		 * @param symmetric whether matrix is symmetric
+		 * @param block output of size (lhs_stop-lhs_start) x (rhs_stop-rhs_start)
+		 * @param lhs_start first lhs vector
+		 * @param lhs_stop one past the last lhs vector
+		 * @param rhs_start first rhs vector
+		 * @param rhs_stop one past the last rhs vector
 		 */
-		int32_t compute_row_start(int64_t offs, int32_t n, bool symmetric)
-		{
-			int32_t i_start;
-
-			if (symmetric)
-				i_start=(int32_t) CMath::floor(n-CMath::sqrt(CMath::sq((float64_t) n)-offs));
-			else
-				i_start=(int32_t) (offs/int64_t(n));
-
-			return i_start;
-		}
+		virtual void compute_block(SGMatrix<float64_t>& block,
+				index_t lhs_start, index_t lhs_stop,
+				index_t rhs_start, index_t rhs_stop);
 
-		/** helper for computing the kernel matrix in a parallel way
+		/** apply the kernel normalizer to a tile of unnormalized kernel
+		 * values as computed by compute()
 		 *
-		 * @param p thread parameters
+		 * @param block tile of kernel values, normalized in place
+		 * @param lhs_start lhs index of the first row of the tile
+		 * @param rhs_start rhs index of the first column of the tile
 		 */
-		template <class T> static void* get_kernel_matrix_helper(void* p);
+		void normalize_block(SGMatrix<float64_t>& block,
+				index_t lhs_start, index_t rhs_start);
 
 		/** Can (optionally) be overridden to post-initialize some member
 		 *  variables which are not PARAMETER::ADD'ed.  Make sure that at
@@ -1084,6 +1110,9 @@ class CKernel : public CSGObject
 		/** normalize the kernel(i,j) function based on this normalization
 		 * function */
 		CKernelNormalizer* normalizer;
+
+		/** number of vectors per tile side of the kernel matrix */
+		int32_t m_block_size;
 };
 
 }
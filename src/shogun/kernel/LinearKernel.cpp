@@ -96,3 +96,11 @@ float64_t CLinearKernel::compute_optimized(int32_t idx)
 		dense_dot(idx, normal.vector, normal.size());
 	return normalizer->normalize_rhs(result, idx);
 }
+
+void CLinearKernel::compute_block(SGMatrix<float64_t>& block,
+		index_t lhs_start, index_t lhs_stop, index_t rhs_start, index_t rhs_stop)
+{
+	((CDotFeatures*) lhs)->dot_block(block, lhs_start, lhs_stop,
+			(CDotFeatures*) rhs, rhs_start, rhs_stop);
+	normalize_block(block, lhs_start, rhs_start);
+}
@@ -65,6 +65,28 @@ float64_t CPolyKernel::compute(int32_t idx_a, int32_t idx_b)
 	return CMath::pow(result, degree);
 }
 
+void CPolyKernel::compute_block(SGMatrix<float64_t>& block,
+		index_t lhs_start, index_t lhs_stop, index_t rhs_start, index_t rhs_stop)
+{
+	((CDotFeatures*) lhs)->dot_block(block, lhs_start, lhs_stop,
+			(CDotFeatures*) rhs, rhs_start, rhs_stop);
+
+	for (index_t j=0; j<block.num_cols; j++)
+	{
+		for (index_t i=0; i<block.num_rows; i++)
+		{
+			float64_t result=block(i,j);
+
+			if (inhomogene)
+				result+=1;
+
+			block(i,j)=CMath::pow(result, degree);
+		}
+	}
+
+	normalize_block(block, lhs_start, rhs_start);
+}
+
 void CPolyKernel::init()
 {
 	set_normalizer(new CSqrtDiagKernelNormalizer());
@@ -99,6 +99,19 @@ class CPolyKernel: public CDotKernel
 		 */
 		virtual float64_t compute(int32_t idx_a, int32_t idx_b);
 
+		/** compute a tile of the kernel matrix from one block of dot
+		 * products, see CDotFeatures::dot_block()
+		 *
+		 * @param block output of size (lhs_stop-lhs_start) x (rhs_stop-rhs_start)
+		 * @param lhs_start first lhs vector
+		 * @param lhs_stop one past the last lhs vector
+		 * @param rhs_start first rhs vector
+		 * @param rhs_stop one past the last rhs vector
+		 */
+		virtual void compute_block(SGMatrix<float64_t>& block,
+				index_t lhs_start, index_t lhs_stop,
+				index_t rhs_start, index_t rhs_stop);
+
 	private:
 		void init();
 
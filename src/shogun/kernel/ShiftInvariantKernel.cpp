@@ -100,6 +100,23 @@ float64_t CShiftInvariantKernel::distance(int32_t a, int32_t b) const
 		return m_distance->distance(a, b);
 }
 
+void CShiftInvariantKernel::distance_block(SGMatrix<float64_t>& block,
+		index_t lhs_start, index_t lhs_stop, index_t rhs_start, index_t rhs_stop) const
+{
+	REQUIRE(m_distance, "The distance instance cannot be NULL!\n");
+	if (m_precomputed_distance==NULL)
+	{
+		m_distance->get_distance_block(block, lhs_start, lhs_stop, rhs_start, rhs_stop);
+		return;
+	}
+
+	for (index_t j=rhs_start; j<rhs_stop; j++)
+	{
+		for (index_t i=lhs_start; i<lhs_stop; i++)
+			block(i-lhs_start, j-rhs_start)=m_precomputed_distance->distance(i, j);
+	}
+}
+
 void CShiftInvariantKernel::register_params()
 {
 	SG_ADD((CSGObject**) &m_distance, "m_distance", "Distance to be used.", MS_NOT_AVAILABLE);
@@ -131,6 +131,21 @@ protected:
 	 */
 	virtual float64_t distance(int32_t idx_a, int32_t idx_b) const;
 
+	/**
+	 * Computes the distances between the lhs vectors [lhs_start, lhs_stop)
+	 * and the rhs vectors [rhs_start, rhs_stop), from the precomputed
+	 * distance if there is one.
+	 *
+	 * @param block output of size (lhs_stop-lhs_start) x (rhs_stop-rhs_start)
+	 * @param lhs_start first lhs vector
+	 * @param lhs_stop one past the last lhs vector
+	 * @param rhs_start first rhs vector
+	 * @param rhs_stop one past the last rhs vector
+	 */
+	void distance_block(SGMatrix<float64_t>& block,
+			index_t lhs_start, index_t lhs_stop,
+			index_t rhs_start, index_t rhs_stop) const;
+
 	/** Distance instance for the kernel. MUST be initialized by the subclasses */
 	CDistance* m_distance;
 
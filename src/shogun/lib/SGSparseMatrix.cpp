@@ -4,6 +4,9 @@
 #include <shogun/io/File.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/io/LibSVMFile.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/base/init.h>
+#include <shogun/base/Parallel.h>
 
 namespace shogun {
 
@@ -18,21 +21,46 @@ SGSparseMatrix<T>::SGSparseMatrix(SGSparseVector<T>* vecs, index_t num_feat,
 		index_t num_vec, bool ref_counting) :
 	SGReferencedData(ref_counting),
 	num_vectors(num_vec), num_features(num_feat),
-	sparse_matrix(vecs)
+	sparse_matrix(vecs), compressed_entries(NULL), compressed_offsets(NULL)
 {
 }
 
 template <class T>
 SGSparseMatrix<T>::SGSparseMatrix(index_t num_feat, index_t num_vec, bool ref_counting) :
 	SGReferencedData(ref_counting),
-	num_vectors(num_vec), num_features(num_feat)
+	num_vectors(num_vec), num_features(num_feat),
+	compressed_entries(NULL), compressed_offsets(NULL)
+{
+	sparse_matrix=SG_MALLOC(SGSparseVector<T>, num_vectors);
+}
+
+template <class T>
+SGSparseMatrix<T>::SGSparseMatrix(index_t num_feat, SGVector<int64_t> offsets)
+	: SGReferencedData()
 {
+	REQUIRE(offsets.vlen>0, "Offsets of at least one vector required!\n");
+
+	num_features=num_feat;
+	num_vectors=offsets.vlen-1;
+	compressed_offsets=SG_MALLOC(int64_t, offsets.vlen);
+	sg_memcpy(compressed_offsets, offsets.vector, sizeof(int64_t)*offsets.vlen);
+	compressed_entries=SG_MALLOC(SGSparseVectorEntry<T>,
+			compressed_offsets[num_vectors]);
 	sparse_matrix=SG_MALLOC(SGSparseVector<T>, num_vectors);
+
+	for (index_t i=0; i<num_vectors; i++)
+	{
+		REQUIRE(compressed_offsets[i]<=compressed_offsets[i+1],
+				"Offsets have to be non-decreasing!\n");
+		sparse_matrix[i]=SGSparseVector<T>(compressed_entries+compressed_offsets[i],
+				compressed_offsets[i+1]-compressed_offsets[i], false);
+	}
 }
 
 template <class T>
 SGSparseMatrix<T>::SGSparseMatrix(SGMatrix<T> dense) : SGReferencedData()
 {
+	init_data();
 	from_dense(dense);
 }
 
@@ -96,6 +124,9 @@ void SGSparseMatrix<T>::load(CFile* loader)
 	SG_SET_LOCALE_C;
 	loader->get_sparse_matrix(sparse_matrix, num_features, num_vectors);
 	SG_RESET_LOCALE;
+
+	// replace the separately allocated vectors by one block
+	*this=get_compressed();
 }
 
 template<>
@@ -117,6 +148,9 @@ template<class T> SGVector<float64_t> SGSparseMatrix<T>::load_with_labels(CLibSV
 	if (do_sort_features)
 		sort_features();
 
+	// replace the separately allocated vectors by one block
+	*this=get_compressed();
+
 	return labels;
 }
 
@@ -161,6 +195,8 @@ void SGSparseMatrix<T>::copy_data(const SGReferencedData& orig)
 	sparse_matrix = ((SGSparseMatrix*)(&orig))->sparse_matrix;
 	num_vectors = ((SGSparseMatrix*)(&orig))->num_vectors;
 	num_features = ((SGSparseMatrix*)(&orig))->num_features;
+	compressed_entries = ((SGSparseMatrix*)(&orig))->compressed_entries;
+	compressed_offsets = ((SGSparseMatrix*)(&orig))->compressed_offsets;
 }
 
 template <class T>
@@ -169,64 +205,186 @@ void SGSparseMatrix<T>::init_data()
 	sparse_matrix = NULL;
 	num_vectors = 0;
 	num_features = 0;
+	compressed_entries = NULL;
+	compressed_offsets = NULL;
 }
 
 template <class T>
 void SGSparseMatrix<T>::free_data()
 {
 	SG_FREE(sparse_matrix);
+	SG_FREE(compressed_entries);
+	SG_FREE(compressed_offsets);
 	num_vectors = 0;
 	num_features = 0;
 }
 
-template<class T> SGSparseMatrix<T> SGSparseMatrix<T>::get_transposed()
+template <class T>
+void SGSparseMatrix<T>::detach_vector(index_t index)
 {
-	SGSparseMatrix<T> sfm(num_vectors, num_features);
+	SGSparseVector<T>& vec=sparse_matrix[index];
 
-	int32_t* hist=SG_CALLOC(int32_t, num_features);
+	if (!compressed_entries || vec.features<compressed_entries ||
+			vec.features>=compressed_entries+compressed_offsets[num_vectors])
+		return;
 
-	// count the lengths of future feature vectors
-	for (int32_t v=0; v<num_vectors; v++)
+	SGSparseVector<T> copy(vec.num_feat_entries);
+	sg_memcpy(copy.features, vec.features,
+			sizeof(SGSparseVectorEntry<T>)*vec.num_feat_entries);
+	vec=copy;
+}
+
+template <class T>
+bool SGSparseMatrix<T>::is_compressed() const
+{
+	if (!compressed_entries)
+		return false;
+
+	// vectors may have been replaced since the block was set up
+	for (index_t i=0; i<num_vectors; i++)
 	{
-		SGSparseVector<T> sv=sparse_matrix[v];
+		if (sparse_matrix[i].features!=compressed_entries+compressed_offsets[i] ||
+				sparse_matrix[i].num_feat_entries!=
+				compressed_offsets[i+1]-compressed_offsets[i])
+			return false;
+	}
+
+	return true;
+}
 
-		for (int32_t i=0; i<sv.num_feat_entries; i++)
-			hist[sv.features[i].feat_index]++;
+template <class T>
+SGSparseMatrix<T> SGSparseMatrix<T>::get_compressed() const
+{
+	SGVector<int64_t> offsets(num_vectors+1);
+	offsets[0]=0;
+	for (index_t i=0; i<num_vectors; i++)
+		offsets[i+1]=offsets[i]+sparse_matrix[i].num_feat_entries;
+
+	SGSparseMatrix<T> result(num_features, offsets);
+
+	Parallel* parallel=get_global_parallel();
+	int32_t num_threads=parallel->get_num_threads();
+	SG_UNREF(parallel);
+
+	#pragma omp parallel for num_threads(num_threads)
+	for (index_t i=0; i<num_vectors; i++)
+	{
+		sg_memcpy(result.sparse_matrix[i].features, sparse_matrix[i].features,
+				sizeof(SGSparseVectorEntry<T>)*sparse_matrix[i].num_feat_entries);
 	}
 
-	for (int32_t v=0; v<num_features; v++)
-		sfm[v]=SGSparseVector<T>(hist[v]);
+	return result;
+}
 
-	SG_FREE(hist);
+template<class T> SGSparseMatrix<T> SGSparseMatrix<T>::get_transposed()
+{
+	Parallel* parallel=get_global_parallel();
+	int32_t num_threads=CMath::max(1, CMath::min(parallel->get_num_threads(),
+			num_vectors));
+	SG_UNREF(parallel);
+
+	// every thread transposes a contiguous range of vectors, the entries it
+	// writes into a future feature vector follow those of the threads before,
+	// which keeps the entries sorted by vector index
+	int64_t* hist=SG_CALLOC(int64_t, int64_t(num_threads)*num_features);
+
+	// count the lengths of future feature vectors per thread
+	#pragma omp parallel for num_threads(num_threads)
+	for (int32_t t=0; t<num_threads; t++)
+	{
+		int64_t* thread_hist=hist+int64_t(t)*num_features;
+		index_t begin=int64_t(num_vectors)*t/num_threads;
+		index_t end=int64_t(num_vectors)*(t+1)/num_threads;
+
+		for (index_t v=begin; v<end; v++)
+		{
+			const SGSparseVector<T>& sv=sparse_matrix[v];
+
+			for (index_t i=0; i<sv.num_feat_entries; i++)
+				thread_hist[sv.features[i].feat_index]++;
+		}
+	}
+
+	// turn the counts into the positions at which every thread starts
+	SGVector<int64_t> offsets(num_features+1);
+	int64_t num_entries=0;
+	for (index_t f=0; f<num_features; f++)
+	{
+		offsets[f]=num_entries;
+		for (int32_t t=0; t<num_threads; t++)
+		{
+			int64_t count=hist[int64_t(t)*num_features+f];
+			hist[int64_t(t)*num_features+f]=num_entries;
+			num_entries+=count;
+		}
+	}
+	offsets[num_features]=num_entries;
 
-	int32_t* index=SG_CALLOC(int32_t, num_features);
+	SGSparseMatrix<T> sfm(num_vectors, offsets);
 
 	// fill future feature vectors with content
-	for (int32_t v=0; v<num_vectors; v++)
+	#pragma omp parallel for num_threads(num_threads)
+	for (int32_t t=0; t<num_threads; t++)
 	{
-		SGSparseVector<T> sv=sparse_matrix[v];
+		int64_t* index=hist+int64_t(t)*num_features;
+		index_t begin=int64_t(num_vectors)*t/num_threads;
+		index_t end=int64_t(num_vectors)*(t+1)/num_threads;
 
-		for (int32_t i=0; i<sv.num_feat_entries; i++)
+		for (index_t v=begin; v<end; v++)
 		{
-			int32_t vidx=sv.features[i].feat_index;
-			int32_t fidx=v;
-			sfm[vidx].features[index[vidx]].feat_index=fidx;
-			sfm[vidx].features[index[vidx]].entry=sv.features[i].entry;
-			index[vidx]++;
+			const SGSparseVector<T>& sv=sparse_matrix[v];
+
+			for (index_t i=0; i<sv.num_feat_entries; i++)
+			{
+				SGSparseVectorEntry<T>& entry=
+					sfm.compressed_entries[index[sv.features[i].feat_index]++];
+				entry.feat_index=v;
+				entry.entry=sv.features[i].entry;
+			}
 		}
 	}
 
-	SG_FREE(index);
+	SG_FREE(hist);
 	return sfm;
 }
 
 
 template<class T> void SGSparseMatrix<T>::sort_features()
 {
+	bool compressed=is_compressed();
+
+	Parallel* parallel=get_global_parallel();
+	int32_t num_threads=parallel->get_num_threads();
+	SG_UNREF(parallel);
+
+	// views into the block of entries must keep their pointers
+	#pragma omp parallel for num_threads(num_threads)
 	for (int32_t i=0; i<num_vectors; i++)
 	{
-		sparse_matrix[i].sort_features();
+		sparse_matrix[i].sort_features(compressed);
 	}
+
+	if (!compressed)
+		return;
+
+	// close the gaps left by merged and removed entries
+	int64_t num_entries=0;
+	for (index_t i=0; i<num_vectors; i++)
+	{
+		SGSparseVector<T>& vec=sparse_matrix[i];
+		SGSparseVectorEntry<T>* features=compressed_entries+num_entries;
+
+		if (vec.features!=features)
+		{
+			memmove(features, vec.features,
+					sizeof(SGSparseVectorEntry<T>)*vec.num_feat_entries);
+			vec=SGSparseVector<T>(features, vec.num_feat_entries, false);
+		}
+
+		compressed_offsets[i]=num_entries;
+		num_entries+=vec.num_feat_entries;
+	}
+	compressed_offsets[num_vectors]=num_entries;
 }
 
 template<class T> void SGSparseMatrix<T>::from_dense(SGMatrix<T> full)
@@ -254,25 +412,27 @@ template<class T> void SGSparseMatrix<T>::from_dense(SGMatrix<T> full)
 		}
 	}
 
-	num_features=num_feat;
-	num_vectors=num_vec;
-	sparse_matrix=SG_MALLOC(SGSparseVector<T>,num_vec);
+	SGVector<int64_t> offsets(num_vec+1);
+	offsets[0]=0;
+	for (int32_t i=0; i<num_vec; i++)
+		offsets[i+1]=offsets[i]+num_feat_entries[i];
+	num_total_entries=offsets[num_vec];
+
+	*this=SGSparseMatrix<T>(num_feat, offsets);
 
 	for (int32_t i=0; i< num_vec; i++)
 	{
-		sparse_matrix[i]=SGSparseVector<T>(num_feat_entries[i]);
 		int32_t sparse_feat_idx=0;
 
 		for (int32_t j=0; j< num_feat; j++)
 		{
-			int64_t pos= i*num_feat + j;
+			int64_t pos= i*((int64_t) num_feat) + j;
 
 			if (src[pos] != static_cast<T>(0))
 			{
 				sparse_matrix[i].features[sparse_feat_idx].entry=src[pos];
 				sparse_matrix[i].features[sparse_feat_idx].feat_index=j;
 				sparse_feat_idx++;
-				num_total_entries++;
 			}
 		}
 	}
@@ -29,7 +29,15 @@ template<class T> class SGMatrix;
 class CFile;
 class CLibSVMFile;
 
-/** @brief template class SGSparseMatrix */
+/** @brief template class SGSparseMatrix
+ *
+ * By default every sparse vector owns its own reference counted block of
+ * entries. Matrices that are created from a dense matrix, transposed, copied
+ * with get_compressed() or created with the offsets constructor use
+ * compressed sparse row (CSR) storage instead: the entries of all vectors are
+ * stored in one block and the vectors are non reference counted views into
+ * it, which are valid as long as the matrix is.
+ */
 template <class T> class SGSparseMatrix : public SGReferencedData
 {
 	public:
@@ -49,6 +57,15 @@ template <class T> class SGSparseMatrix : public SGReferencedData
 		 */
 		SGSparseMatrix(SGMatrix<T> dense);
 
+		/** constructor to create a new matrix in compressed storage, the
+		 * entries are not initialized
+		 *
+		 * @param num_feat number of features
+		 * @param offsets offsets of the vectors in the block of entries
+		 * (num_vec+1 elements, the last one is the total number of entries)
+		 */
+		SGSparseMatrix(index_t num_feat, SGVector<int64_t> offsets);
+
 		/** copy constructor */
 		SGSparseMatrix(const SGSparseMatrix &orig);
 
@@ -138,6 +155,7 @@ template <class T> class SGSparseMatrix : public SGReferencedData
 				if (i_row==sparse_matrix[i_col].features[i].feat_index)
 					return sparse_matrix[i_col].features[i].entry;
 			}
+			detach_vector(i_col);
 			index_t j=sparse_matrix[i_col].num_feat_entries;
 			sparse_matrix[i_col].num_feat_entries=j+1;
 			sparse_matrix[i_col].features=SG_REALLOC(SGSparseVectorEntry<T>,
@@ -187,6 +205,23 @@ template <class T> class SGSparseMatrix : public SGReferencedData
 		/** sort the indices of the sparse matrix such that they are in ascending order */
 		void sort_features();
 
+		/** @return whether all vectors are views into one block of entries */
+		bool is_compressed() const;
+
+		/** copy the matrix into compressed storage
+		 *
+		 * @return compressed copy of the matrix
+		 */
+		SGSparseMatrix<T> get_compressed() const;
+
+		/** turn a vector that is a view into the block of entries into a
+		 * vector that owns its entries, which has to be done before the
+		 * entries of the vector are reallocated
+		 *
+		 * @param index index of the vector
+		 */
+		void detach_vector(index_t index);
+
 protected:
 
 		/** copy data */
@@ -209,6 +244,12 @@ public:
 	/// array of sparse vectors of size num_vectors
 	SGSparseVector<T>* sparse_matrix;
 
+	/// block of entries of all vectors in compressed storage, NULL otherwise
+	SGSparseVectorEntry<T>* compressed_entries;
+
+	/// offsets of the vectors in compressed_entries (num_vectors+1 elements)
+	int64_t* compressed_offsets;
+
 };
 }
 #endif // __SGSPARSEMATRIX_H__
@@ -62,13 +62,28 @@ T SGSparseVector<T>::dense_dot(T alpha, T * vec, int32_t dim, T b)
 
 	if (features)
 	{
-		for (int32_t i = 0; i < num_feat_entries; i++)
+		// independent partial sums let the gathers of consecutive entries
+		// overlap instead of waiting for the previous addition
+		T sum[4] = {0, 0, 0, 0};
+		int32_t i = 0;
+
+		for (; i + 4 <= num_feat_entries; i += 4)
 		{
-			if (features[i].feat_index < dim)
+			for (int32_t k = 0; k < 4; k++)
 			{
-				result += alpha * vec[features[i].feat_index] * features[i].entry;
+				index_t idx = features[i + k].feat_index;
+				if (idx < dim)
+					sum[k] += vec[idx] * features[i + k].entry;
 			}
 		}
+
+		for (; i < num_feat_entries; i++)
+		{
+			if (features[i].feat_index < dim)
+				sum[0] += vec[features[i].feat_index] * features[i].entry;
+		}
+
+		result += alpha * ((sum[0] + sum[1]) + (sum[2] + sum[3]));
 	}
 
 	return result;
@@ -79,19 +94,27 @@ void SGSparseVector<T>::add_to_dense(T alpha, T * vec, int32_t dim, bool abs_val
 {
 	REQUIRE(vec, "vec must not be NULL\n");
 
-	if (abs_val)
+	// the products of four entries are formed before any of them is stored,
+	// the stores stay in order so that repeated feature indices add up
+	T val[4];
+	int32_t i = 0;
+
+	for (; i + 4 <= num_feat_entries; i += 4)
 	{
-		for (int32_t i = 0; i < num_feat_entries; i++)
+		for (int32_t k = 0; k < 4; k++)
 		{
-			vec[features[i].feat_index] += alpha*CMath::abs(features[i].entry);
+			val[k] = abs_val ? alpha*CMath::abs(features[i + k].entry) :
+				alpha*features[i + k].entry;
 		}
+
+		for (int32_t k = 0; k < 4; k++)
+			vec[features[i + k].feat_index] += val[k];
 	}
-	else
+
+	for (; i < num_feat_entries; i++)
 	{
-		for (int32_t i = 0; i < num_feat_entries; i++)
-		{
-			vec[features[i].feat_index] += alpha*features[i].entry;
-		}
+		vec[features[i].feat_index] += abs_val ?
+			alpha*CMath::abs(features[i].entry) : alpha*features[i].entry;
 	}
 }
 
@@ -138,26 +161,71 @@ T SGSparseVector<T>::sparse_dot(const SGSparseVector<T> &a, const SGSparseVector
 		return dot_prod_expensive_unsorted(a, b);
 	}
 
+	// a vector that is much shorter than the other is intersected with it by
+	// galloping search instead of merging
+	if (a.num_feat_entries * SPARSE_DOT_GALLOP_RATIO < b.num_feat_entries)
+		return sparse_dot_galloping(a, b);
+
+	if (b.num_feat_entries * SPARSE_DOT_GALLOP_RATIO < a.num_feat_entries)
+		return sparse_dot_galloping(b, a);
+
 	T dot_prod = 0;
 	index_t a_idx = 0, b_idx = 0;
+	const SGSparseVectorEntry<T>* a_features = a.features;
+	const SGSparseVectorEntry<T>* b_features = b.features;
 
+	// the indices advance without branches, which would be mispredicted
+	// about every other step when the two index sets interleave
 	while (a_idx < a.num_feat_entries && b_idx < b.num_feat_entries)
 	{
-		if (a.features[a_idx].feat_index < b.features[b_idx].feat_index)
+		const index_t a_feat = a_features[a_idx].feat_index;
+		const index_t b_feat = b_features[b_idx].feat_index;
+
+		if (a_feat == b_feat)
+			dot_prod += a_features[a_idx].entry * b_features[b_idx].entry;
+
+		a_idx += a_feat <= b_feat;
+		b_idx += b_feat <= a_feat;
+	}
+
+	return dot_prod;
+}
+
+template <class T>
+T SGSparseVector<T>::sparse_dot_galloping(const SGSparseVector<T>& a,
+		const SGSparseVector<T>& b)
+{
+	T dot_prod = 0;
+	index_t b_idx = 0;
+
+	for (index_t a_idx = 0; a_idx < a.num_feat_entries; a_idx++)
+	{
+		const index_t feat = a.features[a_idx].feat_index;
+
+		// double the step until the index is passed, then bisect
+		index_t step = 1;
+		while (b_idx + step < b.num_feat_entries &&
+				b.features[b_idx + step].feat_index < feat)
 		{
-			a_idx++;
+			b_idx += step;
+			step *= 2;
 		}
-		else if (a.features[a_idx].feat_index > b.features[b_idx].feat_index)
+
+		index_t hi = CMath::min(b_idx + step, b.num_feat_entries);
+		while (b_idx < hi)
 		{
-			b_idx++;
+			index_t mid = b_idx + (hi - b_idx) / 2;
+			if (b.features[mid].feat_index < feat)
+				b_idx = mid + 1;
+			else
+				hi = mid;
 		}
-		else
-		{
-			// a.features[a_idx].feat_index == b.features[b_idx].feat_index
+
+		if (b_idx == b.num_feat_entries)
+			break;
+
+		if (b.features[b_idx].feat_index == feat)
 			dot_prod += a.features[a_idx].entry * b.features[b_idx].entry;
-			a_idx++;
-			b_idx++;
-		}
 	}
 
 	return dot_prod;
@@ -250,8 +318,8 @@ void SGSparseVector<T>::sort_features(bool stable_pointer)
 	int32_t new_feat_count = last_index + 1;
 	ASSERT(new_feat_count <= num_feat_entries);
 
-	// shrinking vector
-	if (!stable_pointer)
+	// shrinking vector, only possible if the vector owns its entries
+	if (!stable_pointer && ref_count() >= 0)
 	{
 		SG_SINFO("shrinking vector from %d to %d\n", num_feat_entries, new_feat_count);
 		features = SG_REALLOC(SGSparseVectorEntry<T>, features, num_feat_entries, new_feat_count);
@@ -19,6 +19,10 @@
 #include <shogun/lib/SGReferencedData.h>
 #include <shogun/lib/SGVector.h>
 
+/** length ratio above which the sparse dot product of sorted vectors
+ * searches the entries of the shorter vector in the longer one */
+#define SPARSE_DOT_GALLOP_RATIO 16
+
 namespace shogun
 {
 	class CFile;
@@ -207,6 +211,16 @@ protected:
 	 */
 	static T dot_prod_expensive_unsorted(const SGSparseVector<T>& a, const SGSparseVector<T>& b);
 
+	/** helper function to compute the dot product of sorted sparse vectors
+	 * by searching the entries of the short vector a in the long vector b
+	 *
+	 * @param a short vector
+	 * @param b long vector
+	 *
+	 * @return dot product
+	 */
+	static T sparse_dot_galloping(const SGSparseVector<T>& a, const SGSparseVector<T>& b);
+
 public:
 	/** number of feature entries */
 	index_t num_feat_entries;
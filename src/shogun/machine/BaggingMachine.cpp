@@ -176,16 +176,24 @@ bool CBaggingMachine::train_machine(CFeatures* data)
 	SG_UNREF(m_oob_indices);
 	m_oob_indices = new CDynamicObjectArray();
 
-	SGMatrix<index_t> rnd_indicies(m_bag_size, m_num_bags);
-	for (index_t i = 0; i < m_num_bags*m_bag_size; ++i)
-		rnd_indicies.matrix[i] = CMath::random(0, m_bag_size-1);
+	// every bag draws from its own stream and is stored at its own position,
+	// so the result does not depend on the number of threads
+	const uint64_t seed = m_random_seed ? m_random_seed : CMath::random();
+	for (int32_t i = 0; i < m_num_bags; ++i)
+	{
+		m_bags->push_back(NULL);
+		m_oob_indices->push_back(NULL);
+	}
 
 	#pragma omp parallel for
 	for (int32_t i = 0; i < m_num_bags; ++i)
 	{
 		CMachine* c=dynamic_cast<CMachine*>(m_machine->clone());
 		ASSERT(c != NULL);
-		SGVector<index_t> idx(rnd_indicies.get_column_vector(i), m_bag_size, false);
+		RandomStream rng(seed, i);
+		SGVector<index_t> idx(m_bag_size);
+		for (index_t j = 0; j < m_bag_size; ++j)
+			idx[j] = rng.random(0, m_bag_size-1);
 
 		CFeatures* features;
 		CLabels* labels;
@@ -219,7 +227,7 @@ bool CBaggingMachine::train_machine(CFeatures* data)
 		}
 		*/
 		features->add_subset(idx);
-		set_machine_parameters(c,idx);
+		set_machine_parameters(c, idx, rng);
 		c->set_labels(labels);
 		c->train(features);
 		features->remove_subset();
@@ -229,10 +237,10 @@ bool CBaggingMachine::train_machine(CFeatures* data)
 		{
 		// get out of bag indexes
 		CDynamicArray<index_t>* oob = get_oob_indices(idx);
-		m_oob_indices->push_back(oob);
+		m_oob_indices->set_element(oob, i);
 
 		// add trained machine to bag array
-		m_bags->push_back(c);
+		m_bags->set_element(c, i);
 		}
 
 		if (get_global_parallel()->get_num_threads()!=1)
@@ -251,12 +259,19 @@ void CBaggingMachine::set_machine_parameters(CMachine* m, SGVector<index_t> idx)
 {
 }
 
+void CBaggingMachine::set_machine_parameters(CMachine* m, SGVector<index_t> idx,
+		RandomStream& rng)
+{
+	set_machine_parameters(m, idx);
+}
+
 void CBaggingMachine::register_parameters()
 {
 	SG_ADD((CSGObject**)&m_features, "features", "Train features for bagging",
 		MS_NOT_AVAILABLE);
 	SG_ADD(&m_num_bags, "num_bags", "Number of bags", MS_AVAILABLE);
 	SG_ADD(&m_bag_size, "bag_size", "Number of vectors per bag", MS_AVAILABLE);
+	SG_ADD(&m_random_seed, "random_seed", "Seed of the bags", MS_NOT_AVAILABLE);
 	SG_ADD((CSGObject**)&m_bags, "bags", "Bags array", MS_NOT_AVAILABLE);
 	SG_ADD((CSGObject**)&m_combination_rule, "combination_rule",
 		"Combination rule to use for aggregating", MS_AVAILABLE);
@@ -286,6 +301,16 @@ int32_t CBaggingMachine::get_bag_size() const
 	return m_bag_size;
 }
 
+void CBaggingMachine::set_random_seed(uint64_t seed)
+{
+	m_random_seed = seed;
+}
+
+uint64_t CBaggingMachine::get_random_seed() const
+{
+	return m_random_seed;
+}
+
 CMachine* CBaggingMachine::get_machine() const
 {
 	SG_REF(m_machine);
@@ -308,6 +333,7 @@ void CBaggingMachine::init()
 	m_labels = NULL;
 	m_num_bags = 0;
 	m_bag_size = 0;
+	m_random_seed = 0;
 	m_all_oob_idx = SGVector<bool>();
 	m_oob_indices = NULL;
 }
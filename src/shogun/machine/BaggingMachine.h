@@ -14,6 +14,7 @@
 #include <shogun/lib/config.h>
 
 #include <shogun/machine/Machine.h>
+#include <shogun/mathematics/RandomStream.h>
 
 namespace shogun
 {
@@ -74,6 +75,23 @@ namespace shogun
 			 */
 			virtual int32_t get_bag_size() const;
 
+			/**
+			 * Set the seed of the random streams the bags are drawn from.
+			 * Bag i draws from RandomStream(seed, i), so the bags do not
+			 * depend on the number of threads.
+			 *
+			 * @param seed seed of the bags, 0 draws a new seed from
+			 * CMath::random() on every call of train()
+			 */
+			void set_random_seed(uint64_t seed);
+
+			/**
+			 * Get the seed of the random streams the bags are drawn from
+			 *
+			 * @return seed of the bags, 0 if drawn on every train()
+			 */
+			uint64_t get_random_seed() const;
+
 			/**
 			 * Get machine for bagging
 			 *
@@ -131,6 +149,18 @@ namespace shogun
 			 */
 			virtual void set_machine_parameters(CMachine* m, SGVector<index_t> idx);
 
+			/**
+			 * sets parameters of CMachine that need randomness. The default
+			 * calls set_machine_parameters(m, idx), so subclasses that only
+			 * override the two argument version keep working.
+			 *
+			 * @param m machine
+			 * @param idx indices of training vectors chosen in current bag
+			 * @param rng random stream of the current bag
+			 */
+			virtual void set_machine_parameters(CMachine* m, SGVector<index_t> idx,
+					RandomStream& rng);
+
 			/** helper function for the apply_{regression,..} functions that
 			 * computes the output
 			 *
@@ -180,6 +210,9 @@ namespace shogun
 			/** number of vectors to use from the training features */
 			int32_t m_bag_size;
 
+			/** seed of the random streams of the bags, 0 if drawn per train */
+			uint64_t m_random_seed;
+
 			/** combination rule to use */
 			CCombinationRule* m_combination_rule;
 
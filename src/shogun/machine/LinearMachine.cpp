@@ -91,7 +91,18 @@ SGVector<float64_t> CLinearMachine::apply_get_outputs(CFeatures* data)
 	ASSERT(m_w.vlen==features->get_dim_feature_space())
 
 	float64_t* out=SG_MALLOC(float64_t, num);
-	features->dense_dot_range(out, 0, num, NULL, m_w.vector, m_w.vlen, bias);
+	if (features->get_feature_class()==C_DENSE &&
+		features->get_feature_type()==F_SHORTREAL)
+	{
+		// dense single precision features are scored with a float32 copy
+		// of w, the model itself stays in double
+		SGVector<float32_t> w(m_w.vlen);
+		for (index_t i=0; i<m_w.vlen; i++)
+			w[i]=m_w[i];
+		features->dense_dot_range_float32(out, 0, num, NULL, w.vector, w.vlen, bias);
+	}
+	else
+		features->dense_dot_range(out, 0, num, NULL, m_w.vector, m_w.vlen, bias);
 	return SGVector<float64_t>(out,num);
 }
 
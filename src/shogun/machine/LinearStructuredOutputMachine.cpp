@@ -11,6 +11,7 @@
 
 #include <shogun/machine/LinearStructuredOutputMachine.h>
 #include <shogun/features/Features.h>
+#include <shogun/mathematics/Math.h>
 
 using namespace shogun;
 
@@ -59,12 +60,22 @@ CStructuredLabels* CLinearStructuredOutputMachine::apply_structured(CFeatures* d
 	CStructuredLabels* out;
 	out = m_model->structured_labels_factory(num_input_vectors);
 
-	for ( int32_t i = 0 ; i < num_input_vectors ; ++i )
+	for ( int32_t block_start = 0 ; block_start < num_input_vectors ; block_start += CStructuredModel::ARGMAX_BLOCK_SIZE )
 	{
-		CResultSet* result = m_model->argmax(m_w, i, false);
-		out->add_label(result->argmax);
+		int32_t block_size = CMath::min(CStructuredModel::ARGMAX_BLOCK_SIZE, num_input_vectors-block_start);
+		SGVector< int32_t > block_idxs(block_size);
+		block_idxs.range_fill(block_start);
+		CDynamicObjectArray* results = m_model->argmax_batch(m_w, block_idxs, false);
 
-		SG_UNREF(result);
+		for ( int32_t i = 0 ; i < block_size ; ++i )
+		{
+			CResultSet* result = (CResultSet*) results->get_element(i);
+			out->add_label(result->argmax);
+
+			SG_UNREF(result);
+		}
+
+		SG_UNREF(results);
 	}
 	SG_UNREF(model_features);
 	return out;
@@ -141,12 +141,18 @@ public:
 protected:
 
 	virtual bool train_machine(CFeatures* data=NULL);
+
+	using CBaggingMachine::set_machine_parameters;
+
 	/** sets parameters of CARTree - sets machine labels and weights here
 	 *
 	 * @param m machine
 	 * @param idx indices of training vectors chosen in current bag
+	 * @param rng random stream of the current bag, seeds the feature
+	 * sampling of the tree
 	 */
-	virtual void set_machine_parameters(CMachine* m, SGVector<index_t> idx);
+	virtual void set_machine_parameters(CMachine* m, SGVector<index_t> idx,
+			RandomStream& rng);
 
 private:
 	/** initialize parameters */
@@ -25,6 +25,7 @@
 #include <shogun/lib/common.h>
 #include <shogun/base/Parallel.h>
 #include <shogun/mathematics/Random.h>
+#include <shogun/mathematics/RandomStream.h>
 #include <shogun/lib/SGVector.h>
 #include <algorithm>
 
@@ -1031,6 +1032,18 @@ class CMath : public CSGObject
 				}
 			}
 
+		/** Permute randomly the elements of the vector with a random
+		 * stream, e.g. one per thread or task of a parallel loop.
+		 *
+		 * @param v the vector to permute.
+		 * @param rng random stream to generate the permutation with.
+		 */
+		template <class T>
+			static void permute(SGVector<T> v, RandomStream& rng)
+			{
+				rng.permute(v.vector, v.vlen);
+			}
+
 		/** Computes sum of non-zero elements
 		 * @param vec vector
 		 * @param len length
@@ -0,0 +1,67 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/mathematics/RandomStream.h>
+#include <shogun/mathematics/Math.h>
+
+using namespace shogun;
+
+float64_t RandomStream::std_normal_distrib()
+{
+	if (m_has_normal)
+	{
+		m_has_normal=false;
+		return m_normal;
+	}
+
+	// Box-Muller transform, the second value is kept for the next call
+	const float64_t radius=CMath::sqrt(-2.0*CMath::log(random_open()));
+	const float64_t angle=2.0*CMath::PI*random_half_open();
+	m_normal=radius*CMath::sin(angle);
+	m_has_normal=true;
+
+	return radius*CMath::cos(angle);
+}
+
+void RandomStream::fill_array_co(float64_t* array, index_t size)
+{
+	const index_t num_blocks=size/2;
+	const uint64_t counter=m_counter;
+
+	for (index_t b=0; b<num_blocks; b++)
+	{
+		uint32_t block[4];
+		generate_block(counter+b, block);
+		array[2*b]=to_half_open((uint64_t(block[1])<<32) | block[0]);
+		array[2*b+1]=to_half_open((uint64_t(block[3])<<32) | block[2]);
+	}
+
+	m_counter+=num_blocks;
+	if (size%2)
+		array[size-1]=random_half_open();
+}
+
+void RandomStream::fill_array_normal(float64_t* array, index_t size,
+		float64_t mu, float64_t sigma)
+{
+	const index_t num_blocks=size/2;
+	const uint64_t counter=m_counter;
+
+	for (index_t b=0; b<num_blocks; b++)
+	{
+		uint32_t block[4];
+		generate_block(counter+b, block);
+		const float64_t u=to_open((uint64_t(block[1])<<32) | block[0]);
+		const float64_t v=to_half_open((uint64_t(block[3])<<32) | block[2]);
+
+		const float64_t radius=sigma*CMath::sqrt(-2.0*CMath::log(u));
+		const float64_t angle=2.0*CMath::PI*v;
+		array[2*b]=mu+radius*CMath::cos(angle);
+		array[2*b+1]=mu+radius*CMath::sin(angle);
+	}
+
+	m_counter+=num_blocks;
+	if (size%2)
+		array[size-1]=normal_distrib(mu, sigma);
+}
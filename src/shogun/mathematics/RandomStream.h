@@ -0,0 +1,257 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef __RANDOMSTREAM_H__
+#define __RANDOMSTREAM_H__
+
+#include <shogun/lib/config.h>
+#include <shogun/lib/common.h>
+
+namespace shogun
+{
+
+/** @brief Counter-based pseudo random number generator (Philox4x32-10).
+ *
+ * The n-th block of four 32-bit outputs of a stream is a bijection of the
+ * 128-bit counter (n, stream) keyed with the 64-bit seed. Streams with
+ * different ids are therefore independent, need no shared state and can
+ * jump to any position in constant time. This makes them suitable for
+ * parallel code: instead of drawing from the locked global generator
+ * (sg_rand) every task creates its own stream
+ *
+ * @code
+ * const uint64_t seed=CMath::random();
+ * #pragma omp parallel for
+ * for (index_t i=0; i<num_tasks; i++)
+ * {
+ *     RandomStream rng(seed, i);
+ *     ...
+ * }
+ * @endcode
+ *
+ * Keying the streams by task instead of by thread keeps results identical
+ * for any number of threads, and seeding them from CMath::random() keeps
+ * them reproducible with CMath::init_random().
+ *
+ * See Salmon et al., Parallel Random Numbers: As Easy as 1, 2, 3 (2011).
+ */
+class RandomStream
+{
+public:
+	/** constructor
+	 *
+	 * @param seed key of the generator
+	 * @param stream id of the stream
+	 */
+	RandomStream(uint64_t seed=0, uint64_t stream=0)
+	{
+		set_seed(seed, stream);
+	}
+
+	/** restart the generator at the beginning of a stream
+	 *
+	 * @param seed key of the generator
+	 * @param stream id of the stream
+	 */
+	void set_seed(uint64_t seed, uint64_t stream=0)
+	{
+		m_key[0]=uint32_t(seed);
+		m_key[1]=uint32_t(seed>>32);
+		m_stream[0]=uint32_t(stream);
+		m_stream[1]=uint32_t(stream>>32);
+		m_counter=0;
+		m_buffer_pos=4;
+		m_has_normal=false;
+	}
+
+	/** skip blocks of four 32-bit outputs in constant time
+	 *
+	 * @param num_blocks number of blocks to skip
+	 */
+	void discard(uint64_t num_blocks)
+	{
+		m_counter+=num_blocks;
+		m_buffer_pos=4;
+		m_has_normal=false;
+	}
+
+	/** @return 32-bit random integer */
+	inline uint32_t random_32()
+	{
+		if (m_buffer_pos==4)
+		{
+			generate_block(m_counter++, m_buffer);
+			m_buffer_pos=0;
+		}
+		return m_buffer[m_buffer_pos++];
+	}
+
+	/** @return 64-bit random integer */
+	inline uint64_t random_64()
+	{
+		uint64_t lo=random_32();
+		return (uint64_t(random_32())<<32) | lo;
+	}
+
+	/** @return random integer in [min_value, max_value] */
+	inline int32_t random(int32_t min_value, int32_t max_value)
+	{
+		return min_value+int32_t(random_32()%uint32_t(max_value-min_value+1));
+	}
+
+	/** @return random integer in [min_value, max_value] */
+	inline uint32_t random(uint32_t min_value, uint32_t max_value)
+	{
+		return min_value+random_32()%(max_value-min_value+1);
+	}
+
+	/** @return random integer in [min_value, max_value] */
+	inline int64_t random(int64_t min_value, int64_t max_value)
+	{
+		return min_value+int64_t(random_64()%uint64_t(max_value-min_value+1));
+	}
+
+	/** @return random integer in [min_value, max_value] */
+	inline uint64_t random(uint64_t min_value, uint64_t max_value)
+	{
+		return min_value+random_64()%(max_value-min_value+1);
+	}
+
+	/** @return random number in [min_value, max_value) */
+	inline float64_t random(float64_t min_value, float64_t max_value)
+	{
+		return min_value+(max_value-min_value)*random_half_open();
+	}
+
+	/** @return random number in [min_value, max_value) */
+	inline float32_t random(float32_t min_value, float32_t max_value)
+	{
+		return min_value+(max_value-min_value)*float32_t(random_half_open());
+	}
+
+	/** @return random number in [0, 1) */
+	inline float64_t random_half_open()
+	{
+		return to_half_open(random_64());
+	}
+
+	/** @return random number in (0, 1) */
+	inline float64_t random_open()
+	{
+		return to_open(random_64());
+	}
+
+	/** @return standard normal random number */
+	float64_t std_normal_distrib();
+
+	/** @return normal random number with mean mu and standard deviation
+	 * sigma
+	 */
+	inline float64_t normal_distrib(float64_t mu, float64_t sigma)
+	{
+		return mu+sigma*std_normal_distrib();
+	}
+
+	/** fill an array with random numbers in [0, 1)
+	 *
+	 * Whole blocks of the stream are generated independently of each
+	 * other, which lets the compiler vectorise the loop.
+	 *
+	 * @param array output
+	 * @param size number of elements
+	 */
+	void fill_array_co(float64_t* array, index_t size);
+
+	/** fill an array with normal random numbers
+	 *
+	 * @param array output
+	 * @param size number of elements
+	 * @param mu mean
+	 * @param sigma standard deviation
+	 */
+	void fill_array_normal(float64_t* array, index_t size,
+			float64_t mu=0.0, float64_t sigma=1.0);
+
+	/** random permutation of an array (Fisher-Yates)
+	 *
+	 * @param v array to permute
+	 * @param len length of the array
+	 */
+	template <class T>
+	void permute(T* v, index_t len)
+	{
+		for (index_t i=0; i<len; ++i)
+		{
+			index_t j=random(i, len-1);
+			T tmp=v[i];
+			v[i]=v[j];
+			v[j]=tmp;
+		}
+	}
+
+protected:
+	/** compute block counter of the stream, i.e. apply ten Philox rounds
+	 * to the counter (counter, stream)
+	 *
+	 * @param counter block counter
+	 * @param out four 32-bit outputs
+	 */
+	inline void generate_block(uint64_t counter, uint32_t* out) const
+	{
+		uint32_t c0=uint32_t(counter);
+		uint32_t c1=uint32_t(counter>>32);
+		uint32_t c2=m_stream[0];
+		uint32_t c3=m_stream[1];
+		uint32_t k0=m_key[0];
+		uint32_t k1=m_key[1];
+
+		for (int32_t round=0; round<10; round++)
+		{
+			const uint64_t p0=uint64_t(0xD2511F53)*c0;
+			const uint64_t p1=uint64_t(0xCD9E8D57)*c2;
+			c0=uint32_t(p1>>32)^c1^k0;
+			c1=uint32_t(p1);
+			c2=uint32_t(p0>>32)^c3^k1;
+			c3=uint32_t(p0);
+			k0+=0x9E3779B9;
+			k1+=0xBB67AE85;
+		}
+
+		out[0]=c0;
+		out[1]=c1;
+		out[2]=c2;
+		out[3]=c3;
+	}
+
+	/** @return the 53 high bits of x as number in [0, 1) */
+	static inline float64_t to_half_open(uint64_t x)
+	{
+		return (x>>11)*(1.0/9007199254740992.0);
+	}
+
+	/** @return the 52 high bits of x as number in (0, 1) */
+	static inline float64_t to_open(uint64_t x)
+	{
+		return ((x>>12)+0.5)*(1.0/4503599627370496.0);
+	}
+
+private:
+	/** key */
+	uint32_t m_key[2];
+	/** high half of the counter, fixed per stream */
+	uint32_t m_stream[2];
+	/** next block */
+	uint64_t m_counter;
+	/** outputs of the current block */
+	uint32_t m_buffer[4];
+	/** next unused output of the current block */
+	int32_t m_buffer_pos;
+	/** whether m_normal holds the second value of a Box-Muller pair */
+	bool m_has_normal;
+	/** cached normal random number */
+	float64_t m_normal;
+};
+
+}
+#endif /* __RANDOMSTREAM_H__ */
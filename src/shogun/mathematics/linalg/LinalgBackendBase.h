@@ -36,6 +36,7 @@
 #include <memory>
 #include <shogun/io/SGIO.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGSparseMatrix.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/common.h>
 #include <shogun/lib/config.h>
@@ -346,6 +347,22 @@ namespace shogun
 		DEFINE_FOR_ALL_PTYPE(BACKEND_GENERIC_IN_PLACE_MATRIX_PROD, SGMatrix)
 #undef BACKEND_GENERIC_IN_PLACE_MATRIX_PROD
 
+/**
+ * Wrapper method of sparse matrix times dense vector or matrix product.
+ *
+ * @see linalg::matrix_prod
+ */
+#define BACKEND_GENERIC_SPARSE_MATRIX_PROD(Type, Container)                    \
+	virtual void matrix_prod(                                                  \
+	    const SGSparseMatrix<Type>& a, const Container<Type>& b,               \
+	    Container<Type>& result, bool transpose_A) const                       \
+	{                                                                          \
+		SG_SNOTIMPLEMENTED;                                                    \
+	}
+		DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_SPARSE_MATRIX_PROD, SGVector)
+		DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_SPARSE_MATRIX_PROD, SGMatrix)
+#undef BACKEND_GENERIC_SPARSE_MATRIX_PROD
+
 /**
  * Wrapper method of max method. Return the largest element in a vector or
  * matrix.
@@ -485,6 +502,20 @@ namespace shogun
 		DEFINE_FOR_ALL_PTYPE(BACKEND_GENERIC_IN_PLACE_SCALE, SGMatrix)
 #undef BACKEND_GENERIC_IN_PLACE_SCALE
 
+/**
+ * Wrapper method of sparse matrix scale operation result = alpha*A.
+ *
+ * @see linalg::scale
+ */
+#define BACKEND_GENERIC_SPARSE_SCALE(Type, Container)                          \
+	virtual void scale(                                                        \
+	    const Container<Type>& a, Type alpha, Container<Type>& result) const   \
+	{                                                                          \
+		SG_SNOTIMPLEMENTED;                                                    \
+	}
+		DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_SPARSE_SCALE, SGSparseMatrix)
+#undef BACKEND_GENERIC_SPARSE_SCALE
+
 /**
  * Wrapper method that sets const values to vectors or matrices.
  *
@@ -646,6 +677,66 @@ namespace shogun
 		DEFINE_FOR_ALL_PTYPE(BACKEND_GENERIC_BLOCK_ROWWISE_SUM, SGMatrix)
 #undef BACKEND_GENERIC_BLOCK_ROWWISE_SUM
 
+/**
+ * Wrapper method of sparse matrix colwise sum.
+ *
+ * @see linalg::colwise_sum
+ */
+#define BACKEND_GENERIC_SPARSE_COLWISE_SUM(Type, Container)                    \
+	virtual SGVector<Type> colwise_sum(const Container<Type>& a) const         \
+	{                                                                          \
+		SG_SNOTIMPLEMENTED;                                                    \
+		return 0;                                                              \
+	}
+		DEFINE_FOR_NON_INTEGER_PTYPE(
+		    BACKEND_GENERIC_SPARSE_COLWISE_SUM, SGSparseMatrix)
+#undef BACKEND_GENERIC_SPARSE_COLWISE_SUM
+
+/**
+ * Wrapper method of sparse matrix rowwise sum.
+ *
+ * @see linalg::rowwise_sum
+ */
+#define BACKEND_GENERIC_SPARSE_ROWWISE_SUM(Type, Container)                    \
+	virtual SGVector<Type> rowwise_sum(const Container<Type>& a) const         \
+	{                                                                          \
+		SG_SNOTIMPLEMENTED;                                                    \
+		return 0;                                                              \
+	}
+		DEFINE_FOR_NON_INTEGER_PTYPE(
+		    BACKEND_GENERIC_SPARSE_ROWWISE_SUM, SGSparseMatrix)
+#undef BACKEND_GENERIC_SPARSE_ROWWISE_SUM
+
+/**
+ * Wrapper method of sparse matrix colwise Euclidean norm.
+ *
+ * @see linalg::colwise_norm
+ */
+#define BACKEND_GENERIC_SPARSE_COLWISE_NORM(Type, Container)                   \
+	virtual SGVector<Type> colwise_norm(const Container<Type>& a) const        \
+	{                                                                          \
+		SG_SNOTIMPLEMENTED;                                                    \
+		return 0;                                                              \
+	}
+		DEFINE_FOR_NON_INTEGER_PTYPE(
+		    BACKEND_GENERIC_SPARSE_COLWISE_NORM, SGSparseMatrix)
+#undef BACKEND_GENERIC_SPARSE_COLWISE_NORM
+
+/**
+ * Wrapper method of sparse matrix rowwise Euclidean norm.
+ *
+ * @see linalg::rowwise_norm
+ */
+#define BACKEND_GENERIC_SPARSE_ROWWISE_NORM(Type, Container)                   \
+	virtual SGVector<Type> rowwise_norm(const Container<Type>& a) const        \
+	{                                                                          \
+		SG_SNOTIMPLEMENTED;                                                    \
+		return 0;                                                              \
+	}
+		DEFINE_FOR_NON_INTEGER_PTYPE(
+		    BACKEND_GENERIC_SPARSE_ROWWISE_NORM, SGSparseMatrix)
+#undef BACKEND_GENERIC_SPARSE_ROWWISE_NORM
+
 /**
  * Wrapper method of svd computation.
  *
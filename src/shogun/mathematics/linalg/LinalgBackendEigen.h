@@ -178,6 +178,15 @@ namespace shogun
 		DEFINE_FOR_ALL_PTYPE(BACKEND_GENERIC_IN_PLACE_MATRIX_PROD, SGMatrix)
 #undef BACKEND_GENERIC_IN_PLACE_MATRIX_PROD
 
+/** Implementation of @see LinalgBackendBase::matrix_prod */
+#define BACKEND_GENERIC_SPARSE_MATRIX_PROD(Type, Container)                    \
+	virtual void matrix_prod(                                                  \
+	    const SGSparseMatrix<Type>& a, const Container<Type>& b,               \
+	    Container<Type>& result, bool transpose_A) const;
+		DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_SPARSE_MATRIX_PROD, SGVector)
+		DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_SPARSE_MATRIX_PROD, SGMatrix)
+#undef BACKEND_GENERIC_SPARSE_MATRIX_PROD
+
 /** Implementation of @see LinalgBackendBase::max */
 #define BACKEND_GENERIC_MAX(Type, Container)                                   \
 	virtual Type max(const Container<Type>& a) const;
@@ -245,6 +254,13 @@ namespace shogun
 		DEFINE_FOR_ALL_PTYPE(BACKEND_GENERIC_IN_PLACE_SCALE, SGMatrix)
 #undef BACKEND_GENERIC_IN_PLACE_SCALE
 
+/** Implementation of @see LinalgBackendBase::scale */
+#define BACKEND_GENERIC_SPARSE_SCALE(Type, Container)                          \
+	virtual void scale(                                                        \
+	    const Container<Type>& a, Type alpha, Container<Type>& result) const;
+		DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_SPARSE_SCALE, SGSparseMatrix)
+#undef BACKEND_GENERIC_SPARSE_SCALE
+
 /** Implementation of @see LinalgBackendBase::set_const */
 #define BACKEND_GENERIC_SET_CONST(Type, Container)                             \
 	virtual void set_const(Container<Type>& a, const Type value) const;
@@ -321,6 +337,34 @@ namespace shogun
 		DEFINE_FOR_ALL_PTYPE(BACKEND_GENERIC_BLOCK_ROWWISE_SUM, SGMatrix)
 #undef BACKEND_GENERIC_BLOCK_ROWWISE_SUM
 
+/** Implementation of @see LinalgBackendBase::colwise_sum */
+#define BACKEND_GENERIC_SPARSE_COLWISE_SUM(Type, Container)                    \
+	virtual SGVector<Type> colwise_sum(const Container<Type>& a) const;
+		DEFINE_FOR_NON_INTEGER_PTYPE(
+		    BACKEND_GENERIC_SPARSE_COLWISE_SUM, SGSparseMatrix)
+#undef BACKEND_GENERIC_SPARSE_COLWISE_SUM
+
+/** Implementation of @see LinalgBackendBase::rowwise_sum */
+#define BACKEND_GENERIC_SPARSE_ROWWISE_SUM(Type, Container)                    \
+	virtual SGVector<Type> rowwise_sum(const Container<Type>& a) const;
+		DEFINE_FOR_NON_INTEGER_PTYPE(
+		    BACKEND_GENERIC_SPARSE_ROWWISE_SUM, SGSparseMatrix)
+#undef BACKEND_GENERIC_SPARSE_ROWWISE_SUM
+
+/** Implementation of @see LinalgBackendBase::colwise_norm */
+#define BACKEND_GENERIC_SPARSE_COLWISE_NORM(Type, Container)                   \
+	virtual SGVector<Type> colwise_norm(const Container<Type>& a) const;
+		DEFINE_FOR_NON_INTEGER_PTYPE(
+		    BACKEND_GENERIC_SPARSE_COLWISE_NORM, SGSparseMatrix)
+#undef BACKEND_GENERIC_SPARSE_COLWISE_NORM
+
+/** Implementation of @see LinalgBackendBase::rowwise_norm */
+#define BACKEND_GENERIC_SPARSE_ROWWISE_NORM(Type, Container)                   \
+	virtual SGVector<Type> rowwise_norm(const Container<Type>& a) const;
+		DEFINE_FOR_NON_INTEGER_PTYPE(
+		    BACKEND_GENERIC_SPARSE_ROWWISE_NORM, SGSparseMatrix)
+#undef BACKEND_GENERIC_SPARSE_ROWWISE_NORM
+
 /** Implementation of @see LinalgBackendBase::svd */
 #define BACKEND_GENERIC_SVD(Type, Container)                                   \
 	virtual void svd(                                                          \
@@ -488,6 +532,18 @@ namespace shogun
 		    SGMatrix<T>& a, SGMatrix<T>& b, SGMatrix<T>& result,
 		    bool transpose_A, bool transpose_B) const;
 
+		/** Sparse matrix * dense vector in-place product method */
+		template <typename T>
+		void matrix_prod_impl(
+		    const SGSparseMatrix<T>& a, const SGVector<T>& b,
+		    SGVector<T>& result, bool transpose) const;
+
+		/** Sparse matrix * dense matrix in-place product method */
+		template <typename T>
+		void matrix_prod_impl(
+		    const SGSparseMatrix<T>& a, const SGMatrix<T>& b,
+		    SGMatrix<T>& result, bool transpose_A) const;
+
 		/** Return the largest element in the vector with Eigen3 library */
 		template <typename T>
 		T max_impl(const SGVector<T>& vec) const;
@@ -548,6 +604,11 @@ namespace shogun
 		template <typename T>
 		void scale_impl(SGMatrix<T>& a, T alpha, SGMatrix<T>& result) const;
 
+		/** Sparse matrix inplace scale method: result = alpha * A */
+		template <typename T>
+		void scale_impl(
+		    const SGSparseMatrix<T>& a, T alpha, SGSparseMatrix<T>& result) const;
+
 		/** Eigen3 set const method */
 		template <typename T, template <typename> class Container>
 		void set_const_impl(Container<T>& a, T value) const;
@@ -606,6 +667,22 @@ namespace shogun
 		SGVector<T> rowwise_sum_impl(
 		    const linalg::Block<SGMatrix<T>>& mat, bool no_diag) const;
 
+		/** Sparse matrix colwise sum method */
+		template <typename T>
+		SGVector<T> colwise_sum_impl(const SGSparseMatrix<T>& mat) const;
+
+		/** Sparse matrix rowwise sum method */
+		template <typename T>
+		SGVector<T> rowwise_sum_impl(const SGSparseMatrix<T>& mat) const;
+
+		/** Sparse matrix colwise Euclidean norm method */
+		template <typename T>
+		SGVector<T> colwise_norm_impl(const SGSparseMatrix<T>& mat) const;
+
+		/** Sparse matrix rowwise Euclidean norm method */
+		template <typename T>
+		SGVector<T> rowwise_norm_impl(const SGSparseMatrix<T>& mat) const;
+
 		/** Eigen3 compute svd method */
 		template <typename T>
 		void svd_impl(
@@ -0,0 +1,660 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef LINALG_EXPRESSION_H_
+#define LINALG_EXPRESSION_H_
+
+#include <shogun/base/Parallel.h>
+#include <shogun/base/init.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
+
+#include <cmath>
+
+namespace shogun
+{
+
+	namespace linalg
+	{
+
+		/** Minimal number of elements for which a fused expression is
+		 * evaluated with more than one thread
+		 */
+		const index_t EXPRESSION_PARALLEL_MIN_SIZE = 1 << 14;
+
+		/** @brief Base class of lazily evaluated elementwise linalg
+		 * expressions.
+		 *
+		 * The elementwise functions of this header (add, element_prod, scale,
+		 * add_scalar, exponent) do not compute anything when called with
+		 * expressions. They only record the operation, and the whole chain is
+		 * computed by @ref eval in a single (parallel) pass over memory,
+		 * without temporaries:
+		 *
+		 * @code
+		 * // result = k * (a .* b + c), one pass instead of three
+		 * linalg::eval(
+		 *     linalg::scale(
+		 *         linalg::add(
+		 *             linalg::element_prod(linalg::lazy(a), linalg::lazy(b)),
+		 *             linalg::lazy(c)),
+		 *         k),
+		 *     result);
+		 * @endcode
+		 *
+		 * Vectors and matrices enter an expression through @ref lazy; the
+		 * expression only holds references to their memory, so the operands
+		 * have to outlive its evaluation. The fused pass runs on the CPU.
+		 * If any operand lives on the GPU, the expression is evaluated node
+		 * by node through the operations of the GPU backend instead.
+		 *
+		 * Derived classes implement
+		 * - num_rows() and num_cols(), the shape of the expression,
+		 * - on_gpu(), whether any operand lives on the GPU,
+		 * - coeff(i), the i-th element (column-major) of the expression,
+		 * - eval_eager(result), evaluation through the backend.
+		 */
+		template <typename T, typename Derived>
+		class Expression
+		{
+		public:
+			/** @return the expression as its derived type */
+			const Derived& derived() const
+			{
+				return static_cast<const Derived&>(*this);
+			}
+
+			/** @return number of elements of the expression */
+			index_t size() const
+			{
+				return derived().num_rows() * derived().num_cols();
+			}
+
+			/** Evaluates the expression through the backend into a newly
+			 * allocated matrix on the device of the operands.
+			 *
+			 * @return the evaluated expression
+			 */
+			SGMatrix<T> materialize() const
+			{
+				SGMatrix<T> result(derived().num_rows(), derived().num_cols());
+				if (derived().on_gpu())
+					to_gpu(result, result);
+				derived().eval_eager(result);
+				return result;
+			}
+		};
+
+		/** @brief Leaf of an expression, a vector or matrix.
+		 *
+		 * Vectors are viewed as single-column matrices.
+		 */
+		template <typename T, template <typename> class Container>
+		class ContainerExpression
+		    : public Expression<T, ContainerExpression<T, Container>>
+		{
+		public:
+			/** type of a newly allocated result */
+			typedef Container<T> result_type;
+
+			/** constructor
+			 *
+			 * @param a vector or matrix
+			 */
+			ContainerExpression(const Container<T>& a)
+			    : m_matrix(as_matrix(a)), m_data(m_matrix.matrix)
+			{
+			}
+
+			/** @return number of rows */
+			index_t num_rows() const
+			{
+				return m_matrix.num_rows;
+			}
+
+			/** @return number of columns */
+			index_t num_cols() const
+			{
+				return m_matrix.num_cols;
+			}
+
+			/** @return whether the operand is on GPU */
+			bool on_gpu() const
+			{
+				return m_matrix.on_gpu();
+			}
+
+			/** @return i-th element */
+			T coeff(index_t i) const
+			{
+				return m_data[i];
+			}
+
+			/** Copies the operand into the result through the backend.
+			 *
+			 * @param result pre-allocated result
+			 */
+			void eval_eager(SGMatrix<T>& result) const
+			{
+				SGMatrix<T> a = m_matrix;
+				scale(a, result, (T)1);
+			}
+
+			/** @return the operand itself, nothing to evaluate */
+			SGMatrix<T> materialize() const
+			{
+				return m_matrix;
+			}
+
+		private:
+			static SGMatrix<T> as_matrix(const SGMatrix<T>& a)
+			{
+				return a;
+			}
+
+			static SGMatrix<T> as_matrix(const SGVector<T>& a)
+			{
+				return SGMatrix<T>(a);
+			}
+
+			/** operand, vectors as single column */
+			SGMatrix<T> m_matrix;
+			/** CPU memory of the operand */
+			const T* m_data;
+		};
+
+		/** @brief Expression alpha * A + beta * B */
+		template <typename T, typename L, typename R>
+		class AddExpression : public Expression<T, AddExpression<T, L, R>>
+		{
+		public:
+			/** type of a newly allocated result */
+			typedef typename L::result_type result_type;
+
+			/** constructor
+			 *
+			 * @param lhs first operand
+			 * @param rhs second operand
+			 * @param alpha constant to be multiplied by the first operand
+			 * @param beta constant to be multiplied by the second operand
+			 */
+			AddExpression(const L& lhs, const R& rhs, T alpha, T beta)
+			    : m_lhs(lhs), m_rhs(rhs), m_alpha(alpha), m_beta(beta)
+			{
+				REQUIRE(
+				    lhs.num_rows() == rhs.num_rows() &&
+				        lhs.num_cols() == rhs.num_cols(),
+				    "Dimension mismatch! A(%d x %d) vs B(%d x %d)\n",
+				    lhs.num_rows(), lhs.num_cols(), rhs.num_rows(),
+				    rhs.num_cols());
+			}
+
+			/** @return number of rows */
+			index_t num_rows() const
+			{
+				return m_lhs.num_rows();
+			}
+
+			/** @return number of columns */
+			index_t num_cols() const
+			{
+				return m_lhs.num_cols();
+			}
+
+			/** @return whether any operand is on GPU */
+			bool on_gpu() const
+			{
+				return m_lhs.on_gpu() || m_rhs.on_gpu();
+			}
+
+			/** @return i-th element */
+			T coeff(index_t i) const
+			{
+				return m_alpha * m_lhs.coeff(i) + m_beta * m_rhs.coeff(i);
+			}
+
+			/** Evaluates the expression through the backend.
+			 *
+			 * @param result pre-allocated result
+			 */
+			void eval_eager(SGMatrix<T>& result) const
+			{
+				SGMatrix<T> a = m_lhs.materialize();
+				SGMatrix<T> b = m_rhs.materialize();
+				add(a, b, result, m_alpha, m_beta);
+			}
+
+		private:
+			L m_lhs;
+			R m_rhs;
+			T m_alpha;
+			T m_beta;
+		};
+
+		/** @brief Expression A .* B, where ".*" denotes elementwise
+		 * multiplication
+		 */
+		template <typename T, typename L, typename R>
+		class ElementProdExpression
+		    : public Expression<T, ElementProdExpression<T, L, R>>
+		{
+		public:
+			/** type of a newly allocated result */
+			typedef typename L::result_type result_type;
+
+			/** constructor
+			 *
+			 * @param lhs first operand
+			 * @param rhs second operand
+			 */
+			ElementProdExpression(const L& lhs, const R& rhs)
+			    : m_lhs(lhs), m_rhs(rhs)
+			{
+				REQUIRE(
+				    lhs.num_rows() == rhs.num_rows() &&
+				        lhs.num_cols() == rhs.num_cols(),
+				    "Dimension mismatch! A(%d x %d) vs B(%d x %d)\n",
+				    lhs.num_rows(), lhs.num_cols(), rhs.num_rows(),
+				    rhs.num_cols());
+			}
+
+			/** @return number of rows */
+			index_t num_rows() const
+			{
+				return m_lhs.num_rows();
+			}
+
+			/** @return number of columns */
+			index_t num_cols() const
+			{
+				return m_lhs.num_cols();
+			}
+
+			/** @return whether any operand is on GPU */
+			bool on_gpu() const
+			{
+				return m_lhs.on_gpu() || m_rhs.on_gpu();
+			}
+
+			/** @return i-th element */
+			T coeff(index_t i) const
+			{
+				return m_lhs.coeff(i) * m_rhs.coeff(i);
+			}
+
+			/** Evaluates the expression through the backend.
+			 *
+			 * @param result pre-allocated result
+			 */
+			void eval_eager(SGMatrix<T>& result) const
+			{
+				SGMatrix<T> a = m_lhs.materialize();
+				SGMatrix<T> b = m_rhs.materialize();
+				element_prod(a, b, result);
+			}
+
+		private:
+			L m_lhs;
+			R m_rhs;
+		};
+
+		/** @brief Expression alpha * A */
+		template <typename T, typename E>
+		class ScaleExpression : public Expression<T, ScaleExpression<T, E>>
+		{
+		public:
+			/** type of a newly allocated result */
+			typedef typename E::result_type result_type;
+
+			/** constructor
+			 *
+			 * @param a operand
+			 * @param alpha scale factor
+			 */
+			ScaleExpression(const E& a, T alpha) : m_a(a), m_alpha(alpha)
+			{
+			}
+
+			/** @return number of rows */
+			index_t num_rows() const
+			{
+				return m_a.num_rows();
+			}
+
+			/** @return number of columns */
+			index_t num_cols() const
+			{
+				return m_a.num_cols();
+			}
+
+			/** @return whether the operand is on GPU */
+			bool on_gpu() const
+			{
+				return m_a.on_gpu();
+			}
+
+			/** @return i-th element */
+			T coeff(index_t i) const
+			{
+				return m_alpha * m_a.coeff(i);
+			}
+
+			/** Evaluates the expression through the backend.
+			 *
+			 * @param result pre-allocated result
+			 */
+			void eval_eager(SGMatrix<T>& result) const
+			{
+				SGMatrix<T> a = m_a.materialize();
+				scale(a, result, m_alpha);
+			}
+
+		private:
+			E m_a;
+			T m_alpha;
+		};
+
+		/** @brief Expression A + b for a scalar b */
+		template <typename T, typename E>
+		class AddScalarExpression
+		    : public Expression<T, AddScalarExpression<T, E>>
+		{
+		public:
+			/** type of a newly allocated result */
+			typedef typename E::result_type result_type;
+
+			/** constructor
+			 *
+			 * @param a operand
+			 * @param b scalar to be added
+			 */
+			AddScalarExpression(const E& a, T b) : m_a(a), m_b(b)
+			{
+			}
+
+			/** @return number of rows */
+			index_t num_rows() const
+			{
+				return m_a.num_rows();
+			}
+
+			/** @return number of columns */
+			index_t num_cols() const
+			{
+				return m_a.num_cols();
+			}
+
+			/** @return whether the operand is on GPU */
+			bool on_gpu() const
+			{
+				return m_a.on_gpu();
+			}
+
+			/** @return i-th element */
+			T coeff(index_t i) const
+			{
+				return m_a.coeff(i) + m_b;
+			}
+
+			/** Evaluates the expression through the backend.
+			 *
+			 * @param result pre-allocated result
+			 */
+			void eval_eager(SGMatrix<T>& result) const
+			{
+				m_a.eval_eager(result);
+				add_scalar(result, m_b);
+			}
+
+		private:
+			E m_a;
+			T m_b;
+		};
+
+		/** @brief Expression exp(A), elementwise */
+		template <typename T, typename E>
+		class ExponentExpression
+		    : public Expression<T, ExponentExpression<T, E>>
+		{
+		public:
+			/** type of a newly allocated result */
+			typedef typename E::result_type result_type;
+
+			/** constructor
+			 *
+			 * @param a operand
+			 */
+			ExponentExpression(const E& a) : m_a(a)
+			{
+			}
+
+			/** @return number of rows */
+			index_t num_rows() const
+			{
+				return m_a.num_rows();
+			}
+
+			/** @return number of columns */
+			index_t num_cols() const
+			{
+				return m_a.num_cols();
+			}
+
+			/** @return whether the operand is on GPU */
+			bool on_gpu() const
+			{
+				return m_a.on_gpu();
+			}
+
+			/** @return i-th element */
+			T coeff(index_t i) const
+			{
+				return (T)std::exp(m_a.coeff(i));
+			}
+
+			/** Evaluates the expression through the backend.
+			 *
+			 * @param result pre-allocated result
+			 */
+			void eval_eager(SGMatrix<T>& result) const
+			{
+				SGMatrix<T> a = m_a.materialize();
+				infer_backend(a, result)->exponent(a, result);
+			}
+
+		private:
+			E m_a;
+		};
+
+		/** Wraps a vector or matrix into an expression. Nothing is copied.
+		 *
+		 * @param a Vector or matrix
+		 * @return Expression of a
+		 */
+		template <typename T, template <typename> class Container>
+		ContainerExpression<T, Container> lazy(const Container<T>& a)
+		{
+			return ContainerExpression<T, Container>(a);
+		}
+
+		/** Records the operation alpha * A + beta * B.
+		 *
+		 * @param a First expression
+		 * @param b Second expression
+		 * @param alpha Constant to be multiplied by the first expression
+		 * @param beta Constant to be multiplied by the second expression
+		 * @return The unevaluated expression
+		 */
+		template <typename T, typename L, typename R>
+		AddExpression<T, L, R> add(
+		    const Expression<T, L>& a, const Expression<T, R>& b, T alpha = 1,
+		    T beta = 1)
+		{
+			return AddExpression<T, L, R>(a.derived(), b.derived(), alpha, beta);
+		}
+
+		/** Records the operation A .* B where ".*" denotes elementwise
+		 * multiplication.
+		 *
+		 * @param a First expression
+		 * @param b Second expression
+		 * @return The unevaluated expression
+		 */
+		template <typename T, typename L, typename R>
+		ElementProdExpression<T, L, R>
+		element_prod(const Expression<T, L>& a, const Expression<T, R>& b)
+		{
+			return ElementProdExpression<T, L, R>(a.derived(), b.derived());
+		}
+
+		/** Records the operation alpha * A.
+		 *
+		 * @param a Expression
+		 * @param alpha Scale factor
+		 * @return The unevaluated expression
+		 */
+		template <typename T, typename E>
+		ScaleExpression<T, E> scale(const Expression<T, E>& a, T alpha)
+		{
+			return ScaleExpression<T, E>(a.derived(), alpha);
+		}
+
+		/** Records the operation A + b for a scalar b.
+		 *
+		 * @param a Expression
+		 * @param b Scalar to be added
+		 * @return The unevaluated expression
+		 */
+		template <typename T, typename E>
+		AddScalarExpression<T, E> add_scalar(const Expression<T, E>& a, T b)
+		{
+			return AddScalarExpression<T, E>(a.derived(), b);
+		}
+
+		/** Records the elementwise operation exp(A).
+		 *
+		 * @param a Expression
+		 * @return The unevaluated expression
+		 */
+		template <typename T, typename E>
+		ExponentExpression<T, E> exponent(const Expression<T, E>& a)
+		{
+			return ExponentExpression<T, E>(a.derived());
+		}
+
+		/** Evaluates an expression into a pre-allocated matrix.
+		 *
+		 * On the CPU, all operations of the expression are computed in one
+		 * pass over memory. The result may be one of the operands of the
+		 * expression.
+		 *
+		 * @param expr The expression
+		 * @param result The matrix that saves the result
+		 */
+		template <typename T, typename E>
+		void eval(const Expression<T, E>& expr, SGMatrix<T>& result)
+		{
+			const E& e = expr.derived();
+			REQUIRE(
+			    e.num_rows() == result.num_rows &&
+			        e.num_cols() == result.num_cols,
+			    "Dimension mismatch! expression(%d x %d) vs result(%d x %d)\n",
+			    e.num_rows(), e.num_cols(), result.num_rows, result.num_cols);
+			REQUIRE(
+			    !(result.on_gpu() ^ e.on_gpu()),
+			    "Cannot operate with result on_gpu (%d) and expression "
+			    "on_gpu (%d).\n",
+			    result.on_gpu(), e.on_gpu());
+
+			if (e.on_gpu())
+			{
+				e.eval_eager(result);
+				return;
+			}
+
+			const index_t size = e.size();
+			T* out = result.matrix;
+
+			Parallel* parallel = get_global_parallel();
+			const int32_t num_threads = parallel->get_num_threads();
+			SG_UNREF(parallel);
+
+#pragma omp parallel for num_threads(num_threads)                              \
+    schedule(static) if (size >= EXPRESSION_PARALLEL_MIN_SIZE)
+			for (index_t i = 0; i < size; ++i)
+				out[i] = e.coeff(i);
+		}
+
+		/** Evaluates an expression into a pre-allocated vector.
+		 *
+		 * @param expr The expression, of shape length x 1
+		 * @param result The vector that saves the result
+		 */
+		template <typename T, typename E>
+		void eval(const Expression<T, E>& expr, SGVector<T>& result)
+		{
+			SGMatrix<T> view(result);
+			eval(expr, view);
+		}
+
+		/** Evaluates an expression into a newly allocated vector or matrix,
+		 * of the same type as the first operand.
+		 *
+		 * @param expr The expression
+		 * @return The evaluated expression
+		 */
+		template <typename T, typename E>
+		typename E::result_type eval(const Expression<T, E>& expr)
+		{
+			const E& e = expr.derived();
+			SGMatrix<T> result(e.num_rows(), e.num_cols());
+			if (e.on_gpu())
+				to_gpu(result, result);
+			eval(expr, result);
+			return typename E::result_type(result);
+		}
+
+		/** Sums all elements of an expression, in one pass over memory
+		 * on the CPU.
+		 *
+		 * @param expr The expression
+		 * @return The sum of all elements
+		 */
+		template <typename T, typename E>
+		T sum(const Expression<T, E>& expr)
+		{
+			const E& e = expr.derived();
+			if (e.on_gpu())
+				return sum(e.materialize());
+
+			const index_t size = e.size();
+			T result = 0;
+
+			Parallel* parallel = get_global_parallel();
+			const int32_t num_threads = parallel->get_num_threads();
+			SG_UNREF(parallel);
+
+#pragma omp parallel for num_threads(num_threads) schedule(static)             \
+    reduction(+ : result) if (size >= EXPRESSION_PARALLEL_MIN_SIZE)
+			for (index_t i = 0; i < size; ++i)
+				result += e.coeff(i);
+
+			return result;
+		}
+
+		/** Computes the dot product of two expressions, in one pass over
+		 * memory on the CPU.
+		 *
+		 * @param a First expression
+		 * @param b Second expression
+		 * @return The dot product
+		 */
+		template <typename T, typename L, typename R>
+		T dot(const Expression<T, L>& a, const Expression<T, R>& b)
+		{
+			return sum(element_prod(a, b));
+		}
+	}
+}
+
+#endif // LINALG_EXPRESSION_H_
@@ -33,6 +33,7 @@
 #ifndef LINALG_NAMESPACE_H_
 #define LINALG_NAMESPACE_H_
 
+#include <shogun/lib/SGSparseVector.h>
 #include <shogun/mathematics/linalg/LinalgBackendBase.h>
 #include <shogun/mathematics/linalg/LinalgEnums.h>
 #include <shogun/mathematics/linalg/SGLinalg.h>
@@ -106,6 +107,40 @@ namespace shogun
 				return sg_linalg->get_cpu_backend();
 		}
 
+		/** Infer the appropriate backend for linalg operations on a sparse
+		 * matrix. Sparse matrices always live in CPU memory.
+		 *
+		 * @param a SGSparseMatrix
+		 * @return @see LinalgBackendBase pointer
+		 */
+		template <typename T>
+		LinalgBackendBase* infer_backend(const SGSparseMatrix<T>& a)
+		{
+			return sg_linalg->get_cpu_backend();
+		}
+
+		/** Infer the appropriate backend for linalg operations on a sparse
+		 * matrix and a dense SGVector or SGMatrix (Container).
+		 * Raise error if the dense operand is on GPU.
+		 *
+		 * @param a SGSparseMatrix
+		 * @param b SGVector or SGMatrix
+		 * @return @see LinalgBackendBase pointer
+		 */
+		template <typename T, template <typename> class Container>
+		LinalgBackendBase*
+		infer_backend(const SGSparseMatrix<T>& a, const Container<T>& b)
+		{
+			if (b.on_gpu())
+			{
+				SG_SERROR(
+				    "Cannot operate with sparse matrix and dense vector/matrix "
+				    "on GPU, sparse operations are only supported on CPU.\n");
+				return NULL;
+			}
+			return sg_linalg->get_cpu_backend();
+		}
+
 		/**
 		 * Transfers data to GPU memory.
 		 * Shallow-copy of SGVector with vector on CPU if GPU backend not
@@ -1085,6 +1120,113 @@ namespace shogun
 			return result;
 		}
 
+		/** Performs the operation of a sparse matrix multiplies a dense
+		 * vector \f$x = Ab\f$ or \f$x = A^T b\f$.
+		 *
+		 * A sparse matrix with num_features rows and num_vectors columns
+		 * stores its columns as sparse vectors. \f$A^T b\f$ computes one dot
+		 * product per sparse vector, \f$Ab\f$ scatters them.
+		 *
+		 * This version returns the result in-place.
+		 * User should pass an appropriately allocated memory vector.
+		 *
+		 * @param A The sparse matrix
+		 * @param b The vector
+		 * @param result Result vector
+		 * @param transpose Whether to transpose the matrix. Default false
+		 */
+		template <typename T>
+		void matrix_prod(
+		    const SGSparseMatrix<T>& A, const SGVector<T>& b,
+		    SGVector<T>& result, bool transpose = false)
+		{
+			const index_t num_rows = transpose ? A.num_vectors : A.num_features;
+			const index_t num_cols = transpose ? A.num_features : A.num_vectors;
+			REQUIRE(
+			    num_cols == b.vlen, "Number of columns of sparse matrix A (%d) "
+			                        "doesn't match length of vector b (%d).\n",
+			    num_cols, b.vlen);
+			REQUIRE(
+			    result.vlen == num_rows, "Length of vector result (%d) "
+			                             "doesn't match number of rows of "
+			                             "sparse matrix A (%d).\n",
+			    result.vlen, num_rows);
+
+			infer_backend(A, b)->matrix_prod(A, b, result, transpose);
+		}
+
+		/** Performs the operation of a sparse matrix multiplies a dense
+		 * vector \f$x = Ab\f$ or \f$x = A^T b\f$.
+		 * This version returns the result in a newly created vector.
+		 *
+		 * @param A The sparse matrix
+		 * @param b The vector
+		 * @param transpose Whether to transpose the matrix. Default false
+		 * @return Result vector
+		 */
+		template <typename T>
+		SGVector<T> matrix_prod(
+		    const SGSparseMatrix<T>& A, const SGVector<T>& b,
+		    bool transpose = false)
+		{
+			SGVector<T> result(transpose ? A.num_vectors : A.num_features);
+			matrix_prod(A, b, result, transpose);
+			return result;
+		}
+
+		/** Performs the operation C = A * B or C = A^T * B of a sparse matrix
+		 * A and a dense matrix B.
+		 *
+		 * This version returns the result in-place.
+		 * User should pass an appropriately allocated memory matrix.
+		 *
+		 * @param A The sparse matrix
+		 * @param B The dense matrix
+		 * @param result Result matrix
+		 * @param transpose_A Whether to transpose the sparse matrix
+		 */
+		template <typename T>
+		void matrix_prod(
+		    const SGSparseMatrix<T>& A, const SGMatrix<T>& B,
+		    SGMatrix<T>& result, bool transpose_A = false)
+		{
+			const index_t num_rows =
+			    transpose_A ? A.num_vectors : A.num_features;
+			const index_t num_cols =
+			    transpose_A ? A.num_features : A.num_vectors;
+			REQUIRE(
+			    num_cols == B.num_rows,
+			    "Number of columns of sparse matrix A (%d) and number of rows "
+			    "of B (%d) should be equal!\n",
+			    num_cols, B.num_rows);
+			REQUIRE(
+			    result.num_rows == num_rows && result.num_cols == B.num_cols,
+			    "Dimension mismatch! A*B (%d x %d) vs result (%d x %d).\n",
+			    num_rows, B.num_cols, result.num_rows, result.num_cols);
+
+			infer_backend(A, B)->matrix_prod(A, B, result, transpose_A);
+		}
+
+		/** Performs the operation C = A * B or C = A^T * B of a sparse matrix
+		 * A and a dense matrix B.
+		 * This version returns the result in a newly created matrix.
+		 *
+		 * @param A The sparse matrix
+		 * @param B The dense matrix
+		 * @param transpose_A Whether to transpose the sparse matrix
+		 * @return The result of the operation
+		 */
+		template <typename T>
+		SGMatrix<T> matrix_prod(
+		    const SGSparseMatrix<T>& A, const SGMatrix<T>& B,
+		    bool transpose_A = false)
+		{
+			SGMatrix<T> result(
+			    transpose_A ? A.num_vectors : A.num_features, B.num_cols);
+			matrix_prod(A, B, result, transpose_A);
+			return result;
+		}
+
 		/**
 		 * Performs the operation y = \alpha ax + \beta y
 		 * This function multiplies a * x (after transposing a, if needed)
@@ -1275,13 +1417,65 @@ namespace shogun
 		 * @return Vector or matrix of alpha * A
 		 */
 		template <typename T, template <typename> class Container>
-		Container<T> scale(Container<T>& a, T alpha = 1)
+		typename std::enable_if<
+		    !std::is_same<Container<T>, SGSparseMatrix<T>>::value,
+		    Container<T>>::type
+		scale(Container<T>& a, T alpha = 1)
 		{
 			auto result = a.clone();
 			scale(a, result, alpha);
 			return result;
 		}
 
+		/**
+		 * Performs the operation result = alpha * A on sparse matrices.
+		 * This version returns the result in-place.
+		 * The result has to have the same sparsity pattern as A, e.g. a copy
+		 * of A or A itself.
+		 *
+		 * @param A The sparse matrix
+		 * @param result The sparse matrix of alpha * A
+		 * @param alpha Scale factor
+		 */
+		template <typename T>
+		void
+		scale(const SGSparseMatrix<T>& A, SGSparseMatrix<T>& result, T alpha)
+		{
+			REQUIRE(
+			    A.num_vectors == result.num_vectors &&
+			        A.num_features == result.num_features,
+			    "Dimension mismatch! A (%d x %d) vs result (%d x %d).\n",
+			    A.num_features, A.num_vectors, result.num_features,
+			    result.num_vectors);
+			for (index_t j = 0; j < A.num_vectors; ++j)
+			{
+				REQUIRE(
+				    A[j].num_feat_entries == result[j].num_feat_entries,
+				    "Number of non-zero entries of vector %d of A (%d) and "
+				    "result (%d) differ.\n",
+				    j, A[j].num_feat_entries, result[j].num_feat_entries);
+			}
+
+			infer_backend(A)->scale(A, alpha, result);
+		}
+
+		/**
+		 * Performs the operation B = alpha * A on sparse matrices.
+		 * This version returns the result in a newly created sparse matrix
+		 * in compressed storage.
+		 *
+		 * @param A The sparse matrix
+		 * @param alpha Scale factor
+		 * @return Sparse matrix of alpha * A
+		 */
+		template <typename T>
+		SGSparseMatrix<T> scale(const SGSparseMatrix<T>& A, T alpha)
+		{
+			SGSparseMatrix<T> result = A.get_compressed();
+			scale(result, result, alpha);
+			return result;
+		}
+
 		/**
 		 * Set const value to vectors or matrices
 		 *
@@ -1423,6 +1617,60 @@ namespace shogun
 			return sg_linalg->get_cpu_backend()->rowwise_sum(a, no_diag);
 		}
 
+		/**
+		 * Method that computes the colwise sum of a sparse matrix, i.e. the
+		 * sum of every sparse vector.
+		 *
+		 * @param mat a sparse matrix whose colwise sum has to be computed
+		 * @return the colwise sum of co-efficients computed as
+		 * \f$s_j=\sum_{i}m_{i,j}\f$
+		 */
+		template <typename T>
+		SGVector<T> colwise_sum(const SGSparseMatrix<T>& mat)
+		{
+			return infer_backend(mat)->colwise_sum(mat);
+		}
+
+		/**
+		 * Method that computes the rowwise sum of a sparse matrix, i.e. the
+		 * sum of every feature over all sparse vectors.
+		 *
+		 * @param mat a sparse matrix whose rowwise sum has to be computed
+		 * @return the rowwise sum of co-efficients computed as
+		 * \f$s_i=\sum_{j}m_{i,j}\f$
+		 */
+		template <typename T>
+		SGVector<T> rowwise_sum(const SGSparseMatrix<T>& mat)
+		{
+			return infer_backend(mat)->rowwise_sum(mat);
+		}
+
+		/**
+		 * Method that computes the Euclidean norm of every column (sparse
+		 * vector) of a sparse matrix.
+		 *
+		 * @param mat a sparse matrix
+		 * @return the colwise norms \f$s_j=\sqrt{\sum_{i}|m_{i,j}|^2}\f$
+		 */
+		template <typename T>
+		SGVector<T> colwise_norm(const SGSparseMatrix<T>& mat)
+		{
+			return infer_backend(mat)->colwise_norm(mat);
+		}
+
+		/**
+		 * Method that computes the Euclidean norm of every row (feature) of a
+		 * sparse matrix.
+		 *
+		 * @param mat a sparse matrix
+		 * @return the rowwise norms \f$s_i=\sqrt{\sum_{j}|m_{i,j}|^2}\f$
+		 */
+		template <typename T>
+		SGVector<T> rowwise_norm(const SGSparseMatrix<T>& mat)
+		{
+			return infer_backend(mat)->rowwise_norm(mat);
+		}
+
 		/**
 		 * Compute the singular value decomposition \f$A = U S V^{*}\f$ of a
 		 * matrix.
@@ -0,0 +1,279 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/base/Parallel.h>
+#include <shogun/base/init.h>
+#include <shogun/lib/SGSparseVector.h>
+#include <shogun/mathematics/linalg/LinalgBackendEigen.h>
+#include <shogun/mathematics/linalg/LinalgMacros.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace shogun;
+
+#define BACKEND_GENERIC_SPARSE_MATRIX_PROD(Type, Container)                    \
+	void LinalgBackendEigen::matrix_prod(                                      \
+	    const SGSparseMatrix<Type>& a, const Container<Type>& b,               \
+	    Container<Type>& result, bool transpose_A) const                       \
+	{                                                                          \
+		matrix_prod_impl(a, b, result, transpose_A);                           \
+	}
+DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_SPARSE_MATRIX_PROD, SGVector)
+DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_SPARSE_MATRIX_PROD, SGMatrix)
+#undef BACKEND_GENERIC_SPARSE_MATRIX_PROD
+
+#define BACKEND_GENERIC_SPARSE_SCALE(Type, Container)                          \
+	void LinalgBackendEigen::scale(                                            \
+	    const Container<Type>& a, Type alpha, Container<Type>& result) const   \
+	{                                                                          \
+		scale_impl(a, alpha, result);                                          \
+	}
+DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_SPARSE_SCALE, SGSparseMatrix)
+#undef BACKEND_GENERIC_SPARSE_SCALE
+
+#define BACKEND_GENERIC_SPARSE_COLWISE_SUM(Type, Container)                    \
+	SGVector<Type> LinalgBackendEigen::colwise_sum(const Container<Type>& a)   \
+	    const                                                                  \
+	{                                                                          \
+		return colwise_sum_impl(a);                                            \
+	}
+DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_SPARSE_COLWISE_SUM, SGSparseMatrix)
+#undef BACKEND_GENERIC_SPARSE_COLWISE_SUM
+
+#define BACKEND_GENERIC_SPARSE_ROWWISE_SUM(Type, Container)                    \
+	SGVector<Type> LinalgBackendEigen::rowwise_sum(const Container<Type>& a)   \
+	    const                                                                  \
+	{                                                                          \
+		return rowwise_sum_impl(a);                                            \
+	}
+DEFINE_FOR_NON_INTEGER_PTYPE(BACKEND_GENERIC_SPARSE_ROWWISE_SUM, SGSparseMatrix)
+#undef BACKEND_GENERIC_SPARSE_ROWWISE_SUM
+
+#define BACKEND_GENERIC_SPARSE_COLWISE_NORM(Type, Container)                   \
+	SGVector<Type> LinalgBackendEigen::colwise_norm(const Container<Type>& a)  \
+	    const                                                                  \
+	{                                                                          \
+		return colwise_norm_impl(a);                                           \
+	}
+DEFINE_FOR_NON_INTEGER_PTYPE(
+    BACKEND_GENERIC_SPARSE_COLWISE_NORM, SGSparseMatrix)
+#undef BACKEND_GENERIC_SPARSE_COLWISE_NORM
+
+#define BACKEND_GENERIC_SPARSE_ROWWISE_NORM(Type, Container)                   \
+	SGVector<Type> LinalgBackendEigen::rowwise_norm(const Container<Type>& a)  \
+	    const                                                                  \
+	{                                                                          \
+		return rowwise_norm_impl(a);                                           \
+	}
+DEFINE_FOR_NON_INTEGER_PTYPE(
+    BACKEND_GENERIC_SPARSE_ROWWISE_NORM, SGSparseMatrix)
+#undef BACKEND_GENERIC_SPARSE_ROWWISE_NORM
+
+#undef DEFINE_FOR_ALL_PTYPE
+#undef DEFINE_FOR_REAL_PTYPE
+#undef DEFINE_FOR_NON_INTEGER_PTYPE
+#undef DEFINE_FOR_NUMERIC_PTYPE
+
+namespace
+{
+	int32_t get_num_threads()
+	{
+		Parallel* parallel = get_global_parallel();
+		int32_t num_threads = parallel->get_num_threads();
+		SG_UNREF(parallel);
+		return num_threads;
+	}
+
+	/* Sums f(entry) into the rows of the sparse matrix, i.e. scatters the
+	 * columns. Every thread accumulates its columns in its own buffer, the
+	 * buffers are added up at the end.
+	 */
+	template <typename T, typename F>
+	void sparse_rowwise_reduce(const SGSparseMatrix<T>& mat, F f, T* result)
+	{
+		const index_t num_rows = mat.num_features;
+		std::fill(result, result + num_rows, T(0));
+
+#pragma omp parallel num_threads(get_num_threads())
+		{
+			SGVector<T> local(num_rows);
+			local.set_const(T(0));
+
+#pragma omp for schedule(dynamic, 64)
+			for (index_t j = 0; j < mat.num_vectors; ++j)
+			{
+				const SGSparseVector<T>& col = mat.sparse_matrix[j];
+				for (index_t k = 0; k < col.num_feat_entries; ++k)
+					local[col.features[k].feat_index] +=
+					    f(col.features[k].entry, j);
+			}
+
+#pragma omp critical
+			{
+				for (index_t i = 0; i < num_rows; ++i)
+					result[i] += local[i];
+			}
+		}
+	}
+}
+
+template <typename T>
+void LinalgBackendEigen::matrix_prod_impl(
+    const SGSparseMatrix<T>& a, const SGVector<T>& b, SGVector<T>& result,
+    bool transpose) const
+{
+	const T* b_vec = b.vector;
+
+	if (transpose)
+	{
+		// result[j] = <A.col(j), b>, one independent dot product per column
+#pragma omp parallel for num_threads(get_num_threads()) schedule(dynamic, 64)
+		for (index_t j = 0; j < a.num_vectors; ++j)
+		{
+			const SGSparseVector<T>& col = a.sparse_matrix[j];
+			T dot = 0;
+			for (index_t k = 0; k < col.num_feat_entries; ++k)
+				dot += col.features[k].entry * b_vec[col.features[k].feat_index];
+			result[j] = dot;
+		}
+	}
+	else
+	{
+		sparse_rowwise_reduce(
+		    a, [b_vec](T entry, index_t j) { return entry * b_vec[j]; },
+		    result.vector);
+	}
+}
+
+template <typename T>
+void LinalgBackendEigen::matrix_prod_impl(
+    const SGSparseMatrix<T>& a, const SGMatrix<T>& b, SGMatrix<T>& result,
+    bool transpose_A) const
+{
+	typename SGMatrix<T>::EigenMatrixXtMap b_eig = b;
+	typename SGMatrix<T>::EigenMatrixXtMap result_eig = result;
+
+	if (transpose_A)
+	{
+		// result.row(j) = A.col(j)^T * B, rows are independent
+#pragma omp parallel for num_threads(get_num_threads()) schedule(dynamic, 64)
+		for (index_t j = 0; j < a.num_vectors; ++j)
+		{
+			const SGSparseVector<T>& col = a.sparse_matrix[j];
+			result_eig.row(j).setZero();
+			for (index_t k = 0; k < col.num_feat_entries; ++k)
+				result_eig.row(j) +=
+				    col.features[k].entry * b_eig.row(col.features[k].feat_index);
+		}
+	}
+	else
+	{
+		// result.col(c) = A * B.col(c), columns of the result are independent
+		result_eig.setZero();
+#pragma omp parallel for num_threads(get_num_threads()) schedule(dynamic)
+		for (index_t c = 0; c < b.num_cols; ++c)
+		{
+			for (index_t j = 0; j < a.num_vectors; ++j)
+			{
+				const T b_jc = b(j, c);
+				if (b_jc == T(0))
+					continue;
+
+				const SGSparseVector<T>& col = a.sparse_matrix[j];
+				for (index_t k = 0; k < col.num_feat_entries; ++k)
+					result(col.features[k].feat_index, c) +=
+					    col.features[k].entry * b_jc;
+			}
+		}
+	}
+}
+
+template <typename T>
+void LinalgBackendEigen::scale_impl(
+    const SGSparseMatrix<T>& a, T alpha, SGSparseMatrix<T>& result) const
+{
+#pragma omp parallel for num_threads(get_num_threads()) schedule(dynamic, 64)
+	for (index_t j = 0; j < a.num_vectors; ++j)
+	{
+		const SGSparseVector<T>& col = a.sparse_matrix[j];
+		SGSparseVector<T>& result_col = result.sparse_matrix[j];
+		for (index_t k = 0; k < col.num_feat_entries; ++k)
+		{
+			result_col.features[k].feat_index = col.features[k].feat_index;
+			result_col.features[k].entry = alpha * col.features[k].entry;
+		}
+	}
+}
+
+template <typename T>
+SGVector<T>
+LinalgBackendEigen::colwise_sum_impl(const SGSparseMatrix<T>& mat) const
+{
+	SGVector<T> result(mat.num_vectors);
+
+#pragma omp parallel for num_threads(get_num_threads()) schedule(dynamic, 64)
+	for (index_t j = 0; j < mat.num_vectors; ++j)
+	{
+		const SGSparseVector<T>& col = mat.sparse_matrix[j];
+		T sum = 0;
+		for (index_t k = 0; k < col.num_feat_entries; ++k)
+			sum += col.features[k].entry;
+		result[j] = sum;
+	}
+
+	return result;
+}
+
+template <typename T>
+SGVector<T>
+LinalgBackendEigen::rowwise_sum_impl(const SGSparseMatrix<T>& mat) const
+{
+	SGVector<T> result(mat.num_features);
+	sparse_rowwise_reduce(
+	    mat, [](T entry, index_t) { return entry; }, result.vector);
+
+	return result;
+}
+
+template <typename T>
+SGVector<T>
+LinalgBackendEigen::colwise_norm_impl(const SGSparseMatrix<T>& mat) const
+{
+	SGVector<T> result(mat.num_vectors);
+
+#pragma omp parallel for num_threads(get_num_threads()) schedule(dynamic, 64)
+	for (index_t j = 0; j < mat.num_vectors; ++j)
+	{
+		const SGSparseVector<T>& col = mat.sparse_matrix[j];
+		floatmax_t sq_sum = 0;
+		for (index_t k = 0; k < col.num_feat_entries; ++k)
+		{
+			const floatmax_t abs_entry = std::abs(col.features[k].entry);
+			sq_sum += abs_entry * abs_entry;
+		}
+		result[j] = (T)std::sqrt(sq_sum);
+	}
+
+	return result;
+}
+
+template <typename T>
+SGVector<T>
+LinalgBackendEigen::rowwise_norm_impl(const SGSparseMatrix<T>& mat) const
+{
+	SGVector<T> result(mat.num_features);
+	sparse_rowwise_reduce(
+	    mat,
+	    [](T entry, index_t) {
+		    const floatmax_t abs_entry = std::abs(entry);
+		    return T(abs_entry * abs_entry);
+	    },
+	    result.vector);
+
+	for (index_t i = 0; i < result.vlen; ++i)
+		result[i] = (T)std::sqrt(std::abs(result[i]));
+
+	return result;
+}
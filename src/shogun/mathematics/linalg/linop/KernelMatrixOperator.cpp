@@ -0,0 +1,93 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <shogun/lib/SGVector.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/kernel/Kernel.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/linalg/linop/KernelMatrixOperator.h>
+
+/// number of rows of a tile of the kernel matrix
+#define KERNEL_TILE_ROWS 64
+/// number of columns of a tile of the kernel matrix
+#define KERNEL_TILE_COLS 1024
+
+namespace shogun
+{
+
+CKernelMatrixOperator::CKernelMatrixOperator()
+	: CLinearOperator<float64_t>()
+{
+	init();
+}
+
+CKernelMatrixOperator::CKernelMatrixOperator(CKernel* kernel, float64_t shift)
+	: CLinearOperator<float64_t>()
+{
+	init();
+
+	REQUIRE(kernel, "Kernel is NULL!\n");
+	REQUIRE(kernel->get_num_vec_lhs()==kernel->get_num_vec_rhs(),
+		"Kernel matrix must be square (%d lhs and %d rhs vectors)!\n",
+		kernel->get_num_vec_lhs(), kernel->get_num_vec_rhs());
+
+	SG_REF(kernel);
+	m_kernel=kernel;
+	m_shift=shift;
+	m_dimension=kernel->get_num_vec_lhs();
+}
+
+CKernelMatrixOperator::~CKernelMatrixOperator()
+{
+	SG_UNREF(m_kernel);
+}
+
+void CKernelMatrixOperator::init()
+{
+	m_kernel=NULL;
+	m_shift=0.0;
+
+	SG_ADD((CSGObject**)&m_kernel, "kernel", "The kernel", MS_NOT_AVAILABLE);
+	SG_ADD(&m_shift, "shift", "Constant added to the diagonal",
+		MS_NOT_AVAILABLE);
+}
+
+SGVector<float64_t> CKernelMatrixOperator::apply(SGVector<float64_t> b) const
+{
+	REQUIRE(m_kernel, "Kernel is not set!\n");
+	REQUIRE(m_dimension==b.vlen, "Number of rows of vector b (%d) doesn't "
+		"match with the number of columns of the kernel matrix (%d)!\n",
+		b.vlen, m_dimension);
+
+	SGVector<float64_t> result(m_dimension);
+	index_t n=m_dimension;
+
+	// every block of rows goes through all the columns a tile at a time, so
+	// the rhs vectors of a tile are reused by all the rows of the block
+#pragma omp parallel for schedule(dynamic) num_threads(parallel->get_num_threads())
+	for (index_t start=0; start<n; start+=KERNEL_TILE_ROWS)
+	{
+		index_t end=CMath::min(start+KERNEL_TILE_ROWS, n);
+
+		for (index_t i=start; i<end; ++i)
+			result[i]=m_shift*b[i];
+
+		for (index_t col_start=0; col_start<n; col_start+=KERNEL_TILE_COLS)
+		{
+			index_t col_end=CMath::min(col_start+KERNEL_TILE_COLS, n);
+
+			for (index_t i=start; i<end; ++i)
+			{
+				float64_t sum=0.0;
+				for (index_t j=col_start; j<col_end; ++j)
+					sum+=m_kernel->kernel(i, j)*b[j];
+				result[i]+=sum;
+			}
+		}
+	}
+
+	return result;
+}
+
+}
@@ -0,0 +1,84 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#ifndef KERNEL_MATRIX_OPERATOR_H_
+#define KERNEL_MATRIX_OPERATOR_H_
+
+#include <shogun/lib/config.h>
+
+#include <shogun/mathematics/linalg/linop/LinearOperator.h>
+
+namespace shogun
+{
+template<class T> class SGVector;
+class CKernel;
+
+/** @brief Class that represents the shifted kernel matrix \f$K+\sigma I\f$ of
+ * a kernel initialized with the same features on both sides as a linear
+ * operator, without storing it.
+ *
+ * The product \f$(K+\sigma I)x\f$ is computed in tiles of rows and columns
+ * of the kernel matrix, in parallel over blocks of rows, so every call
+ * evaluates the \f$n^2\f$ kernel values again in \f$O(n)\f$ memory. Together
+ * with CConjugateGradientSolver it solves kernel systems that are too large
+ * for a dense factorization.
+ */
+class CKernelMatrixOperator : public CLinearOperator<float64_t>
+{
+public:
+	/** default constructor */
+	CKernelMatrixOperator();
+
+	/**
+	 * constructor
+	 *
+	 * @param kernel the initialized kernel, with as many lhs as rhs vectors
+	 * @param shift the constant added to the diagonal of the kernel matrix
+	 */
+	CKernelMatrixOperator(CKernel* kernel, float64_t shift=0.0);
+
+	/** destructor */
+	virtual ~CKernelMatrixOperator();
+
+	/**
+	 * method that applies the shifted kernel matrix to a vector
+	 *
+	 * @param b the vector to which the linear operator applies
+	 * @return the result vector
+	 */
+	virtual SGVector<float64_t> apply(SGVector<float64_t> b) const;
+
+	/** @param shift the constant added to the diagonal of the kernel matrix */
+	void set_shift(float64_t shift)
+	{
+		m_shift=shift;
+	}
+
+	/** @return the constant added to the diagonal of the kernel matrix */
+	float64_t get_shift() const
+	{
+		return m_shift;
+	}
+
+	/** @return object name */
+	virtual const char* get_name() const
+	{
+		return "KernelMatrixOperator";
+	}
+
+private:
+	/** initialize with default values and register params */
+	void init();
+
+	/** the kernel */
+	CKernel* m_kernel;
+
+	/** the constant added to the diagonal */
+	float64_t m_shift;
+
+};
+
+}
+
+#endif // KERNEL_MATRIX_OPERATOR_H_
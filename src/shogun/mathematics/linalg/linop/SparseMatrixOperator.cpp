@@ -13,6 +13,7 @@
 #include <shogun/lib/SGSparseVector.h>
 #include <shogun/base/Parameter.h>
 #include <shogun/mathematics/linalg/linop/SparseMatrixOperator.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/mathematics/eigen3.h>
 
 namespace shogun
@@ -40,24 +41,7 @@ CSparseMatrixOperator<T>::CSparseMatrixOperator
 	{
 		init();
 
-		typedef SGSparseVector<T> vector;
-		typedef SGSparseVectorEntry<T> entry;
-
-		m_operator=SGSparseMatrix<T>(orig.m_operator.num_vectors, orig.m_operator.num_features);
-
-		vector* rows=SG_MALLOC(vector, m_operator.num_features);
-		for (index_t i=0; i<m_operator.num_vectors; ++i)
-		{
-			entry* features=SG_MALLOC(entry, orig.m_operator[i].num_feat_entries);
-			for (index_t j=0; j<orig.m_operator[i].num_feat_entries; ++j)
-			{
-				features[j].feat_index=orig.m_operator[i].features[j].feat_index;
-				features[j].entry=orig.m_operator[i].features[j].entry;
-			}
-			rows[i].features=features;
-			rows[i].num_feat_entries=m_operator[i].num_feat_entries;
-		}
-		m_operator.sparse_matrix=rows;
+		m_operator=orig.m_operator.get_compressed();
 
 		SG_SGCDEBUG("%s deep copy created (%p)\n", this->get_name(), this);
 	}
@@ -202,6 +186,7 @@ void CSparseMatrixOperator<T>::set_diagonal(SGVector<T> diag)
 			// we create a new entry if the diagonal element for this row doesn't exist
 			if (!inserted)
 			{
+				m_operator.detach_vector(i);
 				index_t j=m_operator[i].num_feat_entries;
 				m_operator[i].num_feat_entries=j+1;
 				m_operator[i].features=SG_REALLOC(SGSparseVectorEntry<T>,
@@ -224,10 +209,8 @@ SGVector<T> CSparseMatrixOperator<T>::apply(SGVector<T> b) const
 			"Number of rows of vector must be equal to the "
 			"number of cols of the operator!\n");
 
-		SGVector<T> result(m_operator.num_vectors);
-		result=m_operator*b;
-
-		return result;
+		// the rows of the operator are stored as sparse vectors
+		return linalg::matrix_prod(m_operator, b, true);
 	}
 
 #define UNDEFINED(type) \
@@ -42,16 +42,27 @@ CConjugateGradientSolver::~CConjugateGradientSolver()
 
 SGVector<float64_t> CConjugateGradientSolver::solve(
 	CLinearOperator<float64_t>* A, SGVector<float64_t> b)
+{
+	// initial guess is 0
+	SGVector<float64_t> x0(b.vlen);
+	x0.set_const(0.0);
+
+	return solve(A, b, x0);
+}
+
+SGVector<float64_t> CConjugateGradientSolver::solve(
+	CLinearOperator<float64_t>* A, SGVector<float64_t> b,
+	SGVector<float64_t> x0)
 {
 	SG_DEBUG("CConjugateGradientSolve::solve(): Entering..\n");
 
 	// sanity check
 	REQUIRE(A, "Operator is NULL!\n");
 	REQUIRE(A->get_dimension()==b.vlen, "Dimension mismatch!\n");
+	REQUIRE(x0.vlen==b.vlen, "Initial guess dimension mismatch!\n");
 
-	// the final solution vector, initial guess is 0
-	SGVector<float64_t> result(b.vlen);
-	result.set_const(0.0);
+	// the final solution vector, starting from the initial guess
+	SGVector<float64_t> result=x0.clone();
 
 	// the rest of the part hinges on eigen3 for computing norms
 	Map<VectorXd> x(result.vector, result.vlen);
@@ -61,8 +72,13 @@ SGVector<float64_t> CConjugateGradientSolver::solve(
 	SGVector<float64_t> p_(result.vlen);
 	Map<VectorXd> p(p_.vector, p_.vlen);
 
-	// residual r_i=b-Ax_i, here x_0=[0], so r_0=b
+	// residual r_0=b-Ax_0, which is b for a zero initial guess
 	VectorXd r=b_map;
+	if (x.squaredNorm()>0.0)
+	{
+		SGVector<float64_t> Ax_=A->apply(result);
+		r-=Map<VectorXd>(Ax_.vector, Ax_.vlen);
+	}
 
 	// initial direction is same as residual
 	p=r;
@@ -47,6 +47,18 @@ public:
 	virtual SGVector<float64_t> solve(CLinearOperator<float64_t>* A,
 		SGVector<float64_t> b);
 
+	/**
+	 * solve method for solving real linear systems starting from an initial
+	 * guess, e.g. the solution of a nearby system
+	 *
+	 * @param A the linear operator of the system
+	 * @param b the vector of the system
+	 * @param x0 the initial guess
+	 * @return the solution vector
+	 */
+	SGVector<float64_t> solve(CLinearOperator<float64_t>* A,
+		SGVector<float64_t> b, SGVector<float64_t> x0);
+
 	/** @return object name */
 	virtual const char* get_name() const
 	{
@@ -61,7 +61,8 @@ void CLMNN::train(SGMatrix<float64_t> init_transform)
 	SG_DEBUG("Entering CLMNN::train().\n")
 
 	// Check training data and arguments, initializing, if necessary, init_transform
-	CLMNNImpl::check_training_setup(m_features, m_labels, init_transform);
+	CLMNNImpl::check_training_setup(m_features, m_labels, init_transform,
+			m_diagonal);
 
 	// Initializations
 
@@ -142,9 +143,8 @@ void CLMNN::train(SGMatrix<float64_t> init_transform)
 	m_statistics->resize(iter);
 
 	// Store the transformation found in the class attribute
-	int32_t nfeats = x->get_num_features();
-	float64_t* cloned_data = SGMatrix<float64_t>::clone_matrix(L.data(), nfeats, nfeats);
-	m_linear_transform = SGMatrix<float64_t>(cloned_data, nfeats, nfeats);
+	float64_t* cloned_data = SGMatrix<float64_t>::clone_matrix(L.data(), L.rows(), L.cols());
+	m_linear_transform = SGMatrix<float64_t>(cloned_data, L.rows(), L.cols());
 
 	SG_DEBUG("Leaving CLMNN::train().\n")
 }
@@ -58,7 +58,9 @@ class CLMNN : public CSGObject
 		 * space (or, equivalently, a Mahalanobis distance) such that kNN
 		 * classification performance is maximized
 		 *
-		 * @param init_transform initial linear transform
+		 * @param init_transform initial linear transform, of size D x D or,
+		 * to learn a low-rank transform into r < D dimensions, r x D. If not
+		 * given, it is initialized by PCA
 		 */
 		void train(SGMatrix<float64_t> init_transform=SGMatrix<float64_t>());
 
@@ -10,11 +10,12 @@
 
 #include <shogun/metric/LMNNImpl.h>
 
-
-#include <shogun/multiclass/KNN.h>
+#include <shogun/base/init.h>
+#include <shogun/base/Parallel.h>
 #include <shogun/preprocessor/PruneVarSubMean.h>
 #include <shogun/preprocessor/PCA.h>
 
+#include <algorithm>
 #include <iterator>
 
 /// useful shorthands to perform operations with Eigen matrices
@@ -22,9 +23,55 @@
 // column-wise sum of the squared elements of a matrix
 #define SUMSQCOLS(A)	((A).array().square().colwise().sum())
 
+/// side length of the tiles of pairwise distances computed at once
+#define LMNN_BLOCK_SIZE 256
+/// number of outer products summed at once
+#define LMNN_OUTER_PRODUCTS_BLOCK_SIZE 1024
+
 using namespace shogun;
 using namespace Eigen;
 
+/* G+=w*P*P', in parallel over column panels of G */
+static void add_outer_products(MatrixXd& G, const MatrixXd& P, float64_t w,
+		int32_t num_threads)
+{
+	index_t d = G.rows();
+
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads)
+	for (index_t start = 0; start < d; start += 64)
+	{
+		index_t cols = CMath::min<index_t>(64, d-start);
+		G.middleCols(start, cols).noalias() += w*P*P.middleRows(start, cols).transpose();
+	}
+}
+
+/* G+=w*sum(dx1*dx1'-dx2*dx2') over the impostor triplets, with dx1 the
+ * difference of example and target and dx2 of example and impostor */
+static void add_impostors_outer_products(const Map<const MatrixXd>& X,
+		MatrixXd& G, const std::vector<CImpostorNode>& triplets, float64_t w,
+		int32_t num_threads)
+{
+	index_t d = X.rows();
+	index_t num_triplets = triplets.size();
+
+	for (index_t start = 0; start < num_triplets; start += LMNN_OUTER_PRODUCTS_BLOCK_SIZE)
+	{
+		index_t num = CMath::min<index_t>(LMNN_OUTER_PRODUCTS_BLOCK_SIZE, num_triplets-start);
+		MatrixXd dx1(d, num), dx2(d, num);
+
+#pragma omp parallel for num_threads(num_threads)
+		for (index_t i = 0; i < num; ++i)
+		{
+			const CImpostorNode& triplet = triplets[start+i];
+			dx1.col(i) = X.col(triplet.example) - X.col(triplet.target);
+			dx2.col(i) = X.col(triplet.example) - X.col(triplet.impostor);
+		}
+
+		add_outer_products(G, dx1, w, num_threads);
+		add_outer_products(G, dx2, -w, num_threads);
+	}
+}
+
 CImpostorNode::CImpostorNode(index_t ex, index_t tar, index_t imp)
 : example(ex), target(tar), impostor(imp)
 {
@@ -44,7 +91,7 @@ bool CImpostorNode::operator<(const CImpostorNode& rhs) const
 }
 
 void CLMNNImpl::check_training_setup(CFeatures* features, const CLabels* labels,
-		SGMatrix<float64_t>& init_transform)
+		SGMatrix<float64_t>& init_transform, bool diagonal)
 {
 	REQUIRE(features->has_property(FP_DOT),
 			"LMNN can only be applied to features that support dot products\n")
@@ -63,10 +110,12 @@ void CLMNNImpl::check_training_setup(CFeatures* features, const CLabels* labels,
 	if (init_transform.num_rows==0)
 		init_transform = CLMNNImpl::compute_pca_transform(x);
 
-	REQUIRE(init_transform.num_rows==x->get_num_features() &&
-			init_transform.num_rows==init_transform.num_cols,
-			"The initial transform must be a square matrix of size equal to the "
-			"number of features\n")
+	REQUIRE(init_transform.num_cols==x->get_num_features() &&
+			init_transform.num_rows<=init_transform.num_cols,
+			"The initial transform must have as many columns as features and "
+			"at most as many rows\n")
+	REQUIRE(!diagonal || init_transform.num_rows==init_transform.num_cols,
+			"The diagonal variant requires a square initial transform\n")
 }
 
 SGMatrix<index_t> CLMNNImpl::find_target_nn(CDenseFeatures<float64_t>* x,
@@ -78,58 +127,55 @@ SGMatrix<index_t> CLMNNImpl::find_target_nn(CDenseFeatures<float64_t>* x,
 	int32_t d = x->get_num_features();
 	SGMatrix<index_t> target_neighbors(k, x->get_num_vectors());
 	SGVector<float64_t> unique_labels = y->get_unique_labels();
-	CDenseFeatures<float64_t>* features_slice = new CDenseFeatures<float64_t>();
-	CMulticlassLabels* labels_slice = new CMulticlassLabels();
-	SGVector<index_t> idxsmap(x->get_num_vectors());
-
-	// increase ref count because a KNN instance will be created for each slice, and it
-	// decreses the ref count of its labels and features when destroyed
-	SG_REF(features_slice)
-	SG_REF(labels_slice)
+	// map the feature matrix (each column is a feature vector) to an Eigen matrix
+	Map<const MatrixXd> X(x->get_feature_matrix().matrix, d, x->get_num_vectors());
+	int32_t num_threads = get_global_parallel()->get_num_threads();
 
 	for (index_t i = 0; i < unique_labels.vlen; ++i)
 	{
-		int32_t slice_size = 0;
-		for (int32_t j = 0; j < y->get_num_labels(); ++j)
-		{
-			if (y->get_label(j)==unique_labels[i])
-			{
-				idxsmap[slice_size] = j;
-				++slice_size;
-			}
-		}
+		std::vector<index_t> idxs = CLMNNImpl::get_examples_label(y, unique_labels[i]);
+		index_t slice_size = idxs.size();
+		REQUIRE(slice_size > k, "Every class must have more than k=%d examples, "
+				"class %f has %d\n", k, unique_labels[i], slice_size)
 
 		MatrixXd slice_mat(d, slice_size);
-		for (int32_t j = 0; j < slice_size; ++j)
-			slice_mat.col(j) = Map<const VectorXd>(x->get_feature_vector(idxsmap[j]).vector, d);
+		for (index_t j = 0; j < slice_size; ++j)
+			slice_mat.col(j) = X.col(idxs[j]);
+		RowVectorXd sqnorms = SUMSQCOLS(slice_mat);
 
-		features_slice->set_feature_matrix(SGMatrix<float64_t>(slice_mat.data(), d, slice_size, false));
-
-		//FIXME the labels are not actually necessary to get the nearest neighbors, the
-		//features suffice. The labels are needed when we want to classify.
-		SGVector<float64_t> labels_vec(slice_size);
-		labels_vec.set_const(unique_labels[i]);
-		labels_slice->set_labels(labels_vec);
+		// squared distances of blocks of examples to all the examples in the
+		// class, keeping the k closest ones apart from the example itself
+#pragma omp parallel num_threads(num_threads)
+		{
+			MatrixXd sqdists;
+			std::vector<std::pair<float64_t, index_t> > candidates;
+			candidates.reserve(slice_size);
 
-		CKNN* knn = new CKNN(k+1, new CEuclideanDistance(features_slice, features_slice), labels_slice);
-		SGMatrix<int32_t> target_slice = knn->nearest_neighbors();
-		// sanity check
-		ASSERT(target_slice.num_rows==k+1 && target_slice.num_cols==slice_size)
+#pragma omp for schedule(dynamic)
+			for (index_t start = 0; start < slice_size; start += 16)
+			{
+				index_t num = CMath::min<index_t>(16, slice_size-start);
+				sqdists.noalias() = -2*slice_mat.middleCols(start, num).transpose()*slice_mat;
+				sqdists.rowwise() += sqnorms;
 
-		for (index_t j = 0; j < target_slice.num_cols; ++j)
-		{
-			for (index_t l = 1; l < target_slice.num_rows; ++l)
-				target_neighbors(l-1, idxsmap[j]) = idxsmap[ target_slice(l,j) ];
+				for (index_t r = 0; r < num; ++r)
+				{
+					candidates.clear();
+					for (index_t j = 0; j < slice_size; ++j)
+					{
+						if (j != start+r)
+							candidates.push_back(std::make_pair(sqdists(r,j), j));
+					}
+
+					std::partial_sort(candidates.begin(), candidates.begin()+k,
+							candidates.end());
+					for (index_t l = 0; l < k; ++l)
+						target_neighbors(l, idxs[start+r]) = idxs[candidates[l].second];
+				}
+			}
 		}
-
-		// clean up knn
-		SG_UNREF(knn)
 	}
 
-	// clean up features and labels
-	SG_UNREF(features_slice)
-	SG_UNREF(labels_slice)
-
 	SG_SDEBUG("Leaving CLMNNImpl::find_target_nn().\n")
 
 	return target_neighbors;
@@ -144,15 +190,25 @@ MatrixXd CLMNNImpl::sum_outer_products(CDenseFeatures<float64_t>* x, const SGMat
 	sop.setZero();
 	// map the feature matrix (each column is a feature vector) to an Eigen matrix
 	Map<const MatrixXd> X(x->get_feature_matrix().matrix, d, x->get_num_vectors());
+	int32_t num_threads = get_global_parallel()->get_num_threads();
 
-	// sum the outer products stored in C using the indices specified in target_nn
-	for (index_t i = 0; i < target_nn.num_cols; ++i)
+	// sum the outer products stored in C using the indices specified in target_nn,
+	// a block of differences at a time
+	index_t num_pairs = index_t(target_nn.num_rows)*target_nn.num_cols;
+	for (index_t start = 0; start < num_pairs; start += LMNN_OUTER_PRODUCTS_BLOCK_SIZE)
 	{
-		for (index_t j = 0; j < target_nn.num_rows; ++j)
+		index_t num = CMath::min<index_t>(LMNN_OUTER_PRODUCTS_BLOCK_SIZE, num_pairs-start);
+		MatrixXd dx(d, num);
+
+#pragma omp parallel for num_threads(num_threads)
+		for (index_t p = 0; p < num; ++p)
 		{
-			VectorXd dx = X.col(i) - X.col(target_nn(j,i));
-			sop += dx*dx.transpose();
+			index_t i = (start+p) / target_nn.num_rows;
+			index_t j = (start+p) % target_nn.num_rows;
+			dx.col(p) = X.col(i) - X.col(target_nn(j,i));
 		}
+
+		add_outer_products(sop, dx, 1.0, num_threads);
 	}
 
 	return sop;
@@ -212,23 +268,18 @@ void CLMNNImpl::update_gradient(CDenseFeatures<float64_t>* x, MatrixXd& G,
 
 	// map the feature matrix (each column is a feature vector) to an Eigen matrix
 	Map<const MatrixXd> X(x->get_feature_matrix().matrix, x->get_num_features(), x->get_num_vectors());
+	int32_t num_threads = get_global_parallel()->get_num_threads();
 
 	// remove the gradient contributions of the impostors that were in the previous
 	// set but disappeared in the current
-	for (ImpostorsSetType::iterator it = Np_Nc.begin(); it != Np_Nc.end(); ++it)
-	{
-		VectorXd dx1 = X.col(it->example) - X.col(it->target);
-		VectorXd dx2 = X.col(it->example) - X.col(it->impostor);
-		G -= regularization*(dx1*dx1.transpose() - dx2*dx2.transpose());
-	}
+	add_impostors_outer_products(X, G,
+			std::vector<CImpostorNode>(Np_Nc.begin(), Np_Nc.end()),
+			-regularization, num_threads);
 
 	// add the gradient contributions of the new impostors
-	for (ImpostorsSetType::iterator it = Nc_Np.begin(); it != Nc_Np.end(); ++it)
-	{
-		VectorXd dx1 = X.col(it->example) - X.col(it->target);
-		VectorXd dx2 = X.col(it->example) - X.col(it->impostor);
-		G += regularization*(dx1*dx1.transpose() - dx2*dx2.transpose());
-	}
+	add_impostors_outer_products(X, G,
+			std::vector<CImpostorNode>(Nc_Np.begin(), Nc_Np.end()),
+			regularization, num_threads);
 }
 
 void CLMNNImpl::gradient_step(MatrixXd& L, const MatrixXd& G, float64_t stepsize, bool diagonal)
@@ -340,36 +391,19 @@ MatrixXd CLMNNImpl::compute_sqdists(MatrixXd& LX, const SGMatrix<index_t> target
 	// get the number of examples
 	ASSERT(LX.cols()==target_nn.num_cols)
 	int32_t n = LX.cols();
-	// get the number of features
-	int32_t d = LX.rows();
 	// get the number of neighbors
 	int32_t k = target_nn.num_rows;
 
 	/// compute square distances to target neighbors plus margin
-
-	// create Shogun features from LX to later apply subset
-	SGMatrix<float64_t> lx_mat(LX.data(), d, n, false);
-	CDenseFeatures<float64_t>* lx = new CDenseFeatures<float64_t>(lx_mat);
-
-	// initialize distances
 	MatrixXd sqdists(k,n);
-	sqdists.setZero();
-	for (int32_t i = 0; i < k; ++i)
+
+#pragma omp parallel for num_threads(get_global_parallel()->get_num_threads())
+	for (int32_t i = 0; i < n; ++i)
 	{
-		//FIXME avoid copying the rows of target_nn and access them directly. Maybe
-		//find_target_nn should be changed to return the output transposed wrt how it is
-		//done atm.
-		SGVector<index_t> subset_vec = target_nn.get_row_vector(i);
-		lx->add_subset(subset_vec);
-		// after the subset, there are still n columns, i.e. the subset is used to
-		// modify the order of the columns in x according to the target neighbors
-		sqdists.row(i) = SUMSQCOLS(LX - Map<const MatrixXd>(lx->get_feature_matrix().matrix, d, n)) + 1;
-		lx->remove_subset();
+		for (int32_t j = 0; j < k; ++j)
+			sqdists(j,i) = (LX.col(i) - LX.col(target_nn(j,i))).squaredNorm() + 1;
 	}
 
-	// clean up features used to apply subset
-	SG_UNREF(lx);
-
 	return sqdists;
 }
 
@@ -381,13 +415,14 @@ ImpostorsSetType CLMNNImpl::find_impostors_exact(MatrixXd& LX, const MatrixXd& s
 	// initialize empty impostors set
 	ImpostorsSetType N = ImpostorsSetType();
 
-	// get the number of examples from data
-	int32_t n = LX.cols();
 	// get the number of features
 	int32_t d = LX.rows();
-	// create Shogun features from LX to later apply subset
-	SGMatrix<float64_t> lx_mat(LX.data(), d, n, false);
-	CDenseFeatures<float64_t>* lx = new CDenseFeatures<float64_t>(lx_mat);
+	int32_t num_threads = get_global_parallel()->get_num_threads();
+
+	// squared norms for the distances computed from inner products, and the
+	// largest distance to a target neighbor, beyond which there are no impostors
+	RowVectorXd sqnorms = SUMSQCOLS(LX);
+	RowVectorXd max_sqdists = sqdists.colwise().maxCoeff();
 
 	// get a vector with unique label values
 	SGVector<float64_t> unique = y->get_unique_labels();
@@ -401,33 +436,67 @@ ImpostorsSetType CLMNNImpl::find_impostors_exact(MatrixXd& LX, const MatrixXd& s
 		// pairwise distances are computed once
 		std::vector<index_t> gtidxs = CLMNNImpl::get_examples_gtlabel(y,unique[i]);
 
-		// get distance with features indexed by iidxs and gtidxs separated
-		CEuclideanDistance* euclidean = CLMNNImpl::setup_distance(lx,iidxs,gtidxs);
-		euclidean->set_disable_sqrt(true);
+		index_t num_i = iidxs.size();
+		index_t num_gt = gtidxs.size();
+		MatrixXd ilx(d, num_i), gtlx(d, num_gt);
+		for (index_t ii = 0; ii < num_i; ++ii)
+			ilx.col(ii) = LX.col(iidxs[ii]);
+		for (index_t jj = 0; jj < num_gt; ++jj)
+			gtlx.col(jj) = LX.col(gtidxs[jj]);
 
-		for (int32_t j = 0; j < k; ++j)
+		// squared distances between tiles of both groups from one product each
+#pragma omp parallel num_threads(num_threads)
 		{
-			for (std::size_t ii = 0; ii < iidxs.size(); ++ii)
-			{
-				for (std::size_t jj = 0; jj < gtidxs.size(); ++jj)
-				{
-					// FIXME study if using upper bounded distances can be an improvement
-					float64_t distance = euclidean->distance(ii,jj);
+			std::vector<CImpostorNode> found;
+			MatrixXd tile;
 
-					if (distance <= sqdists(j,iidxs[ii]))
-						N.insert( CImpostorNode(iidxs[ii], target_nn(j,iidxs[ii]), gtidxs[jj]) );
+#pragma omp for schedule(dynamic)
+			for (index_t istart = 0; istart < num_i; istart += LMNN_BLOCK_SIZE)
+			{
+				index_t inum = CMath::min<index_t>(LMNN_BLOCK_SIZE, num_i-istart);
 
-					if (distance <= sqdists(j,gtidxs[jj]))
-						N.insert( CImpostorNode(gtidxs[jj], target_nn(j,gtidxs[jj]), iidxs[ii]) );
+				for (index_t jstart = 0; jstart < num_gt; jstart += LMNN_BLOCK_SIZE)
+				{
+					index_t jnum = CMath::min<index_t>(LMNN_BLOCK_SIZE, num_gt-jstart);
+					tile.noalias() = ilx.middleCols(istart, inum).transpose()*
+							gtlx.middleCols(jstart, jnum);
+
+					for (index_t jj = 0; jj < jnum; ++jj)
+					{
+						index_t gtidx = gtidxs[jstart+jj];
+
+						for (index_t ii = 0; ii < inum; ++ii)
+						{
+							index_t iidx = iidxs[istart+ii];
+							float64_t distance = sqnorms[iidx]+sqnorms[gtidx]-2*tile(ii,jj);
+
+							if (distance <= max_sqdists[iidx])
+							{
+								for (int32_t j = 0; j < k; ++j)
+								{
+									if (distance <= sqdists(j,iidx))
+										found.push_back(CImpostorNode(iidx, target_nn(j,iidx), gtidx));
+								}
+							}
+
+							if (distance <= max_sqdists[gtidx])
+							{
+								for (int32_t j = 0; j < k; ++j)
+								{
+									if (distance <= sqdists(j,gtidx))
+										found.push_back(CImpostorNode(gtidx, target_nn(j,gtidx), iidx));
+								}
+							}
+						}
+					}
 				}
 			}
-		}
 
-		SG_UNREF(euclidean);
+#pragma omp critical
+			N.insert(found.begin(), found.end());
+		}
 	}
 
-	SG_UNREF(lx);
-
 	SG_SDEBUG("Leaving CLMNNImpl::find_impostors_exact().\n")
 
 	return N;
@@ -468,30 +537,17 @@ ImpostorsSetType CLMNNImpl::find_impostors_approx(MatrixXd& LX, const MatrixXd&
 
 SGVector<float64_t> CLMNNImpl::compute_impostors_sqdists(MatrixXd& LX, const ImpostorsSetType& Nexact)
 {
-	// get the number of examples
-	int32_t n = LX.cols();
-	// get the number of features
-	int32_t d = LX.rows();
-	// get the number of impostors
-	size_t num_impostors = Nexact.size();
+	// the set does not allow random access, the triplets are copied to iterate
+	// over them in parallel
+	std::vector<CImpostorNode> triplets(Nexact.begin(), Nexact.end());
+	index_t num_impostors = triplets.size();
 
 	/// compute square distances to impostors
-
-	// create Shogun features from LX and distance
-	SGMatrix<float64_t> lx_mat(LX.data(), d, n, false);
-	CDenseFeatures<float64_t>* lx = new CDenseFeatures<float64_t>(lx_mat);
-	CEuclideanDistance* euclidean = new CEuclideanDistance(lx,lx);
-	euclidean->set_disable_sqrt(true);
-
-	// initialize vector of square distances
 	SGVector<float64_t> sqdists(num_impostors);
-	// compute square distances
-	index_t i = 0;
-	for (ImpostorsSetType::iterator it = Nexact.begin(); it != Nexact.end(); ++it)
-		sqdists[i++] = euclidean->distance(it->example,it->impostor);
 
-	// clean up distance
-	SG_UNREF(euclidean);
+#pragma omp parallel for num_threads(get_global_parallel()->get_num_threads())
+	for (index_t i = 0; i < num_impostors; ++i)
+		sqdists[i] = (LX.col(triplets[i].example) - LX.col(triplets[i].impostor)).squaredNorm();
 
 	return sqdists;
 }
@@ -525,22 +581,3 @@ std::vector<index_t> CLMNNImpl::get_examples_gtlabel(CMulticlassLabels* y,
 
 	return idxs;
 }
-
-CEuclideanDistance* CLMNNImpl::setup_distance(CDenseFeatures<float64_t>* x,
-		std::vector<index_t>& a, std::vector<index_t>& b)
-{
-	// create new features only containing examples whose indices are in a
-	x->add_subset(SGVector<index_t>(a.data(), a.size(), false));
-	CDenseFeatures<float64_t>* afeats = new CDenseFeatures<float64_t>(x->get_feature_matrix());
-	x->remove_subset();
-
-	// create new features only containing examples whose indices are in b
-	x->add_subset(SGVector<index_t>(b.data(), b.size(), false));
-	CDenseFeatures<float64_t>* bfeats = new CDenseFeatures<float64_t>(x->get_feature_matrix());
-	x->remove_subset();
-
-	// create and return distance
-	CEuclideanDistance* euclidean = new CEuclideanDistance(afeats,bfeats);
-	return euclidean;
-}
-
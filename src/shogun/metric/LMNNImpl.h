@@ -81,9 +81,11 @@ class CLMNNImpl
 
 		/**
 		 * check feature and label size, dimensions of the initial transform, etc
-		 * if the initial transform has not been initialized, do it using PCA
+		 * if the initial transform has not been initialized, do it using PCA;
+		 * the diagonal variant requires a square initial transform
 		 */
-		static void check_training_setup(CFeatures* features, const CLabels* labels, SGMatrix<float64_t>& init_transform);
+		static void check_training_setup(CFeatures* features, const CLabels* labels,
+				SGMatrix<float64_t>& init_transform, bool diagonal=false);
 
 		/**
 		 * for each feature in x, find its target neighbors; this is, its k
@@ -142,13 +144,6 @@ class CLMNNImpl
 		/** get the indices of the examples whose label is greater than yi */
 		static std::vector<index_t> get_examples_gtlabel(CMulticlassLabels* y, float64_t yi);
 
-		/**
-		 * create Euclidean distance where the lhs features are the features in x indexed
-		 * by the elements in a, and the rhs features are the ones indexed by b; caller
-		 * is responsible of releasing memory
-		 */
-		static CEuclideanDistance* setup_distance(CDenseFeatures<float64_t>* x, std::vector<index_t>& a, std::vector<index_t>& b);
-
 
 }; /* class CLMNNImpl */
 
@@ -187,6 +187,16 @@ void CCARTree::clear_weights()
 	m_weights_set=false;
 }
 
+void CCARTree::set_random_seed(uint64_t seed)
+{
+	m_random_seed=seed;
+}
+
+uint64_t CCARTree::get_random_seed() const
+{
+	return m_random_seed;
+}
+
 void CCARTree::set_feature_types(SGVector<bool> ft)
 {
 	m_nominal=ft;
@@ -275,6 +285,7 @@ bool CCARTree::train_machine(CFeatures* data)
 		m_nominal.fill_vector(m_nominal.vector,m_nominal.vlen,false);
 	}
 
+	m_rng.set_seed(m_random_seed);
 	set_root(CARTtrain(data,m_weights,m_labels,0));
 
 	if (m_apply_cv_pruning)
@@ -572,7 +583,10 @@ int32_t CCARTree::compute_best_attribute(const SGMatrix<float64_t>& mat, const S
 	if (subset_size)
 	{
 		num_feats=subset_size;
-		CMath::permute(idx);
+		if (m_random_seed)
+			CMath::permute(idx, m_rng);
+		else
+			CMath::permute(idx);
 	}
 
 	float64_t max_gain=MIN_SPLIT_GAIN;
@@ -1505,6 +1519,7 @@ void CCARTree::init()
 	m_max_depth=0;
 	m_min_node_size=0;
 	m_label_epsilon=1e-7;
+	m_random_seed=0;
 	m_sorted_features=SGMatrix<float64_t>();
 	m_sorted_indices=SGMatrix<index_t>();
 
@@ -1520,5 +1535,6 @@ void CCARTree::init()
 	SG_ADD(&m_max_depth, "m_max_depth", "max allowed tree depth", MS_NOT_AVAILABLE)
 	SG_ADD(&m_min_node_size, "m_min_node_size", "min allowed node size", MS_NOT_AVAILABLE)
 	SG_ADD(&m_label_epsilon, "m_label_epsilon", "epsilon for labels", MS_NOT_AVAILABLE)
+	SG_ADD(&m_random_seed, "m_random_seed", "seed of the feature subset sampling", MS_NOT_AVAILABLE)
 	SG_ADD((machine_int_t*)&m_mode, "m_mode", "problem type (multiclass or regression)", MS_NOT_AVAILABLE)
 }
@@ -37,6 +37,7 @@
 #include <shogun/multiclass/tree/TreeMachine.h>
 #include <shogun/multiclass/tree/CARTreeNodeData.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/RandomStream.h>
 
 namespace shogun
 {
@@ -158,6 +159,17 @@ public:
 	/** clear weights of data points */
 	void clear_weights();
 
+	/** set the seed of the random stream used for sampling feature
+	 * subsets. With the default of 0 the global generator is used.
+	 * @param seed seed of the random stream
+	 */
+	void set_random_seed(uint64_t seed);
+
+	/** get the seed of the random stream used for sampling feature subsets
+	 * @return seed of the random stream
+	 */
+	uint64_t get_random_seed() const;
+
 	/** set feature types of various features
 	 * @param ft bool vector true for nominal feature false for continuous feature type
 	 */
@@ -463,6 +475,12 @@ protected:
 
 	/** minimum number of feature vectors required in a node **/
 	int32_t m_min_node_size;
+
+	/** seed of the random stream for feature subsets, 0 for the global generator **/
+	uint64_t m_random_seed;
+
+	/** random stream for feature subsets, restarted in every training **/
+	RandomStream m_rng;
 };
 } /* namespace shogun */
 
@@ -35,7 +35,9 @@
 #include <shogun/mathematics/Math.h>
 #include <shogun/optimization/lbfgs/lbfgs.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/lib/DynamicObjectArray.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/neuralnets/NeuralLayer.h>
 
 using namespace shogun;
@@ -152,6 +154,7 @@ void CNeuralNetwork::initialize_neural_network(float64_t sigma)
 
 CNeuralNetwork::~CNeuralNetwork()
 {
+	free_replicas();
 	SG_UNREF(m_layers);
 }
 
@@ -231,8 +234,26 @@ bool CNeuralNetwork::train_machine(CFeatures* data)
 	REQUIRE(m_max_num_epochs>=0,
 		"Maximum number of epochs (%i) must be >= 0\n", m_max_num_epochs);
 
-	SGMatrix<float64_t> inputs = features_to_matrix(data);
-	SGMatrix<float64_t> targets = labels_to_matrix(m_labels);
+	bool streaming = data!=NULL &&
+		data->get_feature_class()==C_STREAMING_DENSE;
+
+	SGMatrix<float64_t> inputs;
+	SGMatrix<float64_t> targets;
+	if (streaming)
+	{
+		REQUIRE(data->get_feature_type()==F_DREAL,
+			"Feature type must be F_DREAL\n");
+		REQUIRE(m_optimization_method==NNOM_GRADIENT_DESCENT,
+			"Streaming features can only be used with gradient descent\n");
+	}
+	else
+	{
+		REQUIRE(m_labels!=NULL, "No labels given\n");
+		m_labels->ensure_valid(get_name());
+
+		inputs = features_to_matrix(data);
+		targets = labels_to_matrix(m_labels);
+	}
 
 	for (int32_t i=0; i<m_num_layers-1; i++)
 	{
@@ -245,12 +266,21 @@ bool CNeuralNetwork::train_machine(CFeatures* data)
 	for (int32_t i=0; i<m_num_layers; i++)
 		get_layer(i)->is_training = true;
 
+	int32_t num_threads = parallel->get_num_threads();
+	if (num_threads>1)
+		create_replicas(num_threads);
+
 	bool result = false;
-	if (m_optimization_method==NNOM_GRADIENT_DESCENT)
+	if (streaming)
+		result = train_gradient_descent(
+			(CStreamingDenseFeatures<float64_t>*)data);
+	else if (m_optimization_method==NNOM_GRADIENT_DESCENT)
 		result = train_gradient_descent(inputs, targets);
 	else if (m_optimization_method==NNOM_LBFGS)
 		result = train_lbfgs(inputs, targets);
 
+	free_replicas();
+
 	for (int32_t i=0; i<m_num_layers; i++)
 		get_layer(i)->is_training = false;
 	m_is_training = false;
@@ -304,22 +334,8 @@ bool CNeuralNetwork::train_gradient_descent(SGMatrix<float64_t> inputs,
 			SGMatrix<float64_t> inputs_batch(inputs.matrix+j*m_num_inputs,
 				m_num_inputs, m_gd_mini_batch_size, false);
 
-			for (int32_t k=0; k<n_param; k++)
-				m_params[k] += m_gd_momentum*param_updates[k];
-
-			float64_t e = compute_gradients(inputs_batch, targets_batch, gradients);
-
-
-			for (int32_t k=0; k<m_num_layers; k++)
-			{
-				SGVector<float64_t> layer_gradients = get_section(gradients, k);
-				if (layer_gradients.vlen > 0)
-				{
-					SG_INFO("Layer %i (%s), Max Gradient: %g, Mean Gradient: %g.\n", k,get_layer(k)->get_name(),
-						CMath::max(layer_gradients.vector, layer_gradients.vlen),
-						SGVector<float64_t>::sum(layer_gradients.vector, layer_gradients.vlen)/layer_gradients.vlen);
-				}
-			}
+			float64_t e = gradient_descent_step(inputs_batch, targets_batch,
+				gradients, param_updates, alpha);
 
 			// filter the errors
 			if (error==-1.0)
@@ -327,14 +343,6 @@ bool CNeuralNetwork::train_gradient_descent(SGMatrix<float64_t> inputs,
 			else
 				error = (1.0-c) * error + c*e;
 
-			for (int32_t k=0; k<n_param; k++)
-			{
-				param_updates[k] = m_gd_momentum*param_updates[k]
-						-alpha*gradients[k];
-
-				m_params[k] -= alpha*gradients[k];
-			}
-
 			if (error_last_time!=-1.0)
 			{
 				float64_t error_change = (error_last_time-error)/error;
@@ -354,6 +362,168 @@ bool CNeuralNetwork::train_gradient_descent(SGMatrix<float64_t> inputs,
 	return true;
 }
 
+bool CNeuralNetwork::train_gradient_descent(
+	CStreamingDenseFeatures<float64_t>* features)
+{
+	REQUIRE(m_gd_learning_rate>0,
+		"Gradient descent learning rate (%f) must be > 0\n", m_gd_learning_rate);
+	REQUIRE(m_gd_momentum>=0,
+		"Gradient descent momentum (%f) must be >= 0\n", m_gd_momentum);
+	REQUIRE(m_gd_mini_batch_size>0,
+		"Gradient descent mini-batch size (%i) must be > 0 when training on "
+		"streaming features\n", m_gd_mini_batch_size);
+	REQUIRE(features->get_has_labels(), "Streaming features must have labels\n");
+
+	int32_t n_param = get_num_parameters();
+	SGVector<float64_t> gradients(n_param);
+
+	// needed for momentum
+	SGVector<float64_t> param_updates(n_param);
+	param_updates.zero();
+
+	// examples are read into a buffer of several mini-batches which is
+	// shuffled before the mini-batches are formed
+	index_t buffer_size = m_gd_mini_batch_size*m_gd_streaming_buffer_size;
+	SGMatrix<float64_t> inputs(m_num_inputs, buffer_size);
+	SGVector<float64_t> labels(buffer_size);
+	SGVector<index_t> permutation(buffer_size);
+
+	SGMatrix<float64_t> inputs_batch(m_num_inputs, m_gd_mini_batch_size);
+	SGMatrix<float64_t> targets_batch(get_num_outputs(), m_gd_mini_batch_size);
+
+	float64_t error_last_time = -1.0, error = -1.0;
+
+	// the size of the training set is unknown, the buffer is used instead
+	float64_t c = m_gd_error_damping_coeff;
+	if (c==-1.0)
+		c = 0.99/m_gd_streaming_buffer_size + 1e-2;
+
+	bool continue_training = true;
+	float64_t alpha = m_gd_learning_rate;
+
+	features->start_parser();
+	for (int32_t i=0; continue_training; i++)
+	{
+		if (m_max_num_epochs!=0)
+			if (i>=m_max_num_epochs) break;
+
+		if (i>0)
+		{
+			if (!features->is_seekable())
+			{
+				SG_WARNING("Stream is not seekable, training stops after one "
+					"epoch\n");
+				break;
+			}
+			features->reset_stream();
+		}
+
+		while (continue_training)
+		{
+			index_t num_read = 0;
+			while (num_read<buffer_size && features->get_next_example())
+			{
+				SGVector<float64_t> x = features->get_vector();
+				REQUIRE(x.vlen==m_num_inputs,
+					"Number of features (%i) must match the network's number "
+					"of inputs (%i)\n", x.vlen, m_num_inputs);
+
+				sg_memcpy(inputs.get_column_vector(num_read), x.vector,
+					m_num_inputs*sizeof(float64_t));
+				labels[num_read] = features->get_label();
+				features->release_example();
+				num_read++;
+			}
+
+			if (num_read==0)
+				break;
+
+			SGMatrix<float64_t> targets = labels_to_matrix(
+				SGVector<float64_t>(labels.vector, num_read, false));
+
+			SGVector<index_t> perm(permutation.vector, num_read, false);
+			perm.range_fill();
+			CMath::permute(perm);
+
+			for (index_t j=0; j<num_read; j+=m_gd_mini_batch_size)
+			{
+				alpha = m_gd_learning_rate_decay*alpha;
+
+				index_t batch_size =
+					CMath::min<index_t>(m_gd_mini_batch_size, num_read-j);
+
+				SGMatrix<float64_t> inputs_view(inputs_batch.matrix,
+					m_num_inputs, batch_size, false);
+				SGMatrix<float64_t> targets_view(targets_batch.matrix,
+					get_num_outputs(), batch_size, false);
+
+				for (index_t k=0; k<batch_size; k++)
+				{
+					sg_memcpy(inputs_view.get_column_vector(k),
+						inputs.get_column_vector(perm[j+k]),
+						m_num_inputs*sizeof(float64_t));
+					sg_memcpy(targets_view.get_column_vector(k),
+						targets.get_column_vector(perm[j+k]),
+						get_num_outputs()*sizeof(float64_t));
+				}
+
+				set_batch_size(batch_size);
+				float64_t e = gradient_descent_step(inputs_view, targets_view,
+					gradients, param_updates, alpha);
+
+				// filter the errors
+				if (error==-1.0)
+					error = e;
+				else
+					error = (1.0-c) * error + c*e;
+
+				if (error_last_time!=-1.0)
+				{
+					float64_t error_change = (error_last_time-error)/error;
+					if (error_change< m_epsilon && error_change>=0)
+					{
+						SG_INFO("Gradient Descent Optimization Converged\n");
+						continue_training = false;
+						break;
+					}
+
+					SG_INFO("Epoch %i: Error = %f\n",i, error);
+				}
+				error_last_time = error;
+			}
+		}
+	}
+	features->end_parser();
+
+	return true;
+}
+
+float64_t CNeuralNetwork::gradient_descent_step(SGMatrix<float64_t> inputs,
+	SGMatrix<float64_t> targets, SGVector<float64_t> gradients,
+	SGVector<float64_t> param_updates, float64_t alpha)
+{
+	// look ahead along the momentum direction
+	linalg::add(m_params, param_updates, m_params, 1.0, m_gd_momentum);
+
+	float64_t e = compute_gradients(inputs, targets, gradients);
+
+	for (int32_t k=0; k<m_num_layers; k++)
+	{
+		SGVector<float64_t> layer_gradients = get_section(gradients, k);
+		if (layer_gradients.vlen > 0)
+		{
+			SG_INFO("Layer %i (%s), Max Gradient: %g, Mean Gradient: %g.\n", k,get_layer(k)->get_name(),
+				CMath::max(layer_gradients.vector, layer_gradients.vlen),
+				SGVector<float64_t>::sum(layer_gradients.vector, layer_gradients.vlen)/layer_gradients.vlen);
+		}
+	}
+
+	linalg::add(param_updates, gradients, param_updates, m_gd_momentum, -alpha);
+	linalg::add(m_params, gradients, m_params, 1.0, -alpha);
+
+	return e;
+}
+
 bool CNeuralNetwork::train_lbfgs(SGMatrix<float64_t> inputs,
 		const SGMatrix<float64_t> targets)
 {
@@ -466,6 +636,42 @@ SGMatrix<float64_t> CNeuralNetwork::forward_propagate(
 
 float64_t CNeuralNetwork::compute_gradients(SGMatrix<float64_t> inputs,
 		SGMatrix<float64_t> targets, SGVector<float64_t> gradients)
+{
+	bool use_replicas = m_replicas.size()>1 && inputs.num_cols>1;
+	if (use_replicas)
+		backpropagate_parallel(inputs, targets, gradients);
+	else
+		backpropagate(inputs, targets, gradients);
+
+	// L1 and L2 regularization
+	if (m_l2_coefficient != 0.0 || m_l1_coefficient != 0.0)
+	{
+		for (int32_t i=0; i<m_total_num_parameters; i++)
+		{
+			if (m_param_regularizable[i])
+				gradients[i] += m_l2_coefficient*m_params[i]
+					+ m_l1_coefficient*CMath::sign<float64_t>(m_params[i]);
+		}
+	}
+
+	// max-norm regularization
+	if (m_max_norm != -1.0)
+	{
+		for (int32_t i=0; i<m_num_layers; i++)
+		{
+			SGVector<float64_t> layer_params = get_section(m_params,i);
+			get_layer(i)->enforce_max_norm(layer_params, m_max_norm);
+		}
+	}
+
+	if (use_replicas)
+		return compute_error_parallel(targets);
+
+	return compute_error(targets);
+}
+
+void CNeuralNetwork::backpropagate(SGMatrix<float64_t> inputs,
+		SGMatrix<float64_t> targets, SGVector<float64_t> gradients)
 {
 	forward_propagate(inputs);
 
@@ -484,62 +690,97 @@ float64_t CNeuralNetwork::compute_gradients(SGMatrix<float64_t> inputs,
 			get_layer(i)->compute_gradients(get_section(m_params,i),
 				SGMatrix<float64_t>(), m_layers, get_section(gradients,i));
 	}
+}
+
+void CNeuralNetwork::backpropagate_parallel(SGMatrix<float64_t> inputs,
+		SGMatrix<float64_t> targets, SGVector<float64_t> gradients)
+{
+	int32_t num_replicas = get_num_sub_batches(inputs.num_cols);
 
-	// L2 regularization
-	if (m_l2_coefficient != 0.0)
+	#pragma omp parallel for num_threads(num_replicas)
+	for (int32_t t=0; t<num_replicas; t++)
 	{
-		for (int32_t i=0; i<m_total_num_parameters; i++)
-		{
-			if (m_param_regularizable[i])
-				gradients[i] += m_l2_coefficient*m_params[i];
-		}
+		SGMatrix<float64_t> inputs_part = get_sub_batch(inputs, t, num_replicas);
+		SGVector<float64_t> gradients_part(
+			m_replica_gradients.get_column_vector(t),
+			m_total_num_parameters, false);
+
+		CNeuralNetwork* replica = m_replicas[t];
+		replica->set_batch_size(inputs_part.num_cols);
+		replica->backpropagate(inputs_part,
+			get_sub_batch(targets, t, num_replicas), gradients_part);
 	}
 
-	// L1 regularization
-	if (m_l1_coefficient != 0.0)
+	// the gradients of the layers are means over the batch, the gradients of
+	// the sub-batches are weighted by their sizes
+	SGVector<float64_t> weights(num_replicas);
+	for (int32_t t=0; t<num_replicas; t++)
 	{
-		for (int32_t i=0; i<m_total_num_parameters; i++)
-		{
-			if (m_param_regularizable[i])
-				gradients[i] +=
-					m_l1_coefficient*CMath::sign<float64_t>(m_params[i]);
-		}
+		weights[t] = (float64_t)get_sub_batch(inputs, t, num_replicas).num_cols
+			/ inputs.num_cols;
 	}
 
-	// max-norm regularization
-	if (m_max_norm != -1.0)
+	#pragma omp parallel for num_threads(num_replicas)
+	for (int32_t i=0; i<m_total_num_parameters; i++)
 	{
-		for (int32_t i=0; i<m_num_layers; i++)
-		{
-			SGVector<float64_t> layer_params = get_section(m_params,i);
-			get_layer(i)->enforce_max_norm(layer_params, m_max_norm);
-		}
+		float64_t sum = 0.0;
+		for (int32_t t=0; t<num_replicas; t++)
+			sum += weights[t]*m_replica_gradients(i,t);
+		gradients[i] = sum;
 	}
-
-	return compute_error(targets);
 }
 
-float64_t CNeuralNetwork::compute_error(SGMatrix<float64_t> targets)
+float64_t CNeuralNetwork::compute_error_parallel(SGMatrix<float64_t> targets)
 {
-	float64_t error = get_layer(m_num_layers-1)->compute_error(targets);
+	int32_t num_replicas = get_num_sub_batches(targets.num_cols);
 
-	// L2 regularization
-	if (m_l2_coefficient != 0.0)
+	float64_t error = 0.0;
+	#pragma omp parallel for num_threads(num_replicas) reduction(+:error)
+	for (int32_t t=0; t<num_replicas; t++)
 	{
-		for (int32_t i=0; i<m_total_num_parameters; i++)
-		{
-			if (m_param_regularizable[i])
-				error += 0.5*m_l2_coefficient*m_params[i]*m_params[i];
-		}
+		SGMatrix<float64_t> targets_part =
+			get_sub_batch(targets, t, num_replicas);
+
+		error += m_replicas[t]->compute_error(targets_part)
+			* targets_part.num_cols / targets.num_cols;
 	}
 
-	// L1 regularization
-	if (m_l1_coefficient != 0.0)
+	return error;
+}
+
+int32_t CNeuralNetwork::get_num_sub_batches(index_t batch_size)
+{
+	return CMath::min<int32_t>(m_replicas.size(), batch_size);
+}
+
+SGMatrix<float64_t> CNeuralNetwork::get_sub_batch(SGMatrix<float64_t> batch,
+		int32_t t, int32_t num_sub_batches)
+{
+	index_t start = (int64_t)batch.num_cols*t/num_sub_batches;
+	index_t stop = (int64_t)batch.num_cols*(t+1)/num_sub_batches;
+
+	return SGMatrix<float64_t>(batch.matrix+(int64_t)start*batch.num_rows,
+		batch.num_rows, stop-start, false);
+}
+
+float64_t CNeuralNetwork::compute_error(SGMatrix<float64_t> targets)
+{
+	return get_layer(m_num_layers-1)->compute_error(targets)
+		+ compute_regularization_error();
+}
+
+float64_t CNeuralNetwork::compute_regularization_error()
+{
+	float64_t error = 0.0;
+
+	// L1 and L2 regularization
+	if (m_l2_coefficient != 0.0 || m_l1_coefficient != 0.0)
 	{
 		for (int32_t i=0; i<m_total_num_parameters; i++)
 		{
 			if (m_param_regularizable[i])
-				error += m_l1_coefficient*CMath::abs(m_params[i]);
+				error += 0.5*m_l2_coefficient*m_params[i]*m_params[i]
+					+ m_l1_coefficient*CMath::abs(m_params[i]);
 		}
 	}
 
@@ -604,6 +845,39 @@ float64_t CNeuralNetwork::check_gradients(float64_t approx_epsilon, float64_t s)
 	return sum/m_total_num_parameters;
 }
 
+void CNeuralNetwork::create_replicas(int32_t num_replicas)
+{
+	free_replicas();
+
+	// the replicas do not need the labels, avoid copying them
+	CLabels* labels = m_labels;
+	m_labels = NULL;
+
+	for (int32_t t=0; t<num_replicas; t++)
+	{
+		CNeuralNetwork* replica = (CNeuralNetwork*)clone();
+
+		// the parameters are shared, not copied
+		replica->m_params = m_params;
+
+		m_replicas.push_back(replica);
+	}
+
+	m_labels = labels;
+
+	m_replica_gradients = SGMatrix<float64_t>(m_total_num_parameters,
+		num_replicas);
+}
+
+void CNeuralNetwork::free_replicas()
+{
+	for (size_t t=0; t<m_replicas.size(); t++)
+		SG_UNREF(m_replicas[t]);
+
+	m_replicas.clear();
+	m_replica_gradients = SGMatrix<float64_t>();
+}
+
 void CNeuralNetwork::set_batch_size(int32_t batch_size)
 {
 	if (batch_size!=m_batch_size)
@@ -675,6 +949,38 @@ SGMatrix<float64_t> CNeuralNetwork::labels_to_matrix(CLabels* labs)
 	return targets;
 }
 
+SGMatrix<float64_t> CNeuralNetwork::labels_to_matrix(SGVector<float64_t> labs)
+{
+	ELabelType label_type = get_num_outputs()>1 ? LT_MULTICLASS : LT_REGRESSION;
+	if (m_labels!=NULL)
+		label_type = m_labels->get_label_type();
+
+	SGMatrix<float64_t> targets(get_num_outputs(), labs.vlen);
+	targets.zero();
+
+	for (int32_t i=0; i<labs.vlen; i++)
+	{
+		if (label_type == LT_MULTICLASS)
+		{
+			int32_t c = (int32_t)labs[i];
+			REQUIRE(c>=0 && c<get_num_outputs(), "Class label (%i) must be "
+				"in [0, %i)\n", c, get_num_outputs());
+
+			targets(c, i) = 1.0;
+		}
+		else if (label_type == LT_BINARY)
+		{
+			targets(0, i) = (labs[i]==1);
+			if (get_num_outputs()==2)
+				targets(1, i) = (labs[i]==-1);
+		}
+		else
+			targets[i] = labs[i];
+	}
+
+	return targets;
+}
+
 EProblemType CNeuralNetwork::get_machine_problem_type() const
 {
 	// problem type depends on the type of labels given to the network
@@ -773,6 +1079,7 @@ void CNeuralNetwork::init()
 	m_lbfgs_temp_inputs = NULL;
 	m_lbfgs_temp_targets = NULL;
 	m_is_training = false;
+	m_gd_streaming_buffer_size = 16;
 
 	SG_ADD((machine_int_t*)&m_optimization_method, "optimization_method",
 	       "Optimization Method", MS_NOT_AVAILABLE);
@@ -788,6 +1095,8 @@ void CNeuralNetwork::init()
 	       "Gradient Descent Momentum", MS_NOT_AVAILABLE);
 	SG_ADD(&m_gd_error_damping_coeff, "gd_error_damping_coeff",
 	       "Gradient Descent Error Damping Coeff", MS_NOT_AVAILABLE);
+	SG_ADD(&m_gd_streaming_buffer_size, "gd_streaming_buffer_size",
+	       "Gradient Descent Streaming Buffer Size", MS_NOT_AVAILABLE);
 	SG_ADD(&m_epsilon, "epsilon",
 	       "Epsilon", MS_NOT_AVAILABLE);
 	SG_ADD(&m_num_inputs, "num_inputs",
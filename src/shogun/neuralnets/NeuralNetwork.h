@@ -39,9 +39,12 @@
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/SGMatrix.h>
 
+#include <vector>
+
 namespace shogun
 {
 template<class T> class CDenseFeatures;
+template<class T> class CStreamingDenseFeatures;
 class CDynamicObjectArray;
 class CNeuralLayer;
 
@@ -80,12 +83,22 @@ enum ENNOptimizationMethod
  * The network can also be initialized from a JSON file using
  * CNeuralNetworkFileReader.
  *
- * Supported feature types: CDenseFeatures<float64_t>
+ * Supported feature types: CDenseFeatures<float64_t>,
+ * CStreamingDenseFeatures<float64_t> (gradient descent only)
  * Supported label types:
  * 	- CBinaryLabels
  * 	- CMulticlassLabels
  * 	- CRegressionLabels
  *
+ * When training on CStreamingDenseFeatures the labels are read from the
+ * stream, the type of the labels set with set_labels() (if any) specifies
+ * how they are interpreted. Without labels, they are treated as class
+ * indices if the network has more than one output and as regression targets
+ * otherwise. Examples are read in buffers of get_gd_streaming_buffer_size()
+ * mini-batches that are shuffled before training on them, so the whole
+ * dataset never has to be kept in memory. Multiple epochs require a seekable
+ * stream.
+ *
  * The neural network can be trained using
  * [L-BFGS](http://en.wikipedia.org/wiki/Limited-memory_BFGS) (default) or
  * [mini-batch gradient descent]
@@ -101,6 +114,11 @@ enum ENNOptimizationMethod
  * makes it easy to train a network of any combination of arbitrary layer types
  * using any optimization method (gradient descent, L-BFGS, ..)
  *
+ * If more than one thread is available (see Parallel), each batch is split
+ * into one sub-batch per thread during training. The sub-batches are
+ * propagated through per-thread replicas of the layers which share the
+ * network's parameter array, and the resulting gradients are averaged.
+ *
  * All the matrices the network (and related classes) deal with are in
  * column-major format
  *
@@ -380,6 +398,26 @@ public:
 		return m_gd_mini_batch_size;
 	}
 
+	/** Sets the number of mini-batches that are read from a stream and
+	 * shuffled together when training on CStreamingDenseFeatures
+	 * default value is 16
+	 *
+	 * @param gd_streaming_buffer_size buffer size, in mini-batches
+	 */
+	void set_gd_streaming_buffer_size(int32_t gd_streaming_buffer_size)
+	{
+		REQUIRE(gd_streaming_buffer_size>0,
+			"Streaming buffer size (%i) must be > 0\n",
+			gd_streaming_buffer_size);
+		m_gd_streaming_buffer_size = gd_streaming_buffer_size;
+	}
+
+	/** Returns the streaming buffer size, in mini-batches */
+	int32_t get_gd_streaming_buffer_size() const
+	{
+		return m_gd_streaming_buffer_size;
+	}
+
 	/** Sets gradient descent learning rate
 	 * defualt value 0.1
 	 * @param gd_learning_rate gradient descent learning rate
@@ -464,10 +502,21 @@ protected:
 	virtual bool train_gradient_descent(SGMatrix<float64_t> inputs,
 			SGMatrix<float64_t> targets);
 
+	/** trains the network using gradient descent on mini-batches pulled
+	 * from a stream
+	 */
+	virtual bool train_gradient_descent(
+			CStreamingDenseFeatures<float64_t>* features);
+
 	/** trains the network using L-BFGS*/
 	virtual bool train_lbfgs(SGMatrix<float64_t> inputs,
 			SGMatrix<float64_t> targets);
 
+	/** labels are optional when training on streaming features, they are
+	 * checked in train_machine()
+	 */
+	virtual bool train_require_labels() const { return false; }
+
 	/** Applies forward propagation, computes the activations of each layer up
 	 * to layer j
 	 *
@@ -537,6 +586,9 @@ protected:
 	 */
 	virtual float64_t compute_error(SGMatrix<float64_t> targets);
 
+	/** Computes the L1 and L2 regularization terms of the error */
+	float64_t compute_regularization_error();
+
 	virtual bool is_label_valid(CLabels *lab) const;
 
 	/** returns a pointer to layer i in the network */
@@ -553,9 +605,56 @@ protected:
 	 */
 	SGMatrix<float64_t> labels_to_matrix(CLabels* labs);
 
+	/** converts labels read from a stream into a matrix suitable for use
+	 * with the network, see the class description
+	 *
+	 * @return matrix of size get_num_outputs()*labs.vlen
+	 */
+	SGMatrix<float64_t> labels_to_matrix(SGVector<float64_t> labs);
+
 private:
 	void init();
 
+	/** Applies forward and backpropagation on the given batch, computes the
+	 * gradients without the regularization terms
+	 */
+	void backpropagate(SGMatrix<float64_t> inputs,
+			SGMatrix<float64_t> targets, SGVector<float64_t> gradients);
+
+	/** Same as backpropagate(), but splits the batch among the replicas and
+	 * averages their gradients
+	 */
+	void backpropagate_parallel(SGMatrix<float64_t> inputs,
+			SGMatrix<float64_t> targets, SGVector<float64_t> gradients);
+
+	/** Same as compute_error(), using the activations computed by the
+	 * replicas in backpropagate_parallel()
+	 */
+	float64_t compute_error_parallel(SGMatrix<float64_t> targets);
+
+	/** Returns the number of sub-batches a batch is split into */
+	int32_t get_num_sub_batches(index_t batch_size);
+
+	/** Returns sub-batch t of the given batch (columns) */
+	SGMatrix<float64_t> get_sub_batch(SGMatrix<float64_t> batch,
+			int32_t t, int32_t num_sub_batches);
+
+	/** Performs one gradient descent step with momentum on the given batch
+	 *
+	 * @return error on the batch
+	 */
+	float64_t gradient_descent_step(SGMatrix<float64_t> inputs,
+			SGMatrix<float64_t> targets, SGVector<float64_t> gradients,
+			SGVector<float64_t> param_updates, float64_t alpha);
+
+	/** Creates one replica of the network per thread, the replicas share
+	 * the parameters of the network
+	 */
+	void create_replicas(int32_t num_replicas);
+
+	/** Frees the replicas created by create_replicas() */
+	void free_replicas();
+
 	/** callback for l-bfgs */
 	static float64_t lbfgs_evaluate(void *userdata,
 			const float64_t *W,
@@ -710,12 +809,23 @@ protected:
 	 */
 	float64_t m_gd_error_damping_coeff;
 
+	/** number of mini-batches that are read from a stream and shuffled
+	 * together, default value is 16
+	 */
+	int32_t m_gd_streaming_buffer_size;
+
 private:
 	/** temperary pointers to the training data, used to pass the data to L-BFGS
 	 * routines
 	 */
 	const SGMatrix<float64_t>* m_lbfgs_temp_inputs;
 	const SGMatrix<float64_t>* m_lbfgs_temp_targets;
+
+	/** per-thread replicas used during training */
+	std::vector<CNeuralNetwork*> m_replicas;
+
+	/** gradients computed by the replicas, one column per replica */
+	SGMatrix<float64_t> m_replica_gradients;
 };
 
 }
@@ -102,3 +102,16 @@ void AdaGradUpdater::update_variable(SGVector<float64_t> variable_reference,
 	DescendUpdaterWithCorrection::update_variable(variable_reference,
 		raw_negative_descend_direction, learning_rate);
 }
+
+void AdaGradUpdater::update_variable_lazily(SGVector<float64_t> variable_reference,
+	SGSparseVector<float64_t> raw_negative_descend_direction, float64_t learning_rate)
+{
+	REQUIRE(variable_reference.vlen>0,"variable_reference must set\n");
+	if(m_gradient_accuracy.vlen==0)
+	{
+		m_gradient_accuracy=SGVector<float64_t>(variable_reference.vlen);
+		m_gradient_accuracy.set_const(0.0);
+	}
+	DescendUpdaterWithCorrection::update_variable_lazily(variable_reference,
+		raw_negative_descend_direction, learning_rate);
+}
@@ -102,6 +102,25 @@ public:
 		SGVector<float64_t> raw_negative_descend_direction,
 		float64_t learning_rate);
 
+	/** Can the updater be used with sparse negative descend directions?
+	 *
+	 * This is the case without descend correction, since neither the
+	 * entry nor its accumulated gradient change for a zero gradient.
+	 *
+	 * @return whether update_variable_lazily() is supported
+	 */
+	virtual bool supports_lazy_update() const { return m_correction==NULL; }
+
+	/** Update the target variable based on a sparse negative descend direction
+	 *
+	 * @param variable_reference a reference of the target variable
+	 * @param raw_negative_descend_direction the sparse negative descend direction
+	 * @param learning_rate learning rate
+	 */
+	virtual void update_variable_lazily(SGVector<float64_t> variable_reference,
+		SGSparseVector<float64_t> raw_negative_descend_direction,
+		float64_t learning_rate);
+
 protected:
 	/** Get the negative descend direction given current variable  and gradient 
 	 *
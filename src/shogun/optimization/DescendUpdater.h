@@ -32,6 +32,7 @@
 #ifndef DESCENDUPDATER_H
 #define DESCENDUPDATER_H
 #include <shogun/lib/SGVector.h>
+#include <shogun/lib/SGSparseVector.h>
 #include <shogun/base/SGObject.h>
 namespace shogun
 {
@@ -62,6 +63,39 @@ public:
 	virtual void update_variable(SGVector<float64_t> variable_reference,
 		SGVector<float64_t> negative_descend_direction, float64_t learning_rate)=0;
 
+	/** Can the updater be used with sparse negative descend directions?
+	 *
+	 * This is the case if an entry with a zero negative descend direction is
+	 * not changed by update_variable(), so that update_variable_lazily() only
+	 * has to touch the entries of the sparse direction. State kept for the
+	 * other entries (eg, decaying averages) is caught up once they are
+	 * touched again.
+	 *
+	 * @return whether update_variable_lazily() is supported
+	 */
+	virtual bool supports_lazy_update() const { return false; }
+
+	/** Update the target variable based on a sparse negative descend direction
+	 *
+	 * The result is the same as calling update_variable() with a dense
+	 * direction that is zero outside the entries of the sparse one.
+	 *
+	 * @param variable_reference a reference of the target variable
+	 * @param negative_descend_direction the sparse negative descend direction
+	 * @param learning_rate learning rate
+	 */
+	virtual void update_variable_lazily(SGVector<float64_t> variable_reference,
+		SGSparseVector<float64_t> negative_descend_direction, float64_t learning_rate)
+	{
+		SG_NOTIMPLEMENTED
+	}
+
+	/** Catch up the state of all entries skipped by update_variable_lazily()
+	 *
+	 * @param variable_reference a reference of the target variable
+	 */
+	virtual void finish_lazy_update(SGVector<float64_t> variable_reference) {}
+
 };
 
 }
@@ -86,6 +86,20 @@ void DescendUpdaterWithCorrection::update_variable(SGVector<float64_t> variable_
 	}
 }
 
+void DescendUpdaterWithCorrection::update_variable_lazily(SGVector<float64_t> variable_reference,
+	SGSparseVector<float64_t> raw_negative_descend_direction, float64_t learning_rate)
+{
+	REQUIRE(!m_correction, "Lazy update is not supported with descend correction\n");
+
+	for(index_t k=0; k<raw_negative_descend_direction.num_feat_entries; k++)
+	{
+		index_t idx=raw_negative_descend_direction.features[k].feat_index;
+		REQUIRE(idx>=0 && idx<variable_reference.vlen, "The index (%d) is invalid\n", idx);
+		variable_reference[idx]-=get_negative_descend_direction(variable_reference[idx],
+			raw_negative_descend_direction.features[k].entry, idx, learning_rate);
+	}
+}
+
 void DescendUpdaterWithCorrection::init()
 {
 	m_correction=NULL;
@@ -65,6 +65,18 @@ public:
 	 */
 	virtual void update_variable(SGVector<float64_t> variable_reference,
 		SGVector<float64_t> raw_negative_descend_direction, float64_t learning_rate);
+
+	/** Update the target variable based on a sparse negative descend direction
+	 *
+	 * Only supported without descend correction, since a correction (eg,
+	 * momentum) moves entries whose direction is zero.
+	 *
+	 * @param variable_reference a reference of the target variable
+	 * @param raw_negative_descend_direction the sparse negative descend direction
+	 * @param learning_rate learning rate
+	 */
+	virtual void update_variable_lazily(SGVector<float64_t> variable_reference,
+		SGSparseVector<float64_t> raw_negative_descend_direction, float64_t learning_rate);
 	
 	/** Set the type of descend correction
 	 *
@@ -68,6 +68,13 @@ float64_t ElasticNetPenalty::get_sparse_variable(float64_t variable, float64_t p
 	return m_l1_penalty->get_sparse_variable(variable, penalty_weight*m_l1_ratio);
 }
 
+float64_t ElasticNetPenalty::get_lazy_variable(float64_t variable, float64_t decay,
+	float64_t proximal_weight)
+{
+	check_ratio();
+	return m_l1_penalty->get_lazy_variable(variable, decay, proximal_weight*m_l1_ratio);
+}
+
 void ElasticNetPenalty::check_ratio()
 {
 	REQUIRE(m_l1_ratio>0, "l1_ratio must set\n");
@@ -110,6 +110,29 @@ public:
 	 */
 	virtual float64_t get_sparse_variable(float64_t variable, float64_t penalty_weight);
 
+	/** ElasticNet penalty can be caught up lazily
+	 *
+	 * @return true
+	 */
+	virtual bool supports_lazy_update() const { return true; }
+
+	/** The gradient of the L2 part is (1.0-l1_ratio) times the variable
+	 *
+	 * @return 1.0-l1_ratio
+	 */
+	virtual float64_t get_gradient_coefficient() const { return 1.0-m_l1_ratio; }
+
+	/** Apply the soft-thresholds of the L1 part of several skipped steps at
+	 * once
+	 *
+	 * @param variable the raw variable
+	 * @param decay product of the scaling factors
+	 * @param proximal_weight accumulated weight of the penalty
+	 * @return the variable after the skipped steps
+	 */
+	virtual float64_t get_lazy_variable(float64_t variable, float64_t decay,
+		float64_t proximal_weight);
+
 protected:
 
 	/** check l1_ratio */
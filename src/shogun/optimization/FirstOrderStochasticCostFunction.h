@@ -33,6 +33,7 @@
 #define FIRSTORDERSTOCHASTICCOSTFUNCTION_H
 #include <shogun/lib/config.h>
 #include <shogun/optimization/FirstOrderCostFunction.h>
+#include <shogun/lib/SGSparseVector.h>
 namespace shogun
 {
 /** @brief The first order stochastic cost function base class.
@@ -79,6 +80,101 @@ public:
 	 */
 	virtual SGVector<float64_t> get_gradient()=0;
 
+	/** Does the cost function provide sparse sample gradients?
+	 *
+	 * If true, stochastic minimizers call get_gradient_support() and
+	 * get_sparse_gradient() instead of get_gradient() and update only the
+	 * entries in the support, catching up the skipped steps of the other
+	 * entries lazily.
+	 *
+	 * @return whether sparse sample gradients are supported
+	 */
+	virtual bool supports_sparse_gradient() const { return false; }
+
+	/** Get the indices of the target variables the SAMPLE gradient depends on
+	 *
+	 * The indices must not depend on the current value of the target
+	 * variables and must be unique. The sample gradient must be zero outside
+	 * of them and must only read the target variables at them.
+	 *
+	 * For a linear model, these are the non-zero features of the sample
+	 * obtained by next_sample()
+	 *
+	 * @return indices of the sample gradient
+	 */
+	virtual SGVector<index_t> get_gradient_support()
+	{
+		SG_SNOTIMPLEMENTED
+		return SGVector<index_t>();
+	}
+
+	/** Get the SAMPLE gradient at the indices of get_gradient_support()
+	 *
+	 * The k-th entry of the result holds the gradient wrt the target
+	 * variable at the k-th index of get_gradient_support()
+	 *
+	 * @return sparse sample gradient of variables
+	 */
+	virtual SGSparseVector<float64_t> get_sparse_gradient()
+	{
+		SG_SNOTIMPLEMENTED
+		return SGSparseVector<float64_t>();
+	}
+
+	/** Does the cost function provide gradients of samples given by index?
+	 *
+	 * If true, stochastic minimizers can work on mini-batches of samples,
+	 * computing the sample gradients of a mini-batch in parallel
+	 * (see get_sample_gradient())
+	 *
+	 * @return whether sample gradients by index are supported
+	 */
+	virtual bool supports_batch_gradient() const { return false; }
+
+	/** Get the index of the sample obtained by next_sample()
+	 *
+	 * @return index of the current sample
+	 */
+	virtual index_t get_sample_index()
+	{
+		SG_SNOTIMPLEMENTED
+		return -1;
+	}
+
+	/** Get the SAMPLE gradient of the idx-th sample wrt target variables
+	 *
+	 * This is get_gradient() for the given sample instead of the one
+	 * obtained by next_sample(). The method must not modify the state of the
+	 * cost function, since it is called from several threads at once.
+	 *
+	 * For FirstOrderSAGCostFunction, the samples are indexed from 0 to
+	 * get_sample_size()-1.
+	 *
+	 * @param idx index of the sample
+	 * @return sample gradient of variables
+	 */
+	virtual SGVector<float64_t> get_sample_gradient(index_t idx)
+	{
+		SG_SNOTIMPLEMENTED
+		return SGVector<float64_t>();
+	}
+
+	/** Get the SAMPLE gradient of the idx-th sample as a sparse vector
+	 *
+	 * This is get_sparse_gradient() for the given sample. It is used instead
+	 * of get_sample_gradient() if both sparse and batch gradients are
+	 * supported. Like get_sample_gradient(), the method must not modify the
+	 * state of the cost function.
+	 *
+	 * @param idx index of the sample
+	 * @return sparse sample gradient of variables
+	 */
+	virtual SGSparseVector<float64_t> get_sparse_sample_gradient(index_t idx)
+	{
+		SG_SNOTIMPLEMENTED
+		return SGSparseVector<float64_t>();
+	}
+
 	/** Get the cost given current target variables 
 	 *
 	 * For least squares, that is the value of \f$f(w)\f$.
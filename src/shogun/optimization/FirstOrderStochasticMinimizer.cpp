@@ -32,7 +32,11 @@
 #include <shogun/optimization/FirstOrderStochasticMinimizer.h>
 #include <shogun/optimization/SparsePenalty.h>
 #include <shogun/optimization/ProximalPenalty.h>
+#include <shogun/optimization/GradientDescendUpdater.h>
 #include <shogun/base/Parameter.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/mathematics/Math.h>
 using namespace shogun;
 
 void FirstOrderStochasticMinimizer::set_gradient_updater(DescendUpdater* gradient_updater)
@@ -84,6 +88,293 @@ void FirstOrderStochasticMinimizer::do_proximal_operation(SGVector<float64_t>var
 	}
 }
 
+void FirstOrderStochasticMinimizer::set_batch_size(int32_t batch_size)
+{
+	REQUIRE(batch_size>0, "The batch size (%d) must be positive\n", batch_size);
+	m_batch_size=batch_size;
+}
+
+bool FirstOrderStochasticMinimizer::use_batch_update(FirstOrderStochasticCostFunction* fun)
+{
+	REQUIRE(fun,"Cost function must set\n");
+	if(m_batch_size<=1 && !m_hogwild)
+		return false;
+	REQUIRE(fun->supports_batch_gradient(),
+		"Cost function (%s) must support batch gradients to use mini-batches\n",
+		fun->get_name());
+	return true;
+}
+
+bool FirstOrderStochasticMinimizer::supports_hogwild()
+{
+	GradientDescendUpdater* updater=dynamic_cast<GradientDescendUpdater*>(m_gradient_updater);
+	//a proximal operation per mini-batch would not match the sample steps
+	return updater && !updater->enables_descend_correction() &&
+		!dynamic_cast<ProximalPenalty*>(m_penalty_type);
+}
+
+SGVector<index_t> FirstOrderStochasticMinimizer::next_batch(FirstOrderStochasticCostFunction* fun)
+{
+	SGVector<index_t> indices(m_batch_size);
+	index_t num=0;
+	while(num<m_batch_size && fun->next_sample())
+		indices[num++]=fun->get_sample_index();
+
+	if(num<m_batch_size)
+	{
+		SGVector<index_t> last_batch(num);
+		std::copy(indices.vector, indices.vector+num, last_batch.vector);
+		return last_batch;
+	}
+	return indices;
+}
+
+SGVector<float64_t> FirstOrderStochasticMinimizer::get_batch_gradient(FirstOrderStochasticCostFunction* fun,
+	SGVector<index_t> indices, index_t len)
+{
+	REQUIRE(indices.vlen>0, "The mini-batch must not be empty\n");
+	index_t num_blocks=CMath::max(1, CMath::min(indices.vlen, parallel->get_num_threads()));
+	SGMatrix<float64_t> block_sums(len, num_blocks);
+	block_sums.zero();
+
+	#pragma omp parallel for num_threads(num_blocks)
+	for(index_t block=0; block<num_blocks; block++)
+	{
+		index_t start=block*indices.vlen/num_blocks;
+		index_t stop=(block+1)*indices.vlen/num_blocks;
+		float64_t* sum=block_sums.get_column_vector(block);
+		for(index_t k=start; k<stop; k++)
+		{
+			SGVector<float64_t> grad=fun->get_sample_gradient(indices[k]);
+			for(index_t idx=0; idx<len; idx++)
+				sum[idx]+=grad[idx];
+		}
+	}
+
+	SGVector<float64_t> result(len);
+	result.zero();
+	for(index_t block=0; block<num_blocks; block++)
+	{
+		for(index_t idx=0; idx<len; idx++)
+			result[idx]+=block_sums(idx,block);
+	}
+	for(index_t idx=0; idx<len; idx++)
+		result[idx]/=indices.vlen;
+	return result;
+}
+
+void FirstOrderStochasticMinimizer::do_hogwild_update(FirstOrderStochasticCostFunction* fun,
+	SGVector<float64_t> variable_reference, SGVector<index_t> indices)
+{
+	if(m_penalty_type)
+		REQUIRE(m_penalty_weight>0,"The weight of penalty must be set first\n");
+
+	//every sample is one iteration, the schedule is not thread safe
+	SGVector<float64_t> learning_rates(indices.vlen);
+	for(index_t k=0; k<indices.vlen; k++)
+	{
+		learning_rates[k]=1.0;
+		if(m_learning_rate)
+			learning_rates[k]=m_learning_rate->get_learning_rate(m_iter_counter+k+1);
+	}
+
+	float64_t* var=variable_reference.vector;
+	index_t len=variable_reference.vlen;
+	bool sparse=fun->supports_sparse_gradient();
+	//the target variable is shared without locks, only single entries are
+	//written atomically
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
+	for(index_t k=0; k<indices.vlen; k++)
+	{
+		if(sparse)
+		{
+			SGSparseVector<float64_t> grad=fun->get_sparse_sample_gradient(indices[k]);
+			for(index_t i=0; i<grad.num_feat_entries; i++)
+			{
+				index_t idx=grad.features[i].feat_index;
+				float64_t gradient=grad.features[i].entry;
+				if(m_penalty_type)
+					gradient+=m_penalty_weight*m_penalty_type->get_penalty_gradient(var[idx],gradient);
+				float64_t step=learning_rates[k]*gradient;
+				#pragma omp atomic
+				var[idx]-=step;
+			}
+			continue;
+		}
+
+		SGVector<float64_t> grad=fun->get_sample_gradient(indices[k]);
+		for(index_t idx=0; idx<len; idx++)
+		{
+			float64_t gradient=grad[idx];
+			if(m_penalty_type)
+				gradient+=m_penalty_weight*m_penalty_type->get_penalty_gradient(var[idx],grad[idx]);
+			float64_t step=learning_rates[k]*gradient;
+			if(step==0.0)
+				continue;
+			#pragma omp atomic
+			var[idx]-=step;
+		}
+	}
+	m_iter_counter+=indices.vlen;
+}
+
+bool FirstOrderStochasticMinimizer::use_lazy_update(FirstOrderStochasticCostFunction* fun,
+	bool dense_direction)
+{
+	REQUIRE(fun,"Cost function must set\n");
+	REQUIRE(m_gradient_updater,"Descend updater must set\n");
+	if(!fun->supports_sparse_gradient() || !m_gradient_updater->supports_lazy_update())
+		return false;
+
+	bool plain_descend=dynamic_cast<GradientDescendUpdater*>(m_gradient_updater)!=NULL;
+	if(dense_direction && !plain_descend)
+		return false;
+
+	if(m_penalty_type)
+	{
+		if(!m_penalty_type->supports_lazy_update())
+			return false;
+		if(m_penalty_type->get_gradient_coefficient()!=0.0 && !plain_descend)
+			return false;
+		//a proximal operation after a shift does not compose over steps
+		if(dynamic_cast<ProximalPenalty*>(m_penalty_type) &&
+			(dense_direction || !dynamic_cast<SparsePenalty*>(m_penalty_type)))
+			return false;
+	}
+	return true;
+}
+
+void FirstOrderStochasticMinimizer::init_lazy_update(index_t len)
+{
+	m_lazy_scale=1.0;
+	m_lazy_proximal_weight=0.0;
+	m_lazy_shift=0.0;
+	m_entry_scale=SGVector<float64_t>(len);
+	m_entry_scale.set_const(m_lazy_scale);
+	m_entry_proximal_weight=SGVector<float64_t>(len);
+	m_entry_proximal_weight.set_const(m_lazy_proximal_weight);
+	m_entry_shift=SGVector<float64_t>(len);
+	m_entry_shift.set_const(m_lazy_shift);
+}
+
+void FirstOrderStochasticMinimizer::catch_up_variable(SGVector<float64_t> variable_reference,
+	SGVector<index_t> indices, SGVector<float64_t> dense_direction)
+{
+	REQUIRE(m_entry_scale.vlen==variable_reference.vlen,
+		"Lazy update must be initialized for %d variables (%d given)\n",
+		variable_reference.vlen, m_entry_scale.vlen);
+	ProximalPenalty* proximal_penalty=dynamic_cast<ProximalPenalty*>(m_penalty_type);
+	for(index_t k=0; k<indices.vlen; k++)
+	{
+		index_t idx=indices[k];
+		if(m_entry_scale[idx]==m_lazy_scale &&
+			m_entry_proximal_weight[idx]==m_lazy_proximal_weight &&
+			m_entry_shift[idx]==m_lazy_shift)
+			continue;
+
+		float64_t decay=m_lazy_scale/m_entry_scale[idx];
+		if(proximal_penalty)
+		{
+			float64_t proximal_weight=m_entry_scale[idx]*
+				(m_lazy_proximal_weight-m_entry_proximal_weight[idx]);
+			variable_reference[idx]=proximal_penalty->get_lazy_variable(
+				variable_reference[idx], decay, proximal_weight);
+		}
+		else
+			variable_reference[idx]*=decay;
+
+		if(dense_direction.vlen)
+			variable_reference[idx]-=dense_direction[idx]*m_lazy_scale*(m_lazy_shift-m_entry_shift[idx]);
+
+		m_entry_scale[idx]=m_lazy_scale;
+		m_entry_proximal_weight[idx]=m_lazy_proximal_weight;
+		m_entry_shift[idx]=m_lazy_shift;
+	}
+}
+
+void FirstOrderStochasticMinimizer::do_lazy_update(SGVector<float64_t> variable_reference,
+	SGSparseVector<float64_t> gradient, float64_t learning_rate,
+	SGVector<float64_t> dense_direction)
+{
+	//every step scales the untouched entries by factor
+	float64_t factor=1.0;
+	if(m_penalty_type)
+	{
+		REQUIRE(m_penalty_weight>0,"The weight of penalty must be set first\n");
+		factor-=learning_rate*m_penalty_weight*m_penalty_type->get_gradient_coefficient();
+	}
+
+	if(factor<=0.0)
+	{
+		//the step flips or zeros the variable, do it densely
+		finish_lazy_update(variable_reference, dense_direction);
+		SGVector<float64_t> grad(variable_reference.vlen);
+		if(dense_direction.vlen)
+			std::copy(dense_direction.vector, dense_direction.vector+dense_direction.vlen, grad.vector);
+		else
+			grad.zero();
+		for(index_t k=0; k<gradient.num_feat_entries; k++)
+			grad[gradient.features[k].feat_index]=gradient.features[k].entry;
+
+		update_gradient(grad,variable_reference);
+		m_gradient_updater->update_variable(variable_reference,grad,learning_rate);
+		do_proximal_operation(variable_reference);
+		return;
+	}
+
+	if(m_penalty_type)
+	{
+		for(index_t k=0; k<gradient.num_feat_entries; k++)
+		{
+			index_t idx=gradient.features[k].feat_index;
+			float64_t grad=gradient.features[k].entry;
+			gradient.features[k].entry+=m_penalty_weight*
+				m_penalty_type->get_penalty_gradient(variable_reference[idx],grad);
+		}
+	}
+	m_gradient_updater->update_variable_lazily(variable_reference,gradient,learning_rate);
+
+	float64_t proximal_weight=0.0;
+	SparsePenalty* sparse_penalty=dynamic_cast<SparsePenalty*>(m_penalty_type);
+	if(sparse_penalty)
+	{
+		REQUIRE(m_learning_rate, "Learning rate must set when Sparse Penalty (eg, L1) is used\n");
+		proximal_weight=m_penalty_weight*m_learning_rate->get_learning_rate(m_iter_counter);
+		for(index_t k=0; k<gradient.num_feat_entries; k++)
+		{
+			index_t idx=gradient.features[k].feat_index;
+			variable_reference[idx]=sparse_penalty->get_sparse_variable(
+				variable_reference[idx],proximal_weight);
+		}
+	}
+
+	m_lazy_scale*=factor;
+	m_lazy_proximal_weight+=proximal_weight/m_lazy_scale;
+	if(dense_direction.vlen)
+		m_lazy_shift+=learning_rate/m_lazy_scale;
+
+	for(index_t k=0; k<gradient.num_feat_entries; k++)
+	{
+		index_t idx=gradient.features[k].feat_index;
+		m_entry_scale[idx]=m_lazy_scale;
+		m_entry_proximal_weight[idx]=m_lazy_proximal_weight;
+		m_entry_shift[idx]=m_lazy_shift;
+	}
+
+	//rescale before the accumulated weights lose precision
+	if(m_lazy_scale<1e-100)
+		finish_lazy_update(variable_reference, dense_direction);
+}
+
+void FirstOrderStochasticMinimizer::finish_lazy_update(SGVector<float64_t> variable_reference,
+	SGVector<float64_t> dense_direction)
+{
+	SGVector<index_t> indices(variable_reference.vlen);
+	indices.range_fill();
+	catch_up_variable(variable_reference, indices, dense_direction);
+	init_lazy_update(variable_reference.vlen);
+}
+
 void FirstOrderStochasticMinimizer::init_minimization()
 {
 	REQUIRE(m_fun,"Cost function must set\n");
@@ -99,6 +390,11 @@ void FirstOrderStochasticMinimizer::init()
 	m_num_passes=0;
 	m_cur_passes=0;
 	m_iter_counter=0;
+	m_batch_size=1;
+	m_hogwild=false;
+	m_lazy_scale=1.0;
+	m_lazy_proximal_weight=0.0;
+	m_lazy_shift=0.0;
 
 	SG_ADD((CSGObject **)&m_learning_rate, "FirstOrderMinimizer__m_learning_rate",
 		"learning_rate in FirstOrderStochasticMinimizer", MS_NOT_AVAILABLE);
@@ -110,4 +406,10 @@ void FirstOrderStochasticMinimizer::init()
 		"cur_passes in FirstOrderStochasticMinimizer", MS_NOT_AVAILABLE);
 	SG_ADD(&m_iter_counter, "FirstOrderMinimizer__m_iter_counter",
 		"m_iter_counter in FirstOrderStochasticMinimizer", MS_NOT_AVAILABLE);
+	SG_ADD(&m_batch_size, "FirstOrderMinimizer__m_batch_size",
+		"batch_size in FirstOrderStochasticMinimizer", MS_NOT_AVAILABLE);
+	SG_ADD(&m_hogwild, "FirstOrderMinimizer__m_hogwild",
+		"hogwild in FirstOrderStochasticMinimizer", MS_NOT_AVAILABLE);
+	// the lazy update state is only valid within minimize(), which rebuilds
+	// it with init_lazy_update(), so it is not registered
 }
@@ -135,6 +135,52 @@ public:
 	 */
 	virtual int32_t get_iteration_counter() {return m_iter_counter;}
 
+	/** Set the number of samples in a mini-batch
+	 *
+	 * With mini-batches, every step uses the mean of the sample gradients
+	 * of the mini-batch, which are computed in parallel. The cost function
+	 * must support batch gradients (see
+	 * FirstOrderStochasticCostFunction::supports_batch_gradient()).
+	 *
+	 * @param batch_size number of samples in a mini-batch (default 1)
+	 */
+	virtual void set_batch_size(int32_t batch_size);
+
+	/** Get the number of samples in a mini-batch
+	 *
+	 * @return number of samples in a mini-batch
+	 */
+	virtual int32_t get_batch_size() const {return m_batch_size;}
+
+	/** Enable asynchronous (Hogwild) updates of mini-batches
+	 *
+	 * Instead of reducing the sample gradients of a mini-batch to one step,
+	 * the threads take one step per sample on the shared target variable
+	 * without locking. Only supported for GradientDescendUpdater without
+	 * descend correction and without a proximal penalty (eg, L1), otherwise
+	 * synchronous mini-batches are used.
+	 *
+	 * The samples of a mini-batch are shared among the threads, so the batch
+	 * size (see set_batch_size()) should be several times the number of
+	 * threads. With the default batch size of 1, there is no parallelism.
+	 *
+	 * If the cost function supports sparse gradients, a step only writes the
+	 * entries in the support of its sample, including the penalty gradient.
+	 *
+	 * Niu, Feng, et al. "Hogwild: A lock-free approach to parallelizing
+	 * stochastic gradient descent." Advances in Neural Information
+	 * Processing Systems. 2011.
+	 *
+	 * @param hogwild whether to update asynchronously
+	 */
+	virtual void set_hogwild(bool hogwild) {m_hogwild=hogwild;}
+
+	/** Are mini-batches updated asynchronously?
+	 *
+	 * @return whether Hogwild updates are enabled
+	 */
+	virtual bool get_hogwild() const {return m_hogwild;}
+
 protected:
 	/** Do proximal update in place 
 	 *
@@ -142,10 +188,112 @@ protected:
 	 *
 	 */
 	virtual void do_proximal_operation(SGVector<float64_t>variable_reference);
-	
+
 	/** init the minimization process*/
 	virtual void init_minimization();
 
+	/** Are mini-batches used?
+	 *
+	 * @param fun stochastic cost function
+	 * @return whether the batch size is larger than 1 or Hogwild updates
+	 * are enabled
+	 */
+	virtual bool use_batch_update(FirstOrderStochasticCostFunction* fun);
+
+	/** Can mini-batches be updated asynchronously?
+	 *
+	 * @return whether the updater takes a plain gradient step and the
+	 * penalty has no proximal operation
+	 */
+	virtual bool supports_hogwild();
+
+	/** Draw the samples of the next mini-batch from the cost function
+	 *
+	 * @param fun stochastic cost function
+	 * @return indices of the samples, empty at the end of the sample sequence
+	 */
+	virtual SGVector<index_t> next_batch(FirstOrderStochasticCostFunction* fun);
+
+	/** Get the mean of the sample gradients, computed in parallel
+	 *
+	 * The samples are split into one contiguous block per thread and the
+	 * block sums are added up in order, so the result only depends on the
+	 * number of threads.
+	 *
+	 * @param fun stochastic cost function
+	 * @param indices indices of the samples
+	 * @param len length of the target variable
+	 * @return mean of the sample gradients
+	 */
+	virtual SGVector<float64_t> get_batch_gradient(FirstOrderStochasticCostFunction* fun,
+		SGVector<index_t> indices, index_t len);
+
+	/** Do one asynchronous step per sample of a mini-batch
+	 *
+	 * @param fun stochastic cost function
+	 * @param variable_reference variable_reference to be updated
+	 * @param indices indices of the samples
+	 */
+	virtual void do_hogwild_update(FirstOrderStochasticCostFunction* fun,
+		SGVector<float64_t> variable_reference, SGVector<index_t> indices);
+
+	/** Can sparse sample gradients be used with lazy updates?
+	 *
+	 * This requires the cost function to provide sparse gradients, the
+	 * updater and the penalty to support lazy updates. A penalty with a
+	 * non-zero gradient (eg, L2) moves the entries outside the support, which
+	 * can only be caught up in closed form for GradientDescendUpdater.
+	 *
+	 * @param fun stochastic cost function
+	 * @param dense_direction whether every step also moves all entries along
+	 * a fixed direction (eg, the average gradient of SVRG)
+	 * @return whether the lazy path can be used
+	 */
+	virtual bool use_lazy_update(FirstOrderStochasticCostFunction* fun,
+		bool dense_direction=false);
+
+	/** Init the lazy update state for a target variable
+	 *
+	 * @param len length of the target variable
+	 */
+	virtual void init_lazy_update(index_t len);
+
+	/** Apply the skipped steps to the given entries of the target variable
+	 *
+	 * @param variable_reference variable_reference to be updated
+	 * @param indices entries to catch up
+	 * @param dense_direction direction all entries move along at every step,
+	 * scaled by the learning rate (may be empty)
+	 */
+	virtual void catch_up_variable(SGVector<float64_t> variable_reference,
+		SGVector<index_t> indices,
+		SGVector<float64_t> dense_direction=SGVector<float64_t>());
+
+	/** Do a step with a sparse gradient
+	 *
+	 * The entries of the gradient must be caught up. They are updated like
+	 * the dense path does, the step of all the other entries is recorded and
+	 * applied once they are caught up.
+	 *
+	 * @param variable_reference variable_reference to be updated
+	 * @param gradient sparse gradient, without the penalty
+	 * @param learning_rate learning rate of the step
+	 * @param dense_direction direction all entries move along at every step,
+	 * scaled by the learning rate (may be empty)
+	 */
+	virtual void do_lazy_update(SGVector<float64_t> variable_reference,
+		SGSparseVector<float64_t> gradient, float64_t learning_rate,
+		SGVector<float64_t> dense_direction=SGVector<float64_t>());
+
+	/** Catch up all entries of the target variable and reset the lazy state
+	 *
+	 * @param variable_reference variable_reference to be updated
+	 * @param dense_direction direction all entries move along at every step,
+	 * scaled by the learning rate (may be empty)
+	 */
+	virtual void finish_lazy_update(SGVector<float64_t> variable_reference,
+		SGVector<float64_t> dense_direction=SGVector<float64_t>());
+
 	/** the gradient update step */
 	DescendUpdater* m_gradient_updater;
 
@@ -160,7 +308,33 @@ protected:
 
 	/** learning_rate object */
 	LearningRate* m_learning_rate;
-	
+
+	/** number of samples in a mini-batch */
+	int32_t m_batch_size;
+
+	/** whether mini-batches are updated asynchronously */
+	bool m_hogwild;
+
+	/** product of the scaling factors of the lazy steps */
+	float64_t m_lazy_scale;
+
+	/** accumulated proximal weight of the lazy steps, divided by the
+	 * scaling factors up to each step */
+	float64_t m_lazy_proximal_weight;
+
+	/** accumulated learning rates along the dense direction, divided by the
+	 * scaling factors up to each step */
+	float64_t m_lazy_shift;
+
+	/** m_lazy_scale when each entry was caught up */
+	SGVector<float64_t> m_entry_scale;
+
+	/** m_lazy_proximal_weight when each entry was caught up */
+	SGVector<float64_t> m_entry_proximal_weight;
+
+	/** m_lazy_shift when each entry was caught up */
+	SGVector<float64_t> m_entry_shift;
+
 private:
 	/** Init */
 	void init();
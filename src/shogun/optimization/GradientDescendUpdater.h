@@ -59,6 +59,15 @@ public:
 	 */
 	virtual const char* get_name() const { return "GradientDescendUpdater"; }
 
+	/** Can the updater be used with sparse negative descend directions?
+	 *
+	 * This is the case without descend correction, since an entry with a
+	 * zero gradient is not changed then.
+	 *
+	 * @return whether update_variable_lazily() is supported
+	 */
+	virtual bool supports_lazy_update() const { return m_correction==NULL; }
+
 protected:
 	/** Get the negative descend direction given current variable and gradient
 	 *
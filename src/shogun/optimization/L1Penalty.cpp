@@ -70,6 +70,22 @@ float64_t L1Penalty::get_sparse_variable(float64_t variable, float64_t penalty_w
 	return variable;
 }
 
+float64_t L1Penalty::get_lazy_variable(float64_t variable, float64_t decay,
+	float64_t proximal_weight)
+{
+	//the magnitude only shrinks, so rounding once at the end is the same as
+	//rounding after every step
+	if (variable>0.0)
+		variable=CMath::max(variable-proximal_weight, 0.0);
+	else
+		variable=CMath::min(variable+proximal_weight, 0.0);
+	variable*=decay;
+
+	if (CMath::abs(variable)<m_rounding_epsilon)
+		variable=0.0;
+	return variable;
+}
+
 void L1Penalty::init()
 {
 	m_rounding_epsilon=1e-8;
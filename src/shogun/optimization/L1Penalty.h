@@ -104,6 +104,23 @@ public:
 	 */
 	virtual float64_t get_sparse_variable(float64_t variable, float64_t penalty_weight);
 
+	/** L1 penalty can be caught up lazily since consecutive soft-thresholds
+	 * compose to one soft-threshold
+	 *
+	 * @return true
+	 */
+	virtual bool supports_lazy_update() const { return true; }
+
+	/** Apply the soft-thresholds of several skipped steps at once
+	 *
+	 * @param variable the raw variable
+	 * @param decay product of the scaling factors
+	 * @param proximal_weight accumulated weight of the penalty
+	 * @return the variable after the skipped steps
+	 */
+	virtual float64_t get_lazy_variable(float64_t variable, float64_t decay,
+		float64_t proximal_weight);
+
 protected:
 	/** rounding epsilon */
 	float64_t m_rounding_epsilon;
@@ -63,6 +63,13 @@ public:
 	 */
 	virtual const char* get_name() const { return "L1PenaltyForTG"; }
 
+	/** The truncated gradient keeps a cumulative penalty per entry, which
+	 * cannot be caught up lazily
+	 *
+	 * @return false
+	 */
+	virtual bool supports_lazy_update() const { return false; }
+
 	/** Do proximal projection/operation in place
 	 * @param variable the raw variable
 	 * @param proximal_weight weight of the penalty
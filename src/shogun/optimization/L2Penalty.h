@@ -81,6 +81,18 @@ public:
 	virtual float64_t get_penalty_gradient(float64_t variable,
 		float64_t gradient_of_variable) {return variable;}
 
+	/** L2 penalty can be caught up lazily
+	 *
+	 * @return true
+	 */
+	virtual bool supports_lazy_update() const { return true; }
+
+	/** The gradient of L2 penalty is the variable
+	 *
+	 * @return 1
+	 */
+	virtual float64_t get_gradient_coefficient() const { return 1.0; }
+
 };
 
 }
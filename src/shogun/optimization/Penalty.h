@@ -77,6 +77,26 @@ public:
 	virtual float64_t get_penalty_gradient(float64_t variable,
 		float64_t gradient)=0;
 
+	/** Can the penalty be caught up lazily for entries skipped by sparse
+	 * updates?
+	 *
+	 * This requires the gradient of the penalty to be linear in the
+	 * variable (see get_gradient_coefficient()) and, for proximal
+	 * penalties, ProximalPenalty::get_lazy_variable() to be implemented.
+	 *
+	 * @return whether lazy updates are supported
+	 */
+	virtual bool supports_lazy_update() const { return false; }
+
+	/** Returns the coefficient \f$c\f$ of a penalty gradient which is
+	 * linear in the variable, \f$c w\f$
+	 *
+	 * For L2 penalty, that is 1
+	 *
+	 * @return coefficient of the penalty gradient
+	 */
+	virtual float64_t get_gradient_coefficient() const { return 0.0; }
+
 };
 
 }
@@ -59,6 +59,26 @@ public:
 	virtual void update_variable_for_proximity(SGVector<float64_t> variable,
 		float64_t proximal_weight)=0;
 
+	/** Apply the proximal operations of several skipped steps at once
+	 *
+	 * Steps which first scale the variable by a factor in (0,1] and then do
+	 * the proximal operation compose to a single proximal operation followed
+	 * by a single scaling. This method returns the result of the composed
+	 * steps, given the product of the factors and the accumulated weight
+	 * \f$\sum_s \frac{weight_s}{factor_1 \cdots factor_s}\f$
+	 *
+	 * @param variable the raw variable
+	 * @param decay product of the scaling factors
+	 * @param proximal_weight accumulated weight of the penalty
+	 * @return the variable after the skipped steps
+	 */
+	virtual float64_t get_lazy_variable(float64_t variable, float64_t decay,
+		float64_t proximal_weight)
+	{
+		SG_NOTIMPLEMENTED
+		return variable;
+	}
+
 };
 
 }
@@ -79,6 +79,8 @@ void RmsPropUpdater::init()
 	m_epsilon=1e-6;
 	m_build_in_learning_rate=1.0;
 	m_gradient_accuracy=SGVector<float64_t>();
+	m_last_lazy_update=SGVector<int32_t>();
+	m_lazy_update_counter=0;
 
 	SG_ADD(&m_decay_factor, "RmsPropUpdater__m_decay_factor",
 		"decay_factor in RmsPropUpdater", MS_NOT_AVAILABLE);
@@ -88,6 +90,8 @@ void RmsPropUpdater::init()
 		"build_in_learning_rate in RmsPropUpdater", MS_NOT_AVAILABLE);
 	SG_ADD(&m_gradient_accuracy, "RmsPropUpdater__m_gradient_accuracy",
 		"gradient_accuracy in RmsPropUpdater", MS_NOT_AVAILABLE);
+	// the lazy update state is only valid within minimize(), so it is not
+	// registered
 }
 
 float64_t RmsPropUpdater::get_negative_descend_direction(float64_t variable,
@@ -114,5 +118,48 @@ void RmsPropUpdater::update_variable(SGVector<float64_t> variable_reference,
 		m_gradient_accuracy=SGVector<float64_t>(variable_reference.vlen);
 		m_gradient_accuracy.set_const(0.0);
 	}
+	finish_lazy_update(variable_reference);
 	DescendUpdaterWithCorrection::update_variable(variable_reference, raw_negative_descend_direction, learning_rate);
 }
+
+void RmsPropUpdater::update_variable_lazily(SGVector<float64_t> variable_reference,
+	SGSparseVector<float64_t> raw_negative_descend_direction, float64_t learning_rate)
+{
+	REQUIRE(variable_reference.vlen>0,"variable_reference must set\n");
+	if(m_gradient_accuracy.vlen==0)
+	{
+		m_gradient_accuracy=SGVector<float64_t>(variable_reference.vlen);
+		m_gradient_accuracy.set_const(0.0);
+	}
+	if(m_last_lazy_update.vlen==0)
+	{
+		m_last_lazy_update=SGVector<int32_t>(m_gradient_accuracy.vlen);
+		m_last_lazy_update.set_const(0);
+		m_lazy_update_counter=0;
+	}
+
+	//an accumulated gradient decays by m_decay_factor in every skipped update
+	for(index_t k=0; k<raw_negative_descend_direction.num_feat_entries; k++)
+	{
+		index_t idx=raw_negative_descend_direction.features[k].feat_index;
+		REQUIRE(idx>=0 && idx<m_gradient_accuracy.vlen, "Index (%d) is invalid\n", idx);
+		m_gradient_accuracy[idx]*=CMath::pow(m_decay_factor,
+			m_lazy_update_counter-m_last_lazy_update[idx]);
+		m_last_lazy_update[idx]=m_lazy_update_counter+1;
+	}
+	m_lazy_update_counter++;
+
+	DescendUpdaterWithCorrection::update_variable_lazily(variable_reference,
+		raw_negative_descend_direction, learning_rate);
+}
+
+void RmsPropUpdater::finish_lazy_update(SGVector<float64_t> variable_reference)
+{
+	for(index_t idx=0; idx<m_last_lazy_update.vlen; idx++)
+	{
+		m_gradient_accuracy[idx]*=CMath::pow(m_decay_factor,
+			m_lazy_update_counter-m_last_lazy_update[idx]);
+	}
+	m_last_lazy_update=SGVector<int32_t>();
+	m_lazy_update_counter=0;
+}
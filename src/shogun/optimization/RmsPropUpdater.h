@@ -106,6 +106,31 @@ public:
 	 */
 	virtual void update_variable(SGVector<float64_t> variable_reference,
 		SGVector<float64_t> raw_negative_descend_direction, float64_t learning_rate);
+
+	/** Can the updater be used with sparse negative descend directions?
+	 *
+	 * This is the case without descend correction, since an entry with a
+	 * zero gradient is not changed and its accumulated gradient only decays,
+	 * which is caught up when the entry is touched again.
+	 *
+	 * @return whether update_variable_lazily() is supported
+	 */
+	virtual bool supports_lazy_update() const { return m_correction==NULL; }
+
+	/** Update the target variable based on a sparse negative descend direction
+	 *
+	 * @param variable_reference a reference of the target variable
+	 * @param raw_negative_descend_direction the sparse negative descend direction
+	 * @param learning_rate learning rate
+	 */
+	virtual void update_variable_lazily(SGVector<float64_t> variable_reference,
+		SGSparseVector<float64_t> raw_negative_descend_direction, float64_t learning_rate);
+
+	/** Apply the pending decay of all accumulated gradients
+	 *
+	 * @param variable_reference a reference of the target variable
+	 */
+	virtual void finish_lazy_update(SGVector<float64_t> variable_reference);
 protected:
 	/** Get the negative descend direction given current variable  and gradient 
 	 *
@@ -132,6 +157,12 @@ protected:
 
 	/** \f$ g_\theta \f$ */
 	SGVector<float64_t> m_gradient_accuracy;
+
+	/** lazy update at which each accumulated gradient was last decayed */
+	SGVector<int32_t> m_last_lazy_update;
+
+	/** number of lazy updates */
+	int32_t m_lazy_update_counter;
 private:
 	/**  Init */
 	void init();
@@ -56,15 +56,56 @@ float64_t SGDMinimizer::minimize()
 	SGVector<float64_t> variable_reference=m_fun->obtain_variable_reference();
 	FirstOrderStochasticCostFunction *fun=dynamic_cast<FirstOrderStochasticCostFunction *>(m_fun);
 	REQUIRE(fun,"the cost function must be a stochastic cost function\n");
+	bool batch=use_batch_update(fun);
+	bool hogwild=batch && m_hogwild && supports_hogwild();
+	if(batch && m_hogwild && !hogwild)
+		SG_WARNING("Hogwild updates need a plain gradient descend updater and no proximal penalty, "
+			"using synchronous mini-batches\n");
+	bool lazy=!batch && use_lazy_update(fun);
+	if(lazy)
+		init_lazy_update(variable_reference.vlen);
 	for(;m_cur_passes<m_num_passes;m_cur_passes++)
 	{
 		fun->begin_sample();
+		if(batch)
+		{
+			SGVector<index_t> indices;
+			do
+			{
+				indices=next_batch(fun);
+				if(indices.vlen==0)
+					break;
+				if(hogwild)
+				{
+					do_hogwild_update(fun,variable_reference,indices);
+					continue;
+				}
+
+				m_iter_counter++;
+				float64_t learning_rate=1.0;
+				if(m_learning_rate)
+					learning_rate=m_learning_rate->get_learning_rate(m_iter_counter);
+				SGVector<float64_t> grad=get_batch_gradient(fun,indices,variable_reference.vlen);
+				update_gradient(grad,variable_reference);
+				m_gradient_updater->update_variable(variable_reference,grad,learning_rate);
+
+				do_proximal_operation(variable_reference);
+			}
+			while(indices.vlen==m_batch_size);
+			continue;
+		}
 		while(fun->next_sample())
 		{
 			m_iter_counter++;
 			float64_t learning_rate=1.0;
 			if(m_learning_rate)
 				learning_rate=m_learning_rate->get_learning_rate(m_iter_counter);
+			if(lazy)
+			{
+				catch_up_variable(variable_reference,fun->get_gradient_support());
+				do_lazy_update(variable_reference,fun->get_sparse_gradient(),learning_rate);
+				continue;
+			}
 			SGVector<float64_t> grad=m_fun->get_gradient();
 			update_gradient(grad,variable_reference);
 			m_gradient_updater->update_variable(variable_reference,grad,learning_rate);
@@ -72,6 +113,11 @@ float64_t SGDMinimizer::minimize()
 			do_proximal_operation(variable_reference);
 		}
 	}
+	if(lazy)
+	{
+		finish_lazy_update(variable_reference);
+		m_gradient_updater->finish_lazy_update(variable_reference);
+	}
 	float64_t cost=m_fun->get_cost();
 	return cost+get_penalty(variable_reference);
 }
@@ -31,6 +31,7 @@
 #include <shogun/optimization/SVRGMinimizer.h>
 #include <shogun/optimization/SGDMinimizer.h>
 #include <shogun/base/Parameter.h>
+#include <shogun/base/Parallel.h>
 using namespace shogun;
 
 SVRGMinimizer::SVRGMinimizer()
@@ -81,6 +82,8 @@ void SVRGMinimizer::init_minimization()
 		sgd.set_penalty_weight(m_penalty_weight);
 		sgd.set_penalty_type(m_penalty_type);
 		sgd.set_learning_rate(m_learning_rate);
+		sgd.set_batch_size(m_batch_size);
+		sgd.set_hogwild(m_hogwild);
 		sgd.minimize();
 		m_iter_counter+=sgd.get_iteration_counter();
 	}
@@ -93,17 +96,50 @@ float64_t SVRGMinimizer::minimize()
 	SGVector<float64_t> variable_reference=m_fun->obtain_variable_reference();
 	FirstOrderSAGCostFunction *fun=dynamic_cast<FirstOrderSAGCostFunction *>(m_fun);
 	REQUIRE(fun,"the cost function must be a stochastic average gradient cost function\n");
+	bool batch=use_batch_update(fun);
+	if(m_hogwild)
+		SG_WARNING("Hogwild updates are not supported by SVRG, using synchronous mini-batches\n");
+	bool lazy=!batch && use_lazy_update(fun, true);
+	if(lazy)
+		init_lazy_update(variable_reference.vlen);
 	for(;m_cur_passes<(m_num_passes-m_num_sgd_passes);m_cur_passes++)
 	{
 		if(m_cur_passes%m_svrg_interval==0)
 		{
+			if(lazy)
+				finish_lazy_update(variable_reference, m_average_gradient);
 			if(m_previous_variable.vlen==0)
 				m_previous_variable=SGVector<float64_t>(variable_reference.vlen);
 
 			std::copy(variable_reference.vector, variable_reference.vector+variable_reference.vlen, m_previous_variable.vector);
-			m_average_gradient=fun->get_average_gradient();
+			if(fun->supports_batch_gradient())
+			{
+				SGVector<index_t> samples(fun->get_sample_size());
+				samples.range_fill();
+				m_average_gradient=get_batch_gradient(fun, samples, variable_reference.vlen);
+			}
+			else
+				m_average_gradient=fun->get_average_gradient();
 		}
 		fun->begin_sample();
+		if(batch)
+		{
+			SGVector<index_t> indices;
+			do
+			{
+				indices=next_batch(fun);
+				if(indices.vlen==0)
+					break;
+
+				m_iter_counter++;
+				float64_t learning_rate=1.0;
+				if(m_learning_rate)
+					learning_rate=m_learning_rate->get_learning_rate(m_iter_counter);
+				do_batch_svrg_update(fun, variable_reference, indices, learning_rate);
+			}
+			while(indices.vlen==m_batch_size);
+			continue;
+		}
 		while(fun->next_sample())
 		{
 			m_iter_counter++;
@@ -111,6 +147,12 @@ float64_t SVRGMinimizer::minimize()
 			if(m_learning_rate)
 				learning_rate=m_learning_rate->get_learning_rate(m_iter_counter);
 
+			if(lazy)
+			{
+				do_lazy_svrg_update(fun, variable_reference, learning_rate);
+				continue;
+			}
+
 			SGVector<float64_t> grad_new=m_fun->get_gradient();
 			SGVector<float64_t> var(variable_reference.vlen);
 			std::copy(variable_reference.vector, variable_reference.vector+variable_reference.vlen, var.vector);
@@ -128,6 +170,56 @@ float64_t SVRGMinimizer::minimize()
 			do_proximal_operation(variable_reference);
 		}
 	}
+	if(lazy)
+	{
+		finish_lazy_update(variable_reference, m_average_gradient);
+		m_gradient_updater->finish_lazy_update(variable_reference);
+	}
 	float64_t cost=m_fun->get_cost();
 	return cost+get_penalty(variable_reference);
 }
+
+void SVRGMinimizer::do_batch_svrg_update(FirstOrderSAGCostFunction* fun,
+	SGVector<float64_t> variable_reference, SGVector<index_t> indices, float64_t learning_rate)
+{
+	SGVector<float64_t> grad_new=get_batch_gradient(fun, indices, variable_reference.vlen);
+	SGVector<float64_t> var(variable_reference.vlen);
+	std::copy(variable_reference.vector, variable_reference.vector+variable_reference.vlen, var.vector);
+
+	std::copy(m_previous_variable.vector, m_previous_variable.vector+m_previous_variable.vlen, variable_reference.vector);
+	SGVector<float64_t> grad_old=get_batch_gradient(fun, indices, variable_reference.vlen);
+
+	std::copy(var.vector, var.vector+var.vlen, variable_reference.vector);
+	for(index_t idx=0; idx<grad_new.vlen; idx++)
+		grad_new[idx]+=(m_average_gradient[idx]-grad_old[idx]);
+
+	update_gradient(grad_new,variable_reference);
+	m_gradient_updater->update_variable(variable_reference,grad_new,learning_rate);
+
+	do_proximal_operation(variable_reference);
+}
+void SVRGMinimizer::do_lazy_svrg_update(FirstOrderSAGCostFunction* fun,
+	SGVector<float64_t> variable_reference, float64_t learning_rate)
+{
+	SGVector<index_t> support=fun->get_gradient_support();
+	catch_up_variable(variable_reference, support, m_average_gradient);
+	SGSparseVector<float64_t> grad_new=fun->get_sparse_gradient();
+
+	//only the entries in the support are read, swap in their old values
+	SGVector<float64_t> var(support.vlen);
+	for(index_t k=0; k<support.vlen; k++)
+	{
+		var[k]=variable_reference[support[k]];
+		variable_reference[support[k]]=m_previous_variable[support[k]];
+	}
+	SGSparseVector<float64_t> grad_old=fun->get_sparse_gradient();
+	for(index_t k=0; k<support.vlen; k++)
+		variable_reference[support[k]]=var[k];
+
+	REQUIRE(grad_new.num_feat_entries==support.vlen && grad_old.num_feat_entries==support.vlen,
+		"The sparse gradient must have one entry per index of the support\n");
+	for(index_t k=0; k<support.vlen; k++)
+		grad_new.features[k].entry+=(m_average_gradient[support[k]]-grad_old.features[k].entry);
+
+	do_lazy_update(variable_reference, grad_new, learning_rate, m_average_gradient);
+}
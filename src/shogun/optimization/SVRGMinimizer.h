@@ -42,6 +42,11 @@ namespace shogun
  * Johnson, Rie, and Tong Zhang.
  * "Accelerating stochastic gradient descent using predictive variance reduction."
  * Advances in Neural Information Processing Systems. 2013.
+ *
+ * If the cost function supports batch gradients
+ * (FirstOrderStochasticCostFunction::supports_batch_gradient()), the
+ * average gradient of every snapshot is computed in parallel as the mean of
+ * the sample gradients of all samples.
  */
 
 class SVRGMinimizer: public FirstOrderStochasticMinimizer
@@ -116,6 +121,32 @@ protected:
 	/**  init the minimization process */
 	virtual void init_minimization();
 
+	/** Do a SVRG step with a mini-batch
+	 *
+	 * The sample gradients of the mini-batch at the current and at the
+	 * previous variable are computed in parallel
+	 *
+	 * @param fun stochastic average gradient cost function
+	 * @param variable_reference variable_reference to be updated
+	 * @param indices indices of the samples
+	 * @param learning_rate learning rate of the step
+	 */
+	virtual void do_batch_svrg_update(FirstOrderSAGCostFunction* fun,
+		SGVector<float64_t> variable_reference, SGVector<index_t> indices,
+		float64_t learning_rate);
+
+	/** Do a SVRG step with a sparse sample gradient
+	 *
+	 * Only the entries in the support of the sample are updated, the
+	 * average gradient moving the other entries is applied lazily
+	 *
+	 * @param fun stochastic average gradient cost function
+	 * @param variable_reference variable_reference to be updated
+	 * @param learning_rate learning rate of the step
+	 */
+	virtual void do_lazy_svrg_update(FirstOrderSAGCostFunction* fun,
+		SGVector<float64_t> variable_reference, float64_t learning_rate);
+
 	/** the number to go through data  using SGD before SVRG update */
 	int32_t m_num_sgd_passes;
 
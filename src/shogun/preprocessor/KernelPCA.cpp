@@ -19,10 +19,58 @@
 #include <shogun/io/SGIO.h>
 #include <shogun/kernel/Kernel.h>
 #include <shogun/lib/common.h>
+#include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/preprocessor/DimensionReductionPreprocessor.h>
 
 using namespace shogun;
+using namespace Eigen;
+
+/* number of kernel matrix rows computed at once */
+#define KERNEL_BLOCK_ROWS 32
+
+/* Y=K*X for the kernel matrix between the kernel's lhs and rhs, computed in
+ * parallel blocks of rows without ever storing it */
+static void kernel_prod(
+    CKernel* kernel, const MatrixXd& X, MatrixXd& Y, int32_t num_threads)
+{
+	int32_t num_rows = kernel->get_num_vec_lhs();
+	int32_t num_cols = kernel->get_num_vec_rhs();
+	Y.resize(num_rows, X.cols());
+
+#pragma omp parallel num_threads(num_threads)
+	{
+		MatrixXd block(KERNEL_BLOCK_ROWS, num_cols);
+
+#pragma omp for schedule(dynamic)
+		for (index_t start = 0; start < num_rows; start += KERNEL_BLOCK_ROWS)
+		{
+			index_t rows = CMath::min(KERNEL_BLOCK_ROWS, num_rows - start);
+			for (index_t j = 0; j < num_cols; j++)
+				for (index_t i = 0; i < rows; i++)
+					block(i, j) = kernel->kernel(start + i, j);
+
+			Y.middleRows(start, rows).noalias() = block.topRows(rows) * X;
+		}
+	}
+}
+
+/* Y=HKH*X for the centering matrix H=I-11'/n */
+static void centered_kernel_prod(
+    CKernel* kernel, const MatrixXd& X, MatrixXd& Y, int32_t num_threads)
+{
+	RowVectorXd mean = X.colwise().mean();
+	kernel_prod(kernel, X.rowwise() - mean, Y, num_threads);
+	mean = Y.colwise().mean();
+	Y.rowwise() -= mean;
+}
+
+/* orthonormal basis of the column space of X */
+static MatrixXd orthonormalize(const MatrixXd& X)
+{
+	HouseholderQR<MatrixXd> qr(X);
+	return qr.householderQ() * MatrixXd::Identity(X.rows(), X.cols());
+}
 
 CKernelPCA::CKernelPCA() : CDimensionReductionPreprocessor()
 {
@@ -41,11 +89,24 @@ void CKernelPCA::init()
 	m_init_features = NULL;
 	m_transformation_matrix = SGMatrix<float64_t>();
 	m_bias_vector = SGVector<float64_t>();
+	m_method = KPCA_EVD;
+	m_num_landmarks = 1000;
+	m_num_power_iterations = 2;
+	m_oversampling = 10;
 
 	SG_ADD(&m_transformation_matrix, "transformation_matrix",
 		"matrix used to transform data", MS_NOT_AVAILABLE);
 	SG_ADD(&m_bias_vector, "bias_vector",
 		"bias vector used to transform data", MS_NOT_AVAILABLE);
+	SG_ADD((machine_int_t*) &m_method, "method",
+		"method used to compute the components", MS_NOT_AVAILABLE);
+	SG_ADD(&m_num_landmarks, "num_landmarks",
+		"number of landmarks of the Nystroem method", MS_NOT_AVAILABLE);
+	SG_ADD(&m_num_power_iterations, "num_power_iterations",
+		"number of power iterations of the randomized method",
+		MS_NOT_AVAILABLE);
+	SG_ADD(&m_oversampling, "oversampling",
+		"oversampling of the randomized method", MS_NOT_AVAILABLE);
 }
 
 void CKernelPCA::cleanup()
@@ -69,15 +130,7 @@ bool CKernelPCA::init(CFeatures* features)
 {
 	if (!m_initialized && m_kernel)
 	{
-		SG_REF(features);
-		m_init_features = features;
-
-		m_kernel->init(features,features);
-		SGMatrix<float64_t> kernel_matrix = m_kernel->get_kernel_matrix();
-		m_kernel->cleanup();
-		int32_t n = kernel_matrix.num_cols;
-		int32_t m = kernel_matrix.num_rows;
-		ASSERT(n==m)
+		int32_t n = features->get_num_vectors();
 		if (m_target_dim > n)
 		{
 			SG_SWARNING(
@@ -88,36 +141,19 @@ bool CKernelPCA::init(CFeatures* features)
 			m_target_dim = n;
 		}
 
-		SGVector<float64_t> bias_tmp = linalg::rowwise_sum(kernel_matrix);
-		linalg::scale(bias_tmp, bias_tmp, -1.0 / n);
-		float64_t s = linalg::sum(bias_tmp) / n;
-		linalg::add_scalar(bias_tmp, -s);
-
-		linalg::center_matrix(kernel_matrix);
-
-		SGVector<float64_t> eigenvalues(m_target_dim);
-		SGMatrix<float64_t> eigenvectors(kernel_matrix.num_rows, m_target_dim);
-		linalg::eigen_solver_symmetric(
-		    kernel_matrix, eigenvalues, eigenvectors, m_target_dim);
-
-		m_transformation_matrix =
-		    SGMatrix<float64_t>(kernel_matrix.num_rows, m_target_dim);
-		// eigenvalues are in increasing order
-		for (int32_t i = 0; i < m_target_dim; i++)
+		switch (m_method)
 		{
-			//normalize and trap divide by zero and negative eigenvalues
-			auto idx = m_target_dim - i - 1;
-			auto vec = eigenvectors.get_column(idx);
-			linalg::scale(
-			    vec, vec,
-			    1.0 / CMath::sqrt(CMath::max(1e-16, eigenvalues[idx])));
-			m_transformation_matrix.set_column(i, vec);
+		case KPCA_EVD:
+			init_evd(features);
+			break;
+		case KPCA_RANDOMIZED:
+			init_randomized(features);
+			break;
+		case KPCA_NYSTROM:
+			init_nystrom(features);
+			break;
 		}
 
-		m_bias_vector = SGVector<float64_t>(m_target_dim);
-		linalg::matrix_prod(
-		    m_transformation_matrix, bias_tmp, m_bias_vector, true);
-
 		m_initialized=true;
 		SG_INFO("Done\n")
 		return true;
@@ -125,6 +161,199 @@ bool CKernelPCA::init(CFeatures* features)
 	return false;
 }
 
+void CKernelPCA::init_evd(CFeatures* features)
+{
+	SG_REF(features);
+	m_init_features = features;
+
+	m_kernel->init(features,features);
+	SGMatrix<float64_t> kernel_matrix = m_kernel->get_kernel_matrix();
+	m_kernel->cleanup();
+	int32_t n = kernel_matrix.num_cols;
+	int32_t m = kernel_matrix.num_rows;
+	ASSERT(n==m)
+
+	SGVector<float64_t> bias_tmp = linalg::rowwise_sum(kernel_matrix);
+	linalg::scale(bias_tmp, bias_tmp, -1.0 / n);
+	float64_t s = linalg::sum(bias_tmp) / n;
+	linalg::add_scalar(bias_tmp, -s);
+
+	linalg::center_matrix(kernel_matrix);
+
+	SGVector<float64_t> eigenvalues(m_target_dim);
+	SGMatrix<float64_t> eigenvectors(kernel_matrix.num_rows, m_target_dim);
+	linalg::eigen_solver_symmetric(
+	    kernel_matrix, eigenvalues, eigenvectors, m_target_dim);
+
+	m_transformation_matrix =
+	    SGMatrix<float64_t>(kernel_matrix.num_rows, m_target_dim);
+	// eigenvalues are in increasing order
+	for (int32_t i = 0; i < m_target_dim; i++)
+	{
+		//normalize and trap divide by zero and negative eigenvalues
+		auto idx = m_target_dim - i - 1;
+		auto vec = eigenvectors.get_column(idx);
+		linalg::scale(
+		    vec, vec,
+		    1.0 / CMath::sqrt(CMath::max(1e-16, eigenvalues[idx])));
+		m_transformation_matrix.set_column(i, vec);
+	}
+
+	m_bias_vector = SGVector<float64_t>(m_target_dim);
+	linalg::matrix_prod(
+	    m_transformation_matrix, bias_tmp, m_bias_vector, true);
+}
+
+void CKernelPCA::init_randomized(CFeatures* features)
+{
+	SG_REF(features);
+	m_init_features = features;
+
+	m_kernel->init(features, features);
+	int32_t n = m_kernel->get_num_vec_lhs();
+	int32_t l = CMath::min(m_target_dim + m_oversampling, n);
+	int32_t num_threads = parallel->get_num_threads();
+
+	// the first pass also computes the row means of the kernel matrix
+	MatrixXd X(n, l + 1);
+	for (index_t j = 0; j < l; j++)
+		for (index_t i = 0; i < n; i++)
+			X(i, j) = CMath::normal_random(0.0, 1.0);
+	X.leftCols(l).rowwise() -= RowVectorXd(X.leftCols(l).colwise().mean());
+	X.col(l).setConstant(1.0 / n);
+
+	MatrixXd Y;
+	kernel_prod(m_kernel, X, Y, num_threads);
+	VectorXd row_means = Y.col(l);
+	Y.conservativeResize(NoChange, l);
+	Y.rowwise() -= RowVectorXd(Y.colwise().mean());
+
+	MatrixXd Q;
+	for (int32_t i = 0; i < m_num_power_iterations; i++)
+	{
+		Q = orthonormalize(Y);
+		centered_kernel_prod(m_kernel, Q, Y, num_threads);
+	}
+
+	// Rayleigh-Ritz on the subspace
+	Q = orthonormalize(Y);
+	centered_kernel_prod(m_kernel, Q, Y, num_threads);
+	m_kernel->cleanup();
+
+	MatrixXd B = Q.transpose() * Y;
+	SelfAdjointEigenSolver<MatrixXd> solver((B + B.transpose()) / 2);
+	MatrixXd eigenvectors = Q * solver.eigenvectors();
+
+	// eigenvalues are in increasing order
+	m_transformation_matrix = SGMatrix<float64_t>(n, m_target_dim);
+	typename SGMatrix<float64_t>::EigenMatrixXtMap transformation =
+	    m_transformation_matrix;
+	for (int32_t i = 0; i < m_target_dim; i++)
+	{
+		auto idx = l - i - 1;
+		transformation.col(i) =
+		    eigenvectors.col(idx) /
+		    CMath::sqrt(CMath::max(1e-16, solver.eigenvalues()[idx]));
+	}
+
+	VectorXd bias_tmp =
+	    -row_means + VectorXd::Constant(n, row_means.mean());
+	m_bias_vector = SGVector<float64_t>(m_target_dim);
+	typename SGVector<float64_t>::EigenVectorXtMap bias = m_bias_vector;
+	bias = transformation.transpose() * bias_tmp;
+}
+
+void CKernelPCA::init_nystrom(CFeatures* features)
+{
+	int32_t n = features->get_num_vectors();
+	int32_t m = CMath::min(m_num_landmarks, n);
+	REQUIRE(m >= m_target_dim,
+	    "Number of landmarks (%d) must not be smaller than the target "
+	    "dimension (%d)\n", m, m_target_dim);
+
+	SGVector<index_t> perm(n);
+	perm.range_fill();
+	CMath::permute(perm);
+	SGVector<index_t> landmark_idxs(m);
+	sg_memcpy(landmark_idxs.vector, perm.vector, m * sizeof(index_t));
+	CMath::qsort(landmark_idxs.vector, m);
+
+	// the model is expressed in terms of the landmarks only
+	CFeatures* landmarks = features->copy_subset(landmark_idxs);
+	m_init_features = landmarks;
+
+	// the approximate feature map is z(x)=K_mm^(-1/2) k_m(x), restricted
+	// to the numerically nonzero spectrum of K_mm
+	m_kernel->init(landmarks, landmarks);
+	SGMatrix<float64_t> landmark_kernel = m_kernel->get_kernel_matrix();
+	typename SGMatrix<float64_t>::EigenMatrixXtMap eig_landmark_kernel =
+	    landmark_kernel;
+	SelfAdjointEigenSolver<MatrixXd> landmark_solver(eig_landmark_kernel);
+	const VectorXd& landmark_eigenvalues = landmark_solver.eigenvalues();
+
+	float64_t threshold =
+	    CMath::max(landmark_eigenvalues[m - 1], 0.0) * 1e-12;
+	int32_t r = 0;
+	while (r < m && landmark_eigenvalues[m - r - 1] > threshold)
+		r++;
+	REQUIRE(r >= m_target_dim,
+	    "Rank of the landmark kernel matrix (%d) is smaller than the target "
+	    "dimension (%d)\n", r, m_target_dim);
+
+	MatrixXd whitening = landmark_solver.eigenvectors().rightCols(r) *
+	                     landmark_eigenvalues.tail(r).cwiseSqrt().cwiseInverse()
+	                         .asDiagonal();
+
+	// mean and scatter of the approximate features of all vectors
+	m_kernel->init(features, landmarks);
+	MatrixXd scatter = MatrixXd::Zero(r, r);
+	VectorXd sum = VectorXd::Zero(r);
+
+#pragma omp parallel num_threads(parallel->get_num_threads())
+	{
+		MatrixXd block(KERNEL_BLOCK_ROWS, m);
+		MatrixXd local_scatter = MatrixXd::Zero(r, r);
+		VectorXd local_sum = VectorXd::Zero(r);
+
+#pragma omp for schedule(dynamic)
+		for (index_t start = 0; start < n; start += KERNEL_BLOCK_ROWS)
+		{
+			index_t rows = CMath::min(KERNEL_BLOCK_ROWS, n - start);
+			for (index_t j = 0; j < m; j++)
+				for (index_t i = 0; i < rows; i++)
+					block(i, j) = m_kernel->kernel(start + i, j);
+
+			MatrixXd Z = block.topRows(rows) * whitening;
+			local_scatter.noalias() += Z.transpose() * Z;
+			local_sum += Z.colwise().sum().transpose();
+		}
+
+#pragma omp critical
+		{
+			scatter += local_scatter;
+			sum += local_sum;
+		}
+	}
+	m_kernel->cleanup();
+
+	VectorXd mean = sum / n;
+	MatrixXd cov = scatter / n - mean * mean.transpose();
+	SelfAdjointEigenSolver<MatrixXd> solver(cov);
+
+	// eigenvalues are in increasing order
+	MatrixXd components =
+	    solver.eigenvectors().rightCols(m_target_dim).rowwise().reverse();
+
+	m_transformation_matrix = SGMatrix<float64_t>(m, m_target_dim);
+	typename SGMatrix<float64_t>::EigenMatrixXtMap transformation =
+	    m_transformation_matrix;
+	transformation = whitening * components;
+
+	m_bias_vector = SGVector<float64_t>(m_target_dim);
+	typename SGVector<float64_t>::EigenVectorXtMap bias = m_bias_vector;
+	bias = -components.transpose() * mean;
+}
+
 SGMatrix<float64_t> CKernelPCA::apply_to_feature_matrix(CFeatures* features)
 {
 	ASSERT(m_initialized)
@@ -133,8 +362,13 @@ SGMatrix<float64_t> CKernelPCA::apply_to_feature_matrix(CFeatures* features)
 	m_kernel->init(features, m_init_features);
 	auto kernel_matrix = m_kernel->get_kernel_matrix();
 
-	auto rows_sum = linalg::rowwise_sum(kernel_matrix);
-	linalg::add_vector(kernel_matrix, rows_sum, kernel_matrix, 1.0, -1.0 / n);
+	// the Nystroem features are centered by the bias alone
+	if (m_method != KPCA_NYSTROM)
+	{
+		auto rows_sum = linalg::rowwise_sum(kernel_matrix);
+		linalg::add_vector(
+		    kernel_matrix, rows_sum, kernel_matrix, 1.0, -1.0 / n);
+	}
 
 	SGMatrix<float64_t> new_feature_matrix =
 	    linalg::matrix_prod(m_transformation_matrix, kernel_matrix, true, true);
@@ -187,3 +421,50 @@ CDenseFeatures<float64_t>* CKernelPCA::apply_to_string_features(CFeatures* featu
 
 	return new CDenseFeatures<float64_t>(SGMatrix<float64_t>(new_feature_matrix,m_target_dim,num_vectors));
 }
+
+void CKernelPCA::set_method(EKernelPCAMethod method)
+{
+	m_method = method;
+}
+
+EKernelPCAMethod CKernelPCA::get_method() const
+{
+	return m_method;
+}
+
+void CKernelPCA::set_num_landmarks(int32_t num_landmarks)
+{
+	REQUIRE(num_landmarks > 0,
+	    "Number of landmarks (%d) must be positive\n", num_landmarks);
+	m_num_landmarks = num_landmarks;
+}
+
+int32_t CKernelPCA::get_num_landmarks() const
+{
+	return m_num_landmarks;
+}
+
+void CKernelPCA::set_num_power_iterations(int32_t num_power_iterations)
+{
+	REQUIRE(num_power_iterations >= 0,
+	    "Number of power iterations (%d) must not be negative\n",
+	    num_power_iterations);
+	m_num_power_iterations = num_power_iterations;
+}
+
+int32_t CKernelPCA::get_num_power_iterations() const
+{
+	return m_num_power_iterations;
+}
+
+void CKernelPCA::set_oversampling(int32_t oversampling)
+{
+	REQUIRE(oversampling >= 0,
+	    "Oversampling (%d) must not be negative\n", oversampling);
+	m_oversampling = oversampling;
+}
+
+int32_t CKernelPCA::get_oversampling() const
+{
+	return m_oversampling;
+}
@@ -23,6 +23,25 @@ namespace shogun
 class CFeatures;
 class CKernel;
 
+/** method used by KernelPCA to compute the principal components */
+enum EKernelPCAMethod
+{
+	/** eigendecomposition of the full centered kernel matrix.
+	 * O(n^2) memory, O(n^3) time
+	 */
+	KPCA_EVD = 0,
+	/** randomized subspace iteration on the implicitly centered kernel
+	 * matrix, whose blocks are computed on demand in parallel.
+	 * O(n(k+p)) memory, (q+2)n^2 kernel evaluations
+	 */
+	KPCA_RANDOMIZED = 1,
+	/** Nystroem approximation with m random landmarks followed by linear
+	 * PCA of the approximate feature space. O(nm) kernel evaluations,
+	 * the model and its application only depend on the landmarks
+	 */
+	KPCA_NYSTROM = 2
+};
+
 /** @brief Preprocessor KernelPCA performs kernel principal component analysis
  *
  * Schoelkopf, B., Smola, A. J., & Mueller, K. R. (1999).
@@ -30,6 +49,14 @@ class CKernel;
  * Advances in kernel methods support vector learning, 1327(3), 327-352. MIT Press.
  * Retrieved from http://citeseerx.ist.psu.edu/viewdoc/summary?doi=10.1.1.32.8744
  *
+ * For large data sets the top components can be computed without the kernel
+ * matrix by randomized subspace iteration (KPCA_RANDOMIZED), see
+ *
+ * Halko, N., Martinsson, P. G., & Tropp, J. A. (2011).
+ * Finding structure with randomness: Probabilistic algorithms for
+ * constructing approximate matrix decompositions. SIAM review, 53(2), 217-288.
+ *
+ * or approximated from a random subset of landmarks (KPCA_NYSTROM).
  */
 class CKernelPCA: public CDimensionReductionPreprocessor
 {
@@ -80,6 +107,46 @@ public:
 			return m_bias_vector;
 		}
 
+		/** set method used to compute the components
+		 * @param method method
+		 */
+		void set_method(EKernelPCAMethod method);
+
+		/** get method used to compute the components
+		 * @return method
+		 */
+		EKernelPCAMethod get_method() const;
+
+		/** set number of landmarks used by KPCA_NYSTROM
+		 * @param num_landmarks number of landmarks
+		 */
+		void set_num_landmarks(int32_t num_landmarks);
+
+		/** get number of landmarks used by KPCA_NYSTROM
+		 * @return number of landmarks
+		 */
+		int32_t get_num_landmarks() const;
+
+		/** set number of power iterations used by KPCA_RANDOMIZED
+		 * @param num_power_iterations number of power iterations
+		 */
+		void set_num_power_iterations(int32_t num_power_iterations);
+
+		/** get number of power iterations used by KPCA_RANDOMIZED
+		 * @return number of power iterations
+		 */
+		int32_t get_num_power_iterations() const;
+
+		/** set number of additional random vectors used by KPCA_RANDOMIZED
+		 * @param oversampling oversampling
+		 */
+		void set_oversampling(int32_t oversampling);
+
+		/** get number of additional random vectors used by KPCA_RANDOMIZED
+		 * @return oversampling
+		 */
+		int32_t get_oversampling() const;
+
 		/** @return object name */
 		virtual const char* get_name() const { return "KernelPCA"; }
 
@@ -91,6 +158,21 @@ public:
 		/** default init */
 		void init();
 
+		/** compute the components from the full kernel matrix
+		 * @param features training features
+		 */
+		void init_evd(CFeatures* features);
+
+		/** compute the components by randomized subspace iteration
+		 * @param features training features
+		 */
+		void init_randomized(CFeatures* features);
+
+		/** compute the components from the Nystroem approximation
+		 * @param features training features
+		 */
+		void init_nystrom(CFeatures* features);
+
 	protected:
 
 		/** features used by init. needed for apply */
@@ -105,6 +187,18 @@ public:
 		/** true when already initialized */
 		bool m_initialized;
 
+		/** method used to compute the components */
+		EKernelPCAMethod m_method;
+
+		/** number of landmarks of KPCA_NYSTROM */
+		int32_t m_num_landmarks;
+
+		/** number of power iterations of KPCA_RANDOMIZED */
+		int32_t m_num_power_iterations;
+
+		/** oversampling of KPCA_RANDOMIZED */
+		int32_t m_oversampling;
+
 };
 }
 #endif
@@ -16,12 +16,83 @@
 #include <shogun/mathematics/Math.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
 #include <shogun/features/Features.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/mathematics/eigen3.h>
 
 using namespace shogun;
 using namespace Eigen;
 
+/* number of vectors processed at once */
+#define PCA_BLOCK_SIZE 1024
+/* number of columns of the covariance matrix updated by one thread */
+#define PCA_PANEL_WIDTH 64
+
+/* scatter+=X*X' for a block of centered vectors, in parallel over column
+ * panels of the scatter matrix so no reduction is necessary */
+static void add_scatter(Ref<MatrixXd> scatter, const Ref<const MatrixXd>& X,
+		int32_t num_threads)
+{
+	index_t dim = scatter.rows();
+
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads)
+	for (index_t start=0; start<dim; start+=PCA_PANEL_WIDTH)
+	{
+		index_t cols = CMath::min(PCA_PANEL_WIDTH, dim-start);
+		scatter.middleCols(start, cols).noalias() +=
+			X*X.middleRows(start, cols).transpose();
+	}
+}
+
+/* (X-mean*1')*B, in parallel over blocks of vectors */
+static MatrixXd centered_prod(const Map<MatrixXd>& X, const VectorXd& mean,
+		const MatrixXd& B, int32_t num_threads)
+{
+	MatrixXd result = -mean*B.colwise().sum();
+
+#pragma omp parallel num_threads(num_threads)
+	{
+		MatrixXd local_result = MatrixXd::Zero(X.rows(), B.cols());
+
+#pragma omp for schedule(dynamic)
+		for (index_t start=0; start<X.cols(); start+=PCA_BLOCK_SIZE)
+		{
+			index_t num = CMath::min<index_t>(PCA_BLOCK_SIZE, X.cols()-start);
+			local_result.noalias() += X.middleCols(start, num)*B.middleRows(start, num);
+		}
+
+#pragma omp critical
+		result += local_result;
+	}
+
+	return result;
+}
+
+/* (X-mean*1')'*Q, in parallel over blocks of vectors */
+static MatrixXd centered_transpose_prod(const Map<MatrixXd>& X,
+		const VectorXd& mean, const MatrixXd& Q, int32_t num_threads)
+{
+	MatrixXd result(X.cols(), Q.cols());
+	RowVectorXd mean_prod = mean.transpose()*Q;
+
+#pragma omp parallel for schedule(dynamic) num_threads(num_threads)
+	for (index_t start=0; start<X.cols(); start+=PCA_BLOCK_SIZE)
+	{
+		index_t num = CMath::min<index_t>(PCA_BLOCK_SIZE, X.cols()-start);
+		result.middleRows(start, num).noalias() = X.middleCols(start, num).transpose()*Q;
+		result.middleRows(start, num).rowwise() -= mean_prod;
+	}
+
+	return result;
+}
+
+/* orthonormal basis of the column space of X */
+static MatrixXd orthonormalize(const MatrixXd& X)
+{
+	HouseholderQR<MatrixXd> qr(X);
+	return qr.householderQ()*MatrixXd::Identity(X.rows(), X.cols());
+}
+
 CPCA::CPCA(bool do_whitening, EPCAMode mode, float64_t thresh, EPCAMethod method, EPCAMemoryMode mem_mode)
 : CDimensionReductionPreprocessor()
 {
@@ -55,6 +126,8 @@ void CPCA::init()
 	m_mem_mode = MEM_REALLOCATE;
 	m_method = AUTO;
 	m_eigenvalue_zero_tolerance=1e-15;
+	m_oversampling = 10;
+	m_num_power_iterations = 2;
 
 	SG_ADD(&m_transformation_matrix, "transformation_matrix",
 	    "Transformation matrix (Eigenvectors of covariance matrix).",
@@ -74,6 +147,10 @@ void CPCA::init()
 		"Method used for PCA calculation", MS_NOT_AVAILABLE);
 	SG_ADD(&m_eigenvalue_zero_tolerance, "eigenvalue_zero_tolerance", "zero tolerance"
 	" for determining zero eigenvalues during whitening to avoid numerical issues", MS_NOT_AVAILABLE);
+	SG_ADD(&m_oversampling, "oversampling",
+		"Oversampling of randomized PCA", MS_NOT_AVAILABLE);
+	SG_ADD(&m_num_power_iterations, "num_power_iterations",
+		"Number of power iterations of randomized PCA", MS_NOT_AVAILABLE);
 }
 
 CPCA::~CPCA()
@@ -84,6 +161,14 @@ bool CPCA::init(CFeatures* features)
 {
 	if (!m_initialized)
 	{
+		if (features->get_feature_class()==C_STREAMING_DENSE)
+		{
+			REQUIRE(features->get_feature_type()==F_DREAL, "PCA only works with real features")
+			init_with_stream((CStreamingDenseFeatures<float64_t>*) features);
+			m_initialized = true;
+			return true;
+		}
+
 		REQUIRE(features->get_feature_class()==C_DENSE, "PCA only works with dense features")
 		REQUIRE(features->get_feature_type()==F_DREAL, "PCA only works with real features")
 
@@ -100,26 +185,30 @@ bool CPCA::init(CFeatures* features)
 		REQUIRE(m_target_dim<=max_dim_allowed,
 			 "target dimension should be less or equal to than minimum of N and D")
 
-		// center data
 		Map<MatrixXd> fmatrix(feature_matrix.matrix, num_features, num_vectors);
 
 		m_mean_vector = SGVector<float64_t>(num_features);
 		Map<VectorXd> data_mean(m_mean_vector.vector, num_features);
  		data_mean = fmatrix.rowwise().sum()/(float64_t) num_vectors;
-		fmatrix = fmatrix.colwise()-data_mean;
 
 		m_eigenvalues_vector = SGVector<float64_t>(max_dim_allowed);
 
 		if (m_method == AUTO)
 			m_method = (num_vectors>num_features) ? EVD : SVD;
 
+		// EVD and RANDOMIZED center the data on the fly
 		if (m_method == EVD)
 		    init_with_evd(feature_matrix,  max_dim_allowed);
+		else if (m_method == RANDOMIZED)
+		    init_with_randomized_svd(feature_matrix, max_dim_allowed);
 		else
+		{
+			fmatrix = fmatrix.colwise()-data_mean;
 		    init_with_svd(feature_matrix, max_dim_allowed);
+			// restore feature matrix
+			fmatrix = fmatrix.colwise()+data_mean;
+		}
 
-		// restore feature matrix
-		fmatrix = fmatrix.colwise()+data_mean;
 		m_initialized = true;
 		return true;
 	}
@@ -131,15 +220,105 @@ void CPCA::init_with_evd(const SGMatrix<float64_t>& feature_matrix, int32_t max_
 {
 	int32_t num_vectors = feature_matrix.num_cols;
 	int32_t num_features = feature_matrix.num_rows;
+	int32_t num_threads = parallel->get_num_threads();
 
 	Map<MatrixXd> fmatrix(feature_matrix.matrix, num_features, num_vectors);
-	Map<VectorXd> eigenValues(m_eigenvalues_vector.vector, max_dim_allowed);
+	Map<VectorXd> data_mean(m_mean_vector.vector, num_features);
 
-	// covariance matrix
-	MatrixXd cov_mat(num_features, num_features);
-	cov_mat = fmatrix*fmatrix.transpose();
+	// covariance matrix, accumulated over centered blocks of vectors
+	SGMatrix<float64_t> cov(num_features, num_features);
+	Map<MatrixXd> cov_mat(cov.matrix, num_features, num_features);
+	cov_mat.setZero();
+
+	MatrixXd block;
+	for (index_t start=0; start<num_vectors; start+=PCA_BLOCK_SIZE)
+	{
+		index_t num = CMath::min(PCA_BLOCK_SIZE, num_vectors-start);
+		block = fmatrix.middleCols(start, num).colwise()-data_mean;
+		add_scatter(cov_mat, block, num_threads);
+	}
 	cov_mat /= (num_vectors-1);
 
+	compute_evd_transformation(cov, num_vectors, max_dim_allowed);
+}
+
+void CPCA::init_with_stream(CStreamingDenseFeatures<float64_t>* features)
+{
+	int32_t num_threads = parallel->get_num_threads();
+	int32_t num_features = 0;
+	int32_t num_vectors = 0;
+
+	/* the vectors are shifted by the mean of the first batch, which keeps
+	 * the final mean correction of the scatter matrix well conditioned */
+	MatrixXd buffer;
+	MatrixXd scatter;
+	VectorXd sum;
+	VectorXd shift;
+
+	features->start_parser();
+	while (true)
+	{
+		index_t num_read = 0;
+		while (num_read<PCA_BLOCK_SIZE && features->get_next_example())
+		{
+			SGVector<float64_t> x = features->get_vector();
+			if (num_features==0)
+			{
+				num_features = x.vlen;
+				buffer.resize(num_features, PCA_BLOCK_SIZE);
+				scatter = MatrixXd::Zero(num_features, num_features);
+				sum = VectorXd::Zero(num_features);
+			}
+			REQUIRE(x.vlen==num_features, "Number of features (%d) of vector %d "
+				"differs from previous vectors (%d)\n", x.vlen,
+				num_vectors+num_read, num_features);
+
+			buffer.col(num_read) = Map<VectorXd>(x.vector, num_features);
+			features->release_example();
+			num_read++;
+		}
+
+		if (num_read==0)
+			break;
+
+		if (num_vectors==0)
+			shift = buffer.leftCols(num_read).rowwise().mean();
+
+		buffer.leftCols(num_read).colwise() -= shift;
+		sum += buffer.leftCols(num_read).rowwise().sum();
+		add_scatter(scatter, buffer.leftCols(num_read), num_threads);
+		num_vectors += num_read;
+	}
+	features->end_parser();
+
+	REQUIRE(num_vectors>1, "PCA needs at least two vectors (%d given)\n",
+		num_vectors);
+	SG_INFO("num_examples: %ld num_features: %ld \n", num_vectors, num_features)
+
+	int32_t max_dim_allowed = CMath::min(num_vectors, num_features);
+	REQUIRE(m_target_dim<=max_dim_allowed,
+		 "target dimension should be less or equal to than minimum of N and D")
+
+	VectorXd shifted_mean = sum/num_vectors;
+	m_mean_vector = SGVector<float64_t>(num_features);
+	Map<VectorXd> data_mean(m_mean_vector.vector, num_features);
+	data_mean = shift+shifted_mean;
+
+	SGMatrix<float64_t> cov(num_features, num_features);
+	Map<MatrixXd> cov_mat(cov.matrix, num_features, num_features);
+	cov_mat = (scatter-num_vectors*shifted_mean*shifted_mean.transpose())/(num_vectors-1);
+
+	m_eigenvalues_vector = SGVector<float64_t>(max_dim_allowed);
+	compute_evd_transformation(cov, num_vectors, max_dim_allowed);
+}
+
+void CPCA::compute_evd_transformation(SGMatrix<float64_t> cov,
+		int32_t num_vectors, int32_t max_dim_allowed)
+{
+	int32_t num_features = cov.num_rows;
+	Map<MatrixXd> cov_mat(cov.matrix, num_features, num_features);
+	Map<VectorXd> eigenValues(m_eigenvalues_vector.vector, max_dim_allowed);
+
 	SG_INFO("Computing Eigenvalues ... ")
 	// eigen value computed
 	SelfAdjointEigenSolver<MatrixXd> eigenSolve =
@@ -281,6 +460,69 @@ void CPCA::init_with_svd(const SGMatrix<float64_t> &feature_matrix, int32_t max_
 	}
 }
 
+void CPCA::init_with_randomized_svd(const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed)
+{
+	REQUIRE(m_mode==FIXED_NUMBER, "Randomized PCA only works in FIXED_NUMBER mode\n")
+
+	int32_t num_vectors = feature_matrix.num_cols;
+	int32_t num_features = feature_matrix.num_rows;
+	int32_t num_threads = parallel->get_num_threads();
+
+	Map<MatrixXd> fmatrix(feature_matrix.matrix, num_features, num_vectors);
+	VectorXd data_mean = Map<VectorXd>(m_mean_vector.vector, num_features);
+
+	num_dim = m_target_dim;
+	num_old_dim = num_features;
+	int32_t num_samples = CMath::min(num_dim+m_oversampling, max_dim_allowed);
+
+	// range finder with power iterations on the centered data
+	MatrixXd omega(num_vectors, num_samples);
+	for (index_t j=0; j<num_samples; j++)
+		for (index_t i=0; i<num_vectors; i++)
+			omega(i,j) = CMath::normal_random(0.0, 1.0);
+
+	MatrixXd Q = orthonormalize(centered_prod(fmatrix, data_mean, omega, num_threads));
+	for (int32_t i=0; i<m_num_power_iterations; i++)
+	{
+		MatrixXd Z = orthonormalize(
+			centered_transpose_prod(fmatrix, data_mean, Q, num_threads));
+		Q = orthonormalize(centered_prod(fmatrix, data_mean, Z, num_threads));
+	}
+
+	// Q'XX'Q=Z'Z holds the top eigenvalues of the scatter matrix
+	MatrixXd Z = centered_transpose_prod(fmatrix, data_mean, Q, num_threads);
+	SelfAdjointEigenSolver<MatrixXd> eigenSolve(Z.transpose()*Z);
+
+	// eigenvalues in decreasing order, as for the SVD
+	m_eigenvalues_vector = SGVector<float64_t>(num_dim);
+	Map<VectorXd> eigenValues(m_eigenvalues_vector.vector, num_dim);
+	eigenValues = eigenSolve.eigenvalues().tail(num_dim).reverse()/(num_vectors-1);
+	SG_INFO("Done\nReducing from %i to %i features..", num_features, num_dim)
+
+	m_transformation_matrix = SGMatrix<float64_t>(num_features, num_dim);
+	Map<MatrixXd> transformMatrix(m_transformation_matrix.matrix, num_features, num_dim);
+	transformMatrix = Q*eigenSolve.eigenvectors().rightCols(num_dim).rowwise().reverse();
+
+	if (m_whitening)
+	{
+		for (int32_t i = 0; i < num_dim; i++)
+		{
+			if (CMath::fequals_abs<float64_t>(0.0, eigenValues[i], m_eigenvalue_zero_tolerance))
+			{
+				SG_WARNING("Covariance matrix has almost zero Eigenvalue (ie "
+					"Eigenvalue within a tolerance of %E around 0) at "
+					"dimension %d. Consider reducing its dimension.",
+					m_eigenvalue_zero_tolerance, i + 1)
+
+				transformMatrix.col(i) = MatrixXd::Zero(num_features, 1);
+				continue;
+			}
+
+			transformMatrix.col(i) /= CMath::sqrt(eigenValues[i] * (num_vectors - 1));
+		}
+	}
+}
+
 void CPCA::cleanup()
 {
 	m_transformation_matrix=SGMatrix<float64_t>();
@@ -395,3 +637,26 @@ float64_t CPCA::get_eigenvalue_zero_tolerance() const
 {
 	return m_eigenvalue_zero_tolerance;
 }
+
+void CPCA::set_oversampling(int32_t oversampling)
+{
+	REQUIRE(oversampling>=0, "Oversampling (%d) must not be negative\n", oversampling)
+	m_oversampling = oversampling;
+}
+
+int32_t CPCA::get_oversampling() const
+{
+	return m_oversampling;
+}
+
+void CPCA::set_num_power_iterations(int32_t num_power_iterations)
+{
+	REQUIRE(num_power_iterations>=0, "Number of power iterations (%d) must "
+		"not be negative\n", num_power_iterations)
+	m_num_power_iterations = num_power_iterations;
+}
+
+int32_t CPCA::get_num_power_iterations() const
+{
+	return m_num_power_iterations;
+}
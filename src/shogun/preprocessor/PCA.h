@@ -22,6 +22,8 @@
 
 namespace shogun
 {
+template <class T> class CStreamingDenseFeatures;
+
 /** Matrix decomposition method for PCA */
 enum EPCAMethod
 {
@@ -34,7 +36,12 @@ enum EPCAMethod
 	/** Eigenvalue decomposition of covariance matrix.
 	 * Time complexity ~10d^3 (d-dimensions n-number of vectors)
 	 */
-	EVD = 30
+	EVD = 30,
+	/** Randomized SVD with oversampling p and q power iterations, for
+	 * FIXED_NUMBER mode only. Time complexity ~(4q+4)dn(t+p) (t-target
+	 * dimensions)
+	 */
+	RANDOMIZED = 40
 };
 
 /** mode of pca */
@@ -88,9 +95,20 @@ enum EPCAMemoryMode
  * using the formula \f$e_i = \frac{\sqrt{d_i}}{N-1}\f$.
  * The time complexity of this method is \f$~14DN^2\f$ and should be used when N < D.
  *
+ * <em>RANDOMIZED</em> : The top T eigenvectors are computed from a randomized
+ * range finder with oversampling and power iterations, cf. Halko et al. (2011),
+ * Finding structure with randomness. Only products of the centered data with
+ * tall, thin matrices are needed, the data is neither copied nor centered in
+ * place. Only available in FIXED_NUMBER mode.
+ *
  * <em>AUTO</em> : This mode automagically chooses one of the above modes for the user
  * based on whether N > D (chooses EVD) or N < D (chooses SVD).
  *
+ * The EVD accumulates the covariance matrix over blocks of vectors in parallel.
+ * If init is called with CStreamingDenseFeatures, the covariance is accumulated
+ * over batches read from the stream, so data that does not fit into memory
+ * can be reduced in a single pass with O(D^2) memory.
+ *
  * This class provides 3 modes to determine the value of T :
  *
  * <em>FIXED_NUMBER</em> : T is supplied by user directly using set_target_dims method
@@ -192,6 +210,26 @@ class CPCA: public CDimensionReductionPreprocessor
 		 */
 		float64_t get_eigenvalue_zero_tolerance() const;
 
+		/** set number of additional random vectors of RANDOMIZED
+		 * @param oversampling oversampling
+		 */
+		void set_oversampling(int32_t oversampling);
+
+		/** get number of additional random vectors of RANDOMIZED
+		 * @return oversampling
+		 */
+		int32_t get_oversampling() const;
+
+		/** set number of power iterations of RANDOMIZED
+		 * @param num_power_iterations number of power iterations
+		 */
+		void set_num_power_iterations(int32_t num_power_iterations);
+
+		/** get number of power iterations of RANDOMIZED
+		 * @return number of power iterations
+		 */
+		int32_t get_num_power_iterations() const;
+
 	protected:
 
 		void init();
@@ -225,12 +263,28 @@ class CPCA: public CDimensionReductionPreprocessor
 		 * whitening to tackle numerical issues
 		 */
 		float64_t m_eigenvalue_zero_tolerance;
+		/** oversampling of RANDOMIZED */
+		int32_t m_oversampling;
+		/** number of power iterations of RANDOMIZED */
+		int32_t m_num_power_iterations;
 
 	private:
 		/** Computes the transformation matrix using an eigenvalue decomposition. */
 		void init_with_evd(const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed);
 		/** Computes the transformation matrix using svd */
 		void init_with_svd(const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed);
+		/** Computes the transformation matrix using randomized svd */
+		void init_with_randomized_svd(const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed);
+		/** Computes mean and transformation matrix from batches of a stream */
+		void init_with_stream(CStreamingDenseFeatures<float64_t>* features);
+		/** Computes the transformation matrix from the eigenvalue decomposition
+		 * of the covariance matrix
+		 * @param cov_mat covariance matrix
+		 * @param num_vectors number of vectors it was computed from
+		 * @param max_dim_allowed maximum target dimension
+		 */
+		void compute_evd_transformation(SGMatrix<float64_t> cov_mat,
+				int32_t num_vectors, int32_t max_dim_allowed);
 };
 }
 #endif // PCA_H_
@@ -34,10 +34,100 @@
 #include <shogun/labels/RegressionLabels.h>
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/linalg/linop/LinearOperator.h>
+#include <shogun/mathematics/linalg/linsolver/ConjugateGradientSolver.h>
+
+/* number of examples whose kernel rows against the basis are computed at once */
+#define NYSTROM_BLOCK_SIZE 256
 
 using namespace shogun;
 using namespace Eigen;
 
+/* K_mn*K_nm*w, or K_mn*y if w is NULL, computing the rows of K_nm a block at
+ * a time */
+static VectorXd nystrom_product(CKernel* kernel, SGVector<int32_t> col,
+		const VectorXd* w, const float64_t* y, int32_t num_threads)
+{
+	index_t n=kernel->get_num_vec_lhs();
+	index_t m=col.vlen;
+	VectorXd result=VectorXd::Zero(m);
+
+	#pragma omp parallel num_threads(num_threads)
+	{
+		VectorXd partial=VectorXd::Zero(m);
+		MatrixXd tile(NYSTROM_BLOCK_SIZE, m);
+
+		#pragma omp for schedule(dynamic)
+		for (index_t start=0; start<n; start+=NYSTROM_BLOCK_SIZE)
+		{
+			index_t num=CMath::min(NYSTROM_BLOCK_SIZE, n-start);
+			for (index_t j=0; j<m; ++j)
+			{
+				for (index_t i=0; i<num; ++i)
+					tile(i,j)=kernel->kernel(start+i, col[j]);
+			}
+
+			if (w)
+				partial.noalias()+=tile.topRows(num).transpose()*(tile.topRows(num)*(*w));
+			else
+				partial.noalias()+=tile.topRows(num).transpose()*Map<const VectorXd>(y+start, num);
+		}
+
+		#pragma omp critical
+		result+=partial;
+	}
+
+	return result;
+}
+
+namespace shogun
+{
+/* The Nyström system K_mn*K_nm+tau*K_mm in the variables of the preconditioner,
+ * B^{-1}(L^{-1}K_mn*K_nm*L^{-T}+tau*I)B^{-T}, applied without storing K_nm */
+class CNystromPreconditionedOperator : public CLinearOperator<float64_t>
+{
+public:
+	CNystromPreconditionedOperator(CKernel* kernel, SGVector<int32_t> col,
+			const MatrixXd& L, const MatrixXd& B, float64_t tau)
+	: CLinearOperator<float64_t>(col.vlen), m_kernel(kernel), m_col(col),
+		m_L(L), m_B(B), m_tau(tau)
+	{
+		SG_REF(m_kernel);
+	}
+
+	virtual ~CNystromPreconditionedOperator()
+	{
+		SG_UNREF(m_kernel);
+	}
+
+	virtual SGVector<float64_t> apply(SGVector<float64_t> b) const
+	{
+		Map<VectorXd> b_eig(b.vector, b.vlen);
+		VectorXd q=m_B.transpose().triangularView<Upper>().solve(b_eig);
+		VectorXd w=m_L.transpose().triangularView<Upper>().solve(q);
+		VectorXd u=m_L.triangularView<Lower>().solve(nystrom_product(m_kernel,
+				m_col, &w, NULL, parallel->get_num_threads()));
+		u+=m_tau*q;
+
+		SGVector<float64_t> result(b.vlen);
+		Map<VectorXd>(result.vector, result.vlen)=m_B.triangularView<Lower>().solve(u);
+		return result;
+	}
+
+	virtual const char* get_name() const
+	{
+		return "NystromPreconditionedOperator";
+	}
+
+private:
+	CKernel* m_kernel;
+	SGVector<int32_t> m_col;
+	MatrixXd m_L;
+	MatrixXd m_B;
+	float64_t m_tau;
+};
+}
+
 CKRRNystrom::CKRRNystrom() : CKernelRidgeRegression()
 {
 	init();
@@ -90,6 +180,23 @@ bool CKRRNystrom::solve_krr_system()
 	if (y==NULL)
 		SG_ERROR("Labels not set.\n");
 	SGVector<int32_t> col=subsample_indices();
+
+	if (m_solver==KRR_CONJUGATE_GRADIENT)
+	{
+		SGVector<float64_t> alphas(m_num_rkhs_basis);
+		if (!solve_preconditioned_system(col, y, alphas))
+			return false;
+
+		/* Expand alpha with zeros to size n */
+		SGVector<float64_t> alpha_n(n);
+		alpha_n.zero();
+		for (index_t i=0; i<m_num_rkhs_basis; ++i)
+			alpha_n[col[i]]=alphas[i];
+		m_alpha=alpha_n;
+
+		return true;
+	}
+
 	SGMatrix<float64_t> K_mm(m_num_rkhs_basis, m_num_rkhs_basis);
 	SGMatrix<float64_t> K_nm(n, m_num_rkhs_basis);
 	#pragma omp parallel for
@@ -141,3 +248,68 @@ bool CKRRNystrom::solve_krr_system()
 
 	return true;
 }
+
+bool CKRRNystrom::solve_preconditioned_system(SGVector<int32_t> col,
+		SGVector<float64_t> y, SGVector<float64_t> alphas)
+{
+	int32_t n=kernel->get_num_vec_lhs();
+	int32_t m=col.vlen;
+
+	MatrixXd K_mm(m, m);
+	#pragma omp parallel for num_threads(parallel->get_num_threads())
+	for (index_t j=0; j<m; ++j)
+	{
+		for (index_t i=0; i<m; ++i)
+			K_mm(i,j)=kernel->kernel(col[i], col[j]);
+	}
+
+	/* Cholesky factors of the preconditioner, with a jitter for K_mm that is
+	 * singular in floating point */
+	float64_t jitter=m*std::numeric_limits<float64_t>::epsilon()*
+		K_mm.diagonal().maxCoeff();
+	K_mm.diagonal().array()+=jitter;
+	LLT<MatrixXd> llt_L(K_mm);
+	if (llt_L.info()!=Success)
+	{
+		SG_WARNING("Cholesky factorization of the basis kernel matrix failed.\n")
+		return false;
+	}
+	MatrixXd L=llt_L.matrixL();
+
+	MatrixXd BBt=(float64_t(n)/m)*L.transpose()*L;
+	BBt.diagonal().array()+=m_tau;
+	LLT<MatrixXd> llt_B(BBt);
+	if (llt_B.info()!=Success)
+	{
+		SG_WARNING("Cholesky factorization of the preconditioner failed.\n")
+		return false;
+	}
+	MatrixXd B=llt_B.matrixL();
+
+	/* rhs B^{-1}L^{-1}K_mn*y of the preconditioned system */
+	VectorXd rhs=nystrom_product(kernel, col, NULL, y.vector,
+			parallel->get_num_threads());
+	rhs=L.triangularView<Lower>().solve(rhs);
+	rhs=B.triangularView<Lower>().solve(rhs);
+	SGVector<float64_t> b(m);
+	Map<VectorXd>(b.vector, m)=rhs;
+
+	CNystromPreconditionedOperator* op=
+		new CNystromPreconditionedOperator(kernel, col, L, B, m_tau);
+	SG_REF(op);
+	CConjugateGradientSolver* solver=new CConjugateGradientSolver();
+	SG_REF(solver);
+	solver->set_iteration_limit(m_max_iterations);
+	solver->set_relative_tolerence(m_epsilon);
+	solver->set_absolute_tolerence(0.0);
+	SGVector<float64_t> gamma=solver->solve(op, b);
+	SG_UNREF(solver);
+	SG_UNREF(op);
+
+	/* back to the coefficients of the basis, L^{-T}B^{-T}gamma */
+	Map<VectorXd> gamma_eig(gamma.vector, m);
+	VectorXd q=B.transpose().triangularView<Upper>().solve(gamma_eig);
+	Map<VectorXd>(alphas.vector, m)=L.transpose().triangularView<Upper>().solve(q);
+
+	return true;
+}
@@ -60,6 +60,14 @@ namespace shogun {
  * Several ways to subsample columns/rows have been proposed. Here they are
  * subsampled uniformly. To implement another sampling method one has to
  * override the method 'subsample_indices'.
+ *
+ * With KRR_CONJUGATE_GRADIENT the system is solved as in FALKON (Rudi et al.,
+ * 2017) instead: conjugate gradient runs on the system preconditioned with
+ * the Cholesky factors \f$K_{m,m}=LL^T\f$ and
+ * \f$BB^T=\frac{n}{m}L^TL+\tau I\f$, and the products with \f$K_{n,m}\f$
+ * are computed a block of rows at a time in every iteration. Memory is then
+ * \f$O(m^2)\f$ rather than \f$O(nm)\f$, and a few tens of iterations
+ * suffice.
  */
 class CKRRNystrom : public CKernelRidgeRegression
 {
@@ -115,6 +123,16 @@ protected:
 	 */
 	SGVector<int32_t> subsample_indices();
 
+	/** Solve the Nyström system by preconditioned conjugate gradient
+	 *
+	 * @param col sampled indices
+	 * @param y labels
+	 * @param alphas the m coefficients of the sampled examples
+	 * @return boolean to indicate success
+	 */
+	bool solve_preconditioned_system(SGVector<int32_t> col,
+			SGVector<float64_t> y, SGVector<float64_t> alphas);
+
 	/** Number of columns/rows to be sampled */
 	int32_t m_num_rkhs_basis;
 
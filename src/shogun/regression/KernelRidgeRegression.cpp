@@ -15,6 +15,8 @@
 #include <shogun/mathematics/Math.h>
 #include <shogun/labels/RegressionLabels.h>
 #include <shogun/mathematics/eigen3.h>
+#include <shogun/mathematics/linalg/linop/KernelMatrixOperator.h>
+#include <shogun/mathematics/linalg/linsolver/ConjugateGradientSolver.h>
 
 using namespace shogun;
 using namespace Eigen;
@@ -39,11 +41,38 @@ void CKernelRidgeRegression::init()
 {
 	set_tau(1e-6);
 	set_epsilon(0.0001);
+	m_solver=KRR_DIRECT;
+	m_max_iterations=1000;
 	SG_ADD(&m_tau, "tau", "Regularization parameter", MS_AVAILABLE);
+	SG_ADD(&m_epsilon, "epsilon", "Convergence precision", MS_NOT_AVAILABLE);
+	SG_ADD((machine_int_t*) &m_solver, "solver", "Solver for the linear system",
+			MS_NOT_AVAILABLE);
+	SG_ADD(&m_max_iterations, "max_iterations",
+			"Maximum number of conjugate gradient iterations", MS_NOT_AVAILABLE);
 }
 
 bool CKernelRidgeRegression::solve_krr_system()
 {
+	if (m_solver==KRR_CONJUGATE_GRADIENT)
+	{
+		SGVector<float64_t> y = ((CRegressionLabels*)m_labels)->get_labels();
+
+		CKernelMatrixOperator* op = new CKernelMatrixOperator(kernel, m_tau);
+		SG_REF(op);
+		CConjugateGradientSolver* solver = new CConjugateGradientSolver();
+		SG_REF(solver);
+		solver->set_iteration_limit(m_max_iterations);
+		solver->set_relative_tolerence(m_epsilon);
+		solver->set_absolute_tolerence(0.0);
+
+		// m_alpha holds the previous solution, or zeros
+		m_alpha = solver->solve(op, y, m_alpha);
+
+		SG_UNREF(solver);
+		SG_UNREF(op);
+		return true;
+	}
+
 	SGMatrix<float64_t> kernel_matrix(kernel->get_kernel_matrix());
 	int32_t n = kernel_matrix.num_rows;
 	SGVector<float64_t> y = ((CRegressionLabels*)m_labels)->get_labels();
@@ -88,8 +117,14 @@ bool CKernelRidgeRegression::train_machine(CFeatures *data)
 			" columns (num_labels=%d cols=%d\n", m_labels->get_num_labels(), kernel->get_num_vec_rhs());
 	}
 
-	// allocate alpha vector
-	set_alphas(SGVector<float64_t>(m_labels->get_num_labels()));
+	// allocate alpha vector, the previous one is kept as initial guess for
+	// the iterative solver
+	if (m_solver!=KRR_CONJUGATE_GRADIENT ||
+			m_alpha.vlen!=m_labels->get_num_labels())
+	{
+		set_alphas(SGVector<float64_t>(m_labels->get_num_labels()));
+		m_alpha.zero();
+	}
 
 	if(!solve_krr_system())
 		return false;
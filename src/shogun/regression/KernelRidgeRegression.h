@@ -20,6 +20,16 @@
 namespace shogun
 {
 
+/** solver used for the linear system of kernel ridge regression */
+enum EKRRSolver
+{
+	/** dense factorization of the kernel matrix */
+	KRR_DIRECT=0,
+	/** matrix-free conjugate gradient, warm started from the previous
+	 * solution when the number of examples is unchanged */
+	KRR_CONJUGATE_GRADIENT=1
+};
+
 /** @brief Class KernelRidgeRegression implements Kernel Ridge Regression - a regularized least square
  * method for classification and regression.
  *
@@ -49,6 +59,12 @@ namespace shogun
  * where K is the kernel matrix and y the vector of labels. The expressed
  * solution can again be written as a linear combination of kernels (cf.
  * CKernelMachine) with bias \f$b=0\f$.
+ *
+ * By default the system is solved by a Cholesky factorization of the kernel
+ * matrix. With KRR_CONJUGATE_GRADIENT it is solved by conjugate gradient on
+ * a CKernelMatrixOperator, which never stores the kernel matrix, so that
+ * memory grows linearly with the number of examples. Retraining with another
+ * tau then starts from the previous alphas.
  */
 class CKernelRidgeRegression : public CKernelMachine
 {
@@ -76,12 +92,39 @@ class CKernelRidgeRegression : public CKernelMachine
 		 */
 		inline virtual void set_tau(float64_t tau) { m_tau = tau; };
 
-		/** set convergence precision for gauss seidel method
+		/** set convergence precision, the relative residual norm at which
+		 * the conjugate gradient solver stops
 		 *
 		 * @param epsilon new epsilon
 		 */
 		inline void set_epsilon(float64_t epsilon) { m_epsilon = epsilon; }
 
+		/** @return convergence precision */
+		inline float64_t get_epsilon() const { return m_epsilon; }
+
+		/** set the solver for the linear system
+		 *
+		 * @param solver new solver
+		 */
+		inline void set_solver_type(EKRRSolver solver) { m_solver = solver; }
+
+		/** @return the solver for the linear system */
+		inline EKRRSolver get_solver_type() const { return m_solver; }
+
+		/** set the maximum number of conjugate gradient iterations
+		 *
+		 * @param max_iterations new maximum number of iterations
+		 */
+		inline void set_max_iterations(int32_t max_iterations)
+		{
+			REQUIRE(max_iterations>0, "Maximum number of iterations (%d) must "
+					"be positive\n", max_iterations);
+			m_max_iterations = max_iterations;
+		}
+
+		/** @return the maximum number of conjugate gradient iterations */
+		inline int32_t get_max_iterations() const { return m_max_iterations; }
+
 		/** load regression from file
 		 *
 		 * @param srcfile file to load from
@@ -119,7 +162,8 @@ class CKernelRidgeRegression : public CKernelMachine
 		 */
 		virtual bool train_machine(CFeatures* data=NULL);
 
-		/** Train regression using Cholesky decomposition.
+		/** Train regression using Cholesky decomposition or, for
+		 * KRR_CONJUGATE_GRADIENT, matrix-free conjugate gradient.
 		 * Assumes that m_alpha is already allocated.
 		 *
 		 *
@@ -134,7 +178,12 @@ class CKernelRidgeRegression : public CKernelMachine
 		/** regularization parameter tau */
 		float64_t m_tau;
 
-	private:
+		/** solver for the linear system */
+		EKRRSolver m_solver;
+
+		/** maximum number of conjugate gradient iterations */
+		int32_t m_max_iterations;
+
 		/** epsilon constant */
 		float64_t m_epsilon;
 
@@ -115,10 +115,13 @@ struct CrossValidationMMD : PermutationMMD
 
 					m_inverted_permuted_inds.set_const(-1);
 
+					// same streams as in PermutationMMD
+					const uint64_t seed=CMath::random();
 					for (auto n=0; n<m_num_null_samples; ++n)
 					{
+						RandomStream rng(seed, n);
 						std::iota(m_permuted_inds.data(), m_permuted_inds.data()+m_permuted_inds.size(), 0);
-						CMath::permute(m_permuted_inds);
+						CMath::permute(m_permuted_inds, rng);
 
 						m_stack->add_subset(m_permuted_inds);
 						SGVector<index_t> inds=m_stack->get_last_subset()->get_subset_idx();
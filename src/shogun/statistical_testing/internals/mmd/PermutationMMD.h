@@ -200,17 +200,27 @@ struct PermutationMMD : ComputeMMD
 	{
 		ASSERT(m_num_null_samples>0);
 		allocate_permutation_inds();
-		for (auto n=0; n<m_num_null_samples; ++n)
+		const index_t size=m_n_x+m_n_y;
+		// one stream per null sample, so the permutations do not depend on
+		// the number of threads
+		const uint64_t seed=CMath::random();
+#pragma omp parallel
 		{
-			std::iota(m_permuted_inds.data(), m_permuted_inds.data()+m_permuted_inds.size(), 0);
-			CMath::permute(m_permuted_inds);
-			if (m_save_inds)
+			SGVector<index_t> permuted_inds(size);
+#pragma omp for
+			for (auto n=0; n<m_num_null_samples; ++n)
 			{
-				auto offset=n*m_permuted_inds.size();
-				std::copy(m_permuted_inds.data(), m_permuted_inds.data()+m_permuted_inds.size(), &m_all_inds.matrix[offset]);
+				RandomStream rng(seed, n);
+				std::iota(permuted_inds.data(), permuted_inds.data()+permuted_inds.size(), 0);
+				CMath::permute(permuted_inds, rng);
+				if (m_save_inds)
+				{
+					auto offset=int64_t(n)*size;
+					std::copy(permuted_inds.data(), permuted_inds.data()+size, &m_all_inds.matrix[offset]);
+				}
+				for (index_t i=0; i<size; ++i)
+					m_inverted_permuted_inds(permuted_inds[i], n)=i;
 			}
-			for (index_t i=0; i<m_permuted_inds.size(); ++i)
-				m_inverted_permuted_inds(m_permuted_inds[i], n)=i;
 		}
 	}
 
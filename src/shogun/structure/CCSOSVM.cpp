@@ -533,34 +533,44 @@ SGSparseVector<float64_t> CCCSOSVM::find_cutting_plane(float64_t* margin)
 	/* find cutting plane */
 	*margin = 0;
 	new_constraint.zero();
-	for (index_t i = 0; i < num_samples; i++)
+	for (index_t block_start = 0; block_start < num_samples; block_start += CStructuredModel::ARGMAX_BLOCK_SIZE)
 	{
-		CResultSet* result = m_model->argmax(m_w, i);
-		if (result->psi_computed)
-		{
-			new_constraint.add(result->psi_truth);
-			result->psi_pred.scale(-1.0);
-			new_constraint.add(result->psi_pred);
-		}
-		else if(result->psi_computed_sparse)
-		{
-			result->psi_truth_sparse.add_to_dense(1.0, new_constraint.vector,
-					new_constraint.vlen);
-			result->psi_pred_sparse.add_to_dense(-1.0, new_constraint.vector,
-					new_constraint.vlen);
-		}
-		else
+		index_t block_size = CMath::min(CStructuredModel::ARGMAX_BLOCK_SIZE, num_samples-block_start);
+		SGVector<int32_t> block_idxs(block_size);
+		block_idxs.range_fill(block_start);
+		CDynamicObjectArray* results = m_model->argmax_batch(m_w, block_idxs);
+
+		for (index_t bi = 0; bi < block_size; bi++)
 		{
-			SG_ERROR("model(%s) should have either of psi_computed or psi_computed_sparse"
-					"to be set true\n", m_model->get_name());
+			CResultSet* result = (CResultSet*) results->get_element(bi);
+			if (result->psi_computed)
+			{
+				new_constraint.add(result->psi_truth);
+				result->psi_pred.scale(-1.0);
+				new_constraint.add(result->psi_pred);
+			}
+			else if(result->psi_computed_sparse)
+			{
+				result->psi_truth_sparse.add_to_dense(1.0, new_constraint.vector,
+						new_constraint.vlen);
+				result->psi_pred_sparse.add_to_dense(-1.0, new_constraint.vector,
+						new_constraint.vlen);
+			}
+			else
+			{
+				SG_ERROR("model(%s) should have either of psi_computed or psi_computed_sparse"
+						"to be set true\n", m_model->get_name());
+			}
+			/*
+			printf("%.16lf %.16lf\n",
+					CMath::dot(result->psi_truth.vector, result->psi_truth.vector, result->psi_truth.vlen),
+					CMath::dot(result->psi_pred.vector, result->psi_pred.vector, result->psi_pred.vlen));
+			*/
+			*margin += result->delta;
+			SG_UNREF(result);
 		}
-		/*
-		printf("%.16lf %.16lf\n",
-				CMath::dot(result->psi_truth.vector, result->psi_truth.vector, result->psi_truth.vlen),
-				CMath::dot(result->psi_pred.vector, result->psi_pred.vector, result->psi_pred.vlen));
-		*/
-		*margin += result->delta;
-		SG_UNREF(result);
+
+		SG_UNREF(results);
 	}
 	/* scaling */
 	float64_t scale = 1/(float64_t)num_samples;
@@ -108,6 +108,24 @@ CDynProg::CDynProg(int32_t num_svms /*= 8 */)
 
 	mem_initialized = true ;
 
+	m_timing_profile = false ;
+	segment_init_time = 0.0 ;
+	segment_pos_time = 0.0 ;
+	segment_clean_time = 0.0 ;
+	segment_extend_time = 0.0 ;
+	orf_time = 0.0 ;
+	content_time = 0.0 ;
+	content_penalty_time = 0.0 ;
+	content_svm_values_time = 0.0 ;
+	content_plifs_time = 0.0 ;
+	svm_init_time = 0.0 ;
+	svm_pos_time = 0.0 ;
+	inner_loop_time = 0.0 ;
+	inner_loop_max_time = 0.0 ;
+	svm_clean_time = 0.0 ;
+	long_transition_time = 0.0 ;
+	total_time = 0.0 ;
+
 	m_N=1;
 
 	m_raw_intensities = NULL;
@@ -872,9 +890,8 @@ bool CDynProg::extend_orf(
 	int32_t orf_from, int32_t orf_to, int32_t start, int32_t &last_pos,
 	int32_t to)
 {
-#ifdef DYNPROG_TIMING_DETAIL
-	MyTime.start() ;
-#endif
+	if (m_timing_profile)
+		MyTime.start() ;
 
 	if (start<0)
 		start=0 ;
@@ -892,30 +909,33 @@ bool CDynProg::extend_orf(
 
 	if (pos<0)
 	{
-#ifdef DYNPROG_TIMING_DETAIL
-		MyTime.stop() ;
-		orf_time += MyTime.time_diff_sec() ;
-#endif
+		if (m_timing_profile)
+		{
+			MyTime.stop() ;
+			orf_time += MyTime.time_diff_sec() ;
+		}
 		return true ;
 	}
 
 	for (; pos>=start; pos-=3)
 		if (m_genestr_stop[pos])
 		{
-#ifdef DYNPROG_TIMING_DETAIL
-			MyTime.stop() ;
-			orf_time += MyTime.time_diff_sec() ;
-#endif
+			if (m_timing_profile)
+			{
+				MyTime.stop() ;
+				orf_time += MyTime.time_diff_sec() ;
+			}
 			return false ;
 		}
 
 
 	last_pos = CMath::min(pos+3,to-orf_to-3) ;
 
-#ifdef DYNPROG_TIMING_DETAIL
-	MyTime.stop() ;
-	orf_time += MyTime.time_diff_sec() ;
-#endif
+	if (m_timing_profile)
+	{
+		MyTime.stop() ;
+		orf_time += MyTime.time_diff_sec() ;
+	}
 	return true ;
 }
 
@@ -952,24 +972,29 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 	CPlifBase** Plif_state_signals=m_plif_matrices->get_state_signals();
 	//END FIXME
 
+	// flat lookup tables for all plifs that have use_cache set
+	m_plif_matrices->init_penalty_struct_caches();
 
-#ifdef DYNPROG_TIMING
-		segment_init_time = 0.0 ;
-		segment_pos_time = 0.0 ;
-		segment_extend_time = 0.0 ;
-		segment_clean_time = 0.0 ;
-		orf_time = 0.0 ;
-		svm_init_time = 0.0 ;
-		svm_pos_time = 0.0 ;
-		svm_clean_time = 0.0 ;
-		inner_loop_time = 0.0 ;
-		content_svm_values_time = 0.0 ;
-		content_plifs_time = 0.0 ;
-		inner_loop_max_time = 0.0 ;
-		long_transition_time = 0.0 ;
-
-		MyTime2.start() ;
-#endif
+
+		if (m_timing_profile)
+		{
+			segment_init_time = 0.0 ;
+			segment_pos_time = 0.0 ;
+			segment_extend_time = 0.0 ;
+			segment_clean_time = 0.0 ;
+			orf_time = 0.0 ;
+			svm_init_time = 0.0 ;
+			svm_pos_time = 0.0 ;
+			svm_clean_time = 0.0 ;
+			inner_loop_time = 0.0 ;
+			content_svm_values_time = 0.0 ;
+			content_plifs_time = 0.0 ;
+			inner_loop_max_time = 0.0 ;
+			long_transition_time = 0.0 ;
+			total_time = 0.0 ;
+
+			MyTime2.start() ;
+		}
 
 		if (!m_svm_arrays_clean)
 		{
@@ -1042,6 +1067,9 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 				for (int32_t j=0; j<m_seq_len; j++)
 					seq.element(i,j) = 0 ;
 
+			// the states are independent; the sparse features use an
+			// internal cache and are therefore accessed by one thread only
+			#pragma omp parallel for num_threads(parallel->get_num_threads()) if (seq_input!=NULL)
 			for (int32_t i=0; i<m_N; i++)
 				for (int32_t j=0; j<m_seq_len; j++)
 					for (int32_t k=0; k<max_num_signals; k++)
@@ -1460,9 +1488,8 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 						}
 
 						int32_t orf_last_pos = m_pos[t] ;
-#ifdef DYNPROG_TIMING
-						MyTime3.start() ;
-#endif
+						if (m_timing_profile)
+							MyTime3.start() ;
 						int32_t num_ok_pos = 0 ;
 
 						for (int32_t ts=t-1; ts>=0 && m_pos[t]-m_pos[ts]<=look_back_; ts--)
@@ -1504,20 +1531,19 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 								float64_t pen_val = 0.0 ;
 								if (penalty)
 								{
-#ifdef DYNPROG_TIMING_DETAIL
-									MyTime.start() ;
-#endif
+									if (m_timing_profile)
+										MyTime.start() ;
 									pen_val = penalty->lookup_penalty(m_pos[t]-m_pos[ts], svm_value) ;
 
-#ifdef DYNPROG_TIMING_DETAIL
-									MyTime.stop() ;
-									content_plifs_time += MyTime.time_diff_sec() ;
-#endif
+									if (m_timing_profile)
+									{
+										MyTime.stop() ;
+										content_plifs_time += MyTime.time_diff_sec() ;
+									}
 								}
 
-#ifdef DYNPROG_TIMING_DETAIL
-								MyTime.start() ;
-#endif
+								if (m_timing_profile)
+									MyTime.start() ;
 								num_ok_pos++ ;
 
 								if (nbest==1)
@@ -1581,16 +1607,18 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 										}
 									}
 								}
-#ifdef DYNPROG_TIMING_DETAIL
-								MyTime.stop() ;
-								inner_loop_max_time += MyTime.time_diff_sec() ;
-#endif
+								if (m_timing_profile)
+								{
+									MyTime.stop() ;
+									inner_loop_max_time += MyTime.time_diff_sec() ;
+								}
 							}
 						}
-#ifdef DYNPROG_TIMING
-						MyTime3.stop() ;
-						inner_loop_time += MyTime3.time_diff_sec() ;
-#endif
+						if (m_timing_profile)
+						{
+							MyTime3.stop() ;
+							inner_loop_time += MyTime3.time_diff_sec() ;
+						}
 					}
 					for (int32_t i=0; i<num_elem; i++)
 					{
@@ -1630,9 +1658,8 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 						//int32_t loss_last_pos = t ;
 						//float64_t last_loss = 0.0 ;
 
-#ifdef DYNPROG_TIMING
-						MyTime3.start() ;
-#endif
+						if (m_timing_profile)
+							MyTime3.start() ;
 
 						/* long transition stuff */
 						/* only do this, if
@@ -1641,9 +1668,8 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 						 * the loss is switched off
 						 * nbest=1
 						 */
-#ifdef DYNPROG_TIMING
-						MyTime3.start() ;
-#endif
+						if (m_timing_profile)
+							MyTime3.start() ;
 						// long transitions, only when not considering ORFs
 						if ( long_transitions && orf_target==-1 && look_back_ == m_long_transition_threshold )
 						{
@@ -1841,10 +1867,11 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 							}
 						}
 					}
-#ifdef DYNPROG_TIMING
-					MyTime3.stop() ;
-					long_transition_time += MyTime3.time_diff_sec() ;
-#endif
+					if (m_timing_profile)
+					{
+						MyTime3.stop() ;
+						long_transition_time += MyTime3.time_diff_sec() ;
+					}
 
 
 					int32_t numEnt = fixed_list_len;
@@ -1951,17 +1978,89 @@ void CDynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 		//	SG_PRINT("DONE.     \n")
 
 
-#ifdef DYNPROG_TIMING
-		MyTime2.stop() ;
+		if (m_timing_profile)
+		{
+			MyTime2.stop() ;
+			total_time = MyTime2.time_diff_sec() ;
 
-		//if (is_big)
-		SG_PRINT("Timing:  orf=%1.2f s \n Segment_init=%1.2f s Segment_pos=%1.2f s  Segment_extend=%1.2f s Segment_clean=%1.2f s\nsvm_init=%1.2f s  svm_pos=%1.2f  svm_clean=%1.2f\n  content_svm_values_time=%1.2f  content_plifs_time=%1.2f\ninner_loop_max_time=%1.2f inner_loop=%1.2f long_transition_time=%1.2f\n total=%1.2f\n", orf_time, segment_init_time, segment_pos_time, segment_extend_time, segment_clean_time, svm_init_time, svm_pos_time, svm_clean_time, content_svm_values_time, content_plifs_time, inner_loop_max_time, inner_loop_time, long_transition_time, MyTime2.time_diff_sec())
-#endif
+			SG_DEBUG("Timing:  orf=%1.2f s \n Segment_init=%1.2f s Segment_pos=%1.2f s  Segment_extend=%1.2f s Segment_clean=%1.2f s\nsvm_init=%1.2f s  svm_pos=%1.2f  svm_clean=%1.2f\n  content_svm_values_time=%1.2f  content_plifs_time=%1.2f\ninner_loop_max_time=%1.2f inner_loop=%1.2f long_transition_time=%1.2f\n total=%1.2f\n", orf_time, segment_init_time, segment_pos_time, segment_extend_time, segment_clean_time, svm_init_time, svm_pos_time, svm_clean_time, content_svm_values_time, content_plifs_time, inner_loop_max_time, inner_loop_time, long_transition_time, total_time)
+		}
 
 		SG_FREE(fixedtempvv);
 		SG_FREE(fixedtempii);
 	}
 
+void CDynProg::compute_nbest_paths_parallel(CDynamicObjectArray* dynprogs,
+		int32_t max_num_signals, bool use_orf, int16_t nbest, bool with_loss)
+{
+	REQUIRE(dynprogs, "No dynamic programs provided\n")
+
+	int32_t num_dynprogs=dynprogs->get_num_elements();
+	if (num_dynprogs==0)
+		return;
+
+	CDynProg* first=(CDynProg*) dynprogs->get_element(0);
+	int32_t num_threads=first->parallel->get_num_threads();
+	SG_UNREF(first);
+
+	// the plif tables may be shared between the programs, so they are
+	// built before any of them is decoded
+	for (int32_t i=0; i<num_dynprogs; i++)
+	{
+		CDynProg* dp=(CDynProg*) dynprogs->get_element(i);
+		REQUIRE(dp && dp->m_plif_matrices, "Dynamic program %d has no plifs\n", i)
+		dp->m_plif_matrices->init_penalty_struct_caches();
+		SG_UNREF(dp);
+	}
+
+	bool failed=false;
+	char error[256]="";
+
+	#pragma omp parallel for schedule(dynamic) num_threads(num_threads)
+	for (int32_t i=0; i<num_dynprogs; i++)
+	{
+		CDynProg* dp=(CDynProg*) dynprogs->get_element(i);
+		try
+		{
+			dp->compute_nbest_paths(max_num_signals, use_orf, nbest,
+					with_loss, false);
+		}
+		catch (ShogunException& e)
+		{
+			#pragma omp critical
+			{
+				if (!failed)
+					snprintf(error, sizeof(error), "%s", e.get_exception_string());
+				failed=true;
+			}
+		}
+		SG_UNREF(dp);
+	}
+
+	if (failed)
+		SG_SERROR("Decoding failed: %s", error)
+}
+
+SGVector<float64_t> CDynProg::get_timing_profile() const
+{
+	SGVector<float64_t> profile(DPT_NUM_TIMINGS);
+	profile[DPT_ORF]=orf_time;
+	profile[DPT_SEGMENT_INIT]=segment_init_time;
+	profile[DPT_SEGMENT_POS]=segment_pos_time;
+	profile[DPT_SEGMENT_EXTEND]=segment_extend_time;
+	profile[DPT_SEGMENT_CLEAN]=segment_clean_time;
+	profile[DPT_SVM_INIT]=svm_init_time;
+	profile[DPT_SVM_POS]=svm_pos_time;
+	profile[DPT_SVM_CLEAN]=svm_clean_time;
+	profile[DPT_CONTENT_SVM_VALUES]=content_svm_values_time;
+	profile[DPT_CONTENT_PLIFS]=content_plifs_time;
+	profile[DPT_INNER_LOOP_MAX]=inner_loop_max_time;
+	profile[DPT_INNER_LOOP]=inner_loop_time;
+	profile[DPT_LONG_TRANSITION]=long_transition_time;
+	profile[DPT_TOTAL]=total_time;
+
+	return profile;
+}
 
 void CDynProg::best_path_trans_deriv(
 	int32_t *my_state_seq, int32_t *my_pos_seq,
@@ -2392,9 +2491,8 @@ int32_t CDynProg::raw_intensities_interval_query(const int32_t from_pos, const i
 
 void CDynProg::lookup_content_svm_values(const int32_t from_state, const int32_t to_state, const int32_t from_pos, const int32_t to_pos, float64_t* svm_values, int32_t frame)
 {
-#ifdef DYNPROG_TIMING_DETAIL
-	MyTime.start() ;
-#endif
+	if (m_timing_profile)
+		MyTime.start() ;
 //	ASSERT(from_state<to_state)
 //	if (!(from_pos<to_pos))
 //		SG_ERROR("from_pos!<to_pos, from_pos: %i to_pos: %i \n",from_pos,to_pos)
@@ -2438,10 +2536,11 @@ void CDynProg::lookup_content_svm_values(const int32_t from_state, const int32_t
 		float64_t from_val = m_lin_feat.get_element(row, from_state);
 		svm_values[frame+frame_plifs[0]] = (to_val-from_val)/(to_pos-from_pos);
 	}
-#ifdef DYNPROG_TIMING_DETAIL
-	MyTime.stop() ;
-	content_svm_values_time += MyTime.time_diff_sec() ;
-#endif
+	if (m_timing_profile)
+	{
+		MyTime.stop() ;
+		content_svm_values_time += MyTime.time_diff_sec() ;
+	}
 }
 void CDynProg::set_intron_list(CIntronList* intron_list, int32_t num_plifs)
 {
@@ -40,8 +40,6 @@ namespace shogun
 
 	template <class T> class CDynamicArray;
 
-//#define DYNPROG_TIMING
-
 #ifdef USE_BIGSTATES
 typedef uint16_t T_STATES ;
 #else
@@ -49,6 +47,42 @@ typedef uint8_t T_STATES ;
 #endif
 typedef T_STATES* P_STATES ;
 
+/** parts of compute_nbest_paths() that are timed by the timing profile,
+ * see CDynProg::get_timing_profile() */
+enum EDynProgTiming
+{
+	/** ORF checks */
+	DPT_ORF = 0,
+	/** segment loss initialization */
+	DPT_SEGMENT_INIT,
+	/** segment loss position updates */
+	DPT_SEGMENT_POS,
+	/** segment loss extension */
+	DPT_SEGMENT_EXTEND,
+	/** segment loss cleanup */
+	DPT_SEGMENT_CLEAN,
+	/** SVM value initialization */
+	DPT_SVM_INIT,
+	/** SVM value position updates */
+	DPT_SVM_POS,
+	/** SVM value cleanup */
+	DPT_SVM_CLEAN,
+	/** content SVM value lookups */
+	DPT_CONTENT_SVM_VALUES,
+	/** content PLIF lookups */
+	DPT_CONTENT_PLIFS,
+	/** maximization in the inner loop */
+	DPT_INNER_LOOP_MAX,
+	/** inner loop over segment starts */
+	DPT_INNER_LOOP,
+	/** long transitions */
+	DPT_LONG_TRANSITION,
+	/** whole decoding */
+	DPT_TOTAL,
+	/** number of timings */
+	DPT_NUM_TIMINGS
+};
+
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 /** @brief segment loss */
 struct segment_loss_struct
@@ -272,6 +306,38 @@ public:
 	void compute_nbest_paths(int32_t max_num_signals,
 						 bool use_orf, int16_t nbest, bool with_loss, bool with_multiple_sequences);
 
+	/** run compute_nbest_paths() on several sequences concurrently
+	 *
+	 * Each sequence is decoded by its own, fully set up CDynProg object, the
+	 * number of threads is taken from the parallel settings of the first
+	 * one. The objects may share their CPlifMatrix.
+	 *
+	 * @param dynprogs CDynProg objects, one per sequence
+	 * @param max_num_signals maximal number of signals for a single state
+	 * @param use_orf whether orf shall be used
+	 * @param nbest number of best paths (n)
+	 * @param with_loss use loss
+	 */
+	static void compute_nbest_paths_parallel(CDynamicObjectArray* dynprogs,
+			int32_t max_num_signals, bool use_orf, int16_t nbest, bool with_loss);
+
+	/** enable or disable timing of the parts of compute_nbest_paths()
+	 *
+	 * @param enable whether to collect the timing profile
+	 */
+	void set_timing_profile(bool enable) { m_timing_profile=enable; }
+
+	/** @return whether the timing profile is collected */
+	bool get_timing_profile_enabled() const { return m_timing_profile; }
+
+	/** get the time (in seconds) spent in the parts of the last
+	 * compute_nbest_paths() call, indexed by EDynProgTiming. Only
+	 * filled if enabled by set_timing_profile().
+	 *
+	 * @return timing profile
+	 */
+	SGVector<float64_t> get_timing_profile() const;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 	/** given a path though the state model and the corresponding
@@ -571,7 +637,9 @@ private:
 	int32_t **trans_list_forward_id;
 	bool mem_initialized;
 
-#ifdef DYNPROG_TIMING
+	/** whether the timing profile is collected */
+	bool m_timing_profile;
+
 	CTime MyTime;
 	CTime MyTime2;
 	CTime MyTime3;
@@ -591,7 +659,7 @@ private:
 	float64_t inner_loop_max_time ;
 	float64_t svm_clean_time;
 	float64_t long_transition_time ;
-#endif
+	float64_t total_time ;
 
 
 protected:
@@ -112,42 +112,52 @@ bool CFWSOSVM::train_machine(CFeatures* data)
 		w_s.zero();
 		ell_s = 0;
 
-		for (int32_t si = 0; si < N; ++si)
+		// 1) solve the loss-augmented inference for all the points, in
+		// blocks since they all use the same w
+		for (int32_t block_start = 0; block_start < N; block_start += CStructuredModel::ARGMAX_BLOCK_SIZE)
 		{
-			// 1) solve the loss-augmented inference for point si
-			CResultSet* result = m_model->argmax(m_w, si);
+			int32_t block_size = CMath::min(CStructuredModel::ARGMAX_BLOCK_SIZE, N-block_start);
+			SGVector<int32_t> block_idxs(block_size);
+			block_idxs.range_fill(block_start);
+			CDynamicObjectArray* results = m_model->argmax_batch(m_w, block_idxs);
 
-			// 2) get the subgradient
-			// psi_i(y) := phi(x_i,y_i) - phi(x_i, y_pred)
-			SGVector<float64_t> psi_i(M);
-			if (result->psi_computed)
+			for (int32_t bi = 0; bi < block_size; ++bi)
 			{
-				SGVector<float64_t>::add(psi_i.vector,
-					1.0, result->psi_truth.vector, -1.0, result->psi_pred.vector,
-					psi_i.vlen);
+				CResultSet* result = (CResultSet*) results->get_element(bi);
+
+				// 2) get the subgradient
+				// psi_i(y) := phi(x_i,y_i) - phi(x_i, y_pred)
+				SGVector<float64_t> psi_i(M);
+				if (result->psi_computed)
+				{
+					SGVector<float64_t>::add(psi_i.vector,
+						1.0, result->psi_truth.vector, -1.0, result->psi_pred.vector,
+						psi_i.vlen);
+				}
+				else if(result->psi_computed_sparse)
+				{
+					psi_i.zero();
+					result->psi_pred_sparse.add_to_dense(1.0, psi_i.vector, psi_i.vlen);
+					result->psi_truth_sparse.add_to_dense(-1.0, psi_i.vector, psi_i.vlen);
+				}
+				else
+				{
+					SG_ERROR("model(%s) should have either of psi_computed or psi_computed_sparse"
+							"to be set true\n", m_model->get_name());
+				}
+
+				// 3) loss_i = L(y_i, y_pred)
+				float64_t loss_i = result->delta;
+				ASSERT(loss_i - linalg::dot(m_w, psi_i) >= -1e-12);
+
+				// 4) update w_s and ell_s
+				w_s.add(psi_i);
+				ell_s += loss_i;
+
+				SG_UNREF(result);
 			}
-			else if(result->psi_computed_sparse)
-			{
-				psi_i.zero();
-				result->psi_pred_sparse.add_to_dense(1.0, psi_i.vector, psi_i.vlen);
-				result->psi_truth_sparse.add_to_dense(-1.0, psi_i.vector, psi_i.vlen);
-			}
-			else
-			{
-				SG_ERROR("model(%s) should have either of psi_computed or psi_computed_sparse"
-						"to be set true\n", m_model->get_name());
-			}
-
-			// 3) loss_i = L(y_i, y_pred)
-			float64_t loss_i = result->delta;
-			ASSERT(loss_i - linalg::dot(m_w, psi_i) >= -1e-12);
-
-			// 4) update w_s and ell_s
-			w_s.add(psi_i);
-			ell_s += loss_i;
-
-			SG_UNREF(result);
 
+			SG_UNREF(results);
 		} // end si
 
 		w_s.scale(1.0 / (N*m_lambda));
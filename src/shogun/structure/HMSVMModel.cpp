@@ -79,16 +79,22 @@ SGVector< float64_t > CHMSVMModel::get_joint_feature_vector(
 
 	// Translate from labels sequence to state sequence
 	SGVector< int32_t > state_seq = m_state_model->labels_to_states(label_seq);
-	m_transmission_weights.zero();
+
+	// Local counts so that psi can be computed concurrently with Viterbi
+	// decoding, which uses the member weights
+	SGMatrix< float64_t > transmission_weights(m_transmission_weights.num_rows,
+			m_transmission_weights.num_cols);
+	SGVector< float64_t > emission_weights(m_emission_weights.vlen);
+	transmission_weights.zero();
 
 	for ( int32_t i = 0 ; i < state_seq.vlen-1 ; ++i )
-		m_transmission_weights(state_seq[i],state_seq[i+1]) += 1;
+		transmission_weights(state_seq[i],state_seq[i+1]) += 1;
 
 	SGMatrix< float64_t > obs = mf->get_feature_vector(feat_idx);
 	REQUIRE(obs.num_rows == D && obs.num_cols == state_seq.vlen,
 		"obs.num_rows (%d) != D (%d) OR obs.num_cols (%d) != state_seq.vlen (%d)\n",
 		obs.num_rows, D, obs.num_cols, state_seq.vlen)
-	m_emission_weights.zero();
+	emission_weights.zero();
 	index_t aux_idx, weight_idx;
 
 	if ( !m_use_plifs )	// Do not use PLiFs
@@ -100,11 +106,11 @@ SGVector< float64_t > CHMSVMModel::get_joint_feature_vector(
 			for ( int32_t j = 0 ; j < state_seq.vlen ; ++j )
 			{
 				weight_idx = aux_idx + state_seq[j]*D*m_num_obs + obs(f,j);
-				m_emission_weights[weight_idx] += 1;
+				emission_weights[weight_idx] += 1;
 			}
 		}
 
-		m_state_model->weights_to_vector(psi, m_transmission_weights, m_emission_weights,
+		m_state_model->weights_to_vector(psi, transmission_weights, emission_weights,
 				D, m_num_obs);
 	}
 	else	// Use PLiFs
@@ -135,15 +141,15 @@ SGVector< float64_t > CHMSVMModel::get_joint_feature_vector(
 				weight_idx = aux_idx + state_seq[j]*D*m_num_plif_nodes;
 
 				if ( count == 0 )
-					m_emission_weights[weight_idx] += 1;
+					emission_weights[weight_idx] += 1;
 				else if ( count == m_num_plif_nodes )
-					m_emission_weights[weight_idx + m_num_plif_nodes-1] += 1;
+					emission_weights[weight_idx + m_num_plif_nodes-1] += 1;
 				else
 				{
-					m_emission_weights[weight_idx + count] +=
+					emission_weights[weight_idx + count] +=
 						(value-limits[count-1]) / (limits[count]-limits[count-1]);
 
-					m_emission_weights[weight_idx + count-1] +=
+					emission_weights[weight_idx + count-1] +=
 						(limits[count]-value) / (limits[count]-limits[count-1]);
 				}
 
@@ -151,7 +157,7 @@ SGVector< float64_t > CHMSVMModel::get_joint_feature_vector(
 			}
 		}
 
-		m_state_model->weights_to_vector(psi, m_transmission_weights, m_emission_weights,
+		m_state_model->weights_to_vector(psi, transmission_weights, emission_weights,
 				D, m_num_plif_nodes);
 	}
 
@@ -163,7 +169,14 @@ CResultSet* CHMSVMModel::argmax(
 		int32_t feat_idx,
 		bool const training)
 {
-	int32_t dim = get_dim();
+	prepare_argmax_batch(w, training);
+	return argmax_batch_element(w, feat_idx, training);
+}
+
+bool CHMSVMModel::prepare_argmax_batch(
+		SGVector< float64_t > w,
+		bool const training)
+{
 	ASSERT( w.vlen == get_dim() )
 
 	// Shorthand for the number of features of the feature vector
@@ -178,8 +191,43 @@ CResultSet* CHMSVMModel::argmax(
 				"the use_plifs option?\n");
 		REQUIRE(m_plif_matrix->get_num_elements() == S*D, "Dimension mismatch in PLiF matrix, have the "
 				"feature dimension and/or number of states changed from training to prediction?\n");
+
+		m_state_model->reshape_emission_params(m_plif_matrix, w, D, m_num_plif_nodes);
+	}
+	else
+	{
+		m_state_model->reshape_emission_params(m_emission_weights, w, D, m_num_obs);
+
+		// Emission weights with the states as the fastest running index, so
+		// that the emission scores of all the states of an observation are
+		// accumulated from a contiguous column
+		int32_t num_em = D*m_num_obs;
+		m_emission_table = SGMatrix< float64_t >(S, num_em);
+		for ( int32_t s = 0 ; s < S ; ++s )
+		{
+			for ( int32_t em_idx = 0 ; em_idx < num_em ; ++em_idx )
+				m_emission_table(s, em_idx) = m_emission_weights[s*num_em + em_idx];
+		}
 	}
 
+	m_state_model->reshape_transmission_params(m_transmission_weights, w);
+
+	// All the parameters used in Viterbi have been set, the examples of
+	// a batch can be decoded concurrently
+	return true;
+}
+
+CResultSet* CHMSVMModel::argmax_batch_element(
+		SGVector< float64_t > w,
+		int32_t feat_idx,
+		bool const training)
+{
+	// Shorthand for the number of features of the feature vector
+	CMatrixFeatures< float64_t >* mf = (CMatrixFeatures< float64_t >*) m_features;
+	int32_t D = mf->get_num_features();
+	// Shorthand for the number of states
+	int32_t S = m_state_model->get_num_states();
+
 	// Distribution of start states
 	SGVector< float64_t > p = m_state_model->get_start_states();
 	// Distribution of stop states
@@ -196,25 +244,23 @@ CResultSet* CHMSVMModel::argmax(
 
 	if ( !m_use_plifs )	// Do not use PLiFs
 	{
-		index_t em_idx;
-		m_state_model->reshape_emission_params(m_emission_weights, w, D, m_num_obs);
-
 		for ( int32_t i = 0 ; i < T ; ++i )
 		{
+			float64_t* E_i = E.get_column_vector(i);
+
 			for ( int32_t j = 0 ; j < D ; ++j )
 			{
 				//FIXME make independent of observation values
-				em_idx = j*m_num_obs + (index_t)CMath::round(x(j,i));
+				index_t em_idx = j*m_num_obs + (index_t)CMath::round(x(j,i));
+				const float64_t* em = m_emission_table.get_column_vector(em_idx);
 
 				for ( int32_t s = 0 ; s < S ; ++s )
-					E(s,i) += m_emission_weights[s*D*m_num_obs + em_idx];
+					E_i[s] += em[s];
 			}
 		}
 	}
 	else	// Use PLiFs
 	{
-		m_state_model->reshape_emission_params(m_plif_matrix, w, D, m_num_plif_nodes);
-
 		for ( int32_t i = 0 ; i < T ; ++i )
 		{
 			for ( int32_t f = 0 ; f < D ; ++f )
@@ -251,57 +297,57 @@ CResultSet* CHMSVMModel::argmax(
 		SG_UNREF(ytrue);
 	}
 
-	// Initialize the dynamic programming table and the traceback matrix
-	SGMatrix< float64_t >  dp(T, S);
-	SGMatrix< float64_t > trb(T, S);
-	m_state_model->reshape_transmission_params(m_transmission_weights, w);
+	// Initialize the dynamic programming table and the traceback matrix,
+	// both stored with the states as the fastest running index so that the
+	// scores of the previous position are read contiguously
+	SGMatrix< float64_t >  dp(S, T);
+	SGMatrix< int32_t >   trb(S, T);
 
 	for ( int32_t s = 0 ; s < S ; ++s )
 	{
 		if ( p[s] > -CMath::INFTY )
 		{
-			// dp(0,s) = E(s,0)
-			dp(0,s) = E[s];
+			// dp(s,0) = E(s,0)
+			dp[s] = E[s];
 		}
 		else
 		{
-			dp(0,s) = -CMath::INFTY;
+			dp[s] = -CMath::INFTY;
 		}
 	}
 
 	// Viterbi algorithm
-	int32_t idx;
-	float64_t tmp_score, e, a;
-
 	for ( int32_t i = 1 ; i < T ; ++i )
 	{
+		const float64_t* dp_prev = dp.get_column_vector(i-1);
+		float64_t* dp_cur = dp.get_column_vector(i);
+		int32_t* trb_cur = trb.get_column_vector(i);
+
 		for ( int32_t cur = 0 ; cur < S ; ++cur )
 		{
-			idx = cur*T + i;
-
-			 dp[idx] = -CMath::INFTY;
-			trb[idx] = -1;
-
-			// e = E(cur,i)
-			e = E[i*S + cur];
+			// a(prev) = m_transmission_weights(prev, cur)
+			const float64_t* a = m_transmission_weights.get_column_vector(cur);
+			float64_t e = E(cur,i);
+			float64_t best_score = -CMath::INFTY;
+			int32_t best_prev = -1;
 
 			for ( int32_t prev = 0 ; prev < S ; ++prev )
 			{
-				// aij = m_transmission_weights(prev, cur)
-				a = m_transmission_weights[cur*S + prev];
-
-				if ( a > -CMath::INFTY )
+				if ( a[prev] > -CMath::INFTY )
 				{
-					// tmp_score = e + a + dp(i-1, prev)
-					tmp_score = e + a + dp[prev*T + i-1];
+					// tmp_score = e + a + dp(prev, i-1)
+					float64_t tmp_score = e + a[prev] + dp_prev[prev];
 
-					if ( tmp_score > dp[idx] )
+					if ( tmp_score > best_score )
 					{
-						 dp[idx] = tmp_score;
-						trb[idx] = prev;
+						best_score = tmp_score;
+						best_prev = prev;
 					}
 				}
 			}
+
+			dp_cur[cur] = best_score;
+			trb_cur[cur] = best_prev;
 		}
 	}
 
@@ -315,21 +361,22 @@ CResultSet* CHMSVMModel::argmax(
 
 	for ( int32_t s = 0 ; s < S ; ++s )
 	{
-		idx = s*T + T-1;
-
-		if ( q[s] > -CMath::INFTY && dp[idx] > ret->score )
+		if ( q[s] > -CMath::INFTY && dp(s,T-1) > ret->score )
 		{
-			ret->score = dp[idx];
+			ret->score = dp(s,T-1);
 			opt_path[T-1] = s;
 		}
 	}
 
+	if ( opt_path[T-1] == -1 )
+		SG_UNREF(ret);
+
 	REQUIRE(opt_path[T-1]!=-1, "Viterbi decoding found no possible sequence states.\n"
 			"Maybe the state model used cannot produce such sequence.\n"
 			"If using the TwoStateModel, please use sequences of length greater than two.\n");
 
 	for ( int32_t i = T-1 ; i > 0 ; --i )
-		opt_path[i-1] = trb[opt_path[i]*T + i];
+		opt_path[i-1] = trb(opt_path[i], i);
 
 	// Populate the CResultSet object to return
 	CSequence* ypred = m_state_model->states_to_labels(opt_path);
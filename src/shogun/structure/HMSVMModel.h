@@ -172,6 +172,31 @@ class CHMSVMModel : public CStructuredModel
 		 */
 		virtual const char* get_name() const { return "HMSVMModel"; }
 
+	protected:
+		/**
+		 * reshapes the weight vector into the transmission and emission
+		 * weights (or PLiFs) used in Viterbi, see CStructuredModel
+		 *
+		 * @param w weight vector
+		 * @param training true if argmax is called during training
+		 *
+		 * @return true, the examples of a batch are decoded concurrently
+		 */
+		virtual bool prepare_argmax_batch(SGVector< float64_t > w, bool const training);
+
+		/**
+		 * Viterbi decoding of a single example using the weights set by
+		 * prepare_argmax_batch()
+		 *
+		 * @param w weight vector
+		 * @param feat_idx index of the feature to compute the argmax
+		 * @param training true if argmax is called during training
+		 *
+		 * @return structure with the predicted output
+		 */
+		virtual CResultSet* argmax_batch_element(SGVector< float64_t > w,
+				int32_t feat_idx, bool const training);
+
 	private:
 		/* internal initialization */
 		void init();
@@ -192,6 +217,10 @@ class CHMSVMModel : public CStructuredModel
 		/** emission weights used in Viterbi */
 		SGVector< float64_t > m_emission_weights;
 
+		/** emission weights of dimensions (num_states, num_features*num_obs),
+		 * rearranged from m_emission_weights by prepare_argmax_batch() */
+		SGMatrix< float64_t > m_emission_table;
+
 		/** number of supporting points for each PLiF */
 		int32_t m_num_plif_nodes;
 
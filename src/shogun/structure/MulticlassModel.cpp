@@ -69,9 +69,14 @@ CResultSet* CMulticlassModel::argmax(
 		int32_t feat_idx,
 		bool const training)
 {
-	CDotFeatures* df = (CDotFeatures*) m_features;
-	int32_t feats_dim   = df->get_dim_feature_space();
+	prepare_argmax_batch(w, training);
+	return argmax_batch_element(w, feat_idx, training);
+}
 
+bool CMulticlassModel::prepare_argmax_batch(
+		SGVector< float64_t > w,
+		bool const training)
+{
 	if ( training )
 	{
 		CMulticlassSOLabels* ml = (CMulticlassSOLabels*) m_labels;
@@ -86,6 +91,18 @@ CResultSet* CMulticlassModel::argmax(
 	int32_t dim = get_dim();
 	ASSERT(dim == w.vlen)
 
+	// The class scores only read the features and w
+	return true;
+}
+
+CResultSet* CMulticlassModel::argmax_batch_element(
+		SGVector< float64_t > w,
+		int32_t feat_idx,
+		bool const training)
+{
+	CDotFeatures* df = (CDotFeatures*) m_features;
+	int32_t feats_dim   = df->get_dim_feature_space();
+
 	// Find the class that gives the maximum score
 
 	float64_t score = 0, ypred = 0;
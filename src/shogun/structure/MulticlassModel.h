@@ -110,6 +110,29 @@ class CMulticlassModel : public CStructuredModel
 		/** @return name of SGSerializable */
 		virtual const char* get_name() const { return "MulticlassModel"; }
 
+	protected:
+		/**
+		 * sets up the number of classes, see CStructuredModel
+		 *
+		 * @param w weight vector
+		 * @param training true if argmax is called during training
+		 *
+		 * @return true, the examples of a batch are scored concurrently
+		 */
+		virtual bool prepare_argmax_batch(SGVector< float64_t > w, bool const training);
+
+		/**
+		 * scores all the classes for a single example
+		 *
+		 * @param w weight vector
+		 * @param feat_idx index of the feature to compute the argmax
+		 * @param training true if argmax is called during training
+		 *
+		 * @return structure with the predicted output
+		 */
+		virtual CResultSet* argmax_batch_element(SGVector< float64_t > w,
+				int32_t feat_idx, bool const training);
+
 	private:
 		void init();
 
@@ -89,6 +89,12 @@ void CPlifMatrix::set_plif_use_cache(SGVector<bool> use_cache)
 	}
 }
 
+void CPlifMatrix::init_penalty_struct_caches()
+{
+	for (int32_t i=0; i<m_num_plifs; i++)
+		m_PEN[i]->init_penalty_struct_cache();
+}
+
 void CPlifMatrix::set_plif_use_svm(SGVector<int32_t> use_svm)
 {
 	if (use_svm.vlen!=m_num_plifs)
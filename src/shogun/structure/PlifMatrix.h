@@ -110,6 +110,11 @@ class CPlifMatrix: public CSGObject
 		 */
 		void set_plif_use_cache(SGVector<bool> use_cache);
 
+		/** build the penalty lookup tables of all plifs that use a cache
+		 * (a no-op for plifs whose table is up to date)
+		 */
+		void init_penalty_struct_caches();
+
 		/** set plif use svm
 		 *
 		 * @param use_svm use svm
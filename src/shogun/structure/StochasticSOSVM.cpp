@@ -47,12 +47,14 @@ void CStochasticSOSVM::init()
 	SG_ADD(&m_do_weighted_averaging, "do_weighted_averaging", "Do weighted averaging", MS_NOT_AVAILABLE);
 	SG_ADD(&m_debug_multiplier, "debug_multiplier", "Debug multiplier", MS_NOT_AVAILABLE);
 	SG_ADD(&m_rand_seed, "rand_seed", "Random seed", MS_NOT_AVAILABLE);
+	SG_ADD(&m_batch_size, "batch_size", "Mini-batch size", MS_NOT_AVAILABLE);
 
 	m_lambda = 1.0;
 	m_num_iter = 50;
 	m_do_weighted_averaging = true;
 	m_debug_multiplier = 0;
 	m_rand_seed = 1;
+	m_batch_size = 1;
 }
 
 CStochasticSOSVM::~CStochasticSOSVM()
@@ -114,77 +116,88 @@ bool CStochasticSOSVM::train_machine(CFeatures* data)
 	int32_t k = 0;
 	for (int32_t pi = 0; pi < m_num_iter; ++pi)
 	{
-		for (int32_t si = 0; si < N; ++si)
+		for (int32_t si = 0; si < N; si += m_batch_size)
 		{
-			// 1) Picking random example
-			int32_t i = CMath::random(0, N-1);
+			// 1) Picking a mini-batch of random examples
+			int32_t batch_size = CMath::min(m_batch_size, N-si);
+			SGVector<int32_t> batch_idxs(batch_size);
+			for (int32_t bi = 0; bi < batch_size; ++bi)
+				batch_idxs[bi] = CMath::random(0, N-1);
 
-			// 2) solve the loss-augmented inference for point i
-			CResultSet* result = m_model->argmax(m_w, i);
+			// 2) solve the loss-augmented inference for the mini-batch,
+			// all of them with the current w
+			CDynamicObjectArray* results = m_model->argmax_batch(m_w, batch_idxs);
 
-			// 3) get the subgradient
-			// psi_i(y) := phi(x_i,y_i) - phi(x_i, y)
-			SGVector<float64_t> psi_i(M);
-			SGVector<float64_t> w_s(M);
-
-			if (result->psi_computed)
-			{
-				SGVector<float64_t>::add(psi_i.vector,
-					1.0, result->psi_truth.vector, -1.0, result->psi_pred.vector,
-					psi_i.vlen);
-			}
-			else if(result->psi_computed_sparse)
-			{
-				psi_i.zero();
-				result->psi_pred_sparse.add_to_dense(1.0, psi_i.vector, psi_i.vlen);
-				result->psi_truth_sparse.add_to_dense(-1.0, psi_i.vector, psi_i.vlen);
-			}
-			else
-			{
-				SG_ERROR("model(%s) should have either of psi_computed or psi_computed_sparse"
-						"to be set true\n", m_model->get_name());
-			}
-
-			w_s = psi_i.clone();
-			w_s.scale(1.0 / (N*m_lambda));
-
-			// 4) step-size gamma
-			float64_t gamma = 1.0 / (k+1.0);
-
-			// 5) finally update the weights
-			SGVector<float64_t>::add(m_w.vector,
-				1.0-gamma, m_w.vector, gamma*N, w_s.vector, m_w.vlen);
-
-			// 6) Optionally, update the weighted average
-			if (m_do_weighted_averaging)
-			{
-				float64_t rho = 2.0 / (k+2.0);
-				SGVector<float64_t>::add(w_avg.vector,
-					1.0-rho, w_avg.vector, rho, m_w.vector, w_avg.vlen);
-			}
-
-			k += 1;
-			SG_UNREF(result);
-
-			// Debug: compute objective and training error
-			if (m_verbose && k == debug_iter)
+			for (int32_t bi = 0; bi < batch_size; ++bi)
 			{
-				SGVector<float64_t> w_debug;
-				if (m_do_weighted_averaging)
-					w_debug = w_avg.clone();
+				CResultSet* result = (CResultSet*) results->get_element(bi);
+
+				// 3) get the subgradient
+				// psi_i(y) := phi(x_i,y_i) - phi(x_i, y)
+				SGVector<float64_t> psi_i(M);
+				SGVector<float64_t> w_s(M);
+
+				if (result->psi_computed)
+				{
+					SGVector<float64_t>::add(psi_i.vector,
+						1.0, result->psi_truth.vector, -1.0, result->psi_pred.vector,
+						psi_i.vlen);
+				}
+				else if(result->psi_computed_sparse)
+				{
+					psi_i.zero();
+					result->psi_pred_sparse.add_to_dense(1.0, psi_i.vector, psi_i.vlen);
+					result->psi_truth_sparse.add_to_dense(-1.0, psi_i.vector, psi_i.vlen);
+				}
 				else
-					w_debug = m_w.clone();
+				{
+					SG_ERROR("model(%s) should have either of psi_computed or psi_computed_sparse"
+							"to be set true\n", m_model->get_name());
+				}
 
-				float64_t primal = CSOSVMHelper::primal_objective(w_debug, m_model, m_lambda);
-				float64_t train_error = CSOSVMHelper::average_loss(w_debug, m_model);
+				w_s = psi_i.clone();
+				w_s.scale(1.0 / (N*m_lambda));
 
-				SG_DEBUG("pass %d (iteration %d), SVM primal = %f, train_error = %f \n",
-					pi, k, primal, train_error);
+				// 4) step-size gamma
+				float64_t gamma = 1.0 / (k+1.0);
 
-				m_helper->add_debug_info(primal, (1.0*k) / N, train_error);
+				// 5) finally update the weights
+				SGVector<float64_t>::add(m_w.vector,
+					1.0-gamma, m_w.vector, gamma*N, w_s.vector, m_w.vlen);
 
-				debug_iter = CMath::min(debug_iter+N, debug_iter*(1+m_debug_multiplier/100));
+				// 6) Optionally, update the weighted average
+				if (m_do_weighted_averaging)
+				{
+					float64_t rho = 2.0 / (k+2.0);
+					SGVector<float64_t>::add(w_avg.vector,
+						1.0-rho, w_avg.vector, rho, m_w.vector, w_avg.vlen);
+				}
+
+				k += 1;
+				SG_UNREF(result);
+
+				// Debug: compute objective and training error
+				if (m_verbose && k == debug_iter)
+				{
+					SGVector<float64_t> w_debug;
+					if (m_do_weighted_averaging)
+						w_debug = w_avg.clone();
+					else
+						w_debug = m_w.clone();
+
+					float64_t primal = CSOSVMHelper::primal_objective(w_debug, m_model, m_lambda);
+					float64_t train_error = CSOSVMHelper::average_loss(w_debug, m_model);
+
+					SG_DEBUG("pass %d (iteration %d), SVM primal = %f, train_error = %f \n",
+						pi, k, primal, train_error);
+
+					m_helper->add_debug_info(primal, (1.0*k) / N, train_error);
+
+					debug_iter = CMath::min(debug_iter+N, debug_iter*(1+m_debug_multiplier/100));
+				}
 			}
+
+			SG_UNREF(results);
 		}
 	}
 
@@ -238,3 +251,15 @@ void CStochasticSOSVM::set_rand_seed(uint32_t rand_seed)
 	m_rand_seed = rand_seed;
 }
 
+int32_t CStochasticSOSVM::get_batch_size() const
+{
+	return m_batch_size;
+}
+
+void CStochasticSOSVM::set_batch_size(int32_t batch_size)
+{
+	REQUIRE(batch_size > 0, "%s::set_batch_size(): batch size must be positive, "
+		"got %d!\n", get_name(), batch_size);
+	m_batch_size = batch_size;
+}
+
@@ -93,6 +93,17 @@ public:
 	 */
 	void set_rand_seed(uint32_t rand_seed);
 
+	/** @return mini-batch size */
+	int32_t get_batch_size() const;
+
+	/** set the number of examples whose loss-augmented inference is
+	 * solved for the same w, in parallel. The updates are still applied
+	 * one example at a time.
+	 *
+	 * @param batch_size mini-batch size (default: 1)
+	 */
+	void set_batch_size(int32_t batch_size);
+
 protected:
 	/** train primal SO-SVM
 	 *
@@ -126,6 +137,9 @@ private:
 	 */
 	int32_t m_debug_multiplier;
 
+	/** Number of examples per argmax batch (default: 1) */
+	int32_t m_batch_size;
+
 }; /* CStochasticSOSVM */
 
 } /* namespace shogun */
@@ -10,9 +10,12 @@
  */
 
 #include <shogun/structure/StructuredModel.h>
+#include <shogun/lib/ShogunException.h>
 
 using namespace shogun;
 
+const int32_t CStructuredModel::ARGMAX_BLOCK_SIZE;
+
 CResultSet::CResultSet()
 : CSGObject(), argmax(NULL),
 	psi_computed_sparse(false),
@@ -164,6 +167,70 @@ float64_t CStructuredModel::delta_loss(CStructuredData* y1, CStructuredData* y2)
 	return 0.0;
 }
 
+CDynamicObjectArray* CStructuredModel::argmax_batch(
+		SGVector< float64_t > w,
+		SGVector< int32_t > feat_idxs,
+		bool const training)
+{
+	int32_t num_idxs = feat_idxs.vlen;
+	CResultSet** results = SG_CALLOC(CResultSet*, num_idxs);
+
+	bool is_parallel = prepare_argmax_batch(w, training);
+	bool failed = false;
+	char error[256] = "";
+
+	#pragma omp parallel for schedule(dynamic) num_threads(parallel->get_num_threads()) if (is_parallel)
+	for (int32_t i = 0; i < num_idxs; i++)
+	{
+		try
+		{
+			results[i] = argmax_batch_element(w, feat_idxs[i], training);
+		}
+		catch (ShogunException& e)
+		{
+			#pragma omp critical
+			{
+				if (!failed)
+					snprintf(error, sizeof(error), "%s", e.get_exception_string());
+				failed = true;
+			}
+		}
+	}
+
+	CDynamicObjectArray* ret = new CDynamicObjectArray(num_idxs);
+	SG_REF(ret);
+	for (int32_t i = 0; i < num_idxs; i++)
+	{
+		if (results[i])
+			ret->push_back(results[i]);
+		SG_UNREF(results[i]);
+	}
+	SG_FREE(results);
+
+	if (failed)
+	{
+		SG_UNREF(ret);
+		SG_ERROR("%s", error)
+	}
+
+	return ret;
+}
+
+bool CStructuredModel::prepare_argmax_batch(
+		SGVector< float64_t > w,
+		bool const training)
+{
+	return false;
+}
+
+CResultSet* CStructuredModel::argmax_batch_element(
+		SGVector< float64_t > w,
+		int32_t feat_idx,
+		bool const training)
+{
+	return argmax(w, feat_idx, training);
+}
+
 void CStructuredModel::init()
 {
 	SG_ADD((CSGObject**) &m_labels, "m_labels", "Structured labels",
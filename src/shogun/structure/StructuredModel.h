@@ -22,6 +22,7 @@
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/lib/SGSparseVector.h>
 #include <shogun/lib/StructuredData.h>
+#include <shogun/lib/DynamicObjectArray.h>
 
 namespace shogun
 {
@@ -238,6 +239,25 @@ class CStructuredModel : public CSGObject
 		 */
 		virtual CResultSet* argmax(SGVector< float64_t > w, int32_t feat_idx, bool const training = true) = 0;
 
+		/**
+		 * obtains the argmax for a block of examples that share the same
+		 * weight vector, see argmax(). Calls prepare_argmax_batch() once and
+		 * then argmax_batch_element() for every example, in parallel if the
+		 * model allows it.
+		 *
+		 * @param w weight vector
+		 * @param feat_idxs indices of the features to compute the argmax
+		 * @param training true if argmax is called during training
+		 *
+		 * @return array of CResultSet, one per index in feat_idxs
+		 */
+		virtual CDynamicObjectArray* argmax_batch(SGVector< float64_t > w,
+				SGVector< int32_t > feat_idxs, bool const training = true);
+
+		/** number of examples per argmax_batch() call in the solvers that
+		 * compute the argmax of all the examples for the same w */
+		static const int32_t ARGMAX_BLOCK_SIZE = 1024;
+
 		/** computes \f$ \Delta(y_{\text{true}}, y_{\text{pred}}) \f$
 		 *
 		 * @param ytrue_idx index of the true label in labels
@@ -296,6 +316,34 @@ class CStructuredModel : public CSGObject
 		 */
 		virtual int32_t get_num_aux_con() const;
 
+	protected:
+		/**
+		 * prepares the computation of argmax_batch_element() for the given
+		 * weight vector, e.g. by reshaping it into the parameters used in
+		 * inference. The default implementation does nothing.
+		 *
+		 * @param w weight vector
+		 * @param training true if argmax is called during training
+		 *
+		 * @return true if argmax_batch_element() may be called concurrently
+		 * for different examples afterwards, false by default
+		 */
+		virtual bool prepare_argmax_batch(SGVector< float64_t > w, bool const training);
+
+		/**
+		 * computes the argmax of a single example of a block, called by
+		 * argmax_batch() after prepare_argmax_batch(). The default
+		 * implementation calls argmax().
+		 *
+		 * @param w weight vector
+		 * @param feat_idx index of the feature to compute the argmax
+		 * @param training true if argmax is called during training
+		 *
+		 * @return structure with the predicted output
+		 */
+		virtual CResultSet* argmax_batch_element(SGVector< float64_t > w,
+				int32_t feat_idx, bool const training);
+
 	private:
 		/** internal initialization */
 		void init();
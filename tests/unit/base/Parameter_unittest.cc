@@ -1588,7 +1588,7 @@ TEST(TParameter,copy_SPARSE_SCALAR_target_empty)
 	CSparseFeatures<float64_t>* s2=new CSparseFeatures<float64_t>(b);
 
 	SGSparseVector<float64_t> vec1=s1->get_sparse_feature_vector(0);
-	SGSparseVector<float64_t> vec2=s2->get_sparse_feature_vector(0);
+	SGSparseVector<float64_t> vec2=s2->get_sparse_feature_vector(0).clone();
 	void* temp=vec2.features;
 	vec2.features=NULL;
 	vec2.num_feat_entries=0;
@@ -1626,8 +1626,8 @@ TEST(TParameter,copy_SPARSE_SCALAR_source_and_target_empty)
 	CSparseFeatures<float64_t>* s1=new CSparseFeatures<float64_t>(a);
 	CSparseFeatures<float64_t>* s2=new CSparseFeatures<float64_t>(b);
 
-	SGSparseVector<float64_t> vec1=s1->get_sparse_feature_vector(0);
-	SGSparseVector<float64_t> vec2=s2->get_sparse_feature_vector(0);
+	SGSparseVector<float64_t> vec1=s1->get_sparse_feature_vector(0).clone();
+	SGSparseVector<float64_t> vec2=s2->get_sparse_feature_vector(0).clone();
 	void* temp1=vec1.features;
 	void* temp2=vec2.features;
 	vec2.features=NULL;
@@ -1294,4 +1294,237 @@ TEST(LibLinear,simple_set_train_L2R_LR_DUAL_BIAS)
 	SG_UNREF(eval);
 	SG_UNREF(pred);
 }
+
+TEST(LibLinear,parallel_async_atomic_L2R_L1LOSS_SVC_DUAL)
+{
+	CDenseFeatures<float64_t>* train_feats = NULL;
+	CDenseFeatures<float64_t>* test_feats = NULL;
+	CBinaryLabels* ground_truth = NULL;
+
+	generate_data_l2(train_feats, test_feats, ground_truth);
+
+	CLibLinear* ll = new CLibLinear();
+	int32_t num_threads = ll->parallel->get_num_threads();
+	ll->parallel->set_num_threads(4);
+
+	CContingencyTableEvaluation* eval = new CContingencyTableEvaluation();
+
+	ll->set_bias_enabled(true);
+	ll->set_features(train_feats);
+	ll->set_labels(ground_truth);
+	ll->set_liblinear_solver_type(L2R_L1LOSS_SVC_DUAL);
+	ll->set_parallel_mode(LL_ASYNC_ATOMIC);
+	ll->train();
+	CBinaryLabels* pred = ll->apply_binary(test_feats);
+
+	EXPECT_NEAR(eval->evaluate(pred, ground_truth), 1.0, 1e-6);
+
+	ll->parallel->set_num_threads(num_threads);
+	SG_UNREF(ll);
+	SG_UNREF(train_feats);
+	SG_UNREF(test_feats);
+	SG_UNREF(ground_truth);
+	SG_UNREF(eval);
+	SG_UNREF(pred);
+}
+
+TEST(LibLinear,parallel_async_wild_L2R_LR_DUAL)
+{
+	CDenseFeatures<float64_t>* train_feats = NULL;
+	CDenseFeatures<float64_t>* test_feats = NULL;
+	CBinaryLabels* ground_truth = NULL;
+
+	generate_data_l2(train_feats, test_feats, ground_truth);
+
+	CLibLinear* ll = new CLibLinear();
+	int32_t num_threads = ll->parallel->get_num_threads();
+	ll->parallel->set_num_threads(4);
+
+	CContingencyTableEvaluation* eval = new CContingencyTableEvaluation();
+
+	ll->set_bias_enabled(false);
+	ll->set_features(train_feats);
+	ll->set_labels(ground_truth);
+	ll->set_liblinear_solver_type(L2R_LR_DUAL);
+	ll->set_parallel_mode(LL_ASYNC_WILD);
+	ll->train();
+	CBinaryLabels* pred = ll->apply_binary(test_feats);
+
+	EXPECT_NEAR(eval->evaluate(pred, ground_truth), 1.0, 1e-6);
+
+	ll->parallel->set_num_threads(num_threads);
+	SG_UNREF(ll);
+	SG_UNREF(train_feats);
+	SG_UNREF(test_feats);
+	SG_UNREF(ground_truth);
+	SG_UNREF(eval);
+	SG_UNREF(pred);
+}
+
+TEST(LibLinear,parallel_async_atomic_L1R_LR)
+{
+	CDenseFeatures<float64_t>* train_feats = NULL;
+	CDenseFeatures<float64_t>* test_feats = NULL;
+	CBinaryLabels* ground_truth = NULL;
+
+	generate_data_l1(train_feats, test_feats, ground_truth);
+
+	CLibLinear* ll = new CLibLinear();
+	int32_t num_threads = ll->parallel->get_num_threads();
+	ll->parallel->set_num_threads(2);
+
+	CContingencyTableEvaluation* eval = new CContingencyTableEvaluation();
+
+	ll->set_bias_enabled(true);
+	ll->set_features(train_feats);
+	ll->set_labels(ground_truth);
+	ll->set_liblinear_solver_type(L1R_LR);
+	ll->set_parallel_mode(LL_ASYNC_ATOMIC);
+	ll->train();
+	CBinaryLabels* pred = ll->apply_binary(test_feats);
+
+	EXPECT_NEAR(eval->evaluate(pred, ground_truth), 1.0, 1e-6);
+
+	ll->parallel->set_num_threads(num_threads);
+	SG_UNREF(ll);
+	SG_UNREF(train_feats);
+	SG_UNREF(test_feats);
+	SG_UNREF(ground_truth);
+	SG_UNREF(eval);
+	SG_UNREF(pred);
+}
+
+TEST(LibLinear,parallel_deterministic_L1R_L2LOSS_SVC)
+{
+	CDenseFeatures<float64_t>* train_feats = NULL;
+	CDenseFeatures<float64_t>* test_feats = NULL;
+	CBinaryLabels* ground_truth = NULL;
+
+	generate_data_l1(train_feats, test_feats, ground_truth);
+
+	CLibLinear* ll = new CLibLinear();
+	int32_t num_threads = ll->parallel->get_num_threads();
+
+	ll->set_bias_enabled(true);
+	ll->set_features(train_feats);
+	ll->set_labels(ground_truth);
+	ll->set_liblinear_solver_type(L1R_L2LOSS_SVC);
+	ll->set_parallel_mode(LL_DETERMINISTIC);
+	ll->set_parallel_block_size(2);
+
+	ll->parallel->set_num_threads(1);
+	CMath::init_random(17);
+	ll->train();
+	SGVector<float64_t> w_single = ll->get_w().clone();
+	float64_t bias_single = ll->get_bias();
+
+	ll->parallel->set_num_threads(3);
+	CMath::init_random(17);
+	ll->train();
+	SGVector<float64_t> w_multi = ll->get_w();
+
+	for (index_t i = 0; i < w_single.vlen; i++)
+		EXPECT_EQ(w_single[i], w_multi[i]);
+	EXPECT_EQ(bias_single, ll->get_bias());
+
+	CContingencyTableEvaluation* eval = new CContingencyTableEvaluation();
+	CBinaryLabels* pred = ll->apply_binary(test_feats);
+	EXPECT_NEAR(eval->evaluate(pred, ground_truth), 1.0, 1e-6);
+
+	ll->parallel->set_num_threads(num_threads);
+	SG_UNREF(ll);
+	SG_UNREF(train_feats);
+	SG_UNREF(test_feats);
+	SG_UNREF(ground_truth);
+	SG_UNREF(eval);
+	SG_UNREF(pred);
+}
+
+//Primal objective of the L1 regularized solvers on the untransposed data
+float64_t l1r_objective(SGMatrix<float64_t> data, CBinaryLabels* labels,
+		SGVector<float64_t> w, float64_t bias, LIBLINEAR_SOLVER_TYPE type)
+{
+	float64_t obj = CMath::abs(bias);
+	for (index_t i = 0; i < w.vlen; i++)
+		obj += CMath::abs(w[i]);
+
+	for (index_t j = 0; j < data.num_cols; j++)
+	{
+		float64_t out = bias;
+		for (index_t i = 0; i < data.num_rows; i++)
+			out += w[i]*data(i, j);
+		float64_t margin = labels->get_label(j)*out;
+
+		if (type == L1R_LR)
+			obj += CMath::log(1+CMath::exp(-margin));
+		else if (margin < 1)
+			obj += (1-margin)*(1-margin);
+	}
+	return obj;
+}
+
+//Blocks of strongly correlated coordinates make the undamped block steps
+//overshoot, so this compares the damped blocks against the serial solver
+void check_deterministic_convergence(LIBLINEAR_SOLVER_TYPE type)
+{
+	const index_t num_samples = 60;
+	const index_t dim = 20;
+	CMath::init_random(23);
+
+	SGMatrix<float64_t> data(dim, num_samples);
+	SGVector<float64_t> labels(num_samples);
+	for (index_t j = 0; j < num_samples; j++)
+	{
+		float64_t factor = CMath::randn_double();
+		for (index_t i = 0; i < dim; i++)
+			data(i, j) = factor + 0.1*CMath::randn_double();
+		labels[j] = factor + 0.5*CMath::randn_double() > 0 ? 1.0 : -1.0;
+	}
+
+	SGMatrix<float64_t> train_matrix = data.clone();
+	SGMatrix<float64_t>::transpose_matrix(train_matrix.matrix,
+			train_matrix.num_rows, train_matrix.num_cols);
+	CDenseFeatures<float64_t>* train_feats =
+		new CDenseFeatures<float64_t>(train_matrix);
+	CBinaryLabels* ground_truth = new CBinaryLabels(labels);
+
+	CLibLinear* ll = new CLibLinear();
+	int32_t num_threads = ll->parallel->get_num_threads();
+
+	ll->set_bias_enabled(true);
+	ll->set_features(train_feats);
+	ll->set_labels(ground_truth);
+	ll->set_liblinear_solver_type(type);
+	ll->set_epsilon(1e-6);
+	ll->set_max_iterations(100000);
+
+	ll->set_parallel_mode(LL_SEQUENTIAL);
+	CMath::init_random(17);
+	ll->train();
+	float64_t serial = l1r_objective(data, ground_truth, ll->get_w(),
+			ll->get_bias(), type);
+
+	ll->parallel->set_num_threads(3);
+	ll->set_parallel_mode(LL_DETERMINISTIC);
+	ll->set_parallel_block_size(64);
+	CMath::init_random(17);
+	ll->train();
+	float64_t deterministic = l1r_objective(data, ground_truth, ll->get_w(),
+			ll->get_bias(), type);
+
+	EXPECT_NEAR(serial, deterministic, 1e-3*serial);
+
+	ll->parallel->set_num_threads(num_threads);
+	SG_UNREF(ll);
+}
+
+TEST(LibLinear,parallel_deterministic_correlated_L1R_L2LOSS_SVC)
+{
+	check_deterministic_convergence(L1R_L2LOSS_SVC);
+}
+
+TEST(LibLinear,parallel_deterministic_correlated_L1R_LR)
+{
+	check_deterministic_convergence(L1R_LR);
+}
 #endif //HAVE_LAPACK
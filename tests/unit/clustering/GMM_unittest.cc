@@ -0,0 +1,75 @@
+#include <shogun/lib/config.h>
+
+#ifdef HAVE_LAPACK
+#include <shogun/clustering/GMM.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+static CDenseFeatures<float64_t>* two_blobs(int32_t num_per_blob)
+{
+	SGMatrix<float64_t> data(2, 2*num_per_blob);
+	for (int32_t i=0; i<data.num_cols; i++)
+	{
+		float64_t center=i<num_per_blob ? -5 : 5;
+		data(0,i)=CMath::normal_random(center, 1.0);
+		data(1,i)=CMath::normal_random(center, 1.0);
+	}
+
+	return new CDenseFeatures<float64_t>(data);
+}
+
+TEST(GMM, train_em_parallel_equals_serial)
+{
+	CMath::init_random(7);
+	CDenseFeatures<float64_t>* features=two_blobs(600);
+	SG_REF(features);
+
+	float64_t log_likelihood[2];
+	SGVector<float64_t> means[2];
+	for (int32_t run=0; run<2; run++)
+	{
+		CMath::init_random(11);
+		CGMM* gmm=new CGMM(2, FULL);
+		SG_REF(gmm);
+		gmm->parallel->set_num_threads(run==0 ? 1 : 4);
+		gmm->train(features);
+		log_likelihood[run]=gmm->train_em(1e-9, 50);
+		means[run]=gmm->get_nth_mean(0);
+		SG_UNREF(gmm);
+	}
+
+	EXPECT_NEAR(log_likelihood[0], log_likelihood[1], 1e-6);
+	for (int32_t i=0; i<2; i++)
+		EXPECT_NEAR(means[0][i], means[1][i], 1e-8);
+
+	SG_UNREF(features);
+}
+
+TEST(GMM, train_minibatch_em_two_blobs)
+{
+	CMath::init_random(17);
+	CDenseFeatures<float64_t>* features=two_blobs(500);
+	CGMM* gmm=new CGMM(2, DIAG);
+	SG_REF(gmm);
+	gmm->train(features);
+	gmm->train_minibatch_em(100, 20);
+
+	SGVector<float64_t> mean0=gmm->get_nth_mean(0);
+	SGVector<float64_t> mean1=gmm->get_nth_mean(1);
+	float64_t sign=mean0[0]<0 ? 1 : -1;
+	for (int32_t i=0; i<2; i++)
+	{
+		EXPECT_NEAR(mean0[i], -5*sign, 0.3);
+		EXPECT_NEAR(mean1[i], 5*sign, 0.3);
+	}
+
+	SGVector<float64_t> coef=gmm->get_coef();
+	EXPECT_NEAR(coef[0], 0.5, 0.1);
+	EXPECT_NEAR(coef[1], 0.5, 0.1);
+
+	SG_UNREF(gmm);
+}
+#endif /* HAVE_LAPACK */
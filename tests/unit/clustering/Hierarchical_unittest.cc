@@ -0,0 +1,103 @@
+#include <shogun/clustering/Hierarchical.h>
+#include <shogun/distance/EuclideanDistance.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/Math.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+/* points 0, 1, 3 and 7 on a line, with the distance of the second merge
+ * ({0,1} with {3}) for each linkage */
+static void check_linkage(ELinkageType linkage, float64_t second_distance)
+{
+	SGMatrix<float64_t> data(2, 4);
+	data.zero();
+	data(0,1)=1;
+	data(0,2)=3;
+	data(0,3)=7;
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+	CEuclideanDistance* distance=new CEuclideanDistance(features, features);
+	CHierarchical* clustering=new CHierarchical(2, distance, linkage);
+	SG_REF(clustering);
+	clustering->train();
+
+	SGVector<float64_t> merge_distances=clustering->get_merge_distances();
+	SGMatrix<int32_t> cluster_pairs=clustering->get_cluster_pairs();
+
+	EXPECT_NEAR(merge_distances[0], 1, 1e-10);
+	EXPECT_NEAR(merge_distances[1], second_distance, 1e-10);
+	EXPECT_EQ(cluster_pairs(0,0), 0);
+	EXPECT_EQ(cluster_pairs(1,0), 1);
+	EXPECT_EQ(cluster_pairs(0,1), 2);
+	EXPECT_EQ(cluster_pairs(1,1), 4);
+
+	SG_UNREF(clustering);
+}
+
+TEST(Hierarchical, single_linkage)
+{
+	check_linkage(SINGLE_LINKAGE, 2);
+}
+
+TEST(Hierarchical, complete_linkage)
+{
+	check_linkage(COMPLETE_LINKAGE, 3);
+}
+
+TEST(Hierarchical, average_linkage)
+{
+	check_linkage(AVERAGE_LINKAGE, 2.5);
+}
+
+TEST(Hierarchical, ward_linkage)
+{
+	check_linkage(WARD_LINKAGE, CMath::sqrt(4.0/3*6.25));
+}
+
+TEST(Hierarchical, single_linkage_matches_minimum_spanning_tree)
+{
+	CMath::init_random(3);
+	int32_t num=60;
+	SGMatrix<float64_t> data(3, num);
+	for (int32_t i=0; i<data.num_rows*data.num_cols; i++)
+		data.matrix[i]=CMath::random(0.0, 1.0);
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+	CEuclideanDistance* distance=new CEuclideanDistance(features, features);
+	SG_REF(distance);
+	CHierarchical* clustering=new CHierarchical(2, distance);
+	SG_REF(clustering);
+	clustering->parallel->set_num_threads(4);
+	clustering->train();
+
+	/* Prim's algorithm gives the single linkage merge distances */
+	SGVector<float64_t> min_dist(num);
+	SGVector<bool> in_tree(num);
+	min_dist.set_const(CMath::INFTY);
+	in_tree.set_const(false);
+	min_dist[0]=0;
+	SGVector<float64_t> edges(num-1);
+	for (int32_t step=0; step<num; step++)
+	{
+		int32_t next=-1;
+		for (int32_t i=0; i<num; i++)
+		{
+			if (!in_tree[i] && (next<0 || min_dist[i]<min_dist[next]))
+				next=i;
+		}
+		if (step>0)
+			edges[step-1]=min_dist[next];
+		in_tree[next]=true;
+		for (int32_t i=0; i<num; i++)
+			min_dist[i]=CMath::min(min_dist[i], distance->distance(next, i));
+	}
+	CMath::qsort(edges.vector, edges.vlen);
+
+	SGVector<float64_t> merge_distances=clustering->get_merge_distances();
+	for (int32_t i=0; i<merge_distances.vlen; i++)
+		EXPECT_NEAR(merge_distances[i], edges[i], 1e-10);
+
+	SG_UNREF(clustering);
+	SG_UNREF(distance);
+}
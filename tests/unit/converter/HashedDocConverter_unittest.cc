@@ -6,6 +6,8 @@
 #include <shogun/lib/Hash.h>
 #include <shogun/lib/DelimiterTokenizer.h>
 #include <shogun/lib/NGramTokenizer.h>
+#include <shogun/features/SparseFeatures.h>
+#include <shogun/mathematics/Math.h>
 #include <gtest/gtest.h>
 
 using namespace shogun;
@@ -164,3 +166,52 @@ TEST(HashedDocConverterTest, apply_quadratic_test)
 	SG_FREE(hashes);
 	SG_UNREF(converter);
 }
+
+TEST(HashedDocConverterTest, apply_features_multithreaded)
+{
+	int32_t num_docs = 50;
+	int32_t hash_bits = 16;
+
+	/* long documents with many distinct tokens and a few short ones */
+	SGStringList<char> list(num_docs, 0);
+	for (index_t i=0; i<num_docs; i++)
+	{
+		index_t len = i%10==0 ? 1 : CMath::random(1000, 20000);
+		SGString<char> str(len);
+		for (index_t j=0; j<len; j++)
+			str.string[j] = CMath::random(0, 4)==0 ? ' ' : (char) CMath::random('a', 'z');
+
+		list.strings[i] = str;
+		list.max_string_length = CMath::max(list.max_string_length, len);
+	}
+
+	CStringFeatures<char>* s_feats = new CStringFeatures<char>(list, RAWBYTE);
+	CHashedDocConverter* converter = new CHashedDocConverter(hash_bits, true, 2, 1);
+
+	int32_t num_threads = converter->parallel->get_num_threads();
+	converter->parallel->set_num_threads(4);
+	CSparseFeatures<float64_t>* converted =
+		(CSparseFeatures<float64_t>*) converter->apply(s_feats);
+	converter->parallel->set_num_threads(num_threads);
+
+	ASSERT_EQ(converted->get_num_vectors(), num_docs);
+	for (index_t i=0; i<num_docs; i++)
+	{
+		SGSparseVector<float64_t> expected = converter->apply(s_feats->get_feature_vector(i));
+		SGSparseVector<float64_t> vec = converted->get_sparse_feature_vector(i);
+
+		ASSERT_EQ(vec.num_feat_entries, expected.num_feat_entries);
+		for (index_t j=0; j<vec.num_feat_entries; j++)
+		{
+			if (j>0)
+				EXPECT_LT(vec.features[j-1].feat_index, vec.features[j].feat_index);
+			EXPECT_EQ(vec.features[j].feat_index, expected.features[j].feat_index);
+			EXPECT_EQ(vec.features[j].entry, expected.features[j].entry);
+		}
+		converted->free_sparse_feature_vector(i);
+	}
+
+	SG_UNREF(converted);
+	SG_UNREF(converter);
+	SG_UNREF(s_feats);
+}
@@ -10,12 +10,147 @@
 
 #include <gtest/gtest.h>
 
+#include <shogun/distance/ChebyshewMetric.h>
+#include <shogun/distance/CosineDistance.h>
 #include <shogun/distance/CustomMahalanobisDistance.h>
+#include <shogun/distance/EuclideanDistance.h>
+#include <shogun/distance/ManhattanMetric.h>
+#include <shogun/distance/MinkowskiMetric.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/mathematics/Math.h>
 
 using namespace shogun;
 
+static CDenseFeatures<float64_t>* create_random_features(index_t dim, index_t num)
+{
+	SGMatrix<float64_t> feat_mat(dim, num);
+	for (index_t i=0; i<dim*num; i++)
+		feat_mat[i]=CMath::random(-1.0, 1.0);
+
+	return new CDenseFeatures<float64_t>(feat_mat);
+}
+
+static void check_blocked_distance_matrix(CDistance* distance)
+{
+	const float64_t accuracy=1E-10;
+	index_t m=distance->get_num_vec_lhs();
+	index_t n=distance->get_num_vec_rhs();
+
+	// tiles smaller than the matrix and not dividing its size
+	distance->set_block_size(3);
+	SGMatrix<float64_t> distance_matrix=distance->get_distance_matrix();
+	SGMatrix<float32_t> distance_matrix32=distance->get_distance_matrix<float32_t>();
+
+	ASSERT_EQ(distance_matrix.num_rows, m);
+	ASSERT_EQ(distance_matrix.num_cols, n);
+	ASSERT_EQ(distance_matrix32.num_rows, m);
+	ASSERT_EQ(distance_matrix32.num_cols, n);
+
+	for (index_t j=0; j<n; j++)
+	{
+		for (index_t i=0; i<m; i++)
+		{
+			float64_t expected=distance->distance(i, j);
+			EXPECT_NEAR(distance_matrix(i, j), expected, accuracy);
+			EXPECT_NEAR(distance_matrix32(i, j), expected, 1E-5);
+		}
+	}
+}
+
+TEST(Distance, blocked_distance_matrix_asymmetric)
+{
+	CMath::init_random(17);
+	CDenseFeatures<float64_t>* lhs=create_random_features(5, 7);
+	CDenseFeatures<float64_t>* rhs=create_random_features(5, 11);
+
+	CDistance* distances[]={new CEuclideanDistance(lhs, rhs),
+		new CCosineDistance(lhs, rhs), new CManhattanMetric(lhs, rhs),
+		new CChebyshewMetric(lhs, rhs), new CMinkowskiMetric(lhs, rhs, 3.0)};
+
+	for (auto distance : distances)
+	{
+		check_blocked_distance_matrix(distance);
+		SG_UNREF(distance);
+	}
+}
+
+TEST(Distance, blocked_distance_matrix_symmetric)
+{
+	CMath::init_random(17);
+	CDenseFeatures<float64_t>* feats=create_random_features(4, 10);
+
+	CDistance* distances[]={new CEuclideanDistance(feats, feats),
+		new CCosineDistance(feats, feats), new CManhattanMetric(feats, feats),
+		new CChebyshewMetric(feats, feats), new CMinkowskiMetric(feats, feats, 3.0)};
+
+	for (auto distance : distances)
+	{
+		check_blocked_distance_matrix(distance);
+
+		SGMatrix<float64_t> distance_matrix=distance->get_distance_matrix();
+		for (index_t j=0; j<distance_matrix.num_cols; j++)
+		{
+			for (index_t i=0; i<distance_matrix.num_rows; i++)
+				EXPECT_EQ(distance_matrix(i, j), distance_matrix(j, i));
+		}
+
+		SG_UNREF(distance);
+	}
+}
+
+TEST(Distance, blocked_distance_matrix_subset)
+{
+	CMath::init_random(17);
+	CDenseFeatures<float64_t>* lhs=create_random_features(3, 9);
+	CDenseFeatures<float64_t>* rhs=create_random_features(3, 8);
+
+	SGVector<index_t> subset(5);
+	subset[0]=8;
+	subset[1]=1;
+	subset[2]=4;
+	subset[3]=4;
+	subset[4]=0;
+	lhs->add_subset(subset);
+	SG_REF(lhs);
+	SG_REF(rhs);
+
+	CEuclideanDistance* euclidean=new CEuclideanDistance(lhs, rhs);
+	check_blocked_distance_matrix(euclidean);
+	SG_UNREF(euclidean);
+
+	CManhattanMetric* manhattan=new CManhattanMetric(lhs, rhs);
+	check_blocked_distance_matrix(manhattan);
+	SG_UNREF(manhattan);
+
+	SG_UNREF(lhs);
+	SG_UNREF(rhs);
+}
+
+TEST(Distance, blocked_precompute_matrix)
+{
+	CMath::init_random(17);
+	CDenseFeatures<float64_t>* feats=create_random_features(4, 9);
+
+	CEuclideanDistance* euclidean=new CEuclideanDistance(feats, feats);
+	SGMatrix<float64_t> expected=euclidean->get_distance_matrix();
+
+	euclidean->set_block_size(4);
+	euclidean->set_precompute_matrix(true);
+	SGMatrix<float64_t> precomputed=euclidean->get_distance_matrix();
+
+	for (index_t j=0; j<expected.num_cols; j++)
+	{
+		for (index_t i=0; i<expected.num_rows; i++)
+		{
+			EXPECT_NEAR(precomputed(i, j), expected(i, j), 1E-5);
+			EXPECT_NEAR(euclidean->distance(i, j), expected(i, j), 1E-5);
+		}
+	}
+
+	SG_UNREF(euclidean);
+}
+
 TEST(Distance, custom_mahalanobis)
 {
 	// Create a couple of simple 2D features
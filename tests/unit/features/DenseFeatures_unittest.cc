@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <shogun/base/some.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/Math.h>
 #include <gtest/gtest.h>
 
 namespace shogun
@@ -249,3 +250,81 @@ TEST(DenseFeaturesTest, copy_feature_matrix)
 			EXPECT_NEAR(copy(i, j+offset), data(i, inds[j]), 1E-15);
 	}
 }
+
+TEST(DenseFeaturesTest, float32_dense_dot)
+{
+	index_t dim=7;
+	index_t n=6;
+
+	SGMatrix<float32_t> data(dim, n);
+	for (index_t i=0; i<data.num_rows*data.num_cols; ++i)
+		data[i]=0.25*i-3;
+
+	auto features=some<CDenseFeatures<float32_t>>(data);
+
+	SGVector<float32_t> w(dim);
+	SGVector<float64_t> w64(dim);
+	for (index_t i=0; i<dim; ++i)
+	{
+		w[i]=0.5*i-1;
+		w64[i]=w[i];
+	}
+
+	SGVector<float64_t> out(n);
+	features->dense_dot_range_float32(out.vector, 0, n, NULL, w.vector, dim, 1.5);
+	for (index_t j=0; j<n; ++j)
+	{
+		float64_t expected=features->dense_dot(j, w64.vector, dim);
+		EXPECT_NEAR(expected, features->dense_dot_float32(j, w.vector, dim), 1E-5);
+		EXPECT_NEAR(expected+1.5, out[j], 1E-5);
+	}
+
+	SGVector<float32_t> acc(dim);
+	acc.zero();
+	features->add_to_dense_vec_float32(2.0, 1, acc.vector, dim);
+	features->add_to_dense_vec_float32(-1.0, 2, acc.vector, dim, true);
+	for (index_t i=0; i<dim; ++i)
+		EXPECT_NEAR(2.0*data(i, 1)-CMath::abs(data(i, 2)), acc[i], 1E-5);
+}
+
+TEST(DenseFeaturesTest, float32_dot_block)
+{
+	index_t dim=5;
+	index_t n=8;
+
+	SGMatrix<float32_t> data(dim, n);
+	for (index_t i=0; i<data.num_rows*data.num_cols; ++i)
+		data[i]=CMath::sin(i);
+
+	auto features=some<CDenseFeatures<float32_t>>(data);
+
+	SGMatrix<float64_t> block(3, 4);
+	features->dot_block(block, 2, 5, features, 4, 8);
+	for (index_t j=0; j<block.num_cols; ++j)
+	{
+		for (index_t i=0; i<block.num_rows; ++i)
+		{
+			float64_t expected=0;
+			for (index_t k=0; k<dim; ++k)
+				expected+=data(k, i+2)*data(k, j+4);
+			EXPECT_NEAR(expected, block(i, j), 1E-5);
+		}
+	}
+
+	/* subsets take the pairwise path */
+	SGVector<index_t> inds(4);
+	inds.range_fill();
+	features->add_subset(inds);
+	SGMatrix<float64_t> subset_block(2, 2);
+	features->dot_block(subset_block, 0, 2, features, 2, 4);
+	for (index_t j=0; j<subset_block.num_cols; ++j)
+	{
+		for (index_t i=0; i<subset_block.num_rows; ++i)
+		{
+			float64_t expected=0;
+			for (index_t k=0; k<dim; ++k)
+				expected+=data(k, i)*data(k, j+2);
+			EXPECT_NEAR(expected, subset_block(i, j), 1E-5);
+		}
+	}
+}
@@ -0,0 +1,171 @@
+#include <shogun/features/QuantizedDenseFeatures.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/base/some.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+namespace
+{
+	SGMatrix<float64_t> quantization_test_matrix()
+	{
+		SGMatrix<float64_t> data(6, 9);
+		for (index_t j=0; j<data.num_cols; ++j)
+		{
+			for (index_t i=0; i<data.num_rows; ++i)
+				data(i, j)=CMath::sin(i+3*j)*(i+1)+0.5*j;
+		}
+		return data;
+	}
+
+	void check_dot_products(CQuantizedDenseFeatures* quantized)
+	{
+		auto dequantized=wrap(quantized->dequantize());
+		const index_t dim=quantized->get_dim_feature_space();
+		const index_t num=quantized->get_num_vectors();
+
+		SGVector<float64_t> w(dim);
+		for (index_t i=0; i<dim; ++i)
+			w[i]=0.3*i-0.7;
+
+		SGVector<float64_t> out(num);
+		quantized->dense_dot_range(out.vector, 0, num, NULL, w.vector, dim, 2.0);
+
+		for (index_t j=0; j<num; ++j)
+		{
+			float64_t expected=dequantized->dense_dot(j, w.vector, dim);
+			EXPECT_NEAR(expected, quantized->dense_dot(j, w.vector, dim), 1E-10);
+			EXPECT_NEAR(expected+2.0, out[j], 1E-10);
+
+			for (index_t k=0; k<num; ++k)
+			{
+				EXPECT_NEAR(dequantized->dot(j, dequantized, k),
+					quantized->dot(j, quantized, k), 1E-10);
+			}
+		}
+
+		SGVector<float64_t> acc(dim);
+		SGVector<float64_t> expected_acc(dim);
+		acc.zero();
+		expected_acc.zero();
+		quantized->add_to_dense_vec(1.5, 2, acc.vector, dim, true);
+		dequantized->add_to_dense_vec(1.5, 2, expected_acc.vector, dim, true);
+		for (index_t i=0; i<dim; ++i)
+			EXPECT_NEAR(expected_acc[i], acc[i], 1E-10);
+	}
+}
+
+TEST(QuantizedDenseFeaturesTest, symmetric_per_row)
+{
+	SGMatrix<float64_t> data=quantization_test_matrix();
+	auto features=some<CDenseFeatures<float64_t>>(data);
+	auto quantized=some<CQuantizedDenseFeatures>(features, QS_PER_ROW, true);
+
+	ASSERT_EQ(data.num_cols, quantized->get_num_vectors());
+	ASSERT_EQ(data.num_rows, quantized->get_dim_feature_space());
+
+	SGVector<float32_t> scales=quantized->get_scales();
+	SGVector<float32_t> offsets=quantized->get_offsets();
+	SGVector<float64_t> errors=quantized->get_feature_errors();
+	ASSERT_EQ(data.num_rows, scales.vlen);
+
+	for (index_t i=0; i<data.num_rows; ++i)
+	{
+		EXPECT_EQ(0, offsets[i]);
+		EXPECT_LE(errors[i], 0.5*scales[i]*(1+1E-6));
+
+		float64_t max_error=0;
+		for (index_t j=0; j<data.num_cols; ++j)
+		{
+			max_error=CMath::max(max_error,
+				CMath::abs(data(i, j)-quantized->get_feature_vector(j)[i]));
+		}
+		EXPECT_NEAR(max_error, errors[i], 1E-12);
+	}
+
+	check_dot_products(quantized);
+}
+
+TEST(QuantizedDenseFeaturesTest, asymmetric_per_column)
+{
+	SGMatrix<float64_t> data=quantization_test_matrix();
+	auto features=some<CDenseFeatures<float64_t>>(data);
+	auto quantized=some<CQuantizedDenseFeatures>(features, QS_PER_COLUMN, false);
+
+	SGVector<float32_t> scales=quantized->get_scales();
+	ASSERT_EQ(data.num_cols, scales.vlen);
+
+	SGMatrix<int8_t> q=quantized->get_quantized_matrix();
+	for (index_t j=0; j<data.num_cols; ++j)
+	{
+		/* the full int8 range is used */
+		int8_t lo=127;
+		int8_t hi=-128;
+		for (index_t i=0; i<data.num_rows; ++i)
+		{
+			lo=CMath::min(lo, q(i, j));
+			hi=CMath::max(hi, q(i, j));
+			EXPECT_NEAR(data(i, j), quantized->get_feature_vector(j)[i],
+				0.5*scales[j]*(1+1E-6));
+		}
+		EXPECT_EQ(-128, lo);
+		EXPECT_EQ(127, hi);
+	}
+
+	check_dot_products(quantized);
+}
+
+TEST(QuantizedDenseFeaturesTest, subset_and_iterator)
+{
+	SGMatrix<float64_t> data=quantization_test_matrix();
+	auto features=some<CDenseFeatures<float64_t>>(data);
+	auto quantized=some<CQuantizedDenseFeatures>(features, QS_PER_COLUMN, true);
+
+	SGVector<float64_t> last=quantized->get_feature_vector(data.num_cols-1);
+
+	SGVector<index_t> inds(2);
+	inds[0]=data.num_cols-1;
+	inds[1]=0;
+	quantized->add_subset(inds);
+	ASSERT_EQ(2, quantized->get_num_vectors());
+
+	void* it=quantized->get_feature_iterator(0);
+	int32_t index;
+	float64_t value;
+	index_t count=0;
+	while (quantized->get_next_feature(index, value, it))
+	{
+		EXPECT_EQ(count, index);
+		EXPECT_NEAR(last[index], value, 1E-12);
+		count++;
+	}
+	quantized->free_feature_iterator(it);
+	EXPECT_EQ(data.num_rows, count);
+
+	SGVector<float64_t> w(data.num_rows);
+	w.set_const(1.0);
+	EXPECT_NEAR(SGVector<float64_t>::sum(last), quantized->dense_dot(0, w.vector, w.vlen), 1E-10);
+}
+
+TEST(QuantizedDenseFeaturesTest, dot_mixed_scale_types)
+{
+	SGMatrix<float64_t> data=quantization_test_matrix();
+	auto features=some<CDenseFeatures<float64_t>>(data);
+	auto per_row=some<CQuantizedDenseFeatures>(features, QS_PER_ROW, false);
+	auto per_column=some<CQuantizedDenseFeatures>(features, QS_PER_COLUMN, true);
+	EXPECT_EQ(F_CHAR, per_row->get_feature_type());
+
+	check_dot_products(per_row);
+
+	auto row_dense=wrap(per_row->dequantize());
+	auto column_dense=wrap(per_column->dequantize());
+	for (index_t j=0; j<data.num_cols; ++j)
+	{
+		for (index_t k=0; k<data.num_cols; ++k)
+		{
+			EXPECT_NEAR(row_dense->dot(j, column_dense, k),
+				per_row->dot(j, per_column, k), 1E-10);
+		}
+	}
+}
@@ -42,6 +42,35 @@ TEST(SparseFeaturesTest,serialization)
 	SG_UNREF(sparse_features_loaded);
 }
 
+TEST(SparseFeaturesTest,serialization_into_compressed)
+{
+	SGMatrix<int32_t> data(3, 20);
+	for (index_t i=0; i<20*3; ++i)
+		data.matrix[i]=i%2 ? i : 0;
+
+	CSparseFeatures<int32_t>* sparse_features=new CSparseFeatures<int32_t>(data);
+
+	CSerializableAsciiFile* outfile = new CSerializableAsciiFile("sparseFeaturesCompressed.txt", 'w');
+	sparse_features->save_serializable(outfile);
+	SG_UNREF(outfile);
+
+	/* the vectors of the target are views into one block of entries */
+	SGMatrix<int32_t> other(4, 5);
+	other.set_const(1);
+	CSparseFeatures<int32_t>* sparse_features_loaded = new CSparseFeatures<int32_t>(other);
+	EXPECT_TRUE(sparse_features_loaded->get_sparse_feature_matrix().is_compressed());
+
+	CSerializableAsciiFile* infile= new CSerializableAsciiFile("sparseFeaturesCompressed.txt", 'r');
+	EXPECT_TRUE(sparse_features_loaded->load_serializable(infile));
+	SG_UNREF(infile);
+
+	SGMatrix<int32_t> data_loaded = sparse_features_loaded->get_full_feature_matrix();
+	EXPECT_TRUE(data_loaded.equals(data));
+
+	SG_UNREF(sparse_features);
+	SG_UNREF(sparse_features_loaded);
+}
+
 TEST(SparseFeaturesTest,constructor_from_dense)
 {
 	SGMatrix<int32_t> data(2, 3);
@@ -392,3 +421,36 @@ TEST(SparseFeaturesTest,subset_get_full_feature_vector_smaller)
 
 	SG_UNREF(features);
 }
+
+TEST(SparseFeaturesTest,copy_subset_compressed)
+{
+	SGMatrix<int32_t> data(3, 4);
+	for (index_t i=0; i<data.num_rows*data.num_cols; ++i)
+		data.matrix[i]=i%2 ? i : 0;
+
+	CSparseFeatures<int32_t>* features=new CSparseFeatures<int32_t>(data);
+	SGVector<index_t> subset_idx(3);
+	subset_idx[0]=3;
+	subset_idx[1]=1;
+	subset_idx[2]=2;
+	features->add_subset(subset_idx);
+
+	SGVector<index_t> indices(2);
+	indices[0]=2;
+	indices[1]=0;
+	CSparseFeatures<int32_t>* copy=
+		(CSparseFeatures<int32_t>*) features->copy_subset(indices);
+	SG_UNREF(features);
+
+	EXPECT_EQ(copy->get_num_vectors(), indices.vlen);
+	EXPECT_TRUE(copy->get_sparse_feature_matrix().is_compressed());
+
+	for (index_t i=0; i<indices.vlen; ++i)
+	{
+		SGVector<int32_t> vec=copy->get_full_feature_vector(i);
+		for (index_t j=0; j<vec.vlen; ++j)
+			EXPECT_EQ(vec[j], data(j,subset_idx[indices[i]]));
+	}
+
+	SG_UNREF(copy);
+}
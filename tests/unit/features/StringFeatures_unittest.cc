@@ -11,6 +11,8 @@
 #include <shogun/features/StringFeatures.h>
 #include <shogun/lib/SGStringList.h>
 #include <gtest/gtest.h>
+#include <cstdio>
+#include "../utils/Utils.h"
 
 using namespace shogun;
 
@@ -135,3 +137,219 @@ TEST(StringFeaturesTest,clone)
 	SG_UNREF(f);
 	SG_UNREF(f_clone);
 }
+
+SGStringList<char> generateDNAData(index_t num_strings=10, index_t max_string_length=20, index_t min_string_length=10)
+{
+	const char dna[]="ACGT";
+	SGStringList<char> strings(num_strings, max_string_length);
+
+	for (index_t i=0; i<num_strings; ++i)
+	{
+		index_t len=CMath::random(min_string_length, max_string_length);
+		SGString<char> current(len);
+		for (index_t j=0; j<len; ++j)
+			current.string[j]=dna[CMath::random(0, 3)];
+
+		strings.strings[i]=current;
+	}
+	return strings;
+}
+
+void check_strings_equal(CStringFeatures<char>* f, CStringFeatures<char>* ref)
+{
+	ASSERT_EQ(f->get_num_vectors(), ref->get_num_vectors());
+	for (index_t i=0; i<f->get_num_vectors(); ++i)
+	{
+		SGVector<char> vec=f->get_feature_vector(i);
+		SGVector<char> ref_vec=ref->get_feature_vector(i);
+		ASSERT_EQ(vec.vlen, ref_vec.vlen);
+		EXPECT_EQ(f->get_vector_length(i), vec.vlen);
+
+		for (index_t j=0; j<vec.vlen; ++j)
+			EXPECT_EQ(vec.vector[j], ref_vec.vector[j]);
+	}
+}
+
+TEST(StringFeaturesTest,pack_unpack)
+{
+	CStringFeatures<char>* ref=new CStringFeatures<char>(generateDNAData(), DNA);
+	CStringFeatures<char>* f=(CStringFeatures<char>*) ref->duplicate();
+
+	EXPECT_TRUE(f->pack());
+	EXPECT_EQ(f->get_packed_bits(), 2);
+	check_strings_equal(f, ref);
+
+	f->unpack();
+	EXPECT_EQ(f->get_packed_bits(), 0);
+	check_strings_equal(f, ref);
+
+	SG_UNREF(f);
+	SG_UNREF(ref);
+}
+
+TEST(StringFeaturesTest,pack_invalid_symbols)
+{
+	/* alphabet too large */
+	CStringFeatures<char>* ref=new CStringFeatures<char>(generateRandomData(), ALPHANUM);
+	CStringFeatures<char>* f=(CStringFeatures<char>*) ref->duplicate();
+	EXPECT_FALSE(f->pack());
+	check_strings_equal(f, ref);
+	SG_UNREF(f);
+	SG_UNREF(ref);
+
+	/* lower case symbols do not survive remapping */
+	ref=new CStringFeatures<char>(generateDNAData(), DNA);
+	SGVector<char> invalid(3);
+	invalid[0]='A';
+	invalid[1]='a';
+	invalid[2]='C';
+	ref->set_feature_vector(invalid, 3);
+	f=(CStringFeatures<char>*) ref->duplicate();
+	EXPECT_FALSE(f->pack());
+	EXPECT_EQ(f->get_packed_bits(), 0);
+	check_strings_equal(f, ref);
+	SG_UNREF(f);
+	SG_UNREF(ref);
+}
+
+TEST(StringFeaturesTest,packed_copy_subset)
+{
+	CStringFeatures<char>* ref=new CStringFeatures<char>(generateDNAData(), DNA);
+	CStringFeatures<char>* f=(CStringFeatures<char>*) ref->duplicate();
+	ASSERT_TRUE(f->pack());
+
+	SGVector<index_t> indices(4);
+	indices.range_fill(2);
+	CStringFeatures<char>* subset_copy=(CStringFeatures<char>*) f->copy_subset(indices);
+
+	for (index_t i=0; i<indices.vlen; ++i)
+	{
+		SGVector<char> vec=subset_copy->get_feature_vector(i);
+		SGVector<char> ref_vec=ref->get_feature_vector(indices[i]);
+		ASSERT_EQ(vec.vlen, ref_vec.vlen);
+		for (index_t j=0; j<vec.vlen; ++j)
+			EXPECT_EQ(vec.vector[j], ref_vec.vector[j]);
+	}
+
+	CStringFeatures<char>* dup=(CStringFeatures<char>*) f->duplicate();
+	EXPECT_EQ(dup->get_packed_bits(), 2);
+	check_strings_equal(dup, ref);
+
+	SG_UNREF(dup);
+	SG_UNREF(subset_copy);
+	SG_UNREF(f);
+	SG_UNREF(ref);
+}
+
+TEST(StringFeaturesTest,contiguous_file)
+{
+	char fname[]="StringFeatures_contiguous.XXXXXX";
+	generate_temp_filename(fname);
+
+	CStringFeatures<char>* ref=new CStringFeatures<char>(generateDNAData(), DNA);
+
+	for (index_t packed=0; packed<2; ++packed)
+	{
+		CStringFeatures<char>* f=(CStringFeatures<char>*) ref->duplicate();
+		if (packed)
+			ASSERT_TRUE(f->pack());
+		ASSERT_TRUE(f->save_contiguous_file(fname));
+		SG_UNREF(f);
+
+		CStringFeatures<char>* loaded=new CStringFeatures<char>(DNA);
+		ASSERT_TRUE(loaded->load_contiguous_file(fname));
+		EXPECT_EQ(loaded->get_packed_bits(), packed ? 2 : 0);
+		EXPECT_EQ(loaded->get_max_vector_length(), ref->get_max_vector_length());
+		check_strings_equal(loaded, ref);
+
+		/* modifying mapped strings copies them to memory */
+		SGVector<char> vec(3);
+		vec.set_const('G');
+		loaded->set_feature_vector(vec, 0);
+		EXPECT_EQ(loaded->get_packed_bits(), 0);
+		EXPECT_EQ(loaded->get_vector_length(0), 3);
+		EXPECT_EQ(loaded->get_feature(0, 2), 'G');
+		SG_UNREF(loaded);
+	}
+
+	SG_UNREF(ref);
+	std::remove(fname);
+}
+
+TEST(StringFeaturesTest,mapped_feature_vector_copy)
+{
+	char fname[]="StringFeatures_mapped.XXXXXX";
+	generate_temp_filename(fname);
+
+	CStringFeatures<char>* ref=new CStringFeatures<char>(generateDNAData(), DNA);
+	ASSERT_TRUE(ref->save_contiguous_file(fname));
+
+	CStringFeatures<char>* loaded=new CStringFeatures<char>(DNA);
+	ASSERT_TRUE(loaded->load_contiguous_file(fname));
+
+	int32_t len;
+	bool dofree;
+	char* vec=loaded->get_feature_vector(0, len, dofree);
+	EXPECT_TRUE(dofree);
+	ASSERT_GT(len, 0);
+
+	/* the copy is writable and does not alias the mapped file */
+	char first=vec[0];
+	vec[0]=first=='A' ? 'C' : 'A';
+	EXPECT_EQ(loaded->get_feature(0, 0), first);
+	loaded->free_feature_vector(vec, 0, dofree);
+
+	SG_UNREF(loaded);
+	SG_UNREF(ref);
+	std::remove(fname);
+}
+
+TEST(StringFeaturesTest,cleanup_packed_feature_vector)
+{
+	CStringFeatures<char>* ref=new CStringFeatures<char>(generateDNAData(), DNA);
+	CStringFeatures<char>* f=(CStringFeatures<char>*) ref->duplicate();
+	ASSERT_TRUE(f->pack());
+
+	f->cleanup_feature_vector(0);
+	EXPECT_EQ(f->get_packed_bits(), 2);
+	EXPECT_EQ(f->get_vector_length(0), 0);
+
+	for (index_t i=1; i<f->get_num_vectors(); ++i)
+	{
+		SGVector<char> vec=f->get_feature_vector(i);
+		SGVector<char> ref_vec=ref->get_feature_vector(i);
+		ASSERT_EQ(vec.vlen, ref_vec.vlen);
+		for (index_t j=0; j<vec.vlen; ++j)
+			EXPECT_EQ(vec.vector[j], ref_vec.vector[j]);
+	}
+
+	SG_UNREF(f);
+	SG_UNREF(ref);
+}
+
+TEST(StringFeaturesTest,obtain_from_packed_char)
+{
+	CStringFeatures<char>* f=new CStringFeatures<char>(generateDNAData(10, 20, 20), DNA);
+	CStringFeatures<char>* f_packed=(CStringFeatures<char>*) f->duplicate();
+	ASSERT_TRUE(f_packed->pack());
+
+	CStringFeatures<uint16_t>* words=new CStringFeatures<uint16_t>(DNA);
+	CStringFeatures<uint16_t>* words_packed=new CStringFeatures<uint16_t>(DNA);
+	ASSERT_TRUE(words->obtain_from_char(f, 2, 3, 0, false));
+	ASSERT_TRUE(words_packed->obtain_from_char(f_packed, 2, 3, 0, false));
+
+	ASSERT_EQ(words->get_num_vectors(), words_packed->get_num_vectors());
+	for (index_t i=0; i<words->get_num_vectors(); ++i)
+	{
+		SGVector<uint16_t> a=words->get_feature_vector(i);
+		SGVector<uint16_t> b=words_packed->get_feature_vector(i);
+		ASSERT_EQ(a.vlen, b.vlen);
+		for (index_t j=0; j<a.vlen; ++j)
+			EXPECT_EQ(a[j], b[j]);
+	}
+
+	SG_UNREF(words_packed);
+	SG_UNREF(words);
+	SG_UNREF(f_packed);
+	SG_UNREF(f);
+}
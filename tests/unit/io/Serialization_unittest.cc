@@ -10,6 +10,7 @@
 #include <shogun/lib/common.h>
 #include <shogun/base/Parameter.h>
 #include <shogun/io/SerializableAsciiFile.h>
+#include <shogun/io/SerializableBinaryFile.h>
 #include <shogun/io/SerializableJsonFile.h>
 #include <shogun/io/SerializableXmlFile.h>
 #include <shogun/io/SerializableHdf5File.h>
@@ -17,6 +18,8 @@
 
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SparseFeatures.h>
 
 using namespace shogun;
 
@@ -563,6 +566,207 @@ TEST(Serialization, Ascii_matrix_equal_COMPLEX128)
 }
 
 #ifdef HAVE_JSON
+TEST(Serialization, Binary_scalar_equal_FLOAT64)
+{
+	float64_t a=1.7126587125;
+	float64_t b=0.0;
+
+	TSGDataType type(CT_SCALAR, ST_NONE, PT_FLOAT64);
+	TParameter* param1=new TParameter(&type, &a, "param", "");
+	TParameter* param2=new TParameter(&type, &b, "param", "");
+
+	const char* filename="float64_param.bin";
+	// save parameter to a binary file
+	CSerializableBinaryFile *file=new CSerializableBinaryFile(filename, 'w');
+	param1->save(file);
+	file->close();
+	SG_UNREF(file);
+
+	// load parameter from a binary file
+	file=new CSerializableBinaryFile(filename, 'r');
+	param2->load(file);
+	file->close();
+	SG_UNREF(file);
+
+	// check for equality
+	float64_t accuracy=0.0;
+	EXPECT_TRUE(param1->equals(param2, accuracy));
+
+	delete param1;
+	delete param2;
+}
+
+TEST(Serialization, Binary_vector_equal_FLOAT64)
+{
+	SGVector<float64_t> a(5);
+	SGVector<float64_t> b(5);
+
+	a.range_fill(0.1);
+	b.zero();
+
+	TSGDataType type(CT_SGVECTOR, ST_NONE, PT_FLOAT64, &a.vlen);
+	TParameter* param1=new TParameter(&type, &a.vector, "param", "");
+	TParameter* param2=new TParameter(&type, &b.vector, "param", "");
+
+	const char* filename="float64_sgvec_param.bin";
+	// save parameter to a binary file
+	CSerializableBinaryFile *file=new CSerializableBinaryFile(filename, 'w');
+	param1->save(file);
+	file->close();
+	SG_UNREF(file);
+
+	// load parameter from a binary file
+	file=new CSerializableBinaryFile(filename, 'r');
+	param2->load(file);
+	file->close();
+	SG_UNREF(file);
+
+	// check for equality
+	float64_t accuracy=0.0;
+	EXPECT_TRUE(param1->equals(param2, accuracy));
+
+	delete param1;
+	delete param2;
+}
+
+TEST(Serialization, Binary_matrix_equal_COMPLEX128)
+{
+	SGMatrix<complex128_t> a(3, 2);
+	SGMatrix<complex128_t> b(3, 2);
+
+	a.set_const(complex128_t(1.14263158, 2.435754));
+	b.zero();
+
+	TSGDataType type(CT_SGMATRIX, ST_NONE, PT_COMPLEX128, &a.num_rows, &a.num_cols);
+	TParameter* param1=new TParameter(&type, &a.matrix, "param", "");
+	TParameter* param2=new TParameter(&type, &b.matrix, "param", "");
+
+	const char* filename="complex128_sgmat_param.bin";
+	// save parameter to a binary file
+	CSerializableBinaryFile *file=new CSerializableBinaryFile(filename, 'w');
+	param1->save(file);
+	file->close();
+	SG_UNREF(file);
+
+	// load parameter from a binary file
+	file=new CSerializableBinaryFile(filename, 'r');
+	param2->load(file);
+	file->close();
+	SG_UNREF(file);
+
+	// check for equality
+	float64_t accuracy=0.0;
+	EXPECT_TRUE(param1->equals(param2, accuracy));
+
+	delete param1;
+	delete param2;
+}
+
+TEST(Serialization, Binary_dense_features)
+{
+	SGMatrix<float64_t> data(3, 7);
+	for (index_t i=0; i<data.num_rows*data.num_cols; i++)
+		data[i]=i-2.5;
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+
+	const char* filename="dense_features.bin";
+	CSerializableBinaryFile *file=new CSerializableBinaryFile(filename, 'w');
+	EXPECT_TRUE(features->save_serializable(file));
+	SG_UNREF(file);
+
+	CDenseFeatures<float64_t>* loaded=new CDenseFeatures<float64_t>();
+	file=new CSerializableBinaryFile(filename, 'r');
+	EXPECT_TRUE(loaded->load_serializable(file));
+	file->close();
+	SG_UNREF(file);
+
+	EXPECT_TRUE(features->equals(loaded, 0.0));
+
+	SG_UNREF(features);
+	SG_UNREF(loaded);
+}
+
+TEST(Serialization, Binary_sparse_features)
+{
+	SGMatrix<float64_t> data(4, 5);
+	data.zero();
+	data(0, 0)=1.5;
+	data(3, 0)=-2;
+	data(2, 2)=3.25;
+	data(1, 4)=7;
+	CSparseFeatures<float64_t>* features=new CSparseFeatures<float64_t>(data);
+
+	const char* filename="sparse_features.bin";
+	CSerializableBinaryFile *file=new CSerializableBinaryFile(filename, 'w');
+	EXPECT_TRUE(features->save_serializable(file));
+	SG_UNREF(file);
+
+	CSparseFeatures<float64_t>* loaded=new CSparseFeatures<float64_t>();
+	file=new CSerializableBinaryFile(filename, 'r');
+	EXPECT_TRUE(loaded->load_serializable(file));
+	file->close();
+	SG_UNREF(file);
+
+	SGMatrix<float64_t> loaded_data=loaded->get_full_feature_matrix();
+	ASSERT_EQ(loaded_data.num_rows, data.num_rows);
+	ASSERT_EQ(loaded_data.num_cols, data.num_cols);
+	for (index_t i=0; i<data.num_rows*data.num_cols; i++)
+		EXPECT_EQ(loaded_data[i], data[i]);
+
+	SG_UNREF(features);
+	SG_UNREF(loaded);
+}
+
+TEST(Serialization, Binary_skip_unknown_parameter)
+{
+	SGMatrix<float64_t> data(2, 3);
+	for (index_t i=0; i<data.num_rows*data.num_cols; i++)
+		data[i]=0.5*i;
+	CDenseFeatures<float64_t>* first=new CDenseFeatures<float64_t>(data);
+	CDenseFeatures<float64_t>* second=new CDenseFeatures<float64_t>(
+		SGMatrix<float64_t>(data.matrix, 3, 2, false));
+	SG_REF(first);
+	SG_REF(second);
+
+	// the saved object has a parameter the loading object does not know
+	SGVector<float64_t> unknown(10);
+	unknown.range_fill();
+	first->m_parameters->add(&unknown, "unknown", "");
+
+	Parameter* saved=new Parameter();
+	saved->add((CSGObject**) &first, "first", "");
+	saved->add((CSGObject**) &second, "second", "");
+
+	const char* filename="skip_unknown.bin";
+	CSerializableBinaryFile *file=new CSerializableBinaryFile(filename, 'w');
+	EXPECT_TRUE(saved->save(file));
+	file->close();
+	SG_UNREF(file);
+
+	CDenseFeatures<float64_t>* first_loaded=NULL;
+	CDenseFeatures<float64_t>* second_loaded=NULL;
+	Parameter* loaded=new Parameter();
+	loaded->add((CSGObject**) &first_loaded, "first", "");
+	loaded->add((CSGObject**) &second_loaded, "second", "");
+
+	file=new CSerializableBinaryFile(filename, 'r');
+	EXPECT_TRUE(loaded->load(file));
+	file->close();
+	SG_UNREF(file);
+
+	ASSERT_TRUE(first_loaded!=NULL);
+	ASSERT_TRUE(second_loaded!=NULL);
+	EXPECT_TRUE(first_loaded->get_feature_matrix().equals(first->get_feature_matrix()));
+	EXPECT_TRUE(second_loaded->get_feature_matrix().equals(second->get_feature_matrix()));
+
+	delete saved;
+	delete loaded;
+	SG_UNREF(first);
+	SG_UNREF(second);
+	SG_UNREF(first_loaded);
+	SG_UNREF(second_loaded);
+}
+
 TEST(Serialization, Json_scalar_equal_BOOL)
 {
 	bool a=true;
@@ -1,5 +1,8 @@
 #include <shogun/kernel/CombinedKernel.h>
 #include <shogun/kernel/GaussianKernel.h>
+#include <shogun/features/CombinedFeatures.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/Math.h>
 #include <shogun/io/SerializableAsciiFile.h>
 #include <gtest/gtest.h>
 
@@ -217,3 +220,52 @@ TEST(CombinedKernelTest,combination)
 	SG_UNREF(combined_list);
 	SG_UNREF(kernel_list);
 }
+
+TEST(CombinedKernelTest,subkernel_quadratic_forms)
+{
+	index_t num_vectors=150;
+	SGMatrix<float64_t> data(2, num_vectors);
+	CMath::init_random(3);
+	for (index_t i=0; i<data.num_rows*data.num_cols; i++)
+		data.matrix[i]=CMath::random(-1.0, 1.0);
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+	CCombinedFeatures* combined_features=new CCombinedFeatures();
+	CCombinedKernel* combined=new CCombinedKernel();
+	float64_t widths[]={0.5, 1.0, 2.0};
+	for (index_t k=0; k<3; k++)
+	{
+		combined_features->append_feature_obj(features);
+		combined->append_kernel(new CGaussianKernel(10, widths[k]));
+	}
+	combined->init(combined_features, combined_features);
+	SG_REF(combined);
+
+	SGVector<int32_t> idx(100);
+	SGVector<float64_t> coef(idx.vlen);
+	for (index_t i=0; i<idx.vlen; i++)
+	{
+		idx[i]=(7*i)%num_vectors;
+		coef[i]=CMath::random(-1.0, 1.0);
+	}
+
+	SGVector<float64_t> forms=combined->compute_subkernel_quadratic_forms(idx, coef);
+
+	for (index_t k=0; k<3; k++)
+	{
+		SGVector<float64_t> weights(3);
+		weights.zero();
+		weights[k]=1.0;
+		combined->set_subkernel_weights(weights);
+
+		float64_t expected=0;
+		for (index_t i=0; i<idx.vlen; i++)
+		{
+			for (index_t j=0; j<idx.vlen; j++)
+				expected+=coef[i]*coef[j]*combined->kernel(idx[i], idx[j]);
+		}
+		EXPECT_NEAR(forms[k], expected, 1e-10);
+	}
+
+	SG_UNREF(combined);
+}
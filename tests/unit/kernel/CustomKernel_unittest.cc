@@ -17,6 +17,9 @@
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/Math.h>
 
+#include <stdlib.h>
+#include <unistd.h>
+
 using namespace shogun;
 using namespace Eigen;
 
@@ -637,3 +640,100 @@ TEST(CustomKernelTest, row_col_wise_sum_block_no_diag)
 	SG_UNREF(feats_p);
 	SG_UNREF(feats_q);
 }
+
+TEST(CustomKernelTest, tiled_storage)
+{
+	const index_t n=100;
+	SGMatrix<float64_t> km(n, n);
+	for (index_t i=0; i<n; i++)
+	{
+		for (index_t j=0; j<=i; j++)
+		{
+			km(i,j)=CMath::exp(-CMath::sq(float64_t(i-j))/n);
+			km(j,i)=km(i,j);
+		}
+	}
+
+	CCustomKernel* kernel=new CCustomKernel(km);
+	SG_REF(kernel);
+	float64_t sum=kernel->sum_block(10, 70, 60, 30);
+	SGVector<float64_t> row_sums=kernel->row_wise_sum_symmetric_block(0, n);
+
+	kernel->set_storage(CKS_TILED);
+	EXPECT_EQ(kernel->get_storage(), CKS_TILED);
+	for (index_t i=0; i<n; i++)
+	{
+		for (index_t j=0; j<n; j++)
+			EXPECT_NEAR(kernel->kernel(i, j), km(i,j), 1E-6);
+	}
+	EXPECT_NEAR(kernel->sum_block(10, 70, 60, 30), sum, 1E-3);
+	SGVector<float64_t> tiled_row_sums=kernel->row_wise_sum_symmetric_block(0, n);
+	for (index_t i=0; i<n; i++)
+		EXPECT_NEAR(tiled_row_sums[i], row_sums[i], 1E-4);
+
+	SGVector<float64_t> col=kernel->get_kernel_col(77);
+	SGVector<float64_t> row=kernel->get_kernel_row(13);
+	for (index_t i=0; i<n; i++)
+	{
+		EXPECT_NEAR(col[i], km(i,77), 1E-6);
+		EXPECT_NEAR(row[i], km(13,i), 1E-6);
+	}
+
+	kernel->set_storage(CKS_TILED_BF16);
+	for (index_t i=0; i<n; i++)
+	{
+		for (index_t j=0; j<n; j++)
+			EXPECT_NEAR(kernel->kernel(i, j), km(i,j), 1E-2*km(i,j)+1E-6);
+	}
+
+	kernel->set_storage(CKS_UPPER_TRIANGLE);
+	for (index_t i=0; i<n; i++)
+		EXPECT_NEAR(kernel->kernel(i, 99-i), km(i,99-i), 1E-2*km(i,99-i)+1E-6);
+
+	SG_UNREF(kernel);
+}
+
+TEST(CustomKernelTest, save_load_kernel_matrix)
+{
+	const index_t rows=70;
+	const index_t cols=90;
+	SGMatrix<float64_t> km(rows, cols);
+	for (index_t i=0; i<rows*cols; i++)
+		km.matrix[i]=CMath::random(0.0, 1.0);
+
+	CCustomKernel* kernel=new CCustomKernel(km);
+	SG_REF(kernel);
+	CCustomKernel* loaded=new CCustomKernel();
+	SG_REF(loaded);
+
+	char filename[]="custom_kernel_XXXXXX";
+	int fd=mkstemp(filename);
+	ASSERT_NE(fd, -1);
+
+	ECustomKernelStorage storages[]={CKS_FULL, CKS_TILED};
+	for (ECustomKernelStorage storage : storages)
+	{
+		kernel->set_storage(storage);
+		kernel->save_kernel_matrix(filename);
+		EXPECT_TRUE(loaded->load_kernel_matrix(filename));
+		EXPECT_EQ(loaded->get_storage(), storage);
+		EXPECT_EQ(loaded->get_num_vec_lhs(), rows);
+		EXPECT_EQ(loaded->get_num_vec_rhs(), cols);
+
+		for (index_t i=0; i<rows; i++)
+		{
+			for (index_t j=0; j<cols; j++)
+				EXPECT_NEAR(loaded->kernel(i, j), km(i,j), 1E-6);
+		}
+
+		/* the mapping is read-only, the returned matrix is a copy */
+		SGMatrix<float32_t> copy=loaded->get_float32_kernel_matrix();
+		copy(0, 0)=-1;
+		EXPECT_NEAR(loaded->kernel(0, 0), km(0, 0), 1E-6);
+	}
+
+	SG_UNREF(loaded);
+	SG_UNREF(kernel);
+	close(fd);
+	unlink(filename);
+}
@@ -32,7 +32,10 @@
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SparseFeatures.h>
 #include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/LinearKernel.h>
+#include <shogun/kernel/PolyKernel.h>
 #include <gtest/gtest.h>
 
 using namespace shogun;
@@ -293,8 +296,9 @@ TEST(Kernel, row_wise_sum_squared_sum_symmetric_block_with_diag)
 			row_wise_sum+=k;
 			row_wise_squared_sum+=k*k;
 		}
-		EXPECT_NEAR(row_wise_sum_mat(i, 0), row_wise_sum, 1E-15);
-		EXPECT_NEAR(row_wise_sum_mat(i, 1), row_wise_squared_sum, 1E-15);
+		// km is computed in tiles, which round differently than kernel()
+		EXPECT_NEAR(row_wise_sum_mat(i, 0), row_wise_sum, 1E-14);
+		EXPECT_NEAR(row_wise_sum_mat(i, 1), row_wise_squared_sum, 1E-14);
 	}
 
 	// cleanup
@@ -406,9 +410,116 @@ TEST(Kernel, gaussian_get_kernel_matrix)
 	// initialize a Gaussian kernel of width 1
 	CGaussianKernel* kernel=new CGaussianKernel(feats_p, feats_q, 2);
 	SGMatrix<float64_t> km=kernel->get_kernel_matrix();
+	// the tiles get the dot products of the squared distances from a matrix
+	// product, which sums them up in a different order than kernel()
+	for (index_t i=0; i<km.num_rows; i++)
+		for (index_t j=0; j<km.num_cols; ++j)
+			EXPECT_NEAR(kernel->kernel(i,j), km(i, j), 1E-14);
+
+	SG_UNREF(kernel);
+}
+
+TEST(Kernel, gaussian_get_kernel_matrix_precomputed_distance)
+{
+	const index_t num_feats=50;
+	const index_t dim=3;
+
+	SGMatrix<float64_t> data = generate_std_norm_matrix(num_feats, dim);
+	CDenseFeatures<float64_t>* feats=new CDenseFeatures<float64_t>(data);
+
+	CGaussianKernel* kernel=new CGaussianKernel(feats, feats, 2);
+	kernel->precompute_distance();
+	kernel->set_block_size(7);
+	SGMatrix<float64_t> km=kernel->get_kernel_matrix();
 	for (index_t i=0; i<km.num_rows; i++)
 		for (index_t j=0; j<km.num_cols; ++j)
 			EXPECT_NEAR(kernel->kernel(i,j), km(i, j), 1E-15);
 
 	SG_UNREF(kernel);
 }
+
+/* compares the tiled kernel matrix of sparse features with the one of the
+ * same data in dense features and with kernel() */
+static void check_sparse_kernel_matrix(CKernel* kernel, const index_t num_vec)
+{
+	const index_t dim=50;
+	SGMatrix<float64_t> data=generate_std_norm_matrix(num_vec, dim);
+	for (index_t i=0; i<data.num_rows*data.num_cols; i++)
+	{
+		if (CMath::random(0, 4)>0)
+			data.matrix[i]=0;
+	}
+
+	CDenseFeatures<float64_t>* dense=new CDenseFeatures<float64_t>(data);
+	CSparseFeatures<float64_t>* sparse=new CSparseFeatures<float64_t>(data);
+	SG_REF(dense);
+	SG_REF(sparse);
+
+	int32_t num_threads=kernel->parallel->get_num_threads();
+	kernel->parallel->set_num_threads(4);
+	kernel->set_block_size(7);
+
+	kernel->init(dense, dense);
+	SGMatrix<float64_t> dense_km=kernel->get_kernel_matrix();
+
+	kernel->init(sparse, sparse);
+	SGMatrix<float64_t> sparse_km=kernel->get_kernel_matrix();
+	SGMatrix<float32_t> sparse_km32=kernel->get_kernel_matrix<float32_t>();
+
+	for (index_t j=0; j<num_vec; j++)
+	{
+		for (index_t i=0; i<num_vec; i++)
+		{
+			EXPECT_NEAR(sparse_km(i,j), dense_km(i,j), 1E-10);
+			EXPECT_NEAR(sparse_km(i,j), kernel->kernel(i,j), 1E-10);
+			EXPECT_NEAR(sparse_km32(i,j), sparse_km(i,j), 1E-5);
+		}
+	}
+
+	/* rectangular, non-symmetric case */
+	SGVector<index_t> rhs_idx(num_vec/2);
+	for (index_t i=0; i<rhs_idx.vlen; i++)
+		rhs_idx[i]=num_vec-1-2*i;
+	CFeatures* sparse_rhs=sparse->copy_subset(rhs_idx);
+	kernel->init(sparse, sparse_rhs);
+	SGMatrix<float64_t> rect_km=kernel->get_kernel_matrix();
+	ASSERT_EQ(rect_km.num_rows, num_vec);
+	ASSERT_EQ(rect_km.num_cols, num_vec/2);
+	for (index_t j=0; j<rect_km.num_cols; j++)
+	{
+		for (index_t i=0; i<rect_km.num_rows; i++)
+			EXPECT_NEAR(rect_km(i,j), kernel->kernel(i,j), 1E-10);
+	}
+
+	kernel->parallel->set_num_threads(num_threads);
+	kernel->cleanup();
+	SG_UNREF(sparse);
+	SG_UNREF(dense);
+}
+
+TEST(Kernel, linear_sparse_get_kernel_matrix)
+{
+	CMath::init_random(3);
+	CLinearKernel* kernel=new CLinearKernel();
+	SG_REF(kernel);
+	check_sparse_kernel_matrix(kernel, 30);
+	SG_UNREF(kernel);
+}
+
+TEST(Kernel, poly_sparse_get_kernel_matrix)
+{
+	CMath::init_random(5);
+	CPolyKernel* kernel=new CPolyKernel(10, 3, true);
+	SG_REF(kernel);
+	check_sparse_kernel_matrix(kernel, 30);
+	SG_UNREF(kernel);
+}
+
+TEST(Kernel, gaussian_sparse_get_kernel_matrix)
+{
+	CMath::init_random(7);
+	CGaussianKernel* kernel=new CGaussianKernel(10, 20.0);
+	SG_REF(kernel);
+	check_sparse_kernel_matrix(kernel, 30);
+	SG_UNREF(kernel);
+}
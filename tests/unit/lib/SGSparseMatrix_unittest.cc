@@ -286,3 +286,89 @@ TEST(SGSparseMatrix, transposed_square_matrix)
 			EXPECT_NEAR(sparse_matrix(feat_index,vec_index), sparse_matrix_t(vec_index,feat_index), 1E-14);
 	}
 }
+
+TEST(SGSparseMatrix, compressed_storage)
+{
+	const float64_t sparse_level=0.1;
+	const index_t number_of_features=60;
+	const index_t number_of_vectors=90;
+
+	SGMatrix<float64_t> dense_matrix(number_of_features, number_of_vectors);
+	dense_matrix.zero();
+	GenerateMatrix<SGMatrix<float64_t> >(sparse_level, number_of_features,
+			number_of_vectors, 3, &dense_matrix);
+	dense_matrix(0,0)=0;
+
+	SGSparseMatrix<float64_t> sparse_matrix(dense_matrix);
+	EXPECT_TRUE(sparse_matrix.is_compressed());
+	EXPECT_EQ(sparse_matrix.compressed_offsets[0], 0);
+
+	SGSparseMatrix<float64_t> sparse_matrix_t=sparse_matrix.get_transposed();
+	EXPECT_TRUE(sparse_matrix_t.is_compressed());
+	EXPECT_EQ(sparse_matrix_t.compressed_offsets[number_of_features],
+			sparse_matrix.compressed_offsets[number_of_vectors]);
+
+	const SGSparseMatrix<float64_t>& m=sparse_matrix;
+	const SGSparseMatrix<float64_t>& mt=sparse_matrix_t;
+	for (index_t i=0; i<number_of_features; ++i)
+	{
+		EXPECT_TRUE(mt[i].is_sorted());
+		for (index_t j=0; j<number_of_vectors; ++j)
+		{
+			EXPECT_EQ(m(i,j), dense_matrix(i,j));
+			EXPECT_EQ(mt(j,i), dense_matrix(i,j));
+		}
+	}
+
+	// writing a new entry moves the vector out of the block
+	sparse_matrix(0,0)=-1.0;
+	EXPECT_FALSE(sparse_matrix.is_compressed());
+	EXPECT_EQ(m(0,0), -1.0);
+
+	SGSparseMatrix<float64_t> compressed=sparse_matrix.get_compressed();
+	EXPECT_TRUE(compressed.is_compressed());
+	for (index_t j=0; j<number_of_vectors; ++j)
+	{
+		EXPECT_EQ(compressed[j].num_feat_entries, m[j].num_feat_entries);
+		for (index_t k=0; k<m[j].num_feat_entries; ++k)
+		{
+			EXPECT_EQ(compressed[j].features[k].feat_index,
+					m[j].features[k].feat_index);
+			EXPECT_EQ(compressed[j].features[k].entry, m[j].features[k].entry);
+		}
+	}
+}
+
+TEST(SGSparseMatrix, sort_features_compressed)
+{
+	SGVector<int64_t> offsets(4);
+	offsets[0]=0;
+	offsets[1]=3;
+	offsets[2]=3;
+	offsets[3]=6;
+
+	SGSparseMatrix<float64_t> m(5, offsets);
+	index_t index[6]={4, 1, 4, 2, 0, 2};
+	float64_t entry[6]={1, 2, 3, 4, 5, 6};
+	for (index_t i=0; i<6; ++i)
+	{
+		m.compressed_entries[i].feat_index=index[i];
+		m.compressed_entries[i].entry=entry[i];
+	}
+
+	m.sort_features();
+
+	EXPECT_TRUE(m.is_compressed());
+	EXPECT_EQ(m.compressed_offsets[1], 2);
+	EXPECT_EQ(m.compressed_offsets[2], 2);
+	EXPECT_EQ(m.compressed_offsets[3], 4);
+
+	EXPECT_EQ(m[0].features[0].feat_index, 1);
+	EXPECT_EQ(m[0].features[0].entry, 2);
+	EXPECT_EQ(m[0].features[1].feat_index, 4);
+	EXPECT_EQ(m[0].features[1].entry, 4);
+	EXPECT_EQ(m[2].features[0].feat_index, 0);
+	EXPECT_EQ(m[2].features[0].entry, 5);
+	EXPECT_EQ(m[2].features[1].feat_index, 2);
+	EXPECT_EQ(m[2].features[1].entry, 10);
+}
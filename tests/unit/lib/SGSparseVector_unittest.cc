@@ -11,6 +11,7 @@
 #include <shogun/lib/common.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/SGSparseVector.h>
+#include <shogun/mathematics/Math.h>
 
 #include <vector>
 
@@ -81,6 +82,37 @@ TEST(SGSparseVector, dense_dot_float64_int32)
 	EXPECT_NEAR(dot, 2.0, 1E-19);
 }
 
+TEST(SGSparseVector, add_to_dense_repeated_index)
+{
+	const int32_t size=6;
+
+	// seven entries, the repeated index lies within the first four
+	SGSparseVector<float64_t> vec(7);
+	const index_t idx[]={1, 3, 1, 0, 5, 2, 4};
+	for (index_t i=0; i<vec.num_feat_entries; ++i)
+	{
+		vec.features[i].feat_index=idx[i];
+		vec.features[i].entry=i%2 ? -(i+1.0) : i+1.0;
+	}
+
+	for (index_t abs_val=0; abs_val<2; ++abs_val)
+	{
+		SGVector<float64_t> v(size);
+		SGVector<float64_t> expected(size);
+		v.set_const(1.0);
+		expected.set_const(1.0);
+		for (index_t i=0; i<vec.num_feat_entries; ++i)
+		{
+			float64_t entry=vec.features[i].entry;
+			expected[idx[i]]+=0.5*(abs_val ? CMath::abs(entry) : entry);
+		}
+
+		vec.add_to_dense(0.5, v.vector, v.vlen, abs_val);
+		for (index_t i=0; i<size; ++i)
+			EXPECT_NEAR(v[i], expected[i], 1E-15);
+	}
+}
+
 TEST(SGSparseVector, get_feature_unique)
 {
 	SGSparseVector<float64_t> vec(3);
@@ -506,3 +538,36 @@ TEST(SGSparseVector, sparse_dot_not_sorted_features_different_length_last_index_
 	EXPECT_EQ(4, SGSparseVector<int32_t>::sparse_dot(v1, v2));
 	EXPECT_EQ(4, SGSparseVector<int32_t>::sparse_dot(v2, v1));
 }
+
+TEST(SGSparseVector, sparse_dot_galloping_equals_dense)
+{
+	CMath::init_random(17);
+	const index_t dim = 1000;
+	SGVector<float64_t> dense_long(dim);
+	dense_long.zero();
+
+	SGSparseVector<float64_t> v_long(dim / 2);
+	for (index_t i = 0; i < v_long.num_feat_entries; i++)
+	{
+		v_long.features[i].feat_index = 2 * i;
+		v_long.features[i].entry = CMath::random(-1.0, 1.0);
+		dense_long[2 * i] = v_long.features[i].entry;
+	}
+
+	for (index_t len = 1; len < 20; len++)
+	{
+		SGSparseVector<float64_t> v_short(len);
+		float64_t expected = 0;
+		for (index_t i = 0; i < len; i++)
+		{
+			// ascending indices, about half of them hit v_long
+			v_short.features[i].feat_index = i * (dim / len) + (i % 2);
+			v_short.features[i].entry = CMath::random(-1.0, 1.0);
+			expected += v_short.features[i].entry *
+				dense_long[v_short.features[i].feat_index];
+		}
+
+		EXPECT_NEAR(expected, SGSparseVector<float64_t>::sparse_dot(v_short, v_long), 1E-12);
+		EXPECT_NEAR(expected, SGSparseVector<float64_t>::sparse_dot(v_long, v_short), 1E-12);
+	}
+}
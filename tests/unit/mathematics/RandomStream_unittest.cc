@@ -0,0 +1,141 @@
+#include <shogun/mathematics/RandomStream.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/Statistics.h>
+#include <shogun/lib/SGVector.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+/* known answers of Philox4x32-10 from the Random123 distribution */
+TEST(RandomStream, philox_known_answers)
+{
+	RandomStream zero(0, 0);
+	EXPECT_EQ(0x6627e8d5U, zero.random_32());
+	EXPECT_EQ(0xe169c58dU, zero.random_32());
+	EXPECT_EQ(0xbc57ac4cU, zero.random_32());
+	EXPECT_EQ(0x9b00dbd8U, zero.random_32());
+
+	RandomStream ones(0xffffffffffffffffULL, 0xffffffffffffffffULL);
+	ones.discard(0xffffffffffffffffULL);
+	EXPECT_EQ(0x408f276dU, ones.random_32());
+	EXPECT_EQ(0x41c83b0eU, ones.random_32());
+	EXPECT_EQ(0xa20bc7c6U, ones.random_32());
+	EXPECT_EQ(0x6d5451fdU, ones.random_32());
+}
+
+TEST(RandomStream, reproducible_and_independent_streams)
+{
+	RandomStream a(12345, 3);
+	RandomStream b(12345, 3);
+	RandomStream c(12345, 4);
+
+	int32_t num_equal=0;
+	for (int32_t i=0; i<1000; i++)
+	{
+		uint64_t r=a.random_64();
+		EXPECT_EQ(r, b.random_64());
+		num_equal+=r==c.random_64();
+	}
+	EXPECT_EQ(0, num_equal);
+
+	/* restarting a stream replays it */
+	a.set_seed(12345, 3);
+	c.set_seed(12345, 3);
+	for (int32_t i=0; i<10; i++)
+		EXPECT_EQ(a.random_32(), c.random_32());
+}
+
+TEST(RandomStream, discard)
+{
+	RandomStream a(7);
+	RandomStream b(7);
+	for (int32_t i=0; i<4*10; i++)
+		a.random_32();
+	b.discard(10);
+
+	for (int32_t i=0; i<10; i++)
+		EXPECT_EQ(a.random_32(), b.random_32());
+}
+
+TEST(RandomStream, random_range)
+{
+	RandomStream rng(17);
+	for (int32_t i=0; i<10000; i++)
+	{
+		int32_t r=rng.random(-3, 5);
+		EXPECT_GE(r, -3);
+		EXPECT_LE(r, 5);
+
+		float64_t f=rng.random(-1.0, 2.0);
+		EXPECT_GE(f, -1.0);
+		EXPECT_LT(f, 2.0);
+	}
+}
+
+TEST(RandomStream, fill_array_co)
+{
+	RandomStream rng(17);
+	SGVector<float64_t> v(100001);
+	rng.fill_array_co(v.vector, v.vlen);
+
+	for (index_t i=0; i<v.vlen; i++)
+	{
+		EXPECT_GE(v[i], 0.0);
+		EXPECT_LT(v[i], 1.0);
+	}
+	EXPECT_NEAR(0.5, CStatistics::mean(v), 0.01);
+}
+
+TEST(RandomStream, fill_array_normal)
+{
+	RandomStream rng(17);
+	SGVector<float64_t> v(100001);
+	rng.fill_array_normal(v.vector, v.vlen, 2.0, 3.0);
+
+	float64_t mean=CStatistics::mean(v);
+	float64_t var=0;
+	for (index_t i=0; i<v.vlen; i++)
+		var+=CMath::sq(v[i]-mean);
+	var/=v.vlen-1;
+
+	EXPECT_NEAR(2.0, mean, 0.05);
+	EXPECT_NEAR(9.0, var, 0.2);
+}
+
+TEST(RandomStream, std_normal_distrib)
+{
+	RandomStream rng(17);
+	float64_t sum=0;
+	float64_t sum_sq=0;
+	int32_t n=100000;
+	for (int32_t i=0; i<n; i++)
+	{
+		float64_t r=rng.std_normal_distrib();
+		sum+=r;
+		sum_sq+=r*r;
+	}
+
+	EXPECT_NEAR(0.0, sum/n, 0.02);
+	EXPECT_NEAR(1.0, sum_sq/n, 0.02);
+}
+
+TEST(RandomStream, permute)
+{
+	RandomStream rng(17);
+	SGVector<index_t> v(50);
+	v.range_fill();
+	CMath::permute(v, rng);
+
+	SGVector<bool> seen(v.vlen);
+	seen.set_const(false);
+	int32_t num_fixed=0;
+	for (index_t i=0; i<v.vlen; i++)
+	{
+		ASSERT_GE(v[i], 0);
+		ASSERT_LT(v[i], v.vlen);
+		EXPECT_FALSE(seen[v[i]]);
+		seen[v[i]]=true;
+		num_fixed+=v[i]==i;
+	}
+	EXPECT_LT(num_fixed, v.vlen);
+}
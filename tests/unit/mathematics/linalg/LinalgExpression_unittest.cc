@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <shogun/lib/config.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/linalg/LinalgExpression.h>
+#include <shogun/lib/ShogunException.h>
+
+using namespace shogun;
+using namespace linalg;
+
+TEST(LinalgExpression, SGMatrix_fused_chain_equals_eager)
+{
+	const index_t nrows = 3, ncols = 4;
+	const float64_t k = 0.7;
+
+	SGMatrix<float64_t> A(nrows, ncols);
+	SGMatrix<float64_t> B(nrows, ncols);
+	SGMatrix<float64_t> C(nrows, ncols);
+	for (index_t i = 0; i < nrows*ncols; ++i)
+	{
+		A[i] = i;
+		B[i] = 0.5*i - 2;
+		C[i] = -0.25*i;
+	}
+
+	SGMatrix<float64_t> result(nrows, ncols);
+	eval(scale(add(element_prod(lazy(A), lazy(B)), lazy(C)), k), result);
+
+	SGMatrix<float64_t> expected = element_prod(A, B);
+	expected = add(expected, C);
+	expected = scale(expected, k);
+
+	for (index_t i = 0; i < nrows*ncols; ++i)
+		EXPECT_NEAR(expected[i], result[i], 1e-15);
+}
+
+TEST(LinalgExpression, SGVector_add_scalar_exponent)
+{
+	const float64_t alpha = 0.3;
+	const float64_t beta = -1.5;
+
+	SGVector<float64_t> a(9);
+	SGVector<float64_t> b(9);
+	for (index_t i = 0; i < 9; ++i)
+	{
+		a[i] = 0.1*i;
+		b[i] = 0.5*i;
+	}
+
+	SGVector<float64_t> result = eval(
+		add_scalar(exponent(add(lazy(a), lazy(b), alpha, beta)), 2.0));
+
+	ASSERT_EQ(9, result.vlen);
+	for (index_t i = 0; i < 9; ++i)
+		EXPECT_NEAR(CMath::exp(alpha*a[i]+beta*b[i])+2.0, result[i], 1e-15);
+}
+
+TEST(LinalgExpression, result_is_operand)
+{
+	SGVector<float64_t> a(5);
+	SGVector<float64_t> b(5);
+	for (index_t i = 0; i < 5; ++i)
+	{
+		a[i] = i;
+		b[i] = 10*i;
+	}
+
+	eval(add(lazy(b), element_prod(lazy(a), lazy(a)), 1.0, -1.0), a);
+
+	for (index_t i = 0; i < 5; ++i)
+		EXPECT_NEAR(10.0*i-i*i, a[i], 1e-15);
+}
+
+TEST(LinalgExpression, parallel_sum_and_dot)
+{
+	const index_t size = 100000;
+	SGVector<float64_t> a(size);
+	SGVector<float64_t> b(size);
+	for (index_t i = 0; i < size; ++i)
+	{
+		a[i] = CMath::sin(i);
+		b[i] = CMath::cos(i);
+	}
+
+	SGVector<float64_t> c(size);
+	eval(scale(add(lazy(a), lazy(b), 2.0, -1.0), 0.5), c);
+	for (index_t i = 0; i < size; ++i)
+		EXPECT_NEAR(0.5*(2.0*a[i]-b[i]), c[i], 1e-15);
+
+	float64_t expected_sum = 0;
+	float64_t expected_dot = 0;
+	for (index_t i = 0; i < size; ++i)
+	{
+		expected_sum += 2.0*a[i]+1.0;
+		expected_dot += a[i]*b[i];
+	}
+
+	EXPECT_NEAR(expected_sum, linalg::sum(add_scalar(scale(lazy(a), 2.0), 1.0)), 1e-8);
+	EXPECT_NEAR(expected_dot, linalg::dot(lazy(a), lazy(b)), 1e-8);
+}
+
+TEST(LinalgExpression, dimension_mismatch)
+{
+	SGMatrix<float64_t> A(2, 3);
+	SGMatrix<float64_t> B(3, 2);
+	SGMatrix<float64_t> result(2, 3);
+
+	EXPECT_THROW(add(lazy(A), lazy(B)), ShogunException);
+	EXPECT_THROW(eval(lazy(B), result), ShogunException);
+}
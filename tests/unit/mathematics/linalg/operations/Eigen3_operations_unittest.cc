@@ -1636,3 +1636,123 @@ TEST(LinalgBackendEigen, SGMatrix_zero)
 	for (index_t i = 0; i < nrows*ncols; ++i)
 		EXPECT_EQ(A[i], 0);
 }
+
+static SGMatrix<float64_t> sparse_test_matrix(index_t nrows, index_t ncols)
+{
+	SGMatrix<float64_t> A(nrows, ncols);
+	for (index_t i = 0; i < nrows*ncols; ++i)
+		A[i] = i % 3 ? 0 : 0.5*i - 7;
+	return A;
+}
+
+TEST(LinalgBackendEigen, SGSparseMatrix_SGVector_matrix_prod)
+{
+	const index_t nrows = 5, ncols = 7;
+	SGMatrix<float64_t> A = sparse_test_matrix(nrows, ncols);
+	SGSparseMatrix<float64_t> S(A);
+
+	SGVector<float64_t> b(ncols);
+	SGVector<float64_t> c(nrows);
+	for (index_t i = 0; i < ncols; ++i)
+		b[i] = 0.3*i - 1;
+	for (index_t i = 0; i < nrows; ++i)
+		c[i] = -0.2*i + 2;
+
+	auto result = matrix_prod(S, b);
+	auto expected = matrix_prod(A, b);
+	ASSERT_EQ(nrows, result.vlen);
+	for (index_t i = 0; i < nrows; ++i)
+		EXPECT_NEAR(expected[i], result[i], 1e-12);
+
+	auto result_t = matrix_prod(S, c, true);
+	auto expected_t = matrix_prod(A, c, true);
+	ASSERT_EQ(ncols, result_t.vlen);
+	for (index_t i = 0; i < ncols; ++i)
+		EXPECT_NEAR(expected_t[i], result_t[i], 1e-12);
+}
+
+TEST(LinalgBackendEigen, SGSparseMatrix_SGMatrix_matrix_prod)
+{
+	const index_t nrows = 5, ncols = 7, k = 3;
+	SGMatrix<float64_t> A = sparse_test_matrix(nrows, ncols);
+	SGSparseMatrix<float64_t> S(A);
+
+	SGMatrix<float64_t> B(ncols, k);
+	SGMatrix<float64_t> C(nrows, k);
+	for (index_t i = 0; i < ncols*k; ++i)
+		B[i] = 0.1*i - 1;
+	for (index_t i = 0; i < nrows*k; ++i)
+		C[i] = -0.3*i + 2;
+
+	auto result = matrix_prod(S, B);
+	auto expected = matrix_prod(A, B);
+	ASSERT_EQ(nrows, result.num_rows);
+	ASSERT_EQ(k, result.num_cols);
+	for (index_t i = 0; i < nrows*k; ++i)
+		EXPECT_NEAR(expected[i], result[i], 1e-12);
+
+	auto result_t = matrix_prod(S, C, true);
+	auto expected_t = matrix_prod(A, C, true);
+	ASSERT_EQ(ncols, result_t.num_rows);
+	ASSERT_EQ(k, result_t.num_cols);
+	for (index_t i = 0; i < ncols*k; ++i)
+		EXPECT_NEAR(expected_t[i], result_t[i], 1e-12);
+}
+
+TEST(LinalgBackendEigen, SGSparseMatrix_sums_and_norms)
+{
+	const index_t nrows = 5, ncols = 7;
+	SGMatrix<float64_t> A = sparse_test_matrix(nrows, ncols);
+	SGSparseMatrix<float64_t> S(A);
+	Map<MatrixXd> A_eig(A.matrix, nrows, ncols);
+
+	auto col_sum = colwise_sum(S);
+	auto row_sum = rowwise_sum(S);
+	auto col_norm = colwise_norm(S);
+	auto row_norm = rowwise_norm(S);
+
+	ASSERT_EQ(ncols, col_sum.vlen);
+	ASSERT_EQ(ncols, col_norm.vlen);
+	for (index_t j = 0; j < ncols; ++j)
+	{
+		EXPECT_NEAR(A_eig.col(j).sum(), col_sum[j], 1e-12);
+		EXPECT_NEAR(A_eig.col(j).norm(), col_norm[j], 1e-12);
+	}
+
+	ASSERT_EQ(nrows, row_sum.vlen);
+	ASSERT_EQ(nrows, row_norm.vlen);
+	for (index_t i = 0; i < nrows; ++i)
+	{
+		EXPECT_NEAR(A_eig.row(i).sum(), row_sum[i], 1e-12);
+		EXPECT_NEAR(A_eig.row(i).norm(), row_norm[i], 1e-12);
+	}
+}
+
+TEST(LinalgBackendEigen, SGSparseMatrix_scale)
+{
+	const index_t nrows = 5, ncols = 7;
+	const float64_t alpha = -0.4;
+	SGMatrix<float64_t> A = sparse_test_matrix(nrows, ncols);
+	SGSparseMatrix<float64_t> S(A);
+
+	/* const access, which does not insert missing entries */
+	const SGSparseMatrix<float64_t>& S_const = S;
+
+	auto result = scale(S_const, alpha);
+	const SGSparseMatrix<float64_t>& result_const = result;
+	for (index_t i = 0; i < nrows; ++i)
+	{
+		for (index_t j = 0; j < ncols; ++j)
+		{
+			EXPECT_NEAR(alpha*A(i, j), result_const(i, j), 1e-15);
+			EXPECT_NEAR(A(i, j), S_const(i, j), 1e-15);
+		}
+	}
+
+	scale(S, S, alpha);
+	for (index_t i = 0; i < nrows; ++i)
+	{
+		for (index_t j = 0; j < ncols; ++j)
+			EXPECT_NEAR(alpha*A(i, j), S_const(i, j), 1e-15);
+	}
+}
@@ -156,3 +156,40 @@ TEST(LMNN,train_diagonal)
 
 	SG_UNREF(lmnn)
 }
+
+TEST(LMNN,train_low_rank)
+{
+	// two classes in three dimensions, told apart only by the first feature
+	SGMatrix<float64_t> feat_mat(3,6);
+	for (index_t i=0; i<6; i++)
+	{
+		feat_mat(0,i)=i<3 ? -1 : 1;
+		feat_mat(1,i)=i%3;
+		feat_mat(2,i)=(i*7)%3;
+	}
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(feat_mat);
+
+	SGVector<float64_t> lab_vec(6);
+	for (index_t i=0; i<6; i++)
+		lab_vec[i]=i<3 ? 0 : 1;
+	CMulticlassLabels* labels=new CMulticlassLabels(lab_vec);
+
+	CLMNN* lmnn=new CLMNN(features,labels,1);
+	// project into one dimension
+	SGMatrix<float64_t> init_transform(1,3);
+	init_transform(0,0)=0.5;
+	init_transform(0,1)=0.5;
+	init_transform(0,2)=0.5;
+	lmnn->set_maxiter(200);
+	lmnn->train(init_transform);
+
+	SGMatrix<float64_t> L=lmnn->get_linear_transform();
+	EXPECT_EQ(L.num_rows,1);
+	EXPECT_EQ(L.num_cols,3);
+
+	CLMNNStatistics* statistics=lmnn->get_statistics();
+	EXPECT_LT(statistics->obj[statistics->obj.vlen-1],statistics->obj[0]);
+	SG_UNREF(statistics)
+
+	SG_UNREF(lmnn)
+}
@@ -135,6 +135,7 @@ TEST_F(BaggingMachine, classify_CART)
 	c->set_bag_size(14);
 	c->set_num_bags(10);
 	c->set_combination_rule(cv);
+	c->set_random_seed(1);
 	c->train(features_train);
 
 	CMulticlassLabels* result = c->apply_multiclass(features_test);
@@ -147,7 +148,7 @@ TEST_F(BaggingMachine, classify_CART)
 	EXPECT_EQ(1.0,res_vector[4]);
 
 	auto eval = some<CMulticlassAccuracy>();
-	EXPECT_NEAR(0.642857,c->get_oob_error(eval),1e-6);
+	EXPECT_NEAR(0.428571,c->get_oob_error(eval),1e-6);
 
 	SG_UNREF(result);
 }
@@ -164,6 +165,7 @@ TEST_F(BaggingMachine, output_binary)
 	c->set_bag_size(14);
 	c->set_num_bags(10);
 	c->set_combination_rule(cv);
+	c->set_random_seed(1);
 	c->train(features_train);
 
 	CBinaryLabels* result = c->apply_binary(features_test);
@@ -176,11 +178,11 @@ TEST_F(BaggingMachine, output_binary)
 	EXPECT_EQ(1.0, res_vector[3]);
 	EXPECT_EQ(1.0, res_vector[4]);
 
-	EXPECT_DOUBLE_EQ(1.0, values_vector[0]);
-	EXPECT_DOUBLE_EQ(0.3, values_vector[1]);
-	EXPECT_DOUBLE_EQ(0.3, values_vector[2]);
+	EXPECT_DOUBLE_EQ(0.9, values_vector[0]);
+	EXPECT_DOUBLE_EQ(0.2, values_vector[1]);
+	EXPECT_DOUBLE_EQ(0.2, values_vector[2]);
 	EXPECT_DOUBLE_EQ(1.0, values_vector[3]);
-	EXPECT_DOUBLE_EQ(0.7, values_vector[4]);
+	EXPECT_DOUBLE_EQ(0.6, values_vector[4]);
 
 	SG_UNREF(result);
 }
@@ -197,6 +199,7 @@ TEST_F(BaggingMachine, output_multiclass_probs_sum_to_one)
 	c->set_bag_size(14);
 	c->set_num_bags(10);
 	c->set_combination_rule(cv);
+	c->set_random_seed(1);
 	c->train(features_train);
 
 	CMulticlassLabels* result = c->apply_multiclass(features_test);
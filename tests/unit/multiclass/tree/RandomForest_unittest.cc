@@ -98,6 +98,7 @@ TEST_F(RandomForest, classify_nominal_test)
 	c->set_feature_types(weather_ft);
 	CMajorityVote* mv = new CMajorityVote();
 	c->set_combination_rule(mv);
+	c->set_random_seed(1);
 	c->parallel->set_num_threads(1);
 	c->train(weather_features_train);
 
@@ -109,10 +110,10 @@ TEST_F(RandomForest, classify_nominal_test)
 	EXPECT_EQ(0.0,res_vector[1]);
 	EXPECT_EQ(0.0,res_vector[2]);
 	EXPECT_EQ(1.0,res_vector[3]);
-	EXPECT_EQ(1.0,res_vector[4]);
+	EXPECT_EQ(0.0,res_vector[4]);
 
 	CMulticlassAccuracy* eval=new CMulticlassAccuracy();
-	EXPECT_NEAR(0.642857,c->get_oob_error(eval),1e-6);
+	EXPECT_NEAR(0.571429,c->get_oob_error(eval),1e-6);
 
 	SG_UNREF(result);
 	SG_UNREF(c);
@@ -131,6 +132,7 @@ TEST_F(RandomForest, classify_non_nominal_test)
 	c->set_feature_types(weather_ft);
 	CMajorityVote* mv = new CMajorityVote();
 	c->set_combination_rule(mv);
+	c->set_random_seed(1);
 	c->parallel->set_num_threads(1);
 	c->train(weather_features_train);
 
@@ -146,7 +148,7 @@ TEST_F(RandomForest, classify_non_nominal_test)
 	EXPECT_EQ(1.0,res_vector[4]);
 
 	CMulticlassAccuracy* eval=new CMulticlassAccuracy();
-	EXPECT_NEAR(0.714285,c->get_oob_error(eval),1e-6);
+	EXPECT_NEAR(0.642857,c->get_oob_error(eval),1e-6);
 
 	SG_UNREF(result);
 	SG_UNREF(c);
@@ -34,6 +34,7 @@
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/labels/BinaryLabels.h>
 #include <shogun/labels/RegressionLabels.h>
 #include <shogun/labels/MulticlassLabels.h>
@@ -465,3 +466,128 @@ TEST(NeuralNetwork, gradient_descent)
 	SG_UNREF(features);
 	SG_UNREF(predictions);
 }
+
+/** tests that gradient descent with several threads (sub-batches propagated
+ * through replicas of the network) gives the same parameters as with one
+ * thread
+ */
+TEST(NeuralNetwork, gradient_descent_multithreaded)
+{
+	int32_t N = 20;
+	SGMatrix<float64_t> inputs_matrix(1,N);
+	SGVector<float64_t> targets_vector(N);
+
+	for (int32_t i=0; i<N; i++)
+	{
+		inputs_matrix(0,i) = i;
+		targets_vector[i] = i*i;
+	}
+
+	CDenseFeatures<float64_t>* features =
+		new CDenseFeatures<float64_t>(inputs_matrix);
+	SG_REF(features);
+
+	CRegressionLabels* labels = new CRegressionLabels(targets_vector);
+	SG_REF(labels);
+
+	SGVector<float64_t> params[2];
+	int32_t num_threads[2] = {1, 3};
+
+	int32_t old_num_threads = features->parallel->get_num_threads();
+	for (int32_t k=0; k<2; k++)
+	{
+		CMath::init_random(100);
+
+		CDynamicObjectArray* layers = new CDynamicObjectArray();
+		layers->append_element(new CNeuralInputLayer(1));
+		layers->append_element(new CNeuralLogisticLayer(20));
+		layers->append_element(new CNeuralLinearLayer(1));
+
+		CNeuralNetwork* network = new CNeuralNetwork(layers);
+		network->quick_connect();
+		network->initialize_neural_network(1e-2);
+
+		network->set_optimization_method(NNOM_GRADIENT_DESCENT);
+		network->set_gd_mini_batch_size(10);
+		network->set_gd_learning_rate(1e-4);
+		network->set_l2_coefficient(1e-3);
+		network->set_epsilon(0.0);
+		network->set_max_num_epochs(20);
+
+		network->parallel->set_num_threads(num_threads[k]);
+		network->set_labels(labels);
+		network->train(features);
+
+		params[k] = network->get_parameters().clone();
+
+		SG_UNREF(network);
+	}
+	features->parallel->set_num_threads(old_num_threads);
+
+	for (int32_t i=0; i<params[0].vlen; i++)
+		EXPECT_NEAR(params[0][i], params[1][i], 1e-10);
+
+	SG_UNREF(features);
+	SG_UNREF(labels);
+}
+
+/** tests a neural network trained using gradient descent on streaming
+ * features on the binary XOR problem
+ */
+TEST(NeuralNetwork, gradient_descent_streaming)
+{
+	CMath::init_random(100);
+
+	SGMatrix<float64_t> inputs_matrix(2,4);
+	SGVector<float64_t> targets_vector(4);
+	inputs_matrix(0,0) = -1.0;
+	inputs_matrix(1,0) = -1.0;
+	targets_vector[0] = -1.0;
+
+	inputs_matrix(0,1) = -1.0;
+	inputs_matrix(1,1) = 1.0;
+	targets_vector[1] = 1.0;
+
+	inputs_matrix(0,2) = 1.0;
+	inputs_matrix(1,2) = -1.0;
+	targets_vector[2] = 1.0;
+
+	inputs_matrix(0,3) = 1.0;
+	inputs_matrix(1,3) = 1.0;
+	targets_vector[3] = -1.0;
+
+	CDenseFeatures<float64_t>* features =
+		new CDenseFeatures<float64_t>(inputs_matrix);
+	CStreamingDenseFeatures<float64_t>* streaming_features =
+		new CStreamingDenseFeatures<float64_t>(features, targets_vector.vector);
+
+	// only specifies how the labels in the stream are interpreted
+	CBinaryLabels* labels = new CBinaryLabels(targets_vector);
+
+	CDynamicObjectArray* layers = new CDynamicObjectArray();
+	layers->append_element(new CNeuralInputLayer(2));
+	layers->append_element(new CNeuralLogisticLayer(2));
+	layers->append_element(new CNeuralLogisticLayer(1));
+
+	CNeuralNetwork* network = new CNeuralNetwork(layers);
+	network->quick_connect();
+	network->initialize_neural_network(0.1);
+
+	network->set_optimization_method(NNOM_GRADIENT_DESCENT);
+	network->set_gd_mini_batch_size(4);
+	network->set_gd_learning_rate(10.0);
+	network->set_epsilon(0.0);
+	network->set_max_num_epochs(1000);
+
+	network->set_labels(labels);
+	network->train(streaming_features);
+
+	CBinaryLabels* predictions = network->apply_binary(features);
+
+	for (int32_t i=0; i<4; i++)
+		EXPECT_EQ(predictions->get_label(i), labels->get_label(i));
+
+	SG_UNREF(network);
+	SG_UNREF(streaming_features);
+	SG_UNREF(predictions);
+}
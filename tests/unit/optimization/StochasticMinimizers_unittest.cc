@@ -51,6 +51,9 @@
 #include <shogun/optimization/ElasticNetPenalty.h>
 #include <shogun/optimization/SMIDASMinimizer.h>
 #include <shogun/optimization/PNormMappingFunction.h>
+#include <shogun/optimization/AdaGradUpdater.h>
+#include <shogun/optimization/L1Penalty.h>
+#include <functional>
 using namespace shogun;
 using namespace Eigen;
 
@@ -290,6 +293,20 @@ SGVector<float64_t> ClassificationForTestCostFunction::get_gradient()
 	return result;
 }
 
+SGVector<float64_t> ClassificationForTestCostFunction::get_sample_gradient(index_t idx)
+{
+	SGVector<float64_t> result(m_weight.vlen);
+	Map<VectorXd> e_r(result.vector,result.vlen);
+
+	Map<VectorXd> e_w(m_weight.vector,m_weight.vlen);
+	Map<MatrixXd> e_x(m_features.matrix, m_features.num_rows, m_features.num_cols);
+	float64_t tmp=e_w.dot(e_x.col(idx));
+	tmp=exp(tmp*m_labels[idx]);
+	float64_t w=m_labels[idx]*tmp / (1.0+tmp);
+	e_r=w*e_x.col(idx);
+	return result;
+}
+
 SGVector<float64_t> ClassificationForTestCostFunction::get_average_gradient()
 {
 	SGVector<float64_t> result(m_weight.vlen);
@@ -321,6 +338,7 @@ void ClassificationForTestCostFunction::init()
 {
 	m_sample_idx=0;
 	m_call_times=0;
+	m_batch_gradient=false;
 	m_labels=SGVector<float64_t>();
 	m_features=SGMatrix<float64_t>();
 	m_weight=SGVector<float64_t>();
@@ -362,6 +380,71 @@ bool ClassificationForTestCostFunction2::next_sample()
 	return true;
 }
 
+SGVector<float64_t> SparseClassificationForTestCostFunction::get_gradient()
+{
+	m_num_dense_gradients++;
+	return ClassificationForTestCostFunction2::get_gradient();
+}
+
+SGVector<float64_t> SparseClassificationForTestCostFunction::get_sample_gradient(index_t idx)
+{
+	m_num_dense_gradients++;
+	return ClassificationForTestCostFunction2::get_sample_gradient(idx);
+}
+
+SGVector<index_t> SparseClassificationForTestCostFunction::get_gradient_support()
+{
+	index_t num=0;
+	for(index_t idx=0; idx<m_features.num_rows; idx++)
+	{
+		if(m_features(idx,m_sample_idx)!=0.0)
+			num++;
+	}
+	SGVector<index_t> support(num);
+	num=0;
+	for(index_t idx=0; idx<m_features.num_rows; idx++)
+	{
+		if(m_features(idx,m_sample_idx)!=0.0)
+			support[num++]=idx;
+	}
+	return support;
+}
+
+SGSparseVector<float64_t> SparseClassificationForTestCostFunction::get_sparse_gradient()
+{
+	m_num_sparse_gradients++;
+	return get_sparse_sample_gradient(m_sample_idx);
+}
+
+SGSparseVector<float64_t> SparseClassificationForTestCostFunction::get_sparse_sample_gradient(index_t idx)
+{
+	index_t num=0;
+	float64_t tmp=0.0;
+	for(index_t i=0; i<m_features.num_rows; i++)
+	{
+		if(m_features(i,idx)!=0.0)
+		{
+			tmp+=m_weight[i]*m_features(i,idx);
+			num++;
+		}
+	}
+	tmp=exp(tmp*m_labels[idx]);
+	float64_t w=m_labels[idx]*tmp / (1.0+tmp);
+
+	SGSparseVector<float64_t> result(num);
+	num=0;
+	for(index_t i=0; i<m_features.num_rows; i++)
+	{
+		if(m_features(i,idx)!=0.0)
+		{
+			result.features[num].feat_index=i;
+			result.features[num].entry=w*m_features(i,idx);
+			num++;
+		}
+	}
+	return result;
+}
+
 struct ClassificationFixture
 {
 	ClassificationFixture(){init();}
@@ -454,6 +537,31 @@ void RegressionFixture::init()
 	y[9]=30.801085;
 }
 
+struct SparseClassificationFixture
+{
+	SparseClassificationFixture(){init();}
+	SGVector<float64_t> y;
+	SGMatrix<float64_t> x;
+	void init();
+};
+
+void SparseClassificationFixture::init()
+{
+	//sparse features, every sample has one to three non-zero features
+	x=SGMatrix<float64_t>(10,40);
+	y=SGVector<float64_t>(40);
+	x.zero();
+	for(index_t j=0; j<x.num_cols; j++)
+	{
+		for(index_t i=0; i<x.num_rows; i++)
+		{
+			if((3*i+j)%7==0 || i==j%4)
+				x(i,j)=sin(1.0+i+2.0*j);
+		}
+		y[j]=(j%3==0)? 1.0: -1.0;
+	}
+}
+
 TEST(SGDMinimizer,test1)
 {
 	SGVector<float64_t> w(3);
@@ -1086,3 +1194,340 @@ TEST(SMIDASMinimizer, test1)
 
 	delete opt;
 }
+
+/* runs the minimizer built by make_minimizer once with the lazy sparse steps
+ * and once with the dense steps, both have to arrive at the same solution */
+static void check_lazy_update(std::function<FirstOrderStochasticMinimizer*(
+	SparseClassificationForTestCostFunction*)> make_minimizer)
+{
+	SparseClassificationFixture data;
+	SGVector<float64_t> w[2];
+	float64_t cost[2];
+	//run 0 takes the lazy sparse steps, run 1 the dense steps
+	for(index_t run=0; run<2; run++)
+	{
+		SparseClassificationForTestCostFunction* bb=new SparseClassificationForTestCostFunction();
+		bb->set_data(data.x, data.y);
+		bb->set_use_sparse_gradient(run==0);
+		FirstOrderStochasticMinimizer* opt=make_minimizer(bb);
+		cost[run]=opt->minimize();
+		w[run]=bb->obtain_variable_reference();
+		if(run==0)
+		{
+			EXPECT_EQ(0, bb->get_num_dense_gradients());
+			EXPECT_LT(0, bb->get_num_sparse_gradients());
+		}
+		else
+			EXPECT_EQ(0, bb->get_num_sparse_gradients());
+		delete opt;
+	}
+
+	EXPECT_NEAR(cost[1],cost[0],1e-10);
+	for(index_t i=0; i<w[1].vlen; i++)
+		EXPECT_NEAR(w[1][i],w[0][i],1e-10);
+}
+
+TEST(SGDMinimizer, lazy_update_elastic_net)
+{
+	check_lazy_update([](SparseClassificationForTestCostFunction* bb)
+	{
+		SGDMinimizer* opt=new SGDMinimizer(bb);
+		InverseScalingLearningRate* rate= new InverseScalingLearningRate();
+		rate->set_initial_learning_rate(0.5);
+		rate->set_exponent(0.6);
+		rate->set_slope(1.0);
+		rate->set_intercept(0.0);
+		opt->set_gradient_updater(new GradientDescendUpdater());
+		opt->set_penalty_weight(0.1);
+		ElasticNetPenalty* penalty_type=new ElasticNetPenalty();
+		penalty_type->set_l1_ratio(0.5);
+		opt->set_penalty_type(penalty_type);
+		opt->set_number_passes(5);
+		opt->set_learning_rate(rate);
+		return opt;
+	});
+}
+
+TEST(SGDMinimizer, lazy_update_adagrad)
+{
+	check_lazy_update([](SparseClassificationForTestCostFunction* bb)
+	{
+		SGDMinimizer* opt=new SGDMinimizer(bb);
+		ConstLearningRate* rate=new ConstLearningRate();
+		rate->set_const_learning_rate(0.05);
+		opt->set_gradient_updater(new AdaGradUpdater(0.1, 1e-6));
+		opt->set_penalty_weight(0.1);
+		opt->set_penalty_type(new L1Penalty());
+		opt->set_number_passes(5);
+		opt->set_learning_rate(rate);
+		return opt;
+	});
+}
+
+TEST(SGDMinimizer, lazy_update_rmsprop)
+{
+	check_lazy_update([](SparseClassificationForTestCostFunction* bb)
+	{
+		SGDMinimizer* opt=new SGDMinimizer(bb);
+		ConstLearningRate* rate=new ConstLearningRate();
+		rate->set_const_learning_rate(0.05);
+		opt->set_gradient_updater(new RmsPropUpdater(0.05, 1e-6, 0.9));
+		opt->set_penalty_weight(0.1);
+		opt->set_penalty_type(new L1Penalty());
+		opt->set_number_passes(5);
+		opt->set_learning_rate(rate);
+		return opt;
+	});
+}
+
+TEST(SVRGMinimizer, lazy_update_l2)
+{
+	check_lazy_update([](SparseClassificationForTestCostFunction* bb)
+	{
+		SVRGMinimizer* opt=new SVRGMinimizer(bb);
+		ConstLearningRate* rate=new ConstLearningRate();
+		rate->set_const_learning_rate(0.2);
+		opt->set_gradient_updater(new GradientDescendUpdater());
+		opt->set_penalty_weight(0.1);
+		opt->set_penalty_type(new L2Penalty());
+		opt->set_number_passes(5);
+		opt->set_sgd_number_passes(1);
+		opt->set_average_update_interval(2);
+		opt->set_learning_rate(rate);
+		return opt;
+	});
+}
+
+TEST(SGDMinimizer, mini_batch)
+{
+	ClassificationFixture data;
+	ClassificationForTestCostFunction2* bb=new ClassificationForTestCostFunction2();
+	bb->set_data(data.x, data.y);
+	bb->set_batch_gradient(true);
+	SGDMinimizer* opt=new SGDMinimizer(bb);
+
+	ConstLearningRate* rate=new ConstLearningRate();
+	rate->set_const_learning_rate(0.5);
+	opt->set_gradient_updater(new GradientDescendUpdater());
+	opt->set_penalty_weight(0.1);
+	opt->set_penalty_type(new L2Penalty());
+	opt->set_number_passes(3);
+	opt->set_learning_rate(rate);
+	//the last mini-batch of a pass has 2 samples
+	opt->set_batch_size(6);
+	int32_t num_threads=opt->parallel->get_num_threads();
+	opt->parallel->set_num_threads(3);
+	opt->minimize();
+	opt->parallel->set_num_threads(num_threads);
+	EXPECT_EQ(12, opt->get_iteration_counter());
+
+	ClassificationForTestCostFunction2* ref=new ClassificationForTestCostFunction2();
+	ref->set_data(data.x, data.y);
+	SGVector<float64_t> w=ref->obtain_variable_reference();
+	for(index_t pass=0; pass<3; pass++)
+	{
+		for(index_t start=0; start<data.y.vlen; start+=6)
+		{
+			index_t stop=CMath::min(start+6, data.y.vlen);
+			SGVector<float64_t> grad(w.vlen);
+			grad.zero();
+			for(index_t j=start; j<stop; j++)
+			{
+				SGVector<float64_t> sample_grad=ref->get_sample_gradient(j);
+				for(index_t i=0; i<w.vlen; i++)
+					grad[i]+=sample_grad[i];
+			}
+			for(index_t i=0; i<w.vlen; i++)
+				w[i]-=0.5*(grad[i]/(stop-start)+0.1*w[i]);
+		}
+	}
+
+	SGVector<float64_t> result=bb->obtain_variable_reference();
+	for(index_t i=0; i<w.vlen; i++)
+		EXPECT_NEAR(w[i], result[i], 1e-12);
+
+	delete ref;
+	delete opt;
+}
+
+TEST(SGDMinimizer, hogwild)
+{
+	ClassificationFixture data;
+	SGVector<float64_t> w[3];
+	float64_t cost[3];
+	for(index_t run=0; run<3; run++)
+	{
+		ClassificationForTestCostFunction2* bb=new ClassificationForTestCostFunction2();
+		bb->set_data(data.x, data.y);
+		bb->set_batch_gradient(true);
+		SGDMinimizer* opt=new SGDMinimizer(bb);
+
+		InverseScalingLearningRate* rate= new InverseScalingLearningRate();
+		rate->set_initial_learning_rate(0.1);
+		rate->set_exponent(0.6);
+		rate->set_slope(1.0);
+		rate->set_intercept(0.0);
+		opt->set_gradient_updater(new GradientDescendUpdater());
+		opt->set_penalty_weight(0.01);
+		opt->set_penalty_type(new L2Penalty());
+		opt->set_number_passes(5);
+		opt->set_learning_rate(rate);
+		//run 0 is plain SGD, run 1 Hogwild on one thread, run 2 on four threads
+		int32_t num_threads=opt->parallel->get_num_threads();
+		if(run>0)
+		{
+			opt->set_hogwild(true);
+			opt->set_batch_size(8);
+			opt->parallel->set_num_threads(run==1? 1: 4);
+		}
+		opt->minimize();
+		opt->parallel->set_num_threads(num_threads);
+		EXPECT_EQ(100, opt->get_iteration_counter());
+		cost[run]=bb->get_cost()/bb->get_sample_size();
+		w[run]=bb->obtain_variable_reference();
+		delete opt;
+	}
+
+	//on one thread, Hogwild takes the same steps as plain SGD
+	EXPECT_NEAR(cost[0], cost[1], 1e-12);
+	for(index_t i=0; i<w[0].vlen; i++)
+		EXPECT_NEAR(w[0][i], w[1][i], 1e-12);
+
+	//steps on stale variables still decrease the cost, which is log(2) at
+	//the initial zero variable and about 0.604 after plain SGD
+	EXPECT_LT(cost[2], log(2.0)-0.05);
+}
+
+TEST(SGDMinimizer, hogwild_sparse)
+{
+	SparseClassificationFixture data;
+	SGVector<float64_t> w[2];
+	for(index_t run=0; run<2; run++)
+	{
+		SparseClassificationForTestCostFunction* bb=new SparseClassificationForTestCostFunction();
+		bb->set_data(data.x, data.y);
+		bb->set_batch_gradient(true);
+		SGDMinimizer* opt=new SGDMinimizer(bb);
+
+		InverseScalingLearningRate* rate= new InverseScalingLearningRate();
+		rate->set_initial_learning_rate(0.5);
+		rate->set_exponent(0.6);
+		rate->set_slope(1.0);
+		rate->set_intercept(0.0);
+		opt->set_gradient_updater(new GradientDescendUpdater());
+		opt->set_number_passes(5);
+		opt->set_learning_rate(rate);
+		//run 0 is plain SGD with lazy updates, run 1 Hogwild on one thread
+		int32_t num_threads=opt->parallel->get_num_threads();
+		if(run>0)
+		{
+			opt->set_hogwild(true);
+			opt->set_batch_size(8);
+			opt->parallel->set_num_threads(1);
+		}
+		opt->minimize();
+		opt->parallel->set_num_threads(num_threads);
+		//both runs only compute sparse sample gradients
+		EXPECT_EQ(0, bb->get_num_dense_gradients());
+		w[run]=bb->obtain_variable_reference();
+		delete opt;
+	}
+
+	for(index_t i=0; i<w[0].vlen; i++)
+		EXPECT_NEAR(w[0][i], w[1][i], 1e-12);
+}
+
+TEST(SGDMinimizer, hogwild_proximal_penalty)
+{
+	ClassificationFixture data;
+	SGVector<float64_t> w[2];
+	for(index_t run=0; run<2; run++)
+	{
+		ClassificationForTestCostFunction2* bb=new ClassificationForTestCostFunction2();
+		bb->set_data(data.x, data.y);
+		bb->set_batch_gradient(true);
+		SGDMinimizer* opt=new SGDMinimizer(bb);
+
+		ConstLearningRate* rate=new ConstLearningRate();
+		rate->set_const_learning_rate(0.5);
+		opt->set_gradient_updater(new GradientDescendUpdater());
+		opt->set_penalty_weight(0.1);
+		opt->set_penalty_type(new L1Penalty());
+		opt->set_number_passes(3);
+		opt->set_learning_rate(rate);
+		opt->set_batch_size(8);
+		opt->set_hogwild(run==1);
+		int32_t num_threads=opt->parallel->get_num_threads();
+		opt->parallel->set_num_threads(2);
+		opt->minimize();
+		opt->parallel->set_num_threads(num_threads);
+		w[run]=bb->obtain_variable_reference();
+		delete opt;
+	}
+
+	//the L1 proximal operation rules out Hogwild, both runs take the same
+	//synchronous mini-batch steps
+	for(index_t i=0; i<w[0].vlen; i++)
+		EXPECT_NEAR(w[0][i], w[1][i], 1e-12);
+}
+
+TEST(SVRGMinimizer, mini_batch)
+{
+	ClassificationFixture data;
+	SGVector<float64_t> w[2];
+	for(index_t run=0; run<2; run++)
+	{
+		ClassificationForTestCostFunction2* bb=new ClassificationForTestCostFunction2();
+		bb->set_data(data.x, data.y);
+		bb->set_batch_gradient(run==1);
+		SVRGMinimizer* opt=new SVRGMinimizer(bb);
+
+		ConstLearningRate* rate=new ConstLearningRate();
+		rate->set_const_learning_rate(0.5);
+		opt->set_gradient_updater(new GradientDescendUpdater());
+		opt->set_penalty_weight(1.0/data.y.vlen);
+		opt->set_penalty_type(new L2Penalty());
+		opt->set_number_passes(4);
+		opt->set_learning_rate(rate);
+		opt->set_sgd_number_passes(0);
+		opt->set_average_update_interval(2);
+		int32_t num_threads=opt->parallel->get_num_threads();
+		opt->parallel->set_num_threads(4);
+		opt->minimize();
+		opt->parallel->set_num_threads(num_threads);
+		w[run]=bb->obtain_variable_reference();
+		delete opt;
+	}
+
+	//the snapshot gradient computed in parallel is the average gradient
+	for(index_t i=0; i<w[0].vlen; i++)
+		EXPECT_NEAR(w[0][i], w[1][i], 1e-12);
+
+	ClassificationForTestCostFunction2* bb=new ClassificationForTestCostFunction2();
+	bb->set_data(data.x, data.y);
+	bb->set_batch_gradient(true);
+	SVRGMinimizer* opt=new SVRGMinimizer(bb);
+	ConstLearningRate* rate=new ConstLearningRate();
+	rate->set_const_learning_rate(1.5);
+	opt->set_gradient_updater(new GradientDescendUpdater());
+	opt->set_penalty_weight(1.0/data.y.vlen);
+	opt->set_penalty_type(new L2Penalty());
+	opt->set_number_passes(40);
+	opt->set_learning_rate(rate);
+	opt->set_sgd_number_passes(0);
+	opt->set_average_update_interval(2);
+	opt->set_batch_size(4);
+	int32_t num_threads=opt->parallel->get_num_threads();
+	opt->parallel->set_num_threads(4);
+	opt->minimize();
+	opt->parallel->set_num_threads(num_threads);
+
+	//mini-batch SVRG converges to the minimizer of the cost, where the
+	//average gradient plus the penalty gradient vanishes
+	SGVector<float64_t> avg=bb->get_average_gradient();
+	SGVector<float64_t> result=bb->obtain_variable_reference();
+	for(index_t i=0; i<result.vlen; i++)
+		EXPECT_NEAR(0.0, avg[i]+result[i]/data.y.vlen, 1e-8);
+
+	delete opt;
+}
@@ -74,8 +74,13 @@ public:
 	virtual bool next_sample();
 	virtual int32_t get_sample_size();
 	virtual SGVector<float64_t> get_average_gradient();
+	void set_batch_gradient(bool batch_gradient){m_batch_gradient=batch_gradient;}
+	virtual bool supports_batch_gradient() const {return m_batch_gradient;}
+	virtual index_t get_sample_index(){return m_sample_idx;}
+	virtual SGVector<float64_t> get_sample_gradient(index_t idx);
 	virtual const char* get_name() const { return "ClassificationForTestCostFunction"; }
 protected:
+	bool m_batch_gradient;
 	index_t m_sample_idx;
 	SGVector<int32_t> m_sample_sequences;
 	index_t m_num_sequences;
@@ -98,6 +103,29 @@ public:
 	virtual const char* get_name() const { return "ClassificationForTestCostFunction2"; }
 };
 
+class SparseClassificationForTestCostFunction: public ClassificationForTestCostFunction2
+{
+public:
+	SparseClassificationForTestCostFunction()
+		:ClassificationForTestCostFunction2(), m_use_sparse_gradient(true),
+		m_num_dense_gradients(0), m_num_sparse_gradients(0){};
+	virtual ~SparseClassificationForTestCostFunction(){};
+	void set_use_sparse_gradient(bool use_sparse_gradient){m_use_sparse_gradient=use_sparse_gradient;}
+	virtual bool supports_sparse_gradient() const {return m_use_sparse_gradient;}
+	virtual SGVector<float64_t> get_gradient();
+	virtual SGVector<index_t> get_gradient_support();
+	virtual SGSparseVector<float64_t> get_sparse_gradient();
+	virtual SGVector<float64_t> get_sample_gradient(index_t idx);
+	virtual SGSparseVector<float64_t> get_sparse_sample_gradient(index_t idx);
+	index_t get_num_dense_gradients() const {return m_num_dense_gradients;}
+	index_t get_num_sparse_gradients() const {return m_num_sparse_gradients;}
+	virtual const char* get_name() const { return "SparseClassificationForTestCostFunction"; }
+protected:
+	bool m_use_sparse_gradient;
+	index_t m_num_dense_gradients;
+	index_t m_num_sparse_gradients;
+};
+
 class CRegressionExample: public CSGObject
 {
 friend class RegressionForTestCostFunction;
@@ -81,3 +81,49 @@ TEST(KernelPCA, apply_to_feature_vector)
 
 	SG_FREE(kpca);
 }
+
+static void check_method(EKernelPCAMethod method)
+{
+	index_t num_test_vectors = 2;
+
+	SGMatrix<float64_t> train_matrix(num_features, num_vectors);
+	SGMatrix<float64_t> test_matrix(num_features, num_test_vectors);
+	load_data(train_matrix, test_matrix);
+
+	CDenseFeatures<float64_t>* train_feats =
+	    new CDenseFeatures<float64_t>(train_matrix);
+
+	CDenseFeatures<float64_t>* test_feats =
+	    new CDenseFeatures<float64_t>(test_matrix);
+
+	CGaussianKernel* kernel = new CGaussianKernel();
+	kernel->set_width(1);
+
+	// with as many random vectors or landmarks as training vectors both
+	// approximations are exact
+	CKernelPCA* kpca = new CKernelPCA(kernel);
+	kpca->set_target_dim(target_dim);
+	kpca->set_method(method);
+	kpca->set_num_landmarks(num_vectors);
+	kpca->set_oversampling(num_vectors);
+	kpca->parallel->set_num_threads(2);
+	kpca->init(train_feats);
+
+	SGMatrix<float64_t> embedding = kpca->apply_to_feature_matrix(test_feats);
+
+	// allow embedding with opposite sign
+	for (index_t i = 0; i < num_test_vectors * target_dim; ++i)
+		EXPECT_NEAR(CMath::abs(embedding[i]), CMath::abs(resdata[i]), 1E-6);
+
+	SG_FREE(kpca);
+}
+
+TEST(KernelPCA, apply_to_feature_matrix_randomized)
+{
+	check_method(KPCA_RANDOMIZED);
+}
+
+TEST(KernelPCA, apply_to_feature_matrix_nystrom)
+{
+	check_method(KPCA_NYSTROM);
+}
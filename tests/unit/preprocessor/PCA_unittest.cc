@@ -31,6 +31,7 @@
 #include <gtest/gtest.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/lib/SGVector.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
@@ -624,3 +625,88 @@ TEST(PCA, PCA_WHITEN_EVD)
 	SG_UNREF(pca);
 	SG_UNREF(features);
 }
+
+static SGMatrix<float64_t> generate_low_rank_data(int32_t num_features, int32_t num_vectors)
+{
+	SGMatrix<float64_t> data(num_features, num_vectors);
+	for (index_t j=0; j<num_vectors; j++)
+	{
+		for (index_t i=0; i<num_features; i++)
+			data(i,j)=CMath::normal_random(1.0, 1.0/(i+1)/(i+1));
+	}
+
+	return data;
+}
+
+TEST(PCA, PCA_RANDOMIZED_equals_EVD)
+{
+	CMath::init_random(5);
+	SGMatrix<float64_t> data=generate_low_rank_data(20, 300);
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+	SG_REF(features);
+
+	CPCA* evd=new CPCA(EVD);
+	evd->set_target_dim(3);
+	evd->init(features);
+
+	CPCA* randomized=new CPCA(RANDOMIZED);
+	randomized->set_target_dim(3);
+	randomized->parallel->set_num_threads(2);
+	randomized->init(features);
+
+	SGMatrix<float64_t> evd_transmat=evd->get_transformation_matrix();
+	SGMatrix<float64_t> transmat=randomized->get_transformation_matrix();
+	SGVector<float64_t> evd_eigvec=evd->get_eigenvalues();
+	SGVector<float64_t> eigvec=randomized->get_eigenvalues();
+
+	// EVD sorts increasingly, RANDOMIZED decreasingly like SVD
+	for (index_t k=0; k<3; k++)
+	{
+		EXPECT_NEAR(evd_eigvec[evd_eigvec.vlen-1-k], eigvec[k], 1e-8);
+
+		float64_t dot=0;
+		for (index_t i=0; i<20; i++)
+			dot+=evd_transmat(i,2-k)*transmat(i,k);
+		EXPECT_NEAR(1.0, CMath::abs(dot), 1e-8);
+	}
+
+	SG_UNREF(randomized);
+	SG_UNREF(evd);
+	SG_UNREF(features);
+}
+
+TEST(PCA, PCA_streaming_equals_EVD)
+{
+	CMath::init_random(7);
+	SGMatrix<float64_t> data=generate_low_rank_data(10, 2500);
+
+	CDenseFeatures<float64_t>* features=new CDenseFeatures<float64_t>(data);
+	SG_REF(features);
+	CStreamingDenseFeatures<float64_t>* streaming_features=
+		new CStreamingDenseFeatures<float64_t>(features);
+	SG_REF(streaming_features);
+
+	CPCA* evd=new CPCA(EVD);
+	evd->set_target_dim(4);
+	evd->init(features);
+
+	CPCA* streaming=new CPCA(EVD);
+	streaming->set_target_dim(4);
+	streaming->init(streaming_features);
+
+	SGVector<float64_t> evd_mean=evd->get_mean();
+	SGVector<float64_t> mean=streaming->get_mean();
+	for (index_t i=0; i<mean.vlen; i++)
+		EXPECT_NEAR(evd_mean[i], mean[i], 1e-10);
+
+	SGVector<float64_t> evd_eigvec=evd->get_eigenvalues();
+	SGVector<float64_t> eigvec=streaming->get_eigenvalues();
+	for (index_t i=0; i<eigvec.vlen; i++)
+		EXPECT_NEAR(evd_eigvec[i], eigvec[i], 1e-10);
+
+	SG_UNREF(streaming);
+	SG_UNREF(evd);
+	SG_UNREF(streaming_features);
+	SG_UNREF(features);
+}
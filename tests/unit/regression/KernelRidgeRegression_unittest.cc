@@ -0,0 +1,45 @@
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/regression/KernelRidgeRegression.h>
+#include <shogun/base/some.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+TEST(KernelRidgeRegression, conjugate_gradient_equals_direct)
+{
+	index_t num_vectors=200;
+	SGVector<float64_t> lab(num_vectors);
+	SGMatrix<float64_t> train_dat(2, num_vectors);
+	CMath::init_random(3);
+	for (index_t i=0; i<num_vectors; ++i)
+	{
+		train_dat(0,i)=CMath::random(0.0, 5.0);
+		train_dat(1,i)=CMath::random(0.0, 5.0);
+		lab[i]=CMath::sin(train_dat(0,i))+CMath::normal_random(0, 0.1);
+	}
+
+	auto features=some<CDenseFeatures<float64_t>>(train_dat);
+	auto labels=some<CRegressionLabels>(lab);
+	auto kernel=some<CGaussianKernel>(features, features, 10, 2.0);
+	auto krr=some<CKernelRidgeRegression>(0.1, kernel, labels);
+	auto krr_cg=some<CKernelRidgeRegression>(0.1, kernel, labels);
+	krr_cg->set_solver_type(KRR_CONJUGATE_GRADIENT);
+	krr_cg->set_epsilon(1E-10);
+
+	/* the second value of tau starts from the solution for the first */
+	float64_t taus[]={0.1, 0.01};
+	for (index_t t=0; t<2; ++t)
+	{
+		krr->set_tau(taus[t]);
+		krr_cg->set_tau(taus[t]);
+		krr->train();
+		krr_cg->train();
+
+		SGVector<float64_t> alphas=krr->get_alphas();
+		SGVector<float64_t> alphas_cg=krr_cg->get_alphas();
+		for (index_t i=0; i<num_vectors; ++i)
+			EXPECT_NEAR(alphas[i], alphas_cg[i], 1E-5);
+	}
+}
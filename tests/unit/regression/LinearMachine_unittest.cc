@@ -36,7 +36,9 @@
 #include <shogun/regression/Regression.h>
 #include <shogun/machine/LinearMachine.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SparseFeatures.h>
 #include <shogun/regression/LinearRidgeRegression.h>
+#include <shogun/base/some.h>
 #include <shogun/mathematics/eigen3.h>
 
 using namespace shogun;
@@ -127,3 +129,51 @@ TEST(LinearMachine,compute_bias)
 }
 
 #endif /* HAVE_LAPACK */
+
+TEST(LinearMachine, apply_float32_features)
+{
+	const index_t dim=5;
+	const index_t num=7;
+
+	SGMatrix<float64_t> data(dim, num);
+	SGMatrix<float32_t> data32(dim, num);
+	for (index_t j=0; j<num; ++j)
+	{
+		for (index_t i=0; i<dim; ++i)
+		{
+			data(i, j)=(i%2 ? 0 : CMath::sin(i+2*j));
+			data32(i, j)=data(i, j);
+		}
+	}
+
+	SGVector<float64_t> w(dim);
+	for (index_t i=0; i<dim; ++i)
+		w[i]=0.25*i-0.5;
+
+	auto machine=some<CLinearMachine>();
+	machine->set_w(w);
+	machine->set_bias(0.75);
+
+	auto features=some<CDenseFeatures<float64_t>>(data);
+	auto dense32=some<CDenseFeatures<float32_t>>(data32);
+	auto sparse32=some<CSparseFeatures<float32_t>>(data32);
+
+	CRegressionLabels* expected=machine->apply_regression(features);
+	CRegressionLabels* dense_out=machine->apply_regression(dense32);
+	CRegressionLabels* sparse_out=machine->apply_regression(sparse32);
+
+	for (index_t j=0; j<num; ++j)
+	{
+		EXPECT_NEAR(expected->get_label(j), dense_out->get_label(j), 1E-5);
+		EXPECT_NEAR(expected->get_label(j), sparse_out->get_label(j), 1E-5);
+	}
+
+	/* the model is not touched by scoring single precision features */
+	SGVector<float64_t> w_after=machine->get_w();
+	for (index_t i=0; i<dim; ++i)
+		EXPECT_EQ(w[i], w_after[i]);
+
+	SG_UNREF(expected);
+	SG_UNREF(dense_out);
+	SG_UNREF(sparse_out);
+}
@@ -156,4 +156,50 @@ TEST(KRRNystrom, apply_and_compare_to_KRR_with_column_subset)
 		EXPECT_NEAR(result->get_label(i), result_krr->get_label(i), 1E-1);
 }
 
+/**
+ * Test the preconditioned conjugate gradient solver by comparison of the
+ * predictions to the ones of the direct solver, using a subset of the columns.
+ */
+TEST(KRRNystrom, conjugate_gradient_compare_to_direct)
+{
+	/* data matrix dimensions */
+	index_t num_vectors=300;
+	index_t num_features=1;
+	index_t num_basis_rkhs=60;
+
+	/* training label data */
+	SGVector<float64_t> lab(num_vectors);
+
+	/* fill data matrix and labels */
+	SGMatrix<float64_t> train_dat(num_features, num_vectors);
+	for (index_t i=0; i<num_vectors; ++i)
+	{
+		/* labels are a sine plus noise */
+		float64_t point=(float64_t)i*10/num_vectors;
+		lab.vector[i]=CMath::sin(point)+CMath::normal_random(0, 0.1);
+		train_dat.matrix[i]=point;
+	}
+
+	auto features=some<CDenseFeatures<float64_t>>(train_dat);
+	auto labels=some<CRegressionLabels>(lab);
+	auto kernel=some<CGaussianKernel>(features, features, 10, 0.5);
+
+	float64_t tau=0.01;
+	auto nystrom=some<CKRRNystrom>(tau, num_basis_rkhs, kernel, labels);
+
+	/* same sampled columns for both solvers */
+	CMath::init_random(5);
+	nystrom->train();
+	auto result=nystrom->apply_regression(features);
+
+	nystrom->set_solver_type(KRR_CONJUGATE_GRADIENT);
+	nystrom->set_epsilon(1E-10);
+	CMath::init_random(5);
+	nystrom->train();
+	auto result_cg=nystrom->apply_regression(features);
+
+	for (index_t i=0; i<num_vectors; ++i)
+		EXPECT_NEAR(result->get_label(i), result_cg->get_label(i), 1E-2);
+}
+
 #endif /* HAVE_CXX11 */
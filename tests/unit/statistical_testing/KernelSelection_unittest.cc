@@ -289,7 +289,7 @@ TEST(KernelSelectionMaxCrossValidation, quadratic_time_single_kernel_dense)
 	mmd->set_train_test_mode(false);
 
 	auto selected_kernel=static_cast<CGaussianKernel*>(mmd->get_kernel());
-	EXPECT_NEAR(selected_kernel->get_width(), 0.25, 1E-10);
+	EXPECT_NEAR(selected_kernel->get_width(), 0.125, 1E-10);
 }
 
 TEST(KernelSelectionMaxCrossValidation, linear_time_single_kernel_dense)
@@ -103,12 +103,14 @@ TEST(PermutationMMD, biased_full_single_kernel)
 	Map<MatrixXf> map(kernel_matrix.matrix, kernel_matrix.num_rows, kernel_matrix.num_cols);
 	SGVector<float32_t> result_2(num_null_samples);
 	sg_rand->set_seed(12345);
+	const uint64_t seed=CMath::random();
 	for (auto i=0; i<num_null_samples; ++i)
 	{
 		PermutationMatrix<Dynamic, Dynamic> perm(kernel_matrix.num_rows);
 		perm.setIdentity();
 		SGVector<int> perminds(perm.indices().data(), perm.indices().size(), false);
-		CMath::permute(perminds);
+		RandomStream rng(seed, i);
+		CMath::permute(perminds, rng);
 		MatrixXf permuted = perm.transpose()*map*perm;
 		SGMatrix<float32_t> permuted_km(permuted.data(), permuted.rows(), permuted.cols(), false);
 		result_2[i]=compute_mmd(permuted_km);
@@ -116,11 +118,11 @@ TEST(PermutationMMD, biased_full_single_kernel)
 
 	SGVector<index_t> inds(kernel_matrix.num_rows);
 	SGVector<float32_t> result_3(num_null_samples);
-	sg_rand->set_seed(12345);
 	for (auto i=0; i<num_null_samples; ++i)
 	{
 		std::iota(inds.vector, inds.vector+inds.vlen, 0);
-		CMath::permute(inds);
+		RandomStream rng(seed, i);
+		CMath::permute(inds, rng);
 		feats->add_subset(inds);
 		kernel->init(feats, feats);
 		kernel_matrix=kernel->get_kernel_matrix<float32_t>();
@@ -183,12 +185,14 @@ TEST(PermutationMMD, unbiased_full_single_kernel)
 	Map<MatrixXf> map(kernel_matrix.matrix, kernel_matrix.num_rows, kernel_matrix.num_cols);
 	SGVector<float32_t> result_2(num_null_samples);
 	sg_rand->set_seed(12345);
+	const uint64_t seed=CMath::random();
 	for (auto i=0; i<num_null_samples; ++i)
 	{
 		PermutationMatrix<Dynamic, Dynamic> perm(kernel_matrix.num_rows);
 		perm.setIdentity();
 		SGVector<int> perminds(perm.indices().data(), perm.indices().size(), false);
-		CMath::permute(perminds);
+		RandomStream rng(seed, i);
+		CMath::permute(perminds, rng);
 		MatrixXf permuted = perm.transpose()*map*perm;
 		SGMatrix<float32_t> permuted_km(permuted.data(), permuted.rows(), permuted.cols(), false);
 		result_2[i]=compute_mmd(permuted_km);
@@ -196,11 +200,11 @@ TEST(PermutationMMD, unbiased_full_single_kernel)
 
 	SGVector<index_t> inds(kernel_matrix.num_rows);
 	SGVector<float32_t> result_3(num_null_samples);
-	sg_rand->set_seed(12345);
 	for (auto i=0; i<num_null_samples; ++i)
 	{
 		std::iota(inds.vector, inds.vector+inds.vlen, 0);
-		CMath::permute(inds);
+		RandomStream rng(seed, i);
+		CMath::permute(inds, rng);
 		feats->add_subset(inds);
 		kernel->init(feats, feats);
 		kernel_matrix=kernel->get_kernel_matrix<float32_t>();
@@ -262,12 +266,14 @@ TEST(PermutationMMD, unbiased_incomplete_single_kernel)
 	Map<MatrixXf> map(kernel_matrix.matrix, kernel_matrix.num_rows, kernel_matrix.num_cols);
 	SGVector<float32_t> result_2(num_null_samples);
 	sg_rand->set_seed(12345);
+	const uint64_t seed=CMath::random();
 	for (auto i=0; i<num_null_samples; ++i)
 	{
 		PermutationMatrix<Dynamic, Dynamic> perm(kernel_matrix.num_rows);
 		perm.setIdentity();
 		SGVector<int> perminds(perm.indices().data(), perm.indices().size(), false);
-		CMath::permute(perminds);
+		RandomStream rng(seed, i);
+		CMath::permute(perminds, rng);
 		MatrixXf permuted = perm.transpose()*map*perm;
 		SGMatrix<float32_t> permuted_km(permuted.data(), permuted.rows(), permuted.cols(), false);
 		result_2[i]=compute_mmd(permuted_km);
@@ -275,11 +281,11 @@ TEST(PermutationMMD, unbiased_incomplete_single_kernel)
 
 	SGVector<index_t> inds(kernel_matrix.num_rows);
 	SGVector<float32_t> result_3(num_null_samples);
-	sg_rand->set_seed(12345);
 	for (auto i=0; i<num_null_samples; ++i)
 	{
 		std::iota(inds.vector, inds.vector+inds.vlen, 0);
-		CMath::permute(inds);
+		RandomStream rng(seed, i);
+		CMath::permute(inds, rng);
 		feats->add_subset(inds);
 		kernel->init(feats, feats);
 		kernel_matrix=kernel->get_kernel_matrix<float32_t>();
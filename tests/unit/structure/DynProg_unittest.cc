@@ -0,0 +1,232 @@
+#include <shogun/base/DynArray.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/lib/DynamicObjectArray.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGNDArray.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/structure/DynProg.h>
+#include <shogun/structure/PlifMatrix.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+namespace
+{
+	const int32_t num_states = 3;
+	const int32_t seq_len = 60;
+	const int32_t num_svms = 8;
+
+	/* two plifs scoring the segment length of every transition, a single
+	 * plif per transition would be shared with the plif list
+	 */
+	CPlifMatrix* create_plif_matrix()
+	{
+		const int32_t num_plifs = 2;
+		CPlifMatrix* pm = new CPlifMatrix();
+		pm->create_plifs(num_plifs, 2);
+
+		SGVector<int32_t> ids(num_plifs);
+		ids.range_fill();
+		pm->set_plif_ids(ids);
+
+		SGVector<float64_t> min_values(num_plifs);
+		SGVector<float64_t> max_values(num_plifs);
+		min_values.set_const(1);
+		max_values.set_const(30);
+		pm->set_plif_min_values(min_values);
+		pm->set_plif_max_values(max_values);
+
+		SGVector<bool> use_cache(num_plifs);
+		use_cache.set_const(false);
+		pm->set_plif_use_cache(use_cache);
+
+		SGVector<int32_t> use_svm(num_plifs);
+		use_svm.zero();
+		pm->set_plif_use_svm(use_svm);
+
+		SGMatrix<float64_t> limits(num_plifs, 2);
+		SGMatrix<float64_t> penalties(num_plifs, 2);
+		for (index_t i = 0; i < num_plifs; ++i)
+		{
+			limits(i, 0) = 1;
+			limits(i, 1) = 30;
+			penalties(i, 0) = 0.5 * (i + 1);
+			penalties(i, 1) = -0.5;
+		}
+		pm->set_plif_limits(limits);
+		pm->set_plif_penalties(penalties);
+
+		SGVector<index_t> dims(3);
+		dims[0] = num_states;
+		dims[1] = num_states;
+		dims[2] = num_plifs;
+		SGNDArray<float64_t> transition_plifs(dims);
+		for (index_t k = 0; k < num_plifs; ++k)
+		{
+			for (index_t i = 0; i < num_states * num_states; ++i)
+				transition_plifs.array[k * num_states * num_states + i] = k + 1;
+		}
+		pm->compute_plif_matrix(transition_plifs);
+
+		SGMatrix<int32_t> state_signals(num_states, 1);
+		state_signals.zero();
+		pm->compute_signal_plifs(state_signals);
+
+		return pm;
+	}
+
+	/* fully connected model on a random sequence */
+	CDynProg* create_dynprog(CPlifMatrix* pm)
+	{
+		const char acgt[] = "ACGT";
+		const int32_t gene_len = 3 * seq_len;
+
+		CDynProg* dp = new CDynProg(num_svms);
+		dp->set_num_states(num_states);
+		dp->long_transition_settings(false, 1000, 0);
+
+		SGVector<int32_t> pos(seq_len);
+		for (index_t i = 0; i < seq_len; ++i)
+			pos[i] = 3 * i;
+		dp->set_pos(pos);
+
+		SGVector<char> gene_string(gene_len);
+		for (index_t i = 0; i < gene_len; ++i)
+			gene_string[i] = acgt[CMath::random(0, 3)];
+		dp->set_gene_string(gene_string);
+		dp->create_word_string();
+		dp->precompute_stop_codons();
+		dp->init_content_svm_value_array(num_svms);
+
+		SGMatrix<float64_t> dict_weights(5440, num_svms);
+		dict_weights.zero();
+		dp->set_dict_weights(dict_weights);
+		dp->precompute_content_values();
+
+		SGMatrix<int32_t> mod_words(num_svms, 2);
+		mod_words.set_const(1);
+		dp->init_mod_words_array(mod_words);
+
+		SGMatrix<int32_t> orf_info(num_states, 2);
+		orf_info.set_const(-1);
+		dp->set_orf_info(orf_info);
+
+		SGVector<float64_t> p(num_states);
+		SGVector<float64_t> q(num_states);
+		p.zero();
+		q.zero();
+		dp->set_p_vector(p);
+		dp->set_q_vector(q);
+
+		/* (from, to, score), sorted by the target state */
+		SGMatrix<float64_t> a_trans(num_states * num_states, 3);
+		for (index_t to = 0; to < num_states; ++to)
+		{
+			for (index_t from = 0; from < num_states; ++from)
+			{
+				index_t row = to * num_states + from;
+				a_trans(row, 0) = from;
+				a_trans(row, 1) = to;
+				a_trans(row, 2) = from == to ? 0 : -1;
+			}
+		}
+		dp->set_a_trans_matrix(a_trans);
+		EXPECT_TRUE(dp->check_svm_arrays());
+
+		SGVector<index_t> dims(3);
+		dims[0] = num_states;
+		dims[1] = seq_len;
+		dims[2] = 1;
+		SGNDArray<float64_t> observations(dims);
+		for (index_t i = 0; i < num_states * seq_len; ++i)
+			observations.array[i] = CMath::random(-1.0, 1.0);
+		dp->set_observation_matrix(observations);
+
+		SGMatrix<float64_t> seg_path(2, seq_len);
+		seg_path.zero();
+		dp->set_content_type_array(seg_path);
+
+		SGMatrix<float64_t> segment_loss(1, 2);
+		segment_loss.zero();
+		dp->best_path_set_segment_loss(segment_loss);
+
+		dp->set_plif_matrices(pm);
+		return dp;
+	}
+}
+
+TEST(DynProg, compute_nbest_paths_parallel)
+{
+	const int32_t num_dynprogs = 5;
+	CMath::init_random(7);
+
+	CPlifMatrix* pm = create_plif_matrix();
+	CDynamicObjectArray* dynprogs = new CDynamicObjectArray();
+	SG_REF(dynprogs);
+	for (index_t i = 0; i < num_dynprogs; ++i)
+		dynprogs->append_element(create_dynprog(pm));
+
+	int32_t num_threads = pm->parallel->get_num_threads();
+	pm->parallel->set_num_threads(3);
+
+	CDynProg::compute_nbest_paths_parallel(dynprogs, 1, false, 1, false);
+
+	for (index_t i = 0; i < num_dynprogs; ++i)
+	{
+		CDynProg* dp = (CDynProg*) dynprogs->get_element(i);
+		SGVector<float64_t> scores = dp->get_scores();
+		SGMatrix<int32_t> states = dp->get_states();
+		SGMatrix<int32_t> positions = dp->get_positions();
+		EXPECT_TRUE(CMath::is_finite(scores[0]));
+
+		dp->compute_nbest_paths(1, false, 1, false, false);
+		SGVector<float64_t> serial_scores = dp->get_scores();
+		SGMatrix<int32_t> serial_states = dp->get_states();
+		SGMatrix<int32_t> serial_positions = dp->get_positions();
+
+		ASSERT_EQ(serial_scores.vlen, scores.vlen);
+		for (index_t k = 0; k < scores.vlen; ++k)
+			EXPECT_EQ(serial_scores[k], scores[k]);
+
+		ASSERT_EQ(serial_states.num_cols, states.num_cols);
+		for (index_t k = 0; k < states.num_rows * states.num_cols; ++k)
+		{
+			EXPECT_EQ(serial_states[k], states[k]);
+			EXPECT_EQ(serial_positions[k], positions[k]);
+		}
+		SG_UNREF(dp);
+	}
+
+	pm->parallel->set_num_threads(num_threads);
+	SG_UNREF(dynprogs);
+}
+
+TEST(DynProg, timing_profile)
+{
+	CMath::init_random(11);
+
+	CPlifMatrix* pm = create_plif_matrix();
+	CDynProg* dp = create_dynprog(pm);
+	SG_REF(dp);
+	EXPECT_FALSE(dp->get_timing_profile_enabled());
+
+	dp->compute_nbest_paths(1, false, 1, false, false);
+	SGVector<float64_t> profile = dp->get_timing_profile();
+	ASSERT_EQ(DPT_NUM_TIMINGS, profile.vlen);
+	for (index_t i = 0; i < profile.vlen; ++i)
+		EXPECT_EQ(0.0, profile[i]);
+
+	dp->set_timing_profile(true);
+	EXPECT_TRUE(dp->get_timing_profile_enabled());
+	dp->compute_nbest_paths(1, false, 1, false, false);
+	profile = dp->get_timing_profile();
+	EXPECT_GT(profile[DPT_TOTAL], 0.0);
+	for (index_t i = 0; i < profile.vlen; ++i)
+	{
+		EXPECT_GE(profile[i], 0.0);
+		EXPECT_LE(profile[i], profile[DPT_TOTAL]);
+	}
+
+	SG_UNREF(dp);
+}
@@ -0,0 +1,60 @@
+#include <shogun/lib/SGVector.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/structure/HMSVMModel.h>
+#include <shogun/structure/SequenceLabels.h>
+#include <shogun/structure/TwoStateModel.h>
+#include <gtest/gtest.h>
+
+using namespace shogun;
+
+TEST(HMSVMModel, argmax_batch_equals_argmax)
+{
+	int32_t num_exm = 20;
+	CMath::init_random(17);
+	CHMSVMModel* model = CTwoStateModel::simulate_data(num_exm, 250, 3, 1);
+	SG_REF(model);
+	model->init_training();
+
+	SGVector<float64_t> w(model->get_dim());
+	for (int32_t i = 0; i < w.vlen; ++i)
+		w[i] = CMath::normal_random(0.0, 1.0);
+
+	int32_t num_threads = model->parallel->get_num_threads();
+	model->parallel->set_num_threads(4);
+
+	SGVector<int32_t> idxs(num_exm);
+	idxs.range_fill();
+
+	for (int32_t training = 0; training < 2; ++training)
+	{
+		CDynamicObjectArray* results = model->argmax_batch(w, idxs, training);
+		ASSERT_EQ(results->get_num_elements(), num_exm);
+
+		for (int32_t i = 0; i < num_exm; ++i)
+		{
+			CResultSet* expected = model->argmax(w, i, training);
+			CResultSet* result = (CResultSet*) results->get_element(i);
+
+			EXPECT_NEAR(result->score, expected->score, 1e-10);
+			EXPECT_NEAR(result->delta, expected->delta, 1e-10);
+
+			SGVector<int32_t> seq = ((CSequence*) result->argmax)->get_data();
+			SGVector<int32_t> expected_seq = ((CSequence*) expected->argmax)->get_data();
+			ASSERT_EQ(seq.vlen, expected_seq.vlen);
+			for (int32_t j = 0; j < seq.vlen; ++j)
+				EXPECT_EQ(seq[j], expected_seq[j]);
+
+			ASSERT_EQ(result->psi_pred.vlen, expected->psi_pred.vlen);
+			for (int32_t j = 0; j < result->psi_pred.vlen; ++j)
+				EXPECT_NEAR(result->psi_pred[j], expected->psi_pred[j], 1e-10);
+
+			SG_UNREF(result);
+			SG_UNREF(expected);
+		}
+
+		SG_UNREF(results);
+	}
+
+	model->parallel->set_num_threads(num_threads);
+	SG_UNREF(model);
+}